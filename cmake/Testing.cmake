@@ -237,3 +237,38 @@ add_custom_target(build_transaction_tests DEPENDS ${transaction_targets})
 
 get_property(benchmark_targets GLOBAL PROPERTY COUCHBASE_BENCHMARKS)
 add_custom_target(build_benchmarks DEPENDS ${benchmark_targets})
+
+macro(unit_benchmark name)
+  add_executable(benchmark_unit_${name} "${PROJECT_SOURCE_DIR}/test/benchmark_unit_${name}.cxx")
+  target_include_directories(benchmark_unit_${name} PRIVATE ${PROJECT_SOURCE_DIR} ${PROJECT_BINARY_DIR}/generated
+                                                            ${PROJECT_BINARY_DIR}/generated_$<CONFIG>)
+  target_include_directories(
+    benchmark_unit_${name} SYSTEM BEFORE
+    PRIVATE $<BUILD_INTERFACE:${PROJECT_SOURCE_DIR}/third_party/expected/include>
+            $<BUILD_INTERFACE:$<TARGET_PROPERTY:spdlog::spdlog,INTERFACE_INCLUDE_DIRECTORIES>>
+            $<BUILD_INTERFACE:$<TARGET_PROPERTY:asio,INTERFACE_INCLUDE_DIRECTORIES>>)
+  propagate_public_compile_definitions(benchmark_unit_${name} spdlog::spdlog asio)
+  set_project_warnings(benchmark_unit_${name})
+  set_project_options(benchmark_unit_${name})
+  target_link_libraries(
+    benchmark_unit_${name}
+    PRIVATE test_main
+            Threads::Threads
+            $<BUILD_INTERFACE:Microsoft.GSL::GSL>
+            $<BUILD_INTERFACE:taocpp::json>
+            ${couchbase_cxx_client_DEFAULT_LIBRARY}
+            test_utils)
+  if(COUCHBASE_CXX_CLIENT_STATIC_BORINGSSL AND WIN32)
+    # Ignore the `LNK4099: PDB ['crypto.pdb'|'ssl.pdb'] was not found` warnings, as we don't (atm) keep track fo the
+    # *.PDB from the BoringSSL build
+    set_target_properties(benchmark_unit_${name} PROPERTIES LINK_FLAGS "/ignore:4099")
+  endif()
+  catch_discover_tests(
+    benchmark_unit_${name}
+    PROPERTIES
+    SKIP_REGULAR_EXPRESSION
+    "SKIP"
+    LABELS
+    "benchmark")
+  set_property(GLOBAL APPEND PROPERTY COUCHBASE_BENCHMARKS "benchmark_unit_${name}")
+endmacro()
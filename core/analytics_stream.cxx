@@ -28,6 +28,7 @@
 
 #include <tao/json/value.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -126,14 +127,7 @@ public:
     // subsequent pull instead of issuing another receive that would park forever on the
     // drained-but-open row channel. The public handle guards this too, but a core::-direct consumer
     // (e.g. a wrapper) relies on this being safe.
-    std::optional<std::error_code> sticky_terminal;
-    {
-      const std::scoped_lock lock{ mutex_ };
-      if (terminal_reached_) {
-        sticky_terminal = terminal_ec_;
-      }
-    }
-    if (sticky_terminal) {
+    if (auto sticky_terminal = terminal(); sticky_terminal) {
       // Deliver outside the lock: the handler typically issues the next pull, which re-enters
       // next_row and would re-lock the non-recursive mutex_ and deadlock if invoked while held.
       return handler(std::nullopt, *sticky_terminal);
@@ -143,41 +137,31 @@ public:
       if (!row.empty()) {
         return handler(std::move(row), {});
       }
-      // Empty row marks the end of the stream. Classify the terminal, remember it (so later pulls
-      // are served the sticky terminal above), then deliver.
-      std::error_code terminal_ec{};
-      if (ec) {
-        // Normalize a mid-document lexer failure to parsing_failure, matching the buffered path.
-        terminal_ec = normalize_stream_error(ec);
-      } else if (auto raw_meta = self->streamer_.metadata(); !raw_meta.has_value()) {
-        // A clean end without reconstructed metadata violates the row_streamer invariant; surface
-        // it rather than silently reporting success with no metadata.
-        CB_LOG_WARNING("analytics_stream: end reached but row_streamer returned no metadata");
-        terminal_ec = errc::common::internal_server_failure;
-      } else {
-        try {
-          auto meta = operations::parse_analytics_meta(utils::json::parse(raw_meta.value()));
-          terminal_ec = operations::map_analytics_error(meta);
-          const std::scoped_lock lock{ self->mutex_ };
-          // The trailer is where a request that failed part-way reports itself, so its diagnostics
-          // supersede the preamble's for the terminal error.
-          self->error_details_ = extract_error_details(meta, std::move(raw_meta.value()));
-          self->meta_data_ = std::move(meta);
-        } catch (const std::exception&) {
-          terminal_ec = errc::common::parsing_failure;
-          const std::scoped_lock lock{ self->mutex_ };
-          self->error_details_.raw = std::move(raw_meta.value());
-        }
-      }
-      {
-        const std::scoped_lock lock{ self->mutex_ };
-        self->terminal_reached_ = true;
-        self->terminal_ec_ = terminal_ec;
-      }
-      handler(std::nullopt, terminal_ec);
+      // Empty row marks the end of the stream.
+      handler(std::nullopt, self->finish(ec));
     });
   }
 
+  void next_rows(std::size_t max_rows,
+                 std::size_t max_bytes,
+                 utils::movable_function<void(row_batch, std::error_code)>&& handler)
+  {
+    if (auto sticky_terminal = terminal(); sticky_terminal) {
+      return handler({}, *sticky_terminal);
+    }
+    streamer_.next_rows(
+      max_rows,
+      max_bytes,
+      [self = shared_from_this(), handler = std::move(handler)](row_batch rows,
+                                                                std::error_code ec) mutable {
+        if (!rows.empty()) {
+          return handler(std::move(rows), {});
+        }
+        // An empty batch marks the end of the stream, as an empty row does for next_row.
+        handler({}, self->finish(ec));
+      });
+  }
+
   [[nodiscard]] auto signature() const -> std::optional<std::string>
   {
     const std::scoped_lock lock{ mutex_ };
@@ -203,6 +187,52 @@ public:
   }
 
 private:
+  // The terminal the stream has already reported, if any.
+  [[nodiscard]] auto terminal() const -> std::optional<std::error_code>
+  {
+    const std::scoped_lock lock{ mutex_ };
+    if (terminal_reached_) {
+      return terminal_ec_;
+    }
+    return {};
+  }
+
+  // Classifies the terminal of the stream and remembers it, so that later pulls are served the
+  // sticky terminal.
+  auto finish(std::error_code ec) -> std::error_code
+  {
+    std::error_code terminal_ec{};
+    if (ec) {
+      // Normalize a mid-document lexer failure to parsing_failure, matching the buffered path.
+      terminal_ec = normalize_stream_error(ec);
+    } else if (auto raw_meta = streamer_.metadata(); !raw_meta.has_value()) {
+      // A clean end without reconstructed metadata violates the row_streamer invariant; surface
+      // it rather than silently reporting success with no metadata.
+      CB_LOG_WARNING("analytics_stream: end reached but row_streamer returned no metadata");
+      terminal_ec = errc::common::internal_server_failure;
+    } else {
+      try {
+        auto meta = operations::parse_analytics_meta(utils::json::parse(raw_meta.value()));
+        terminal_ec = operations::map_analytics_error(meta);
+        const std::scoped_lock lock{ mutex_ };
+        // The trailer is where a request that failed part-way reports itself, so its diagnostics
+        // supersede the preamble's for the terminal error.
+        error_details_ = extract_error_details(meta, std::move(raw_meta.value()));
+        meta_data_ = std::move(meta);
+      } catch (const std::exception&) {
+        terminal_ec = errc::common::parsing_failure;
+        const std::scoped_lock lock{ mutex_ };
+        error_details_.raw = std::move(raw_meta.value());
+      }
+    }
+    {
+      const std::scoped_lock lock{ mutex_ };
+      terminal_reached_ = true;
+      terminal_ec_ = terminal_ec;
+    }
+    return terminal_ec;
+  }
+
   row_streamer streamer_;
   mutable std::mutex mutex_{};
   std::optional<std::string> signature_{};
@@ -234,6 +264,14 @@ analytics_stream::next_row(
   impl_->next_row(std::move(handler));
 }
 
+void
+analytics_stream::next_rows(std::size_t max_rows,
+                            std::size_t max_bytes,
+                            utils::movable_function<void(row_batch, std::error_code)>&& handler)
+{
+  impl_->next_rows(max_rows, max_bytes, std::move(handler));
+}
+
 auto
 analytics_stream::signature() const -> std::optional<std::string>
 {
@@ -20,18 +20,21 @@
 #include "bucket_unit_test_api.hxx"
 
 #include "collection_id_cache_entry.hxx"
+#include "collection_id_table.hxx"
 #include "core/app_telemetry_meter.hxx"
 #include "core/cluster_options.hxx"
 #include "core/config_listener.hxx"
 #include "core/document_id.hxx"
 #include "core/error_context/key_value_error_map_info.hxx"
 #include "core/error_context/key_value_status_code.hxx"
+#include "core/io/io_context_pool.hxx"
 #include "core/io/mcbp_message.hxx"
 #include "core/logger/logger.hxx"
 #include "core/mcbp/codec.hxx"
 #include "core/metrics/meter_wrapper.hxx"
 #include "core/protocol/client_opcode.hxx"
 #include "core/protocol/client_request.hxx"
+#include "core/protocol/compression_policy.hxx"
 #include "core/protocol/hello_feature.hxx"
 #include "core/response_handler.hxx"
 #include "core/service_type.hxx"
@@ -61,9 +64,11 @@
 #include <spdlog/fmt/bundled/core.h>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 
 #include <iterator>
 #include <map>
@@ -94,10 +99,12 @@ public:
               std::vector<protocol::hello_feature> known_features,
               std::shared_ptr<impl::bootstrap_state_listener> state_listener,
               asio::io_context& ctx,
-              tls_context_provider& tls)
+              tls_context_provider& tls,
+              std::shared_ptr<io::io_context_pool> io_pool)
     : client_id_{ std::move(client_id) }
     , name_{ std::move(name) }
     , log_prefix_{ fmt::format("[{}/{}]", client_id_, name_) }
+    , name_label_{ name_ }
     , tracer_{ std::move(tracer) }
     , meter_{ std::move(meter) }
     , orphan_reporter_{ std::move(orphan_reporter) }
@@ -108,11 +115,15 @@ public:
     , codec_{ { known_features_.begin(), known_features_.end() } }
     , ctx_{ ctx }
     , tls_{ tls }
+    , io_pool_{ std::move(io_pool) }
     , heartbeat_timer_(ctx_)
     , heartbeat_interval_{ origin_.options().config_poll_floor >
                                origin_.options().config_poll_interval
                              ? origin_.options().config_poll_floor
                              : origin_.options().config_poll_interval }
+    , compression_policy_{ origin_.options().compression_min_size,
+                           origin_.options().compression_min_ratio }
+    , compression_adaptive_{ origin_.options().compression_adaptive }
   {
   }
 
@@ -128,7 +139,7 @@ public:
       tracing::service::key_value,
       fmt::format("{}", req->command_),
       metrics::standardized_error_type(ec),
-      name_,
+      name_label_,
       req->scope_name_,
       req->collection_name_,
     };
@@ -367,6 +378,9 @@ public:
     if (!action.need_to_retry()) {
       return false;
     }
+    if (meter_) {
+      meter_->record_retry(tracing::service::key_value, reason);
+    }
 
     // Park the request where close() can reach it. The timer below is the only
     // thing that would re-dispatch it, and asio abandons a pending wait when the
@@ -402,11 +416,11 @@ public:
   {
     if (req->key_.empty()) {
       if (auto server = server_by_vbucket(req->vbucket_, req->replica_index_); server) {
-        return find_or_connect_session_by_index(server.value());
+        return find_or_connect_session_by_index(server.value(), req->vbucket_);
       }
     } else if (auto [partition, server] = map_id(req->key_, req->replica_index_); server) {
       req->vbucket_ = partition;
-      return find_or_connect_session_by_index(server.value());
+      return find_or_connect_session_by_index(server.value(), partition);
     }
     return std::nullopt;
   }
@@ -450,6 +464,57 @@ public:
     return { 0, std::nullopt };
   }
 
+  // The first session to a data node runs on the io_context the node is pinned to in io_pool_, and
+  // each extra session (@p connection > 0) on the next one, so that a node with several connections
+  // is served by several IO threads.
+  auto create_node_session(const std::string& node_uuid,
+                           const std::string& hostname,
+                           std::uint16_t port,
+                           std::size_t connection = 0) -> io::mcbp_session
+  {
+    const couchbase::core::origin origin(origin_.credentials(), hostname, port, origin_.options());
+    auto& ctx = io_pool_ ? io_pool_->context_for(hostname, port, connection) : ctx_;
+    return origin_.options().enable_tls
+             ? io::mcbp_session(
+                 client_id_, node_uuid, ctx, tls_, origin, state_listener_, name_, known_features_)
+             : io::mcbp_session(
+                 client_id_, node_uuid, ctx, origin, state_listener_, name_, known_features_);
+  }
+
+  // Opens connections to the endpoint until @p pool together with the session in sessions_ holds
+  // kv_connections_per_node of them. Must be called with sessions_mutex_ held.
+  void top_up_extra_sessions(std::vector<io::mcbp_session>& pool,
+                             const std::string& node_uuid,
+                             const std::string& hostname,
+                             std::uint16_t port)
+  {
+    const auto wanted = origin_.options().kv_connections_per_node;
+    while (pool.size() + 1 < wanted) {
+      io::mcbp_session session = create_node_session(node_uuid, hostname, port, pool.size() + 1);
+      CB_LOG_DEBUG(R"({} add extra session="{}", address="{}:{}", connection={}/{})",
+                   log_prefix_,
+                   session.id(),
+                   hostname,
+                   port,
+                   pool.size() + 2,
+                   wanted);
+      session.bootstrap(
+        [self = shared_from_this(), session](std::error_code err,
+                                             topology::configuration cfg) mutable -> void {
+          if (err) {
+            return self->remove_session(session.id());
+          }
+          self->update_config(std::move(cfg));
+          session.on_configuration_update(self);
+          session.on_stop([id = session.id(), self]() -> void {
+            self->remove_session(id);
+          });
+        },
+        true);
+      pool.push_back(std::move(session));
+    }
+  }
+
   void connect_session(std::size_t index)
   {
     const std::scoped_lock lock(config_mutex_, sessions_mutex_);
@@ -473,13 +538,7 @@ public:
       return;
     }
 
-    const couchbase::core::origin origin(origin_.credentials(), hostname, port, origin_.options());
-    io::mcbp_session session =
-      origin_.options().enable_tls
-        ? io::mcbp_session(
-            client_id_, node.node_uuid, ctx_, tls_, origin, state_listener_, name_, known_features_)
-        : io::mcbp_session(
-            client_id_, node.node_uuid, ctx_, origin, state_listener_, name_, known_features_);
+    io::mcbp_session session = create_node_session(node.node_uuid, hostname, port);
     CB_LOG_DEBUG(R"({} rev={}, connect idx={}, session="{}", address="{}:{}")",
                  log_prefix_,
                  config_->rev_str(),
@@ -502,6 +561,7 @@ public:
       },
       true);
     sessions_.insert_or_assign(index, std::move(session));
+    top_up_extra_sessions(extra_sessions_[{ hostname, port }], node.node_uuid, hostname, port);
   }
 
   void restart_sessions()
@@ -568,23 +628,11 @@ public:
             std::swap(current->second, ptr->second);
           }
         }
+        top_up_extra_sessions(extra_sessions_[{ hostname, port }], node.node_uuid, hostname, port);
         ++kv_node_index;
         continue;
       }
-      const couchbase::core::origin origin(
-        origin_.credentials(), hostname, port, origin_.options());
-      io::mcbp_session session =
-        origin_.options().enable_tls
-          ? io::mcbp_session(client_id_,
-                             node.node_uuid,
-                             ctx_,
-                             tls_,
-                             origin,
-                             state_listener_,
-                             name_,
-                             known_features_)
-          : io::mcbp_session(
-              client_id_, node.node_uuid, ctx_, origin, state_listener_, name_, known_features_);
+      io::mcbp_session session = create_node_session(node.node_uuid, hostname, port);
       CB_LOG_DEBUG(R"({} rev={}, restart idx={}, session="{}", address="{}:{}")",
                    log_prefix_,
                    config_->rev_str(),
@@ -607,6 +655,7 @@ public:
         },
         true);
       sessions_.insert_or_assign(index, std::move(session));
+      top_up_extra_sessions(extra_sessions_[{ hostname, port }], node.node_uuid, hostname, port);
       ++kv_node_index;
     }
   }
@@ -629,6 +678,23 @@ public:
         ptr = std::next(ptr);
       }
     }
+    for (auto& [address, pool] : extra_sessions_) {
+      for (auto ptr = pool.cbegin(); ptr != pool.cend();) {
+        if (ptr->id() == id) {
+          CB_LOG_DEBUG(
+            R"({} removed extra session id="{}", address="{}", bootstrap_address="{}:{}")",
+            log_prefix_,
+            ptr->id(),
+            ptr->remote_address(),
+            ptr->bootstrap_hostname(),
+            ptr->bootstrap_port());
+          ptr = pool.erase(ptr);
+          found = true;
+        } else {
+          ptr = std::next(ptr);
+        }
+      }
+    }
 
     if (found) {
       asio::post(asio::bind_executor(ctx_, [self = shared_from_this()]() {
@@ -871,15 +937,22 @@ public:
     }
 
     std::map<size_t, io::mcbp_session> old_sessions;
+    std::map<kv_endpoint, std::vector<io::mcbp_session>> old_extra_sessions;
     std::optional<io::mcbp_session> bootstrapping_session;
     {
       const std::scoped_lock lock(sessions_mutex_);
       std::swap(old_sessions, sessions_);
+      std::swap(old_extra_sessions, extra_sessions_);
       std::swap(bootstrapping_session, bootstrapping_session_);
     }
     for (auto& [index, session] : old_sessions) {
       session.stop(retry_reason::do_not_retry);
     }
+    for (auto& [address, pool] : old_extra_sessions) {
+      for (auto& session : pool) {
+        session.stop(retry_reason::do_not_retry);
+      }
+    }
     // Stop the session that is still bootstrapping (if any): this completes its bootstrap with an
     // error, releasing the continuation that would otherwise strand the session and this bucket.
     if (bootstrapping_session) {
@@ -967,6 +1040,12 @@ public:
         return;
       }
 
+      if (config_ && config.collections_manifest_uid &&
+          config_->collections_manifest_uid != config.collections_manifest_uid) {
+        CB_LOG_DEBUG("{} collections manifest changed, invalidate cached collection IDs",
+                     log_prefix_);
+        collection_ids_.invalidate();
+      }
       if (config_) {
         diff_nodes(config_->nodes, config.nodes, added);
         diff_nodes(config.nodes, config_->nodes, removed);
@@ -1009,6 +1088,9 @@ public:
         return;
       }
       std::map<size_t, io::mcbp_session> new_sessions{};
+      // The extra connections follow their endpoint through the new configuration as a whole: kept
+      // when the endpoint stays, whatever its new index, and dropped together when it goes away.
+      std::map<kv_endpoint, std::vector<io::mcbp_session>> new_extra_sessions{};
 
       std::size_t next_index{ 0 };
       for (const auto& node : config.nodes) {
@@ -1019,6 +1101,11 @@ public:
           continue;
         }
 
+        if (auto extra = extra_sessions_.find({ hostname, port }); extra != extra_sessions_.end()) {
+          new_extra_sessions.insert_or_assign(extra->first, std::move(extra->second));
+          extra_sessions_.erase(extra);
+        }
+
         bool reused_session{ false };
         for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
           if (it->second.bootstrap_hostname() == hostname &&
@@ -1039,6 +1126,8 @@ public:
           }
         }
         if (reused_session) {
+          top_up_extra_sessions(
+            new_extra_sessions[{ hostname, port }], node.node_uuid, hostname, port);
           continue;
         }
 
@@ -1046,20 +1135,7 @@ public:
           ++next_index;
           continue;
         }
-        const couchbase::core::origin origin(
-          origin_.credentials(), hostname, port, origin_.options());
-        io::mcbp_session session =
-          origin_.options().enable_tls
-            ? io::mcbp_session(client_id_,
-                               node.node_uuid,
-                               ctx_,
-                               tls_,
-                               origin,
-                               state_listener_,
-                               name_,
-                               known_features_)
-            : io::mcbp_session(
-                client_id_, node.node_uuid, ctx_, origin, state_listener_, name_, known_features_);
+        io::mcbp_session session = create_node_session(node.node_uuid, hostname, port);
         CB_LOG_DEBUG(R"({} rev={}, add session="{}", address="{}:{}", index={})",
                      log_prefix_,
                      config.rev_str(),
@@ -1090,9 +1166,12 @@ public:
           },
           true);
         new_sessions.insert_or_assign(next_index, std::move(session));
+        top_up_extra_sessions(
+          new_extra_sessions[{ hostname, port }], node.node_uuid, hostname, port);
         ++next_index;
       }
       std::swap(sessions_, new_sessions);
+      std::swap(extra_sessions_, new_extra_sessions);
 
       for (auto it = new_sessions.begin(); it != new_sessions.end(); ++it) {
         CB_LOG_DEBUG(R"({} rev={}, drop session="{}", address="{}:{}", index={})",
@@ -1104,6 +1183,17 @@ public:
                      it->first);
         dropped_sessions.push_back(std::move(it->second));
       }
+      for (auto& [address, pool] : new_extra_sessions) {
+        for (auto& session : pool) {
+          CB_LOG_DEBUG(R"({} rev={}, drop extra session="{}", address="{}:{}")",
+                       log_prefix_,
+                       config.rev_str(),
+                       session.id(),
+                       session.bootstrap_hostname(),
+                       session.bootstrap_port());
+          dropped_sessions.push_back(std::move(session));
+        }
+      }
     }
     // Stop dropped sessions synchronously, after releasing sessions_mutex_ (stop() fires on_stop ->
     // remove_session(), which re-acquires the mutex). Stopping synchronously -- rather than via
@@ -1126,10 +1216,35 @@ public:
     return {};
   }
 
-  [[nodiscard]] auto find_or_connect_session_by_index(std::size_t index)
+  // Picks one of the connections to the node at @p index by the vbucket of the operation. All
+  // operations on a vbucket therefore share a connection and keep the order they would have on a
+  // single one. A connection that is not ready yet is skipped in favour of the session in
+  // sessions_, which is also the only candidate when kv_connections_per_node is one.
+  [[nodiscard]] auto find_session_by_index(std::size_t index, std::uint16_t vbucket) const
+    -> std::optional<io::mcbp_session>
+  {
+    const std::scoped_lock lock(sessions_mutex_);
+    auto ptr = sessions_.find(index);
+    if (ptr == sessions_.end()) {
+      return {};
+    }
+    if (auto extra = extra_sessions_.find(
+          { ptr->second.bootstrap_hostname(), ptr->second.bootstrap_port_number() });
+        extra != extra_sessions_.end() && !extra->second.empty()) {
+      if (auto slot = vbucket % (extra->second.size() + 1); slot > 0) {
+        if (const auto& candidate = extra->second[slot - 1];
+            candidate.has_config() && !candidate.is_stopped()) {
+          return candidate;
+        }
+      }
+    }
+    return ptr->second;
+  }
+
+  [[nodiscard]] auto find_or_connect_session_by_index(std::size_t index, std::uint16_t vbucket)
     -> std::optional<io::mcbp_session>
   {
-    if (auto session = find_session_by_index(index); session) {
+    if (auto session = find_session_by_index(index, vbucket); session) {
       return session;
     }
     connect_session(index);
@@ -1152,11 +1267,37 @@ public:
     return origin_.options().default_timeout_for(service_type::key_value);
   }
 
+  [[nodiscard]] auto compression_policy(const document_id& id) -> protocol::compression_policy
+  {
+    auto policy = compression_policy_;
+    if (compression_adaptive_) {
+      // collections sharing a sampler only blend their statistics, which is good enough here
+      const auto hash = std::hash<std::string>{}(id.collection_path());
+      policy.sampler = &compression_samplers_[hash % compression_samplers_.size()];
+    }
+    return policy;
+  }
+
+  [[nodiscard]] auto collection_uid(const document_id& id) const -> std::optional<std::uint32_t>
+  {
+    return collection_ids_.find(id);
+  }
+
+  void update_collection_uid(const document_id& id, std::uint32_t uid)
+  {
+    collection_ids_.update(id, uid);
+  }
+
   [[nodiscard]] auto name() const -> const std::string&
   {
     return name_;
   }
 
+  [[nodiscard]] auto name_label() const -> const metrics::metric_label&
+  {
+    return name_label_;
+  }
+
   [[nodiscard]] auto log_prefix() const -> const std::string&
   {
     return client_id_;
@@ -1192,27 +1333,38 @@ public:
     return app_telemetry_meter_;
   }
 
-  void export_diag_info(diag::diagnostics_result& res) const
+  [[nodiscard]] auto all_sessions() const -> std::vector<io::mcbp_session>
   {
-    std::map<size_t, io::mcbp_session> sessions;
-    {
-      const std::scoped_lock lock(sessions_mutex_);
-      sessions = sessions_;
+    std::vector<io::mcbp_session> sessions;
+    const std::scoped_lock lock(sessions_mutex_);
+    sessions.reserve(sessions_.size() * origin_.options().kv_connections_per_node);
+    for (const auto& [index, session] : sessions_) {
+      sessions.push_back(session);
+    }
+    for (const auto& [address, pool] : extra_sessions_) {
+      sessions.insert(sessions.end(), pool.begin(), pool.end());
     }
-    for (const auto& [index, session] : sessions) {
+    return sessions;
+  }
+
+  void export_diag_info(diag::diagnostics_result& res) const
+  {
+    for (const auto& session : all_sessions()) {
       res.services[service_type::key_value].emplace_back(session.diag_info());
     }
   }
 
+  void export_connection_stats(diag::connection_stats_result& res) const
+  {
+    for (const auto& session : all_sessions()) {
+      res.services[service_type::key_value].emplace_back(session.connection_stats());
+    }
+  }
+
   void ping(const std::shared_ptr<diag::ping_collector>& collector,
             std::optional<std::chrono::milliseconds> timeout)
   {
-    std::map<size_t, io::mcbp_session> sessions;
-    {
-      const std::scoped_lock lock(sessions_mutex_);
-      sessions = sessions_;
-    }
-    for (const auto& [index, session] : sessions) {
+    for (const auto& session : all_sessions()) {
       session.ping(collector->build_reporter(), timeout);
     }
   }
@@ -1246,12 +1398,7 @@ public:
 
   void for_each_session(utils::movable_function<void(io::mcbp_session&)> handler)
   {
-    std::map<size_t, io::mcbp_session> sessions;
-    {
-      const std::scoped_lock lock(sessions_mutex_);
-      sessions = sessions_;
-    }
-    for (auto& [index, session] : sessions) {
+    for (auto& session : all_sessions()) {
       handler(session);
     }
   }
@@ -1260,6 +1407,7 @@ private:
   const std::string client_id_;
   const std::string name_;
   const std::string log_prefix_;
+  const metrics::metric_label name_label_;
   const std::shared_ptr<tracing::tracer_wrapper> tracer_;
   const std::shared_ptr<metrics::meter_wrapper> meter_;
   const std::shared_ptr<core::orphan_reporter> orphan_reporter_;
@@ -1268,14 +1416,21 @@ private:
   const std::shared_ptr<impl::bootstrap_state_listener> state_listener_;
   origin origin_;
   mcbp::codec codec_;
+  std::array<protocol::compression_sampler, 64> compression_samplers_{};
+  collection_id_table collection_ids_{};
 
   asio::io_context& ctx_;
   tls_context_provider& tls_;
+  std::shared_ptr<io::io_context_pool> io_pool_;
 
   asio::steady_timer heartbeat_timer_;
   std::chrono::milliseconds heartbeat_interval_;
   std::atomic_size_t heartbeat_next_index_{ 0 };
 
+  // the options are fixed for the life of the bucket, only the sampler depends on the collection
+  const protocol::compression_policy compression_policy_;
+  const bool compression_adaptive_;
+
   std::atomic_bool closed_{ false };
   std::atomic_bool configured_{ false };
 
@@ -1292,6 +1447,11 @@ private:
   mcbp::operation_queue retry_backoff_queue_{};
 
   std::map<size_t, io::mcbp_session> sessions_{};
+  // Connections to a KV endpoint beyond the first one, when kv_connections_per_node is greater than
+  // one. Keyed by the endpoint rather than by the node index, which a rebalance may change; the
+  // first connection of every endpoint is the one in sessions_. Guarded by sessions_mutex_.
+  using kv_endpoint = std::pair<std::string, std::uint16_t>;
+  std::map<kv_endpoint, std::vector<io::mcbp_session>> extra_sessions_{};
   // The very first session is only moved into sessions_ once it finishes bootstrapping; until then
   // it lives solely inside its own bootstrap continuation (which captures a copy of the session and
   // this bucket). If the cluster is closed while that bootstrap is in flight (e.g. a bucket that
@@ -1313,7 +1473,8 @@ bucket::bucket(std::string client_id,
                std::string name,
                couchbase::core::origin origin,
                std::vector<protocol::hello_feature> known_features,
-               std::shared_ptr<impl::bootstrap_state_listener> state_listener)
+               std::shared_ptr<impl::bootstrap_state_listener> state_listener,
+               std::shared_ptr<io::io_context_pool> io_pool)
 
   : ctx_(ctx)
   , impl_{ std::make_shared<bucket_impl>(std::move(client_id),
@@ -1326,7 +1487,8 @@ bucket::bucket(std::string client_id,
                                          std::move(known_features),
                                          std::move(state_listener),
                                          ctx,
-                                         tls) }
+                                         tls,
+                                         std::move(io_pool)) }
 {
 }
 
@@ -1341,6 +1503,12 @@ bucket::export_diag_info(diag::diagnostics_result& res) const
   return impl_->export_diag_info(res);
 }
 
+void
+bucket::export_connection_stats(diag::connection_stats_result& res) const
+{
+  return impl_->export_connection_stats(res);
+}
+
 void
 bucket::ping(const std::shared_ptr<diag::ping_collector>& collector,
              std::optional<std::chrono::milliseconds> timeout)
@@ -1372,6 +1540,12 @@ bucket::name() const -> const std::string&
   return impl_->name();
 }
 
+auto
+bucket::name_label() const -> const metrics::metric_label&
+{
+  return impl_->name_label();
+}
+
 void
 bucket::close()
 {
@@ -1464,12 +1638,37 @@ bucket::default_timeout() const -> std::chrono::milliseconds
   return impl_->default_timeout();
 }
 
+auto
+bucket::compression_policy(const document_id& id) const -> protocol::compression_policy
+{
+  return impl_->compression_policy(id);
+}
+
+auto
+bucket::collection_uid(const document_id& id) const -> std::optional<std::uint32_t>
+{
+  return impl_->collection_uid(id);
+}
+
+void
+bucket::update_collection_uid(const document_id& id, std::uint32_t uid)
+{
+  return impl_->update_collection_uid(id, uid);
+}
+
 auto
 bucket::find_session_by_index(std::size_t index) const -> std::optional<io::mcbp_session>
 {
   return impl_->find_session_by_index(index);
 }
 
+auto
+bucket::find_session_by_index(std::size_t index, std::uint16_t partition) const
+  -> std::optional<io::mcbp_session>
+{
+  return impl_->find_session_by_index(index, partition);
+}
+
 auto
 bucket::next_session_index() -> std::size_t
 {
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "config_listener.hxx"
+#include "core/metrics/metric_label.hxx"
 #include "io/mcbp_command.hxx"
 #include "operations.hxx"
 #include "tls_context_provider.hxx"
@@ -56,6 +57,10 @@ namespace impl
 {
 class bootstrap_state_listener;
 } // namespace impl
+namespace io
+{
+class io_context_pool;
+} // namespace io
 
 class app_telemetry_meter;
 
@@ -78,7 +83,8 @@ public:
          std::string name,
          couchbase::core::origin origin,
          std::vector<protocol::hello_feature> known_features,
-         std::shared_ptr<impl::bootstrap_state_listener> state_listener);
+         std::shared_ptr<impl::bootstrap_state_listener> state_listener,
+         std::shared_ptr<io::io_context_pool> io_pool = {});
   ~bucket() override;
 
   template<typename Request, typename Handler>
@@ -158,7 +164,7 @@ public:
       cmd->request.partition = partition;
       index = server.value();
     }
-    auto session = find_session_by_index(index);
+    auto session = find_session_by_index(index, cmd->request.partition);
     if (!session || !session->has_config()) {
       CB_LOG_TRACE(
         R"([{}] defer operation id="{}", key="{}", partition={}, index={}, session={}, address="{}", has_config={}, rev={})",
@@ -236,12 +242,15 @@ public:
   void on_configuration_update(std::shared_ptr<config_listener> handler);
   void close();
   void export_diag_info(diag::diagnostics_result& res) const;
+  void export_connection_stats(diag::connection_stats_result& res) const;
   void ping(const std::shared_ptr<diag::ping_collector>& collector,
             std::optional<std::chrono::milliseconds> timeout);
   void defer_command(utils::movable_function<void(std::error_code)> command);
   void for_each_session(utils::movable_function<void(io::mcbp_session&)> handler);
 
   [[nodiscard]] auto name() const -> const std::string&;
+  // the name, interned as the bucket attribute of the operation metrics
+  [[nodiscard]] auto name_label() const -> const metrics::metric_label&;
   [[nodiscard]] auto log_prefix() const -> const std::string&;
   [[nodiscard]] auto tracer() const -> std::shared_ptr<tracing::tracer_wrapper>;
   [[nodiscard]] auto meter() const -> std::shared_ptr<metrics::meter_wrapper>;
@@ -250,6 +259,17 @@ public:
   [[nodiscard]] auto default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strategy>;
   [[nodiscard]] auto is_closed() const -> bool;
   [[nodiscard]] auto is_configured() const -> bool;
+  /**
+   * When values written to the collection of @p id are compressed, for connections that negotiated
+   * snappy.
+   */
+  [[nodiscard]] auto compression_policy(const document_id& id) const
+    -> protocol::compression_policy;
+  /**
+   * The cached collection ID for @p id, shared by all sessions of the bucket.
+   */
+  [[nodiscard]] auto collection_uid(const document_id& id) const -> std::optional<std::uint32_t>;
+  void update_collection_uid(const document_id& id, std::uint32_t uid);
 
   [[nodiscard]] auto unit_test_api() -> bucket_unit_test_api;
 
@@ -262,6 +282,8 @@ private:
   [[nodiscard]] auto next_session_index() -> std::size_t;
   [[nodiscard]] auto find_session_by_index(std::size_t index) const
     -> std::optional<io::mcbp_session>;
+  [[nodiscard]] auto find_session_by_index(std::size_t index, std::uint16_t partition) const
+    -> std::optional<io::mcbp_session>;
   [[nodiscard]] auto map_id(const document_id& id)
     -> std::pair<std::uint16_t, std::optional<std::size_t>>;
   [[nodiscard]] auto config_rev() const -> std::string;
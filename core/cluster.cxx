@@ -41,11 +41,13 @@
 #include "core/diagnostics.hxx"
 #include "core/error.hxx"
 #include "core/impl/get_replica.hxx"
+#include "core/impl/hedged_read.hxx"
 #include "core/impl/lookup_in_replica.hxx"
 #include "core/impl/observe_seqno.hxx"
 #include "core/io/http_command.hxx"
 #include "core/io/http_message.hxx"
 #include "core/io/http_session_manager.hxx"
+#include "core/io/io_context_pool.hxx"
 #include "core/io/mcbp_session.hxx"
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
 #include "core/io/config_tracker.hxx"
@@ -60,9 +62,11 @@
 #include "core/management/analytics_link_s3_external.hxx"
 #include "core/mcbp/queue_request.hxx"
 #include "core/meta/version.hxx"
+#include "core/metrics/connection_stats_openmetrics.hxx"
 #include "core/metrics/logging_meter.hxx"
 #include "core/metrics/meter_wrapper.hxx"
 #include "core/metrics/noop_meter.hxx"
+#include "core/metrics/openmetrics_writer.hxx"
 #include "core/operations/document_analytics.hxx"
 #include "core/operations/document_append.hxx"
 #include "core/operations/document_decrement.hxx"
@@ -373,19 +377,25 @@ class cluster_impl : public std::enable_shared_from_this<cluster_impl>
 {
 public:
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
-  explicit cluster_impl(asio::io_context& ctx)
+  explicit cluster_impl(asio::io_context& ctx,
+                        std::vector<std::reference_wrapper<asio::io_context>> session_contexts = {})
     : ctx_(ctx)
     , work_(asio::make_work_guard(ctx_))
+    , io_pool_(std::make_shared<io::io_context_pool>(ctx_, std::move(session_contexts)))
     , session_manager_(std::make_shared<io::http_session_manager>(id_, ctx_, tls_, origin_))
     , retry_backoff_(ctx_)
   {
+    session_manager_->set_io_context_pool(io_pool_);
   }
 #else
-  explicit cluster_impl(asio::io_context& ctx)
+  explicit cluster_impl(asio::io_context& ctx,
+                        std::vector<std::reference_wrapper<asio::io_context>> session_contexts = {})
     : ctx_(ctx)
     , work_(asio::make_work_guard(ctx_))
+    , io_pool_(std::make_shared<io::io_context_pool>(ctx_, std::move(session_contexts)))
     , session_manager_(std::make_shared<io::http_session_manager>(id_, ctx_, tls_, origin_))
   {
+    session_manager_->set_io_context_pool(io_pool_);
   }
 #endif
 
@@ -681,7 +691,8 @@ public:
                                      bucket_name,
                                      origin,
                                      known_features,
-                                     dns_srv_tracker_);
+                                     dns_srv_tracker_,
+                                     io_pool_);
         buckets_.try_emplace(bucket_name, b);
 
         // Register the tracer & the meter for config updates to track Cluster name & UUID
@@ -1723,6 +1734,25 @@ public:
       }));
   }
 
+  void connection_stats(utils::movable_function<void(diag::connection_stats_result)>&& handler)
+  {
+    if (stopped_ || is_protostellar()) {
+      return handler({});
+    }
+    asio::post(asio::bind_executor(
+      ctx_, [self = shared_from_this(), handler = std::move(handler)]() mutable {
+        diag::connection_stats_result res{};
+        if (self->session_) {
+          res.services[service_type::key_value].emplace_back(self->session_->connection_stats());
+        }
+        self->for_each_bucket([&res](const auto& bucket) {
+          bucket->export_connection_stats(res);
+        });
+        self->session_manager_->export_connection_stats(res);
+        handler(std::move(res));
+      }));
+  }
+
   // IMPORTANT — do not std::move observability members out of *self* below.
   //
   // The public-API cluster::notify_fork(fork_event::child) in
@@ -1878,6 +1908,11 @@ public:
     return meter_;
   }
 
+  auto read_latencies() const -> const std::shared_ptr<impl::read_latency_tracker>&
+  {
+    return read_latencies_;
+  }
+
   auto cluster_label_listener() -> const std::shared_ptr<cluster_label_listener>&
   {
     return cluster_label_listener_;
@@ -1941,6 +1976,7 @@ private:
   std::string id_{ uuid::to_string(uuid::random()) };
   asio::io_context& ctx_;
   asio::executor_work_guard<asio::io_context::executor_type> work_;
+  std::shared_ptr<io::io_context_pool> io_pool_;
   tls_context_provider tls_{};
   std::shared_ptr<io::http_session_manager> session_manager_;
   std::shared_ptr<app_telemetry_reporter> app_telemetry_reporter_{};
@@ -1963,6 +1999,9 @@ private:
   std::shared_ptr<tracing::tracer_wrapper> tracer_{ nullptr };
   std::shared_ptr<metrics::meter_wrapper> meter_{ nullptr };
   std::shared_ptr<orphan_reporter> orphan_reporter_{ nullptr };
+  std::shared_ptr<impl::read_latency_tracker> read_latencies_{
+    std::make_shared<impl::read_latency_tracker>()
+  };
   std::atomic_bool stopped_{ false };
   std::shared_ptr<core::app_telemetry_meter> app_telemetry_meter_{
     std::make_shared<core::app_telemetry_meter>()
@@ -1980,6 +2019,12 @@ cluster::cluster(asio::io_context& ctx)
 {
 }
 
+cluster::cluster(asio::io_context& ctx,
+                 std::vector<std::reference_wrapper<asio::io_context>> session_contexts)
+  : impl_{ std::make_shared<cluster_impl>(ctx, std::move(session_contexts)) }
+{
+}
+
 cluster::cluster(std::shared_ptr<cluster_impl> impl)
   : impl_{ std::move(impl) }
 {
@@ -2056,6 +2101,15 @@ cluster::diagnostics(std::optional<std::string> report_id,
   }
 }
 
+void
+cluster::connection_stats(
+  utils::movable_function<void(diag::connection_stats_result)>&& handler) const
+{
+  if (impl_) {
+    impl_->connection_stats(std::move(handler));
+  }
+}
+
 void
 cluster::ping(std::optional<std::string> report_id,
               std::optional<std::string> bucket_name,
@@ -3246,6 +3300,29 @@ cluster::meter() const -> std::shared_ptr<metrics::meter_wrapper>
   return impl_->meter();
 }
 
+auto
+cluster::read_latencies() const -> std::shared_ptr<impl::read_latency_tracker>
+{
+  return impl_->read_latencies();
+}
+
+void
+cluster::openmetrics(utils::movable_function<void(std::string)>&& handler) const
+{
+  connection_stats([impl = impl_, handler = std::move(handler)](
+                     diag::connection_stats_result stats) mutable {
+    metrics::openmetrics_writer writer{};
+    if (auto meter = impl->meter(); meter) {
+      if (auto logging = std::dynamic_pointer_cast<metrics::logging_meter>(meter->wrapped());
+          logging) {
+        logging->write_openmetrics(writer);
+      }
+    }
+    metrics::write_connection_stats(writer, stats);
+    handler(std::move(writer).finish());
+  });
+}
+
 auto
 cluster::cluster_label_listener() const -> const std::shared_ptr<core::cluster_label_listener>&
 {
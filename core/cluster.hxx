@@ -29,8 +29,11 @@
 
 #include <asio/io_context.hpp>
 #include <chrono>
+#include <functional>
 #include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -66,6 +69,11 @@ namespace io
 class http_session_manager;
 } // namespace io
 
+namespace impl
+{
+class read_latency_tracker;
+} // namespace impl
+
 namespace o = operations;
 namespace om = operations::management;
 template<typename T>
@@ -75,6 +83,15 @@ class cluster
 {
 public:
   explicit cluster(asio::io_context& ctx);
+
+  /**
+   * Creates a cluster whose KV and HTTP sessions are spread over @p session_contexts in addition
+   * to @p ctx, each endpoint pinned to one of them. Timers, configuration handling and bootstrap
+   * stay on @p ctx. The caller owns all contexts and has to keep every one of them running until
+   * close() completes.
+   */
+  cluster(asio::io_context& ctx,
+          std::vector<std::reference_wrapper<asio::io_context>> session_contexts);
   explicit cluster(std::shared_ptr<cluster_impl> impl);
 
   [[nodiscard]] auto io_context() const -> asio::io_context&;
@@ -343,6 +360,12 @@ public:
   void diagnostics(std::optional<std::string> report_id,
                    mf<void(diag::diagnostics_result)>&& handler) const;
 
+  /**
+   * Snapshot of the live counters of every KV and HTTP connection. It only reads atomics (and
+   * takes a couple of short per-session locks), so it is cheap enough to be polled every second.
+   */
+  void connection_stats(mf<void(diag::connection_stats_result)>&& handler) const;
+
   void ping(std::optional<std::string> report_id,
             std::optional<std::string> bucket_name,
             std::set<service_type> services,
@@ -364,6 +387,16 @@ public:
 
   [[nodiscard]] auto tracer() const -> std::shared_ptr<tracing::tracer_wrapper>;
   [[nodiscard]] auto meter() const -> std::shared_ptr<metrics::meter_wrapper>;
+  /**
+   * Recent KV read latencies per node, from which hedged reads derive their delays.
+   */
+  [[nodiscard]] auto read_latencies() const -> std::shared_ptr<impl::read_latency_tracker>;
+  /**
+   * Renders the built-in logging meter and the connection statistics in the OpenMetrics text
+   * format, ready to be served as a Prometheus scrape. Scraping does not reset the meter. The meter
+   * part is left out when the cluster uses a custom meter.
+   */
+  void openmetrics(mf<void(std::string)>&& handler) const;
   [[nodiscard]] auto cluster_label_listener() const
     -> const std::shared_ptr<cluster_label_listener>&;
   [[nodiscard]] auto find_bucket_by_name(const std::string& name) const -> std::shared_ptr<bucket>;
@@ -32,9 +32,11 @@ public:
     const std::scoped_lock lock(mutex_);
     if (config.cluster_name.has_value() && (cluster_name_ != config.cluster_name)) {
       cluster_name_ = std::move(config.cluster_name);
+      metric_cluster_name_ = metrics::metric_label{ cluster_name_.value() };
     }
     if (config.cluster_uuid.has_value() && (cluster_uuid_ != config.cluster_uuid)) {
       cluster_uuid_ = std::move(config.cluster_uuid);
+      metric_cluster_uuid_ = metrics::metric_label{ cluster_uuid_.value() };
     }
   }
 
@@ -47,10 +49,21 @@ public:
     };
   }
 
+  auto cluster_metric_labels() -> cluster_label_listener::metric_labels
+  {
+    const std::shared_lock lock(mutex_);
+    return cluster_label_listener::metric_labels{
+      metric_cluster_name_,
+      metric_cluster_uuid_,
+    };
+  }
+
 private:
   std::shared_mutex mutex_{};
   std::optional<std::string> cluster_name_{};
   std::optional<std::string> cluster_uuid_{};
+  std::optional<metrics::metric_label> metric_cluster_name_{};
+  std::optional<metrics::metric_label> metric_cluster_uuid_{};
 };
 
 cluster_label_listener::cluster_label_listener()
@@ -69,4 +82,10 @@ cluster_label_listener::cluster_labels() const -> labels
 {
   return impl_->cluster_labels();
 }
+
+auto
+cluster_label_listener::cluster_metric_labels() const -> metric_labels
+{
+  return impl_->cluster_metric_labels();
+}
 } // namespace couchbase::core
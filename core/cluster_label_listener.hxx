@@ -18,6 +18,7 @@
 #pragma once
 
 #include "config_listener.hxx"
+#include "core/metrics/metric_label.hxx"
 
 #include <memory>
 #include <optional>
@@ -40,6 +41,15 @@ public:
 
   [[nodiscard]] auto cluster_labels() const -> labels;
 
+  struct metric_labels {
+    std::optional<metrics::metric_label> cluster_name;
+    std::optional<metrics::metric_label> cluster_uuid;
+  };
+
+  // The same labels, interned when the configuration changes, so that recording a metric copies
+  // no strings.
+  [[nodiscard]] auto cluster_metric_labels() const -> metric_labels;
+
 private:
   std::shared_ptr<cluster_label_listener_impl> impl_;
 };
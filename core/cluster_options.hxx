@@ -19,7 +19,9 @@
 
 #include "core/columnar/security_options.hxx"
 #include "core/io/dns_config.hxx"
+#include "core/io/http_node_selection.hxx"
 #include "core/io/ip_protocol.hxx"
+#include "core/io/query_cache.hxx"
 #include "core/metrics/logging_meter_options.hxx"
 #include "core/orphan_reporter.hxx"
 #include "core/row_streamer_options.hxx"
@@ -36,6 +38,7 @@
 #include <couchbase/transactions/transactions_config.hxx>
 
 #include <chrono>
+#include <map>
 #include <string>
 
 namespace couchbase::core
@@ -76,6 +79,7 @@ public:
   bool enable_compression{ true };
   std::size_t compression_min_size{ 32 };
   double compression_min_ratio{ 0.83 };
+  bool compression_adaptive{ false };
   bool enable_tracing{ true };
   bool enable_metrics{ true };
   bool enable_orphan_reporting{ true };
@@ -95,6 +99,8 @@ public:
     timeout_defaults::config_idle_redial_timeout;
 
   std::size_t max_http_connections{ 0 };
+  // Node selection per HTTP service, round robin for the services that are not listed.
+  std::map<service_type, io::http_node_selection> http_node_selection{};
   std::chrono::milliseconds idle_http_connection_timeout =
     timeout_defaults::idle_http_connection_timeout;
   std::string user_agent_extra{};
@@ -119,6 +125,8 @@ public:
   bool preserve_bootstrap_nodes_order{ false };
   bool allow_enterprise_analytics{ false };
   bool enable_lazy_connections{ false };
+  std::size_t kv_connections_per_node{ 1 };
+  std::size_t query_cache_capacity{ query_cache::default_capacity };
 
   // Tuning for the streaming query/analytics row engine. Internal-only for now (no public API);
   // sensible static defaults apply unless a core caller overrides them. idle_timeout is derived
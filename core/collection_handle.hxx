@@ -0,0 +1,94 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace couchbase::core
+{
+/**
+ * The identity of one collection, built once per couchbase::collection and shared by every
+ * document_id created through it, so that operations neither format the "scope.collection" path
+ * nor look it up to find the collection id.
+ *
+ * The handle also remembers the collection id it was last resolved to, stamped with the generation
+ * of the collection_id_table that resolved it. The id only counts while that generation is current:
+ * when the bucket invalidates its table (for example after a manifest change) every handle becomes
+ * stale at once, without having to be visited.
+ */
+class collection_handle
+{
+public:
+  collection_handle(std::string bucket, std::string scope, std::string collection)
+    : bucket_{ std::move(bucket) }
+    , scope_{ std::move(scope) }
+    , collection_{ std::move(collection) }
+    , path_{ scope_ + "." + collection_ }
+  {
+  }
+
+  [[nodiscard]] auto bucket() const -> const std::string&
+  {
+    return bucket_;
+  }
+
+  [[nodiscard]] auto scope() const -> const std::string&
+  {
+    return scope_;
+  }
+
+  [[nodiscard]] auto collection() const -> const std::string&
+  {
+    return collection_;
+  }
+
+  [[nodiscard]] auto path() const -> const std::string&
+  {
+    return path_;
+  }
+
+  /**
+   * The collection id, if it was resolved in @p generation.
+   */
+  [[nodiscard]] auto uid(std::uint32_t generation) const -> std::optional<std::uint32_t>
+  {
+    const auto state = state_.load(std::memory_order_acquire);
+    if (static_cast<std::uint32_t>(state >> 32U) != generation) {
+      return {};
+    }
+    return static_cast<std::uint32_t>(state);
+  }
+
+  void uid(std::uint32_t generation, std::uint32_t value)
+  {
+    state_.store(static_cast<std::uint64_t>(generation) << 32U | value, std::memory_order_release);
+  }
+
+private:
+  std::string bucket_;
+  std::string scope_;
+  std::string collection_;
+  std::string path_;
+  // generation in the upper half, collection id in the lower; generation 0 is never current
+  std::atomic<std::uint64_t> state_{ 0 };
+};
+} // namespace couchbase::core
@@ -0,0 +1,102 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "collection_id_table.hxx"
+
+#include <utility>
+
+namespace couchbase::core
+{
+namespace
+{
+auto
+next_generation() -> std::uint32_t
+{
+  static std::atomic<std::uint32_t> generation{ 0 };
+  auto value = generation.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (value == 0) {
+    // generation 0 marks a handle that was never resolved, skip it on wrap around
+    value = generation.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+  return value;
+}
+} // namespace
+
+collection_id_table::collection_id_table()
+  : snapshot_{ make_snapshot(next_generation()) }
+  , generation_{ snapshot_->generation }
+{
+}
+
+auto
+collection_id_table::make_snapshot(std::uint32_t generation) -> std::shared_ptr<snapshot>
+{
+  auto result = std::make_shared<snapshot>();
+  result->generation = generation;
+  result->uids.try_emplace("_default._default", 0);
+  return result;
+}
+
+auto
+collection_id_table::find(const document_id& id) const -> std::optional<std::uint32_t>
+{
+  const auto& handle = id.handle();
+  if (handle) {
+    if (auto uid = handle->uid(generation_.load(std::memory_order_acquire)); uid) {
+      return uid;
+    }
+  }
+  const auto current = std::atomic_load(&snapshot_);
+  auto entry = current->uids.find(id.collection_path());
+  if (entry == current->uids.end()) {
+    return {};
+  }
+  if (handle) {
+    handle->uid(current->generation, entry->second);
+  }
+  return entry->second;
+}
+
+void
+collection_id_table::update(const document_id& id, std::uint32_t uid)
+{
+  const std::scoped_lock lock(update_mutex_);
+  const auto current = std::atomic_load(&snapshot_);
+  auto next = std::make_shared<snapshot>(*current);
+  next->uids.insert_or_assign(id.collection_path(), uid);
+  if (const auto& handle = id.handle(); handle) {
+    handle->uid(next->generation, uid);
+  }
+  std::atomic_store(&snapshot_, std::shared_ptr<const snapshot>{ std::move(next) });
+}
+
+void
+collection_id_table::invalidate()
+{
+  const std::scoped_lock lock(update_mutex_);
+  auto next = make_snapshot(next_generation());
+  const auto generation = next->generation;
+  std::atomic_store(&snapshot_, std::shared_ptr<const snapshot>{ std::move(next) });
+  generation_.store(generation, std::memory_order_release);
+}
+
+auto
+collection_id_table::generation() const -> std::uint32_t
+{
+  return generation_.load(std::memory_order_acquire);
+}
+} // namespace couchbase::core
@@ -0,0 +1,71 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "document_id.hxx"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace couchbase::core
+{
+/**
+ * Collection ids known to one bucket, shared by all of its KV sessions, so that a new or
+ * reconnected session does not have to resolve them again.
+ *
+ * Readers never lock: they load an immutable snapshot with std::atomic_load. Writers (a freshly
+ * resolved id, or an invalidation) copy the snapshot under a mutex and publish the copy, which is
+ * cheap because the table only changes when a collection is first used or the manifest changes.
+ *
+ * Every snapshot carries a generation that is unique across all tables of the process. Ids found
+ * for a document_id that came through a collection_handle are stamped on the handle with that
+ * generation, and later lookups take the id straight from the handle, touching nothing but two
+ * atomics, while the generation is still current. invalidate() starts a new generation, which
+ * drops every cached id of the bucket in bulk.
+ */
+class collection_id_table
+{
+public:
+  collection_id_table();
+
+  [[nodiscard]] auto find(const document_id& id) const -> std::optional<std::uint32_t>;
+  void update(const document_id& id, std::uint32_t uid);
+  void invalidate();
+
+  [[nodiscard]] auto generation() const -> std::uint32_t;
+
+private:
+  struct snapshot {
+    std::uint32_t generation;
+    std::map<std::string, std::uint32_t, std::less<>> uids;
+  };
+
+  [[nodiscard]] static auto make_snapshot(std::uint32_t generation) -> std::shared_ptr<snapshot>;
+
+  std::mutex update_mutex_{};
+  std::shared_ptr<const snapshot> snapshot_;
+  // mirrors snapshot_->generation, so that a hit on a handle does not have to load the snapshot
+  std::atomic<std::uint32_t> generation_;
+};
+} // namespace couchbase::core
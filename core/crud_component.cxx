@@ -25,7 +25,6 @@
 #include "core/protocol/datatype.hxx"
 #include "core/protocol/magic.hxx"
 #include "core/range_scan_options.hxx"
-#include "core/utils/binary.hxx"
 #include "core/utils/unsigned_leb128.hxx"
 #include "mcbp/big_endian.hxx"
 #include "mcbp/queue_request.hxx"
@@ -201,15 +200,21 @@ parse_range_scan_documents(gsl::span<std::byte> data,
       if (remaining.size() < value_length) {
         return errc::network::protocol_error;
       }
-      body.value = { remaining.begin(),
-                     remaining.begin() + static_cast<std::ptrdiff_t>(value_length) };
-      if (protocol::has_flag(body.datatype, protocol::datatype::snappy)) {
-        std::string uncompressed;
-        if (snappy::Uncompress(
-              reinterpret_cast<const char*>(body.value.data()), body.value.size(), &uncompressed)) {
-          body.value = core::utils::to_binary(uncompressed);
-          protocol::clear_flag(body.datatype, protocol::datatype::snappy);
-        }
+      const auto* value = reinterpret_cast<const char*>(remaining.data());
+      std::size_t uncompressed_size{ 0 };
+      bool inflated{ false };
+      if (protocol::has_flag(body.datatype, protocol::datatype::snappy) &&
+          snappy::GetUncompressedLength(value, value_length, &uncompressed_size)) {
+        // inflate straight into the item, which then owns a buffer of exactly the value's size
+        body.value.resize(uncompressed_size);
+        inflated =
+          snappy::RawUncompress(value, value_length, reinterpret_cast<char*>(body.value.data()));
+      }
+      if (inflated) {
+        protocol::clear_flag(body.datatype, protocol::datatype::snappy);
+      } else {
+        body.value.assign(remaining.begin(),
+                          remaining.begin() + static_cast<std::ptrdiff_t>(value_length));
       }
       data = gsl::make_span(remaining.data() + value_length, remaining.size() - value_length);
     }
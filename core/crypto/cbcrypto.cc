@@ -1069,4 +1069,15 @@ to_cipher(const std::string& str) -> couchbase::core::crypto::Cipher
 
   throw std::invalid_argument("to_cipher: Unknown cipher: " + str);
 }
+
+void
+secure_erase(std::string& data)
+{
+  // the volatile access keeps the compiler from dropping the stores as dead
+  volatile char* ptr = data.data();
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    ptr[i] = 0;
+  }
+  data.clear();
+}
 } // namespace couchbase::core::crypto
@@ -96,4 +96,11 @@ auto
 decrypt(Cipher cipher, std::string_view key, std::string_view iv, std::string_view data)
   -> std::string;
 
+/**
+ * Overwrite the contents of the string with zeros before clearing it, so that key material does
+ * not linger in freed memory.
+ */
+void
+secure_erase(std::string& data);
+
 } // namespace couchbase::core::crypto
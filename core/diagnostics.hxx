@@ -20,6 +20,8 @@
 #include "service_type.hxx"
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <string>
@@ -93,4 +95,44 @@ struct ping_result {
 
   int version{ 2 };
 };
+
+/**
+ * Live counters of a single connection. The totals count from the moment the session was created,
+ * so rates are the difference between two snapshots of the same connection id.
+ */
+struct endpoint_connection_stats {
+  service_type type{};
+  std::string id;
+  std::string remote;
+  std::string local;
+  endpoint_state state{};
+  /** serialized as "namespace" */
+  std::optional<std::string> bucket{};
+
+  std::uint64_t bytes_sent{ 0 };
+  std::uint64_t bytes_received{ 0 };
+  std::uint64_t requests_sent{ 0 };
+  std::uint64_t responses_received{ 0 };
+  /** requests that have been sent (or are waiting to be), and still wait for their response */
+  std::size_t in_flight{ 0 };
+  /** bytes handed to the session, but not to the socket yet */
+  std::size_t write_queue_bytes{ 0 };
+  /** operations scheduled for retry after they had been dispatched to this connection */
+  std::uint64_t retries{ 0 };
+
+  /**
+   * KV only: opaques that did not find a free slot, and spilled to a map, in either the handler
+   * ring or the slab of pending operations
+   */
+  std::uint64_t opaque_overflow_spills{ 0 };
+  /** KV only: bytes received, but not parsed into responses yet */
+  std::size_t parser_buffered_bytes{ 0 };
+  /** KV only: compressed values received, before and after decompression */
+  std::uint64_t compressed_bytes_received{ 0 };
+  std::uint64_t decompressed_bytes_received{ 0 };
+};
+
+struct connection_stats_result {
+  std::map<service_type, std::vector<endpoint_connection_stats>> services{};
+};
 } // namespace couchbase::core::diag
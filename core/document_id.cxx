@@ -95,10 +95,16 @@ document_id::document_id(std::string bucket,
   collection_path_ = compile_collection_path(scope_, collection_);
 }
 
+document_id::document_id(std::shared_ptr<collection_handle> handle, std::string key)
+  : key_(std::move(key))
+  , handle_(std::move(handle))
+{
+}
+
 auto
 document_id::has_default_collection() const -> bool
 {
-  return !use_collections_ || collection_path_ == "_default._default";
+  return !use_collections_ || collection_path() == "_default._default";
 }
 
 auto
@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include "collection_handle.hxx"
+
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -28,25 +31,34 @@ struct document_id {
   document_id() = default;
   document_id(std::string bucket, std::string key);
   document_id(std::string bucket, std::string scope, std::string collection, std::string key);
+  document_id(std::shared_ptr<collection_handle> handle, std::string key);
 
   [[nodiscard]] const std::string& bucket() const
   {
-    return bucket_;
+    return handle_ ? handle_->bucket() : bucket_;
   }
 
   [[nodiscard]] const std::string& scope() const
   {
-    return scope_;
+    return handle_ ? handle_->scope() : scope_;
   }
 
   [[nodiscard]] const std::string& collection() const
   {
-    return collection_;
+    return handle_ ? handle_->collection() : collection_;
   }
 
   [[nodiscard]] const std::string& collection_path() const
   {
-    return collection_path_;
+    return handle_ ? handle_->path() : collection_path_;
+  }
+
+  /**
+   * The handle of the collection this id was created through, if any.
+   */
+  [[nodiscard]] const std::shared_ptr<collection_handle>& handle() const
+  {
+    return handle_;
   }
 
   [[nodiscard]] const std::string& key() const
@@ -107,6 +119,7 @@ private:
   std::string collection_{};
   std::string key_{};
   std::string collection_path_{};
+  std::shared_ptr<collection_handle> handle_{};
   std::optional<std::uint32_t>
     collection_uid_{}; // filled with resolved UID during request lifetime
   bool use_collections_{ true };
@@ -30,7 +30,9 @@
 #include "core/agent_group.hxx"
 #include "core/agent_group_config.hxx"
 #include "core/cluster.hxx"
+#include "core/collection_handle.hxx"
 #include "core/impl/subdoc/command.hxx"
+#include "core/io/mcbp_session.hxx"
 #include "core/logger/logger.hxx"
 #include "core/metrics/meter_wrapper.hxx"
 #include "core/operations/document_append.hxx"
@@ -103,11 +105,14 @@
 #include <asio/post.hpp>
 #include <asio/steady_timer.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <future>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <string_view>
 #include <system_error>
@@ -133,6 +138,7 @@ public:
     , bucket_name_{ bucket_name }
     , scope_name_{ scope_name }
     , name_{ name }
+    , handle_{ std::make_shared<core::collection_handle>(bucket_name_, scope_name_, name_) }
     , crypto_manager_{ std::move(crypto_manager) }
   {
   }
@@ -167,14 +173,31 @@ public:
     auto obs_rec =
       create_observability_recorder(core::tracing::operation::mcbp_get, options.parent_span);
 
+    if (options.hedged && !options.with_expiry && options.projections.empty()) {
+      core::operations::get_any_replica_request request{
+        core::document_id{ handle_, std::move(document_key) },
+        options.timeout,
+        read_preference::no_preference,
+        obs_rec->operation_span(),
+        true,
+        true,
+      };
+      return core_.execute(std::move(request),
+                           [obs_rec = std::move(obs_rec),
+                            crypto_manager = crypto_manager_,
+                            handler = std::move(handler)](auto resp) mutable {
+                             obs_rec->finish(resp.ctx.ec());
+                             invoke_with_node_id(std::move(handler),
+                                                 core::impl::make_error(std::move(resp.ctx)),
+                                                 get_result{ resp.cas,
+                                                             { std::move(resp.value), resp.flags },
+                                                             {},
+                                                             std::move(crypto_manager) });
+                           });
+    }
     if (!options.with_expiry && options.projections.empty()) {
       core::operations::get_request request{
-        core::document_id{
-          bucket_name_,
-          scope_name_,
-          name_,
-          std::move(document_key),
-        },
+        core::document_id{ handle_, std::move(document_key) },
         {},
         {},
         options.timeout,
@@ -195,12 +218,7 @@ public:
                            });
     }
     core::operations::get_projected_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       {},
       {},
       options.projections,
@@ -238,12 +256,7 @@ public:
                                                  options.parent_span);
 
     core::operations::get_and_touch_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       {},
       {},
       expiry,
@@ -275,12 +288,7 @@ public:
       create_observability_recorder(core::tracing::operation::mcbp_touch, options.parent_span);
 
     core::operations::touch_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       {},
       {},
       expiry,
@@ -305,15 +313,11 @@ public:
                                                  options.parent_span);
 
     core::operations::get_any_replica_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       options.timeout,
       options.read_preference,
       obs_rec->operation_span(),
+      options.hedged,
     };
     return core_.execute(std::move(request),
                          [obs_rec = std::move(obs_rec),
@@ -339,12 +343,7 @@ public:
                                                  options.parent_span);
 
     core::operations::get_all_replicas_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       options.timeout,
       options.read_preference,
       obs_rec->operation_span(),
@@ -377,12 +376,7 @@ public:
     auto obs_rec =
       create_observability_recorder(core::tracing::operation::mcbp_remove, options.parent_span);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ handle_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::remove_request request{
         std::move(id),
@@ -466,12 +460,7 @@ public:
                                                  options.parent_span);
 
     core::operations::get_and_lock_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       {},
       {},
       static_cast<uint32_t>(lock_duration.count()),
@@ -502,12 +491,7 @@ public:
       create_observability_recorder(core::tracing::operation::mcbp_unlock, options.parent_span);
 
     core::operations::unlock_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       {},
       {},
       cas,
@@ -531,12 +515,7 @@ public:
       create_observability_recorder(core::tracing::operation::mcbp_exists, options.parent_span);
 
     core::operations::exists_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       {},
       {},
       options.timeout,
@@ -561,13 +540,39 @@ public:
     auto obs_rec =
       create_observability_recorder(core::tracing::operation::mcbp_lookup_in, options.parent_span);
 
+    if (options.hedged) {
+      core::operations::lookup_in_any_replica_request request{
+        core::document_id{ handle_, std::move(document_key) },
+        specs,
+        options.timeout,
+        obs_rec->operation_span(),
+        read_preference::no_preference,
+        options.access_deleted,
+        true,
+        true,
+      };
+      return core_.execute(
+        std::move(request),
+        [obs_rec = std::move(obs_rec), handler = std::move(handler)](auto resp) mutable {
+          obs_rec->finish(resp.ctx.ec());
+          std::vector<lookup_in_result::entry> entries{};
+          entries.reserve(resp.fields.size());
+          for (auto& entry : resp.fields) {
+            entries.emplace_back(lookup_in_result::entry{
+              std::move(entry.path),
+              std::move(entry.value),
+              entry.original_index,
+              entry.exists,
+              entry.ec,
+            });
+          }
+          invoke_with_node_id(std::move(handler),
+                              core::impl::make_error(std::move(resp.ctx)),
+                              lookup_in_result{ resp.cas, std::move(entries), resp.deleted });
+        });
+    }
     core::operations::lookup_in_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       {},
       {},
       options.access_deleted,
@@ -610,12 +615,7 @@ public:
       core::tracing::operation::mcbp_lookup_in_all_replicas, options.parent_span);
 
     core::operations::lookup_in_all_replicas_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       specs,
       options.timeout,
       obs_rec->operation_span(),
@@ -660,16 +660,13 @@ public:
       core::tracing::operation::mcbp_lookup_in_any_replica, options.parent_span);
 
     core::operations::lookup_in_any_replica_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ handle_, std::move(document_key) },
       specs,
       options.timeout,
       obs_rec->operation_span(),
       options.read_preference,
+      false,
+      options.hedged,
     };
     return core_.execute(
       std::move(request),
@@ -701,12 +698,7 @@ public:
     auto obs_rec = create_observability_recorder(
       core::tracing::operation::mcbp_mutate_in, options.parent_span, options.durability_level);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ handle_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::mutate_in_request request{
         std::move(id),
@@ -827,12 +819,7 @@ public:
       core::tracing::operation::mcbp_upsert, options.parent_span, options.durability_level);
 
     auto [data, flags] = get_encoded_value(std::move(value), obs_rec);
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ handle_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::upsert_request request{
         std::move(id),
@@ -918,12 +905,7 @@ public:
       core::tracing::operation::mcbp_insert, options.parent_span, options.durability_level);
 
     auto [data, flags] = get_encoded_value(std::move(value), obs_rec);
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ handle_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::insert_request request{
         std::move(id),
@@ -1013,12 +995,7 @@ public:
 
     auto [data, flags] = get_encoded_value(std::move(value), obs_rec);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ handle_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::replace_request request{
         std::move(id),
@@ -1311,7 +1288,155 @@ public:
       });
   }
 
+  void get_multi(std::vector<std::string> document_keys,
+                 const get_options::built& options,
+                 get_multi_handler&& handler) const
+  {
+    auto keys = std::make_shared<const std::vector<std::string>>(std::move(document_keys));
+    dispatch_multi<get_result>(
+      keys,
+      options.timeout,
+      std::move(handler),
+      [self = shared_from_this(), keys, options](std::size_t index, auto&& complete) {
+        self->get(keys->at(index), options, std::forward<decltype(complete)>(complete));
+      });
+  }
+
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    const upsert_options::built& options,
+                    upsert_multi_handler&& handler) const
+  {
+    std::vector<std::string> document_keys;
+    document_keys.reserve(documents.size());
+    for (const auto& [key, value] : documents) {
+      document_keys.emplace_back(key);
+    }
+    auto keys = std::make_shared<const std::vector<std::string>>(std::move(document_keys));
+    auto values = std::make_shared<std::vector<std::pair<std::string, codec::encoded_value>>>(
+      std::move(documents));
+    dispatch_multi<mutation_result>(
+      keys,
+      options.timeout,
+      std::move(handler),
+      [self = shared_from_this(), keys, values, options](std::size_t index, auto&& complete) {
+        // every index is dispatched exactly once, so the value can be moved into its request
+        self->upsert(keys->at(index),
+                     std::move(values->at(index).second),
+                     options,
+                     std::forward<decltype(complete)>(complete));
+      });
+  }
+
+  void remove_multi(std::vector<std::string> document_keys,
+                    const remove_options::built& options,
+                    remove_multi_handler&& handler) const
+  {
+    auto keys = std::make_shared<const std::vector<std::string>>(std::move(document_keys));
+    dispatch_multi<mutation_result>(
+      keys,
+      options.timeout,
+      std::move(handler),
+      [self = shared_from_this(), keys, options](std::size_t index, auto&& complete) {
+        self->remove(keys->at(index), options, std::forward<decltype(complete)>(complete));
+      });
+  }
+
+  void touch_multi(std::vector<std::string> document_keys,
+                   std::uint32_t expiry,
+                   const touch_options::built& options,
+                   touch_multi_handler&& handler) const
+  {
+    auto keys = std::make_shared<const std::vector<std::string>>(std::move(document_keys));
+    dispatch_multi<result>(
+      keys,
+      options.timeout,
+      std::move(handler),
+      [self = shared_from_this(), keys, expiry, options](std::size_t index, auto&& complete) {
+        self->touch(keys->at(index), expiry, options, std::forward<decltype(complete)>(complete));
+      });
+  }
+
 private:
+  /**
+   * Runs one operation per key and reports all of them to @p handler, in the order of @p keys.
+   *
+   * The keys are first sorted by the node that owns their vBucket, and the operations are
+   * dispatched under one io::mcbp_write_batch, so the requests for a node leave in a single write.
+   * Each operation keeps its own timeout and error; only a failure to get the bucket configuration
+   * is reported for every key.
+   *
+   * @param dispatch callable accepting the index of a key and the per-key completion handler
+   */
+  template<typename Result, typename Dispatch>
+  void dispatch_multi(std::shared_ptr<const std::vector<std::string>> keys,
+                      std::optional<std::chrono::milliseconds> timeout,
+                      std::function<void(std::vector<std::pair<error, Result>>)>&& handler,
+                      Dispatch&& dispatch) const
+  {
+    if (keys->empty()) {
+      return handler({});
+    }
+    auto [origin_ec, origin] = core_.origin();
+    if (origin_ec) {
+      return handler(std::vector<std::pair<error, Result>>(keys->size(),
+                                                           { error{ origin_ec }, Result{} }));
+    }
+
+    struct multi_state {
+      multi_state(std::size_t size,
+                  std::function<void(std::vector<std::pair<error, Result>>)>&& h)
+        : results(size)
+        , remaining{ size }
+        , handler{ std::move(h) }
+      {
+      }
+
+      std::vector<std::pair<error, Result>> results;
+      std::atomic_size_t remaining;
+      std::function<void(std::vector<std::pair<error, Result>>)> handler;
+    };
+    auto state = std::make_shared<multi_state>(keys->size(), std::move(handler));
+
+    core::impl::with_bucket_config_or_timeout<std::vector<std::size_t>>(
+      core_,
+      bucket_name_,
+      timeout.value_or(origin.options().key_value_timeout),
+      [state, dispatch = std::forward<Dispatch>(dispatch)](error err,
+                                                          std::vector<std::size_t> order) mutable {
+        if (err) {
+          for (auto& [result_error, result] : state->results) {
+            result_error = err;
+          }
+          return state->handler(std::move(state->results));
+        }
+        const core::io::mcbp_write_batch batch{};
+        for (const auto index : order) {
+          dispatch(index, [state, index](error result_error, Result result) {
+            state->results[index] = { std::move(result_error), std::move(result) };
+            // acq_rel, so that the last completion sees the results stored by the others
+            if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+              state->handler(std::move(state->results));
+            }
+          });
+        }
+      },
+      [keys](const std::shared_ptr<core::topology::configuration>& config) {
+        std::vector<std::size_t> order(keys->size());
+        std::iota(order.begin(), order.end(), std::size_t{ 0 });
+        if (config && config->vbmap.has_value() && !config->vbmap->empty()) {
+          std::vector<std::size_t> server_index(keys->size());
+          for (std::size_t i = 0; i < keys->size(); ++i) {
+            server_index[i] = config->map_key(keys->at(i), 0)
+                                .second.value_or(std::numeric_limits<std::size_t>::max());
+          }
+          std::stable_sort(order.begin(), order.end(), [&server_index](auto lhs, auto rhs) {
+            return server_index[lhs] < server_index[rhs];
+          });
+        }
+        return std::make_pair(std::error_code{}, std::move(order));
+      });
+  }
+
   static auto get_encoded_value(
     std::variant<codec::encoded_value, std::function<codec::encoded_value()>> value,
     const std::unique_ptr<core::impl::observability_recorder>& obs_rec) -> codec::encoded_value
@@ -1349,6 +1474,7 @@ private:
   std::string bucket_name_;
   std::string scope_name_;
   std::string name_;
+  std::shared_ptr<core::collection_handle> handle_;
   std::shared_ptr<crypto::manager> crypto_manager_;
 };
 
@@ -1945,4 +2071,92 @@ collection::scan(const couchbase::scan_type& scan_type,
   });
   return future;
 }
+
+void
+collection::get_multi(std::vector<std::string> document_ids,
+                      const get_options& options,
+                      get_multi_handler&& handler) const
+{
+  return impl_->get_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::get_multi(std::vector<std::string> document_ids, const get_options& options) const
+  -> std::future<std::vector<std::pair<error, get_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, get_result>>>>();
+  auto future = barrier->get_future();
+  get_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
+void
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options,
+                         upsert_multi_handler&& handler) const
+{
+  return impl_->upsert_multi(std::move(documents), options.build(), std::move(handler));
+}
+
+auto
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options) const
+  -> std::future<std::vector<std::pair<error, mutation_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, mutation_result>>>>();
+  auto future = barrier->get_future();
+  upsert_multi(std::move(documents), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
+void
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options,
+                         remove_multi_handler&& handler) const
+{
+  return impl_->remove_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options) const
+  -> std::future<std::vector<std::pair<error, mutation_result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, mutation_result>>>>();
+  auto future = barrier->get_future();
+  remove_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
+void
+collection::touch_multi(std::vector<std::string> document_ids,
+                        std::chrono::seconds duration,
+                        const touch_options& options,
+                        touch_multi_handler&& handler) const
+{
+  return impl_->touch_multi(std::move(document_ids),
+                            core::impl::expiry_relative(duration),
+                            options.build(),
+                            std::move(handler));
+}
+
+auto
+collection::touch_multi(std::vector<std::string> document_ids,
+                        std::chrono::seconds duration,
+                        const touch_options& options) const
+  -> std::future<std::vector<std::pair<error, result>>>
+{
+  auto barrier = std::make_shared<std::promise<std::vector<std::pair<error, result>>>>();
+  auto future = barrier->get_future();
+  touch_multi(std::move(document_ids), duration, options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
 } // namespace couchbase
@@ -0,0 +1,129 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "hedged_read.hxx"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace couchbase::core::impl
+{
+void
+read_latency_tracker::record(const std::string& endpoint,
+                             std::chrono::steady_clock::duration latency)
+{
+  auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+  auto sample = static_cast<std::uint32_t>(
+    std::clamp<decltype(micros)>(micros, 0, std::numeric_limits<std::uint32_t>::max()));
+
+  const std::scoped_lock lock(mutex_);
+  auto& w = windows_[endpoint];
+  w.samples[w.next] = sample;
+  w.next = (w.next + 1) % window_size;
+  w.count = std::min(w.count + 1, window_size);
+  if (w.count < min_samples || w.next % 8 != 0) {
+    // the percentile moves slowly, there is no need to sort the window on every sample
+    return;
+  }
+  std::vector<std::uint32_t> sorted(w.samples.begin(),
+                                    w.samples.begin() + static_cast<std::ptrdiff_t>(w.count));
+  auto rank = sorted.begin() + static_cast<std::ptrdiff_t>(sorted.size() * 95 / 100);
+  std::nth_element(sorted.begin(), rank, sorted.end());
+  w.p95 = std::chrono::microseconds{ *rank };
+}
+
+auto
+read_latency_tracker::hedge_delay(const std::string& endpoint) const -> std::chrono::microseconds
+{
+  const std::scoped_lock lock(mutex_);
+  if (auto it = windows_.find(endpoint); it != windows_.end()) {
+    return std::clamp(it->second.p95, min_delay, max_delay);
+  }
+  return default_delay;
+}
+
+hedged_read::hedged_read(asio::io_context& io,
+                         std::shared_ptr<read_latency_tracker> latencies,
+                         std::vector<std::string> endpoints,
+                         utils::movable_function<void(std::size_t)> dispatch)
+  : timer_{ io }
+  , latencies_{ std::move(latencies) }
+  , endpoints_{ std::move(endpoints) }
+  , dispatch_{ std::move(dispatch) }
+{
+}
+
+void
+hedged_read::start()
+{
+  send_next();
+}
+
+void
+hedged_read::record(std::size_t index, std::chrono::steady_clock::duration latency)
+{
+  if (index < endpoints_.size()) {
+    latencies_->record(endpoints_[index], latency);
+  }
+}
+
+void
+hedged_read::hedge_now()
+{
+  send_next();
+}
+
+void
+hedged_read::stop()
+{
+  const std::scoped_lock lock(mutex_);
+  stopped_ = true;
+  timer_.cancel();
+}
+
+auto
+hedged_read::sent() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return next_;
+}
+
+void
+hedged_read::send_next()
+{
+  std::size_t index{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (stopped_ || next_ >= endpoints_.size()) {
+      return;
+    }
+    index = next_++;
+    if (next_ < endpoints_.size()) {
+      // armed before dispatching, because a request that fails immediately hedges from within
+      timer_.expires_after(latencies_->hedge_delay(endpoints_[index]));
+      timer_.async_wait([self = shared_from_this()](std::error_code ec) {
+        if (ec == asio::error::operation_aborted) {
+          return;
+        }
+        self->send_next();
+      });
+    }
+  }
+  dispatch_(index);
+}
+} // namespace couchbase::core::impl
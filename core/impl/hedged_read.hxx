@@ -0,0 +1,120 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace couchbase::core::impl
+{
+/**
+ * Keeps a window of recent KV read latencies per node and derives from it how long a hedged read
+ * waits for a node before asking the next one.
+ *
+ * The delay is the 95th percentile of the window, so that only the slowest few percent of reads
+ * send a second request. Until a node has enough samples the default delay is used. The result is
+ * clamped so that a very fast node does not turn every read into two, and a very slow one does
+ * not disable hedging.
+ */
+class read_latency_tracker
+{
+public:
+  static constexpr std::size_t window_size{ 128 };
+  static constexpr std::size_t min_samples{ 32 };
+  static constexpr std::chrono::microseconds default_delay{ std::chrono::milliseconds{ 10 } };
+  static constexpr std::chrono::microseconds min_delay{ std::chrono::milliseconds{ 1 } };
+  static constexpr std::chrono::microseconds max_delay{ std::chrono::milliseconds{ 250 } };
+
+  void record(const std::string& endpoint, std::chrono::steady_clock::duration latency);
+
+  [[nodiscard]] auto hedge_delay(const std::string& endpoint) const -> std::chrono::microseconds;
+
+private:
+  struct window {
+    std::array<std::uint32_t, window_size> samples{};
+    std::size_t count{ 0 };
+    std::size_t next{ 0 };
+    std::chrono::microseconds p95{ default_delay };
+  };
+
+  mutable std::mutex mutex_{};
+  std::map<std::string, window> windows_{};
+};
+
+/**
+ * Sends a read to one node at a time, moving on to the next node either when the previous one
+ * failed, or when it did not answer within its hedge delay.
+ *
+ * The operation supplies @p dispatch, which sends the read to the node at the given position in
+ * @p endpoints, and reports back through @ref hedge_now and @ref stop. The requests that are still
+ * in flight once a winner is found are cancelled by the operation itself.
+ */
+class hedged_read : public std::enable_shared_from_this<hedged_read>
+{
+public:
+  hedged_read(asio::io_context& io,
+              std::shared_ptr<read_latency_tracker> latencies,
+              std::vector<std::string> endpoints,
+              utils::movable_function<void(std::size_t)> dispatch);
+
+  /**
+   * Sends the read to the first node.
+   */
+  void start();
+
+  /**
+   * The read to the node at @p index completed after @p latency. Feeds the latency tracker.
+   */
+  void record(std::size_t index, std::chrono::steady_clock::duration latency);
+
+  /**
+   * The last read failed: do not wait for the delay, send to the next node right away.
+   */
+  void hedge_now();
+
+  /**
+   * A response has been accepted, no more nodes will be asked.
+   */
+  void stop();
+
+  [[nodiscard]] auto sent() const -> std::size_t;
+
+private:
+  void send_next();
+
+  asio::steady_timer timer_;
+  std::shared_ptr<read_latency_tracker> latencies_;
+  const std::vector<std::string> endpoints_;
+  const utils::movable_function<void(std::size_t)> dispatch_;
+  mutable std::mutex mutex_{};
+  std::size_t next_{ 0 };
+  bool stopped_{ false };
+};
+} // namespace couchbase::core::impl
@@ -27,6 +27,7 @@
 #include <atomic>
 #include <future>
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -57,6 +58,7 @@ public:
   ~internal_query_stream_result();
 
   void next(query_row_handler&& handler);
+  void next_rows(std::size_t max_rows, std::size_t max_bytes, query_rows_handler&& handler);
   void cancel();
 
   /**
@@ -67,6 +67,7 @@
 #include <asio/bind_executor.hpp>
 #include <asio/detail/concurrency_hint.hpp>
 #include <asio/execution_context.hpp>
+#include <asio/executor_work_guard.hpp>
 #include <asio/post.hpp>
 
 #include <gsl/assert>
@@ -77,7 +78,9 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -157,6 +160,7 @@ options_to_origin(const std::string& connection_string, cluster_options::built o
   user_options.config_poll_interval = opts.network.config_poll_interval;
   user_options.idle_http_connection_timeout = opts.network.idle_http_connection_timeout;
   user_options.enable_lazy_connections = opts.network.enable_lazy_connections;
+  user_options.kv_connections_per_node = opts.network.kv_connections_per_node;
   if (opts.network.max_http_connections) {
     user_options.max_http_connections = opts.network.max_http_connections.value();
   }
@@ -181,6 +185,7 @@ options_to_origin(const std::string& connection_string, cluster_options::built o
   user_options.enable_compression = opts.compression.enabled;
   user_options.compression_min_size = opts.compression.min_size;
   user_options.compression_min_ratio = opts.compression.min_ratio;
+  user_options.compression_adaptive = opts.compression.adaptive;
 
   user_options.enable_metrics = opts.metrics.enabled;
   if (opts.metrics.enabled) {
@@ -241,12 +246,14 @@ public:
     : connection_string_{ std::move(connection_string) }
     , options_{ options.build() }
   {
+    start_io_threads();
   }
 
   cluster_impl(std::string connection_string, cluster_options::built options)
     : connection_string_{ std::move(connection_string) }
     , options_{ std::move(options) }
   {
+    start_io_threads();
   }
 
   cluster_impl(const cluster_impl&) = delete;
@@ -511,30 +518,27 @@ public:
       if (transactions_) {
         transactions_->notify_fork(event);
       }
-      io_.stop();
-      // Guarded like do_close() below, and for the same reason: close() already
-      // stopped the io_context and joined this thread, so a notify_fork(prepare)
+      // Guarded inside, like do_close() below, and for the same reason: close() already
+      // stopped the io_contexts and joined the threads, so a notify_fork(prepare)
       // afterwards has nothing left to join -- and join() on a thread that is not
       // joinable throws std::system_error, out of a void public API.
-      if (io_thread_.joinable()) {
-        io_thread_.join();
-      }
+      stop_io_threads();
     }
 
-    // Our own IO thread is gone at this point, checkable in program order
-    // rather than only by a sanitizer: fork_prepare has just joined it, and
-    // fork_child/fork_parent inherit an already-joined one, because prepare runs
+    // Our own IO threads are gone at this point, checkable in program order
+    // rather than only by a sanitizer: fork_prepare has just joined them, and
+    // fork_child/fork_parent inherit already-joined ones, because prepare runs
     // before fork() and only the forking thread survives into the child. If a
     // later change moves the restart back above this line, this fires
     // immediately instead of turning into an intermittent use-after-free.
     //
     // The transactions cleanup threads were stopped above, before io_.stop(), so
     // by here the only threads this cluster owned are gone.
-    Expects(!io_thread_.joinable());
+    Expects(!io_thread_.joinable() && session_io_threads_.empty());
 
     if (event == fork_event::prepare) {
       try {
-        io_.notify_fork(fork_event_to_asio(event));
+        notify_fork_io_contexts(fork_event_to_asio(event));
       } catch (...) {
         // Undo everything this prepare did, then report. Returning stopped and threadless
         // would hang ~cluster_impl, which waits on a completion only the IO thread can
@@ -550,10 +554,8 @@ public:
         // Note for the caller: do not try to compensate by calling notify_fork(parent)
         // after this throws. Prepare has already been undone here, and that call would
         // find a restarted IO thread and trip the precondition above.
-        io_.restart();
-        io_thread_ = std::thread{ [&io = io_] {
-          io.run();
-        } };
+        restart_io_contexts();
+        start_io_threads();
         if (transactions_) {
           transactions_->notify_fork(fork_event::parent);
         }
@@ -568,9 +570,9 @@ public:
       // stream_impl::close(), which detaches a socket it did not open rather than
       // shutting it down -- but it happens on the reconnect path, asynchronously, and
       // only once the replaced impl is destroyed.
-      io_.restart();
+      restart_io_contexts();
       try {
-        io_.notify_fork(fork_event_to_asio(event));
+        notify_fork_io_contexts(fork_event_to_asio(event));
       } catch (...) {
         // notify_fork() throws if re-registering a descriptor with the new
         // epoll instance fails. The io_context is unusable after that (asio says
@@ -578,14 +580,10 @@ public:
         // waits on a completion only the IO thread can deliver, so returning
         // from here stopped and threadless would hang ~cluster_impl instead of
         // surfacing the failure.
-        io_thread_ = std::thread{ [&io = io_] {
-          io.run();
-        } };
+        start_io_threads();
         throw;
       }
-      io_thread_ = std::thread{ [&io = io_] {
-        io.run();
-      } };
+      start_io_threads();
     }
 
     // prepare was handled above, before the io_context was stopped. The child does
@@ -635,10 +633,78 @@ private:
       core_stopped.set_value();
     });
     f.get();
+    stop_io_threads();
+  }
+
+  // The primary context runs on io_thread_ and is kept alive by the work guard of core_. The
+  // session contexts only exist when network_options::io_threads asks for more than one thread,
+  // and each of their threads holds its own guard, so that an endpoint without traffic does not
+  // let its thread return from run().
+  void start_io_threads()
+  {
+    io_thread_ = std::thread{ [&io = io_] {
+      io.run();
+    } };
+    for (const auto& ctx : session_io_) {
+      session_io_threads_.emplace_back([&io = *ctx] {
+        auto guard = asio::make_work_guard(io);
+        io.run();
+      });
+    }
+  }
+
+  void stop_io_threads()
+  {
     io_.stop();
+    for (const auto& ctx : session_io_) {
+      ctx->stop();
+    }
     if (io_thread_.joinable()) {
       io_thread_.join();
     }
+    for (auto& thread : session_io_threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    session_io_threads_.clear();
+  }
+
+  void restart_io_contexts()
+  {
+    io_.restart();
+    for (const auto& ctx : session_io_) {
+      ctx->restart();
+    }
+  }
+
+  void notify_fork_io_contexts(asio::execution_context::fork_event event)
+  {
+    io_.notify_fork(event);
+    for (const auto& ctx : session_io_) {
+      ctx->notify_fork(event);
+    }
+  }
+
+  static auto make_session_io_contexts(std::size_t io_threads)
+    -> std::vector<std::unique_ptr<asio::io_context>>
+  {
+    std::vector<std::unique_ptr<asio::io_context>> contexts{};
+    for (std::size_t i = 1; i < io_threads; ++i) {
+      contexts.emplace_back(std::make_unique<asio::io_context>(ASIO_CONCURRENCY_HINT_SAFE));
+    }
+    return contexts;
+  }
+
+  [[nodiscard]] auto session_io_contexts() const
+    -> std::vector<std::reference_wrapper<asio::io_context>>
+  {
+    std::vector<std::reference_wrapper<asio::io_context>> contexts{};
+    contexts.reserve(session_io_.size());
+    for (const auto& ctx : session_io_) {
+      contexts.emplace_back(*ctx);
+    }
+    return contexts;
   }
 
   [[nodiscard]] auto create_observability_recorder(
@@ -658,11 +724,13 @@ private:
   std::string connection_string_;
   cluster_options::built options_;
   asio::io_context io_{ ASIO_CONCURRENCY_HINT_SAFE };
-  core::cluster core_{ io_ };
+  // Declared before core_ so that the sessions pinned to them are destroyed first.
+  std::vector<std::unique_ptr<asio::io_context>> session_io_{ make_session_io_contexts(
+    options_.network.io_threads) };
+  core::cluster core_{ io_, session_io_contexts() };
   std::shared_ptr<couchbase::core::transactions::transactions> transactions_{ nullptr };
-  std::thread io_thread_{ [&io = io_] {
-    io.run();
-  } };
+  std::thread io_thread_{};
+  std::vector<std::thread> session_io_threads_{};
 };
 
 /*
@@ -30,6 +30,7 @@
 #include "observability_recorder.hxx"
 #include "query.hxx"
 
+#include <cstddef>
 #include <future>
 #include <memory>
 #include <mutex>
@@ -239,6 +240,45 @@ internal_query_stream_result::next(query_row_handler&& handler)
   });
 }
 
+void
+internal_query_stream_result::next_rows(std::size_t max_rows,
+                                        std::size_t max_bytes,
+                                        query_rows_handler&& handler)
+{
+  {
+    const std::scoped_lock lk{ meta_mutex_ };
+    if (terminal_reached_) {
+      return handler(terminal_value_.first, {});
+    }
+  }
+  bool expected = false;
+  if (!pull_in_flight_.compare_exchange_strong(expected, true)) {
+    return handler(
+      error{ errc::common::invalid_argument, "a previous next() call is still in flight" }, {});
+  }
+  // Same gate and terminal handling as next(), once per batch instead of once per row.
+  stream_.next_rows(
+    max_rows,
+    max_bytes,
+    [handler = std::move(handler), self = shared_from_this()](core::row_batch rows,
+                                                              std::error_code ec) mutable {
+      if (!rows.empty()) {
+        self->pull_in_flight_.store(false);
+        return handler({}, query_row_batch{ to_binary(rows.data), std::move(rows.offsets) });
+      }
+      self->resolve_meta_data(ec);
+      if (ec) {
+        error terminal_error;
+        {
+          const std::scoped_lock lk{ self->meta_mutex_ };
+          terminal_error = self->terminal_value_.first;
+        }
+        return handler(std::move(terminal_error), {});
+      }
+      return handler({}, {});
+    });
+}
+
 // ---------------------------------------------------------------------------
 // query_stream_result public implementation
 // ---------------------------------------------------------------------------
@@ -274,6 +314,34 @@ query_stream_result::next() const -> std::future<std::pair<error, std::optional<
   return barrier->get_future();
 }
 
+void
+query_stream_result::next_rows(std::size_t max_rows,
+                               std::size_t max_bytes,
+                               query_rows_handler&& handler) const
+{
+  if (!internal_) {
+    // Empty handle behaves as an immediately-exhausted stream.
+    handler(error{}, {});
+    return;
+  }
+  return internal_->next_rows(max_rows, max_bytes, std::move(handler));
+}
+
+auto
+query_stream_result::next_rows(std::size_t max_rows, std::size_t max_bytes) const
+  -> std::future<std::pair<error, query_row_batch>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, query_row_batch>>>();
+  if (!internal_) {
+    barrier->set_value({ error{}, query_row_batch{} });
+    return barrier->get_future();
+  }
+  internal_->next_rows(max_rows, max_bytes, [barrier](error err, query_row_batch rows) mutable {
+    barrier->set_value({ std::move(err), std::move(rows) });
+  });
+  return barrier->get_future();
+}
+
 auto
 query_stream_result::signature() const -> std::optional<codec::binary>
 {
@@ -18,8 +18,13 @@
 
 #include "replica_utils.hxx"
 
+#include "core/impl/hedged_read.hxx"
 #include "core/logger/logger.hxx"
 
+#include <spdlog/fmt/bundled/core.h>
+
+#include <algorithm>
+
 namespace couchbase::core::impl
 {
 
@@ -63,4 +68,42 @@ effective_nodes(const document_id& id,
   }
   return available_nodes;
 }
+
+auto
+order_for_hedged_read(const document_id& id,
+                      std::vector<readable_node>& nodes,
+                      const std::shared_ptr<topology::configuration>& config,
+                      const read_latency_tracker& latencies) -> std::vector<std::string>
+{
+  auto endpoint_of = [&id, &config](const readable_node& node) -> std::string {
+    auto [vbid, server] = config->map_key(id.key(), node.index);
+    if (!server.has_value() || server.value() >= config->nodes.size()) {
+      return {};
+    }
+    const auto& server_node = config->nodes[server.value()];
+    return fmt::format("{}:{}",
+                       server_node.hostname,
+                       server_node.port_or(service_type::key_value, false, 0));
+  };
+
+  std::vector<std::pair<readable_node, std::string>> ordered{};
+  ordered.reserve(nodes.size());
+  for (const auto& node : nodes) {
+    ordered.emplace_back(node, endpoint_of(node));
+  }
+  std::stable_sort(ordered.begin(), ordered.end(), [&latencies](const auto& lhs, const auto& rhs) {
+    if (lhs.first.is_replica != rhs.first.is_replica) {
+      return !lhs.first.is_replica;
+    }
+    return latencies.hedge_delay(lhs.second) < latencies.hedge_delay(rhs.second);
+  });
+
+  std::vector<std::string> endpoints{};
+  endpoints.reserve(ordered.size());
+  for (std::size_t i = 0; i < ordered.size(); ++i) {
+    nodes[i] = ordered[i].first;
+    endpoints.emplace_back(std::move(ordered[i].second));
+  }
+  return endpoints;
+}
 } // namespace couchbase::core::impl
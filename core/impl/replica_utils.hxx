@@ -29,6 +29,8 @@
 
 namespace couchbase::core::impl
 {
+class read_latency_tracker;
+
 struct readable_node {
   bool is_replica;
   std::size_t index;
@@ -46,4 +48,16 @@ effective_nodes(const document_id& id,
                 const std::shared_ptr<topology::configuration>& config,
                 const read_preference& preference,
                 const std::string& preferred_server_group) -> std::vector<readable_node>;
+
+/**
+ * Orders the nodes returned by @ref effective_nodes for a hedged read: the active first (when it
+ * passed the read preference), followed by the replicas from the lowest to the highest hedge delay.
+ *
+ * Returns the KV endpoints of the reordered nodes, under which their latencies are tracked.
+ */
+auto
+order_for_hedged_read(const document_id& id,
+                      std::vector<readable_node>& nodes,
+                      const std::shared_ptr<topology::configuration>& config,
+                      const read_latency_tracker& latencies) -> std::vector<std::string>;
 } // namespace couchbase::core::impl
@@ -0,0 +1,53 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/diagnostics.hxx"
+
+#include <atomic>
+#include <cstdint>
+
+namespace couchbase::core::io
+{
+/**
+ * The counters that the KV and HTTP sessions share in their connection statistics. They are bumped
+ * with relaxed increments from the IO thread (bytes, responses) or the thread that dispatches the
+ * request (requests, retries), and can be read at any time without stopping either.
+ */
+struct connection_counters {
+  std::atomic<std::uint64_t> bytes_sent{ 0 };
+  std::atomic<std::uint64_t> bytes_received{ 0 };
+  std::atomic<std::uint64_t> requests_sent{ 0 };
+  std::atomic<std::uint64_t> responses_received{ 0 };
+  std::atomic<std::uint64_t> retries{ 0 };
+
+  static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value = 1)
+  {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void export_to(diag::endpoint_connection_stats& stats) const
+  {
+    stats.bytes_sent = bytes_sent.load(std::memory_order_relaxed);
+    stats.bytes_received = bytes_received.load(std::memory_order_relaxed);
+    stats.requests_sent = requests_sent.load(std::memory_order_relaxed);
+    stats.responses_received = responses_received.load(std::memory_order_relaxed);
+    stats.retries = retries.load(std::memory_order_relaxed);
+  }
+};
+} // namespace couchbase::core::io
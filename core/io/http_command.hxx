@@ -28,6 +28,7 @@
 #include "core/utils/movable_function.hxx"
 #include "http_session.hxx"
 #include "http_traits.hxx"
+#include "timer_wheel.hxx"
 
 #include <couchbase/tracing/request_tracer.hxx>
 
@@ -43,7 +44,7 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
   using response_type = typename Request::response_type;
   using handler_type = utils::movable_function<void(response_type&&)>;
 
-  asio::steady_timer deadline;
+  io::wheel_timer deadline;
   Request request;
   encoded_request_type encoded;
   std::shared_ptr<tracing::tracer_wrapper> tracer_;
@@ -59,7 +60,7 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
   std::shared_ptr<couchbase::tracing::request_span> parent_span_{ nullptr };
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
   std::chrono::milliseconds dispatch_timeout_{};
-  asio::steady_timer dispatch_deadline_;
+  io::wheel_timer dispatch_deadline_;
 
   http_command(asio::io_context& ctx,
                Request req,
@@ -290,9 +291,11 @@ private:
 
 #ifdef COUCHBASE_CXX_CLIENT_CREATE_OPERATION_SPAN_IN_CORE
         if (self->meter_) {
+          // interned once per request type
+          static const metrics::metric_label operation_label{ Request::observability_identifier };
           metrics::metric_attributes attrs{
             tracing::service_name_for_http_service(self->request.type),
-            self->request.observability_identifier,
+            operation_label,
             metrics::standardized_error_type(ec),
           };
           self->meter_->record_value(std::move(attrs), start);
@@ -313,6 +316,7 @@ private:
         try {
           self->invoke_handler(ec, std::move(msg));
         } catch (const priv::retry_http_request&) {
+          self->session_->record_retry();
           self->send();
         }
       });
@@ -0,0 +1,38 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+namespace couchbase::core::io
+{
+/**
+ * How the HTTP session manager picks the node for a request of a service that has no preferred
+ * node.
+ */
+enum class http_node_selection {
+  /**
+   * Rotate over the nodes of the service, reusing any idle connection first.
+   */
+  round_robin,
+
+  /**
+   * Pick two nodes of the service at random and send to the one with the lower expected latency,
+   * judged by the moving average of its response times and its number of outstanding requests.
+   */
+  least_latency,
+};
+} // namespace couchbase::core::io
@@ -0,0 +1,170 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "http_node_selector.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace couchbase::core::io
+{
+void
+http_endpoint_load::start()
+{
+  outstanding_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+http_endpoint_load::finish(std::chrono::nanoseconds elapsed,
+                           std::chrono::steady_clock::time_point now)
+{
+  outstanding_.fetch_sub(1, std::memory_order_relaxed);
+  const auto sample = static_cast<double>(elapsed.count());
+  auto current = average_ns_.load(std::memory_order_relaxed);
+  std::int64_t updated{};
+  do {
+    const auto average = static_cast<double>(current);
+    updated = (current == 0)
+                ? elapsed.count()
+                : static_cast<std::int64_t>(average + smoothing_factor * (sample - average));
+    if (updated <= 0) {
+      updated = 1;
+    }
+  } while (!average_ns_.compare_exchange_weak(current, updated, std::memory_order_relaxed));
+  last_sample_ns_.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+auto
+http_endpoint_load::outstanding() const -> std::size_t
+{
+  return outstanding_.load(std::memory_order_relaxed);
+}
+
+auto
+http_endpoint_load::average_latency(std::chrono::steady_clock::time_point now) const
+  -> std::chrono::nanoseconds
+{
+  const auto average = average_ns_.load(std::memory_order_relaxed);
+  if (average == 0) {
+    return {};
+  }
+  const auto idle = now.time_since_epoch() -
+                    std::chrono::steady_clock::duration{
+                      last_sample_ns_.load(std::memory_order_relaxed) };
+  if (idle <= std::chrono::steady_clock::duration::zero()) {
+    return std::chrono::nanoseconds{ average };
+  }
+  const auto half_lives = std::chrono::duration<double>(idle) /
+                          std::chrono::duration<double>(decay_half_life);
+  return std::chrono::nanoseconds{ static_cast<std::int64_t>(static_cast<double>(average) *
+                                                             std::exp2(-half_lives)) };
+}
+
+auto
+http_endpoint_load::score(std::chrono::steady_clock::time_point now) const -> double
+{
+  // One nanosecond added, so that the queue still counts for endpoints without a sample yet.
+  return static_cast<double>(average_latency(now).count() + 1) *
+         static_cast<double>(outstanding() + 1);
+}
+
+auto
+http_node_selector::load_for(service_type type, const std::string& hostname, std::uint16_t port)
+  -> std::shared_ptr<http_endpoint_load>
+{
+  const std::scoped_lock lock(loads_mutex_);
+  if (auto it = loads_.find(std::tie(type, hostname, port)); it != loads_.end()) {
+    return it->second;
+  }
+  auto load = std::make_shared<http_endpoint_load>();
+  loads_.try_emplace({ type, hostname, port }, load);
+  return load;
+}
+
+auto
+http_node_selector::score(service_type type,
+                          const std::string& hostname,
+                          std::uint16_t port,
+                          std::chrono::steady_clock::time_point now) const -> double
+{
+  const std::scoped_lock lock(loads_mutex_);
+  if (auto it = loads_.find(std::tie(type, hostname, port)); it != loads_.end()) {
+    return it->second->score(now);
+  }
+  return 0;
+}
+
+auto
+http_node_selector::pick_two(std::size_t count) -> std::pair<std::size_t, std::size_t>
+{
+  if (count < 2) {
+    return { 0, 0 };
+  }
+  thread_local std::minstd_rand generator{ std::random_device{}() };
+  const auto first = std::uniform_int_distribution<std::size_t>{ 0, count - 1 }(generator);
+  auto second = std::uniform_int_distribution<std::size_t>{ 0, count - 2 }(generator);
+  if (second >= first) {
+    ++second;
+  }
+  return { first, second };
+}
+
+auto
+pick_least_loaded_node(const std::vector<topology::configuration::node>& nodes,
+                       service_type type,
+                       const std::string& network,
+                       bool enable_tls,
+                       const http_node_selector& selector,
+                       std::chrono::steady_clock::time_point now)
+  -> const topology::configuration::node*
+{
+  const auto is_candidate = [type, &network, enable_tls](const auto& node) {
+    return node.port_or(network, type, enable_tls, 0) != 0;
+  };
+  const auto candidates =
+    static_cast<std::size_t>(std::count_if(nodes.begin(), nodes.end(), is_candidate));
+  if (candidates == 0) {
+    return nullptr;
+  }
+
+  auto [first, second] = http_node_selector::pick_two(candidates);
+  const topology::configuration::node* first_node{ nullptr };
+  const topology::configuration::node* second_node{ nullptr };
+  std::size_t index{ 0 };
+  for (const auto& node : nodes) {
+    if (!is_candidate(node)) {
+      continue;
+    }
+    if (index == first) {
+      first_node = &node;
+    }
+    if (index == second) {
+      second_node = &node;
+    }
+    ++index;
+  }
+  if (first_node == second_node) {
+    return first_node;
+  }
+  const auto score_of = [&](const topology::configuration::node& node) {
+    return selector.score(
+      type, node.hostname_for(network), node.port_or(network, type, enable_tls, 0), now);
+  };
+  return score_of(*second_node) < score_of(*first_node) ? second_node : first_node;
+}
+} // namespace couchbase::core::io
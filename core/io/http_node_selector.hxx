@@ -0,0 +1,115 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/service_type.hxx"
+#include "core/topology/configuration.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Load of one HTTP endpoint as seen by this client: an exponentially weighted moving average of its
+ * response times and the number of requests sent to it that have not completed yet.
+ *
+ * The average fades towards zero while the endpoint receives no traffic, so a node that was slow
+ * once is probed again after a while instead of being avoided for good.
+ */
+class http_endpoint_load
+{
+public:
+  static constexpr double smoothing_factor{ 0.2 };
+  static constexpr std::chrono::milliseconds decay_half_life{ 1'000 };
+
+  void start();
+  void finish(std::chrono::nanoseconds elapsed,
+              std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+  [[nodiscard]] auto outstanding() const -> std::size_t;
+  [[nodiscard]] auto average_latency(
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const
+    -> std::chrono::nanoseconds;
+
+  /**
+   * Expected cost of sending one more request to the endpoint: the average latency scaled by the
+   * number of requests that would be queued in front of it. Lower is better.
+   */
+  [[nodiscard]] auto score(std::chrono::steady_clock::time_point now =
+                             std::chrono::steady_clock::now()) const -> double;
+
+private:
+  std::atomic<std::int64_t> average_ns_{ 0 };
+  std::atomic<std::int64_t> last_sample_ns_{ 0 };
+  std::atomic<std::size_t> outstanding_{ 0 };
+};
+
+/**
+ * Per service and endpoint loads for the latency-aware node selection of the HTTP session manager.
+ */
+class http_node_selector
+{
+public:
+  [[nodiscard]] auto load_for(service_type type, const std::string& hostname, std::uint16_t port)
+    -> std::shared_ptr<http_endpoint_load>;
+
+  /**
+   * Score of the endpoint, or zero when no request has been sent to it yet.
+   */
+  [[nodiscard]] auto score(service_type type,
+                           const std::string& hostname,
+                           std::uint16_t port,
+                           std::chrono::steady_clock::time_point now =
+                             std::chrono::steady_clock::now()) const -> double;
+
+  /**
+   * Two distinct indexes in [0, count) drawn uniformly at random, or the same index twice when
+   * there is only one to choose from. @p count must not be zero.
+   */
+  [[nodiscard]] static auto pick_two(std::size_t count) -> std::pair<std::size_t, std::size_t>;
+
+private:
+  using endpoint_key = std::tuple<service_type, std::string, std::uint16_t>;
+
+  mutable std::mutex loads_mutex_{};
+  std::map<endpoint_key, std::shared_ptr<http_endpoint_load>, std::less<>> loads_{};
+};
+
+/**
+ * Power of two choices: of two nodes drawn at random among those that offer @p type, the one with
+ * the lower score in @p selector. Returns nullptr when no node offers the service.
+ */
+auto
+pick_least_loaded_node(const std::vector<topology::configuration::node>& nodes,
+                       service_type type,
+                       const std::string& network,
+                       bool enable_tls,
+                       const http_node_selector& selector,
+                       std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now())
+  -> const topology::configuration::node*;
+} // namespace couchbase::core::io
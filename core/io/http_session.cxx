@@ -206,6 +206,34 @@ http_session::diag_info() -> diag::endpoint_diag_info
            state_ };
 }
 
+auto
+http_session::connection_stats() -> diag::endpoint_connection_stats
+{
+  diag::endpoint_connection_stats stats{};
+  stats.type = type_;
+  stats.id = id_;
+  stats.remote = remote_address();
+  stats.local = local_address();
+  stats.state = state_;
+  counters_.export_to(stats);
+  {
+    // one request at a time: it is in flight until its response (or its headers, when streaming)
+    // has been handed over
+    const std::scoped_lock lock(current_response_mutex_);
+    if (current_response_.handler || current_streaming_response_.resp_handler) {
+      stats.in_flight = 1;
+    }
+  }
+  stats.write_queue_bytes = queued_bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void
+http_session::record_retry()
+{
+  connection_counters::add(counters_.retries);
+}
+
 auto
 http_session::log_prefix() -> std::string
 {
@@ -387,6 +415,7 @@ http_session::write(const std::vector<std::uint8_t>& buf)
     return;
   }
   const std::scoped_lock lock(output_buffer_mutex_);
+  queued_bytes_.fetch_add(buf.size(), std::memory_order_relaxed);
   output_buffer_.push_back(buf);
 }
 
@@ -397,6 +426,7 @@ http_session::write(const std::string_view& buf)
     return;
   }
   const std::scoped_lock lock(output_buffer_mutex_);
+  queued_bytes_.fetch_add(buf.size(), std::memory_order_relaxed);
   output_buffer_.emplace_back(buf.begin(), buf.end());
 }
 
@@ -459,6 +489,7 @@ http_session::write_and_stream(
   }
   write("\r\n");
   write(request.body);
+  connection_counters::add(counters_.requests_sent);
   flush();
 }
 
@@ -551,6 +582,7 @@ http_session::read_some(
                                        static_cast<std::ptrdiff_t>(bytes_transferred)));
 
       self->last_active_ = std::chrono::steady_clock::now();
+      connection_counters::add(self->counters_.bytes_received, bytes_transferred);
       if (ec) {
         CB_LOG_ERROR(
           "{} IO error while reading from the socket: {}", self->info_.log_prefix(), ec.message());
@@ -739,6 +771,7 @@ http_session::do_read()
                                        static_cast<std::ptrdiff_t>(bytes_transferred)));
 
       self->last_active_ = std::chrono::steady_clock::now();
+      connection_counters::add(self->counters_.bytes_received, bytes_transferred);
       if (ec) {
         if (self->idle_) {
           // Expected: the peer closed a pooled idle connection.  Tear it down
@@ -776,6 +809,7 @@ http_session::do_read()
           return self->stop();
         }
         if (res.complete || res.headers_complete) {
+          connection_counters::add(self->counters_.responses_received);
           streaming_response_context ctx{};
           {
             const std::scoped_lock lock(self->current_response_mutex_);
@@ -815,6 +849,7 @@ http_session::do_read()
         return self->stop();
       }
       if (res.complete) {
+        connection_counters::add(self->counters_.responses_received);
         response_context ctx{};
         {
           const std::scoped_lock lock(self->current_response_mutex_);
@@ -846,6 +881,7 @@ http_session::do_write()
   std::vector<asio::const_buffer> buffers;
   buffers.reserve(writing_buffer_.size());
   for (auto& buf : writing_buffer_) {
+    queued_bytes_.fetch_sub(buf.size(), std::memory_order_relaxed);
     CB_LOG_PROTOCOL("[HTTP, OUT] type={}, host=\"{}\", buffer_size={}{:a}",
                     type_,
                     info_.remote_address(),
@@ -864,6 +900,7 @@ http_session::do_write()
         return;
       }
       self->last_active_ = std::chrono::steady_clock::now();
+      connection_counters::add(self->counters_.bytes_sent, bytes_transferred);
       if (ec) {
         CB_LOG_ERROR(
           "{} IO error while writing to the socket: {}", self->info_.log_prefix(), ec.message());
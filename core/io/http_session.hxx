@@ -24,6 +24,7 @@
 #include "core/origin.hxx"
 #include "core/platform/base64.h"
 #include "core/utils/movable_function.hxx"
+#include "connection_counters.hxx"
 #include "http_context.hxx"
 #include "http_message.hxx"
 #include "http_parser.hxx"
@@ -99,6 +100,8 @@ public:
   [[nodiscard]] auto local_address() -> std::string;
   [[nodiscard]] auto remote_endpoint() -> const asio::ip::tcp::endpoint&;
   [[nodiscard]] auto diag_info() -> diag::endpoint_diag_info;
+  [[nodiscard]] auto connection_stats() -> diag::endpoint_connection_stats;
+  void record_retry();
   [[nodiscard]] auto log_prefix() -> std::string;
   [[nodiscard]] auto id() const -> const std::string&;
   [[nodiscard]] auto node_uuid() const -> const std::string&;
@@ -159,6 +162,7 @@ public:
     }
     write("\r\n");
     write(request.body);
+    connection_counters::add(counters_.requests_sent);
     flush();
   }
 
@@ -258,5 +262,7 @@ private:
 
   std::chrono::time_point<std::chrono::steady_clock> last_active_{};
   diag::endpoint_state state_{ diag::endpoint_state::disconnected };
+  connection_counters counters_{};
+  std::atomic<std::size_t> queued_bytes_{ 0 };
 };
 } // namespace couchbase::core::io
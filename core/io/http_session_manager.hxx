@@ -33,8 +33,11 @@
 #include "core/tracing/tracer_wrapper.hxx"
 #include "http_command.hxx"
 #include "http_context.hxx"
+#include "http_node_selection.hxx"
+#include "http_node_selector.hxx"
 #include "http_session.hxx"
 #include "http_traits.hxx"
+#include "io_context_pool.hxx"
 
 #include <gsl/narrow>
 
@@ -77,6 +80,7 @@ public:
 
   void set_meter(std::shared_ptr<metrics::meter_wrapper> meter)
   {
+    query_cache_.set_meter(meter);
     meter_ = std::move(meter);
   }
 
@@ -85,6 +89,11 @@ public:
     app_telemetry_meter_ = std::move(app_telemetry_meter);
   }
 
+  void set_io_context_pool(std::shared_ptr<io_context_pool> io_pool)
+  {
+    io_pool_ = std::move(io_pool);
+  }
+
   auto configuration_capabilities() const -> configuration_capabilities
   {
     std::scoped_lock config_lock(config_mutex_);
@@ -173,6 +182,7 @@ public:
     {
       std::scoped_lock lock(config_mutex_, next_index_mutex_);
       options_ = options;
+      query_cache_.set_capacity(options.query_cache_capacity);
       next_index_ = next_index;
       config_ = config;
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
@@ -209,6 +219,26 @@ public:
     }
   }
 
+  void export_connection_stats(diag::connection_stats_result& res)
+  {
+    std::scoped_lock lock(sessions_mutex_);
+
+    for (const auto& [type, sessions] : busy_sessions_) {
+      for (const auto& session : sessions) {
+        if (session) {
+          res.services[type].emplace_back(session->connection_stats());
+        }
+      }
+    }
+    for (const auto& [type, sessions] : idle_sessions_) {
+      for (const auto& session : sessions) {
+        if (session) {
+          res.services[type].emplace_back(session->connection_stats());
+        }
+      }
+    }
+  }
+
   template<typename Collector>
   void ping(std::set<service_type> services,
             std::optional<std::chrono::milliseconds> timeout,
@@ -340,6 +370,14 @@ public:
         preferred_node_address = fmt::format("{}:{}", n.hostname, n.port);
         preferred_node = std::move(n);
       }
+    } else if (preferred_node_address.empty() &&
+               node_selection_for(type) == http_node_selection::least_latency) {
+      // Choose the node first and only then look for an idle session to it, otherwise whichever
+      // node happens to have idle sessions would keep receiving the traffic.
+      if (auto n = pick_least_loaded_node(type); n.port != 0) {
+        preferred_node_address = fmt::format("{}:{}", n.hostname, n.port);
+        preferred_node = std::move(n);
+      }
     } else if (!preferred_node_address.empty()) {
       // A 'sticky' node was specified. We should populate the node details.
       preferred_node = lookup_node(type, preferred_node_address);
@@ -554,9 +592,23 @@ public:
       options_.default_timeout_for(request.type));
 #endif
 
+    std::shared_ptr<http_endpoint_load> load{};
+    if (preferred_node.empty() &&
+        node_selection_for(request.type) == http_node_selection::least_latency) {
+      load = node_selector_.load_for(
+        request.type, session->http_context().hostname, session->http_context().port);
+      load->start();
+    }
+
     using response_type = typename Request::response_type;
-    cmd->start([self = shared_from_this(), cmd, handler = std::forward<Handler>(handler)](
-                 response_type&& resp) mutable {
+    cmd->start([self = shared_from_this(),
+                cmd,
+                load = std::move(load),
+                start = std::chrono::steady_clock::now(),
+                handler = std::forward<Handler>(handler)](response_type&& resp) mutable {
+      if (load) {
+        load->finish(std::chrono::steady_clock::now() - start);
+      }
       handler(std::move(resp));
       self->check_in(cmd->request.type, cmd->session_);
     });
@@ -747,12 +799,14 @@ private:
 
   auto create_session(service_type type, const node_details& node) -> std::shared_ptr<http_session>
   {
+    // Pinned per endpoint like the KV sessions; the commands keep their timers on ctx_.
+    auto& session_ctx = io_pool_ ? io_pool_->context_for(node.hostname, node.port) : ctx_;
     std::shared_ptr<http_session> session;
     if (options_.enable_tls) {
       session = std::make_shared<http_session>(type,
                                                client_id_,
                                                node.node_uuid,
-                                               ctx_,
+                                               session_ctx,
                                                tls_,
                                                origin_,
                                                node.hostname,
@@ -770,7 +824,7 @@ private:
       session = std::make_shared<http_session>(type,
                                                client_id_,
                                                node.node_uuid,
-                                               ctx_,
+                                               session_ctx,
                                                origin_,
                                                node.hostname,
                                                std::to_string(node.port),
@@ -938,39 +992,60 @@ private:
     return {};
   }
 
-  auto pick_random_node(service_type type, const std::string& undesired_node) -> node_details
+  auto node_selection_for(service_type type) const -> http_node_selection
   {
-    std::vector<topology::configuration::node> candidate_nodes{};
-    {
-      const std::scoped_lock lock(config_mutex_);
-      std::copy_if(config_.nodes.begin(),
-                   config_.nodes.end(),
-                   std::back_inserter(candidate_nodes),
-                   [this, type, &undesired_node](const topology::configuration::node& node) {
-                     auto endpoint = node.endpoint(options_.network, type, options_.enable_tls);
-                     return endpoint.has_value() && (endpoint.value() != undesired_node);
-                   });
+    const std::scoped_lock lock(config_mutex_);
+    if (auto it = options_.http_node_selection.find(type);
+        it != options_.http_node_selection.end()) {
+      return it->second;
     }
+    return http_node_selection::round_robin;
+  }
 
-    if (candidate_nodes.empty()) {
+  auto make_node_details(service_type type, const topology::configuration::node& node) const
+    -> node_details
+  {
+    return {
+      node.hostname_for(options_.network),
+      node.port_or(options_.network, type, options_.enable_tls, 0),
+      node.node_uuid,
+      node.hostname,
+      node.port_or(type, options_.enable_tls, 0),
+    };
+  }
+
+  auto pick_random_node(service_type type, const std::string& undesired_node) -> node_details
+  {
+    const std::scoped_lock lock(config_mutex_);
+    const auto is_candidate = [this, type, &undesired_node](const auto& node) {
+      auto endpoint = node.endpoint(options_.network, type, options_.enable_tls);
+      return endpoint.has_value() && (endpoint.value() != undesired_node);
+    };
+    const auto candidates = static_cast<std::size_t>(
+      std::count_if(config_.nodes.begin(), config_.nodes.end(), is_candidate));
+    if (candidates == 0) {
       // Could not find any other nodes
       return {};
     }
 
-    std::vector<topology::configuration::node> selected{};
-    std::sample(candidate_nodes.begin(),
-                candidate_nodes.end(),
-                std::back_inserter(selected),
-                1,
-                std::mt19937{ std::random_device{}() });
-    const auto& first_selected = selected.at(0);
-    return {
-      first_selected.hostname_for(options_.network),
-      first_selected.port_or(options_.network, type, options_.enable_tls, 0),
-      first_selected.node_uuid,
-      first_selected.hostname,
-      first_selected.port_or(type, options_.enable_tls, 0),
-    };
+    auto selected = http_node_selector::pick_two(candidates).first;
+    for (const auto& node : config_.nodes) {
+      if (is_candidate(node) && selected-- == 0) {
+        return make_node_details(type, node);
+      }
+    }
+    return {};
+  }
+
+  auto pick_least_loaded_node(service_type type) -> node_details
+  {
+    const std::scoped_lock lock(config_mutex_);
+    const auto* node = io::pick_least_loaded_node(
+      config_.nodes, type, options_.network, options_.enable_tls, node_selector_);
+    if (node == nullptr) {
+      return {};
+    }
+    return make_node_details(type, *node);
   }
 
   std::string client_id_;
@@ -980,6 +1055,7 @@ private:
   std::shared_ptr<tracing::tracer_wrapper> tracer_{ nullptr };
   std::shared_ptr<metrics::meter_wrapper> meter_{ nullptr };
   std::shared_ptr<core::app_telemetry_meter> app_telemetry_meter_{ nullptr };
+  std::shared_ptr<io_context_pool> io_pool_{ nullptr };
   cluster_options options_{};
 
   topology::configuration config_{};
@@ -989,6 +1065,7 @@ private:
   std::map<service_type, std::list<std::shared_ptr<http_session>>> pending_sessions_{};
   std::size_t next_index_{ 0 };
   std::mutex next_index_mutex_{};
+  http_node_selector node_selector_{};
   std::mutex sessions_mutex_{};
   query_cache query_cache_{};
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
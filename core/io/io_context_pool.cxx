@@ -0,0 +1,61 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "io_context_pool.hxx"
+
+namespace couchbase::core::io
+{
+io_context_pool::io_context_pool(asio::io_context& primary,
+                                 std::vector<std::reference_wrapper<asio::io_context>> others)
+{
+  contexts_.reserve(others.size() + 1);
+  contexts_.emplace_back(primary);
+  for (auto& ctx : others) {
+    if (&ctx.get() != &primary) {
+      contexts_.emplace_back(ctx);
+    }
+  }
+}
+
+auto
+io_context_pool::primary() const -> asio::io_context&
+{
+  return contexts_.front().get();
+}
+
+auto
+io_context_pool::size() const -> std::size_t
+{
+  return contexts_.size();
+}
+
+auto
+io_context_pool::context_for(const std::string& hostname,
+                             std::uint16_t port,
+                             std::size_t connection) -> asio::io_context&
+{
+  if (contexts_.size() == 1) {
+    return contexts_.front().get();
+  }
+  const std::scoped_lock lock(affinity_mutex_);
+  auto [it, inserted] = affinity_.try_emplace({ hostname, port }, next_index_);
+  if (inserted) {
+    next_index_ = (next_index_ + 1) % contexts_.size();
+  }
+  return contexts_[(it->second + connection) % contexts_.size()].get();
+}
+} // namespace couchbase::core::io
@@ -0,0 +1,64 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <asio/io_context.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * The set of io_contexts that KV and HTTP sessions are spread across. Each context is expected to
+ * be run by its own thread.
+ *
+ * An endpoint (hostname and port) is given a context the first time it is asked for, round-robin
+ * over the pool, and keeps it for as long as the pool lives, so a reconnect does not migrate it.
+ * Further connections to the same endpoint (e.g. kv_connections_per_node) continue round-robin
+ * from there, each on the next context. The primary context is always the first member, and is the
+ * only one handed out when the pool has no other contexts.
+ */
+class io_context_pool
+{
+public:
+  explicit io_context_pool(asio::io_context& primary,
+                           std::vector<std::reference_wrapper<asio::io_context>> others = {});
+
+  [[nodiscard]] auto primary() const -> asio::io_context&;
+  [[nodiscard]] auto size() const -> std::size_t;
+  /**
+   * @param connection which connection to the endpoint the context is for, zero for the first one
+   */
+  [[nodiscard]] auto context_for(const std::string& hostname,
+                                 std::uint16_t port,
+                                 std::size_t connection = 0) -> asio::io_context&;
+
+private:
+  std::vector<std::reference_wrapper<asio::io_context>> contexts_;
+  std::mutex affinity_mutex_{};
+  std::map<std::pair<std::string, std::uint16_t>, std::size_t> affinity_{};
+  std::size_t next_index_{ 0 };
+};
+} // namespace couchbase::core::io
@@ -33,17 +33,18 @@
 #include "mcbp_session.hxx"
 #include "mcbp_traits.hxx"
 #include "retry_orchestrator.hxx"
+#include "timer_wheel.hxx"
 
 #include <couchbase/durability_level.hxx>
 #include <couchbase/error_codes.hxx>
 
 #include <asio/dispatch.hpp>
 #include <asio/io_context.hpp>
-#include <asio/steady_timer.hpp>
 #include <asio/strand.hpp>
 #include <spdlog/fmt/bundled/chrono.h>
 
 #include <functional>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -59,8 +60,8 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
 
   using encoded_request_type = typename Request::encoded_request_type;
   using encoded_response_type = typename Request::encoded_response_type;
-  asio::steady_timer deadline;
-  asio::steady_timer retry_backoff;
+  io::wheel_timer deadline;
+  io::wheel_timer retry_backoff;
   // Only cancellable operations (replica fan-out) need a strand: their dispatch
   // path can run on the caller thread while a sibling's completion cancels them
   // from an IO thread, so all access to session_/opaque_/handler_ is confined to
@@ -308,8 +309,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
           return self->invoke_handler(ec);
         }
         protocol::client_response<protocol::get_collection_id_response_body> resp(std::move(msg));
-        self->session_->update_collection_uid(self->request.id.collection_path(),
-                                              resp.body().collection_uid());
+        self->manager_->update_collection_uid(self->request.id, resp.body().collection_uid());
         self->request.id.collection_uid(resp.body().collection_uid());
         return self->send();
       }));
@@ -345,7 +345,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     request.opaque = *opaque_;
     if (request.id.use_collections() && !request.id.is_collection_resolved()) {
       if (session_->supports_feature(protocol::hello_feature::collections)) {
-        auto collection_id = session_->get_collection_uid(request.id.collection_path());
+        auto collection_id = manager_->collection_uid(request.id);
         if (collection_id) {
           request.id.collection_uid(collection_id.value());
         } else {
@@ -376,9 +376,16 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     }
 
     auto dispatch_span = create_dispatch_span();
+    // reads never carry a value, so only mutations look up the policy (and its sampler)
+    std::optional<protocol::compression_policy> compression{};
+    if (encoded.compresses_value() && session_->supports_feature(protocol::hello_feature::snappy)) {
+      compression = manager_->compression_policy(request.id);
+    }
+    auto payload = encoded.gathered_data(compression ? &compression.value() : nullptr);
     session_->write_and_subscribe(
       request.opaque,
-      encoded.data(session_->supports_feature(protocol::hello_feature::snappy)),
+      std::move(payload.frame),
+      std::move(payload.value),
       on_strand([self = this->shared_from_this(),
                  start = std::chrono::steady_clock::now(),
                  dispatch_span = std::move(dispatch_span)](
@@ -423,11 +430,14 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
 
 #ifdef COUCHBASE_CXX_CLIENT_CREATE_OPERATION_SPAN_IN_CORE
         {
+          // interned once per request type, the bucket name once per bucket
+          static const metrics::metric_label service_label{ tracing::service::key_value };
+          static const metrics::metric_label operation_label{ Request::observability_identifier };
           metrics::metric_attributes attrs{
-            tracing::service::key_value,
-            self->request.observability_identifier,
+            service_label,
+            operation_label,
             metrics::standardized_error_type(ec),
-            self->request.id.bucket(),
+            self->manager_->name_label(),
             self->request.id.scope(),
             self->request.id.collection(),
           };
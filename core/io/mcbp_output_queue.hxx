@@ -17,8 +17,8 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
-#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -28,19 +28,33 @@ namespace couchbase::core::io
  * Send-side buffering for an mcbp connection.
  *
  * A KV operation appends its encoded frame from the caller's thread while the connection's write
- * loop (`do_write` / the async_write completion) runs on an IO thread; this queue owns both buffers
- * and the single flag that coordinates them, so all of that state is mutated under one lock.
+ * loop (`do_write` / the async_write completion) runs on an IO thread. Producers never take a lock:
+ * each append pushes one node onto an intrusive lock-free stack, and the writer detaches the whole
+ * stack with a single exchange and reverses it, so it receives everything queued so far, in order,
+ * as one gathered write. The writing batch is only touched by the writer.
  *
- * The flag exists to eliminate a per-operation `asio::post`. `enqueue()`/`mark_for_dispatch()` only
- * ask the caller to schedule a write on the idle -> scheduled transition; while a write is already
- * scheduled or in flight they return false, because the in-flight write's completion is what
- * re-drives the loop. Draining the queue to empty returns it to idle so the next enqueue re-arms.
+ * The scheduled flag exists to eliminate a per-operation `asio::post`. `enqueue()` and
+ * `mark_for_dispatch()` only ask the caller to schedule a write on the idle -> scheduled
+ * transition; while a write is already scheduled or in flight they return false, because the
+ * in-flight write's completion is what re-drives the loop. Draining the queue to empty returns it
+ * to idle so the next enqueue re-arms.
  */
 class mcbp_output_queue
 {
 public:
   using buffer = std::vector<std::byte>;
 
+  mcbp_output_queue() = default;
+  mcbp_output_queue(const mcbp_output_queue&) = delete;
+  mcbp_output_queue(mcbp_output_queue&&) = delete;
+  auto operator=(const mcbp_output_queue&) -> mcbp_output_queue& = delete;
+  auto operator=(mcbp_output_queue&&) -> mcbp_output_queue& = delete;
+
+  ~mcbp_output_queue()
+  {
+    release(head_.exchange(nullptr, std::memory_order_acquire));
+  }
+
   /**
    * Append a buffer and stage it for the next write.
    *
@@ -49,8 +63,20 @@ public:
    */
   [[nodiscard]] auto enqueue(buffer&& buf) -> bool
   {
-    const std::scoped_lock lock(mutex_);
-    output_.emplace_back(std::move(buf));
+    push(new node{ std::move(buf), {}, nullptr });
+    return arm();
+  }
+
+  /**
+   * Append a frame whose document value is kept in a buffer of its own, and stage both for the next
+   * write. They are queued as one node, so the gathered write puts the value on the wire right after
+   * its frame without it ever being copied. An empty value is skipped.
+   *
+   * @return same as enqueue(buffer&&).
+   */
+  [[nodiscard]] auto enqueue(buffer&& frame, buffer&& value) -> bool
+  {
+    push(new node{ std::move(frame), std::move(value), nullptr });
     return arm();
   }
 
@@ -60,8 +86,16 @@ public:
    */
   void stage(buffer&& buf)
   {
-    const std::scoped_lock lock(mutex_);
-    output_.emplace_back(std::move(buf));
+    push(new node{ std::move(buf), {}, nullptr });
+  }
+
+  /**
+   * Append a frame and its detached value (see enqueue(buffer&&, buffer&&)) without requesting a
+   * write.
+   */
+  void stage(buffer&& frame, buffer&& value)
+  {
+    push(new node{ std::move(frame), std::move(value), nullptr });
   }
 
   /**
@@ -72,32 +106,59 @@ public:
    */
   [[nodiscard]] auto mark_for_dispatch() -> bool
   {
-    const std::scoped_lock lock(mutex_);
-    if (output_.empty()) {
+    if (head_.load() == nullptr) {
       return false;
     }
     return arm();
   }
 
   /**
-   * Move all queued buffers into the writing batch so it can be handed to async_write.
+   * Move all queued buffers into the writing batch so it can be handed to async_write. Must only be
+   * called by the writer.
    *
    * @return true if there is a batch to send (see writing()); false if nothing is queued (the queue
    * is returned to idle) or a write is already in flight (left untouched).
    */
   [[nodiscard]] auto begin_writing() -> bool
   {
-    const std::scoped_lock lock(mutex_);
     if (!writing_.empty()) {
       // A batch is still in flight; issuing another async_write concurrently would corrupt the
       // stream. Leave it scheduled — the in-flight completion will re-drive us.
       return false;
     }
-    if (output_.empty()) {
-      scheduled_ = false;
-      return false;
+    node* batch = head_.exchange(nullptr, std::memory_order_acquire);
+    while (batch == nullptr) {
+      // Go idle, then look again: a producer that pushed before the store saw the flag still set
+      // and did not ask for a write, so its buffer has to be picked up here.
+      scheduled_.store(false);
+      if (head_.load() == nullptr) {
+        return false;
+      }
+      if (scheduled_.exchange(true)) {
+        // a producer re-armed the queue in the meantime and will schedule the write itself
+        return false;
+      }
+      batch = head_.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    // the stack is in LIFO order, reverse it to get the order of the producers
+    node* ordered = nullptr;
+    while (batch != nullptr) {
+      auto* next = batch->next;
+      batch->next = ordered;
+      ordered = batch;
+      batch = next;
+    }
+    while (ordered != nullptr) {
+      auto* next = ordered->next;
+      queued_bytes_.fetch_sub(ordered->size(), std::memory_order_relaxed);
+      writing_.emplace_back(std::move(ordered->frame));
+      if (!ordered->value.empty()) {
+        writing_.emplace_back(std::move(ordered->value));
+      }
+      delete ordered;
+      ordered = next;
     }
-    std::swap(writing_, output_);
     return true;
   }
 
@@ -115,36 +176,73 @@ public:
    */
   void finish_writing()
   {
-    const std::scoped_lock lock(mutex_);
+    // clear() keeps the capacity, so a steady stream of batches does not reallocate
     writing_.clear();
   }
 
   /**
-   * Discard everything and return to idle (used when the connection is reset or stopped).
+   * Discard everything and return to idle (used by the writer when the connection is reset or
+   * stopped).
    */
   void reset()
   {
-    const std::scoped_lock lock(mutex_);
-    output_.clear();
+    release(head_.exchange(nullptr, std::memory_order_acquire));
     writing_.clear();
-    scheduled_ = false;
+    scheduled_.store(false);
+  }
+
+  /**
+   * Bytes queued by producers and not yet moved into a writing batch. Safe to call from any thread;
+   * the value is a snapshot, meant for statistics.
+   */
+  [[nodiscard]] auto queued_bytes() const -> std::size_t
+  {
+    return queued_bytes_.load(std::memory_order_relaxed);
   }
 
 private:
-  // Precondition: mutex_ held. Transition idle -> scheduled, reporting whether the caller owns the
-  // resulting write post.
+  struct node {
+    buffer frame;
+    buffer value;
+    node* next;
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+      return frame.size() + value.size();
+    }
+  };
+
+  void push(node* item)
+  {
+    // counted before the node is visible, so that the writer never subtracts it first
+    queued_bytes_.fetch_add(item->size(), std::memory_order_relaxed);
+    item->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(item->next, item)) {
+      // item->next was refreshed with the current head, try again
+    }
+  }
+
+  // Transition idle -> scheduled, reporting whether the caller owns the resulting write post. The
+  // push and this exchange are sequentially consistent, and so are the store and load in
+  // begin_writing(), so either the writer sees the pushed node or the producer sees the queue idle.
   auto arm() -> bool
   {
-    if (scheduled_) {
-      return false;
+    return !scheduled_.exchange(true);
+  }
+
+  void release(node* item)
+  {
+    while (item != nullptr) {
+      auto* next = item->next;
+      queued_bytes_.fetch_sub(item->size(), std::memory_order_relaxed);
+      delete item;
+      item = next;
     }
-    scheduled_ = true;
-    return true;
   }
 
-  std::vector<buffer> output_{};
+  std::atomic<node*> head_{ nullptr };
+  std::atomic_bool scheduled_{ false };
+  std::atomic<std::size_t> queued_bytes_{ 0 };
   std::vector<buffer> writing_{};
-  bool scheduled_{ false };
-  std::mutex mutex_{};
 };
 } // namespace couchbase::core::io
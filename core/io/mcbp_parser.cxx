@@ -31,84 +31,103 @@
 namespace couchbase::core::io
 {
 auto
-mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
+mcbp_parser::next(mcbp_frame_view& frame) -> mcbp_parser::result
 {
   static const std::size_t header_size = 24;
-  if (buf.size() < header_size) {
+  if (bytes_to_parse() < header_size) {
     return result::need_data;
   }
-  std::memcpy(&msg.header, buf.data(), header_size);
-  std::uint32_t body_size = utils::byte_swap(msg.header.bodylen);
-  if (body_size > 0 && buf.size() - header_size < body_size) {
+  const std::byte* start = buf.data() + offset;
+  std::memcpy(&frame.header, start, header_size);
+  const std::uint32_t body_size = utils::byte_swap(frame.header.bodylen);
+  if (body_size > 0 && bytes_to_parse() - header_size < body_size) {
     return result::need_data;
   }
-  msg.body.clear();
-  msg.body.reserve(body_size);
-  std::uint32_t key_size = utils::byte_swap(msg.header.keylen);
-  std::uint32_t prefix_size = static_cast<std::uint32_t>(msg.header.extlen) + key_size;
-  if (msg.header.magic == static_cast<std::uint8_t>(protocol::magic::alt_client_response)) {
-    const std::uint8_t framing_extras_size = msg.header.keylen & 0xffU;
-    key_size = static_cast<std::uint32_t>(msg.header.keylen >> 8U);
+  std::uint32_t key_size = utils::byte_swap(frame.header.keylen);
+  std::uint32_t prefix_size = static_cast<std::uint32_t>(frame.header.extlen) + key_size;
+  if (frame.header.magic == static_cast<std::uint8_t>(protocol::magic::alt_client_response)) {
+    const std::uint8_t framing_extras_size = frame.header.keylen & 0xffU;
+    key_size = static_cast<std::uint32_t>(frame.header.keylen >> 8U);
     prefix_size = static_cast<std::uint32_t>(framing_extras_size) +
-                  static_cast<std::uint32_t>(msg.header.extlen) + key_size;
+                  static_cast<std::uint32_t>(frame.header.extlen) + key_size;
   }
   // The prefix (framing extras + extras + key) must lie within the body that
   // bodylen advertised. extlen and keylen are separate header fields from
   // bodylen, so a frame can claim prefix_size > body_size. Only body_size was
-  // checked against the buffer above; without this guard the inserts below read
-  // past the buffer and "body_size - prefix_size" underflows on the snappy path.
+  // checked against the buffer above; without this guard the spans below reach
+  // past the buffer and "body_size - prefix_size" underflows.
   if (prefix_size > body_size) {
     CB_LOG_WARNING("rejecting malformed frame: prefix_size ({}) exceeds body_size ({}), "
                    "magic={:x}, opcode={:x}, extlen={}, keylen={}",
                    prefix_size,
                    body_size,
-                   msg.header.magic,
-                   msg.header.opcode,
-                   msg.header.extlen,
+                   frame.header.magic,
+                   frame.header.opcode,
+                   frame.header.extlen,
                    key_size);
     reset();
     return result::failure;
   }
-  msg.body.insert(
-    msg.body.end(), buf.begin() + header_size, buf.begin() + header_size + prefix_size);
+  frame.prefix = { start + header_size, prefix_size };
+  frame.value = { start + header_size + prefix_size, body_size - prefix_size };
+  offset += header_size + body_size;
 
-  const bool is_compressed =
-    protocol::has_flag(static_cast<std::byte>(msg.header.datatype), protocol::datatype::snappy);
-  bool use_raw_value = true;
-  if (is_compressed) {
-    std::string uncompressed;
-    const std::size_t offset = header_size + prefix_size;
-    if (snappy::Uncompress(reinterpret_cast<const char*>(buf.data() + offset),
-                           body_size - prefix_size,
-                           &uncompressed)) {
-      msg.body.insert(msg.body.end(),
-                      reinterpret_cast<std::byte*>(uncompressed.data()),
-                      reinterpret_cast<std::byte*>(uncompressed.data() + uncompressed.size()));
-      use_raw_value = false;
-      // patch header with new body size
-      msg.header.bodylen =
-        utils::byte_swap(static_cast<std::uint32_t>(prefix_size + uncompressed.size()));
-    }
-  }
-  if (use_raw_value) {
-    msg.body.insert(msg.body.end(),
-                    buf.begin() + header_size + prefix_size,
-                    buf.begin() + header_size + body_size);
-  }
-  buf.erase(buf.begin(), buf.begin() + header_size + body_size);
-  if (!buf.empty() && !protocol::is_valid_magic(std::to_integer<std::uint8_t>(buf[0]))) {
+  if (offset < buf.size() &&
+      !protocol::is_valid_magic(std::to_integer<std::uint8_t>(buf[offset]))) {
     CB_LOG_WARNING("parsed frame for magic={:x}, opcode={:x}, opaque={}, body_len={}. Invalid "
                    "magic of the next frame: {:x}, {} "
                    "bytes to parse{}",
-                   msg.header.magic,
-                   msg.header.opcode,
-                   msg.header.opaque,
+                   frame.header.magic,
+                   frame.header.opcode,
+                   frame.header.opaque,
                    body_size,
-                   buf[0],
-                   buf.size(),
-                   spdlog::to_hex(buf));
-    reset();
+                   buf[offset],
+                   bytes_to_parse(),
+                   spdlog::to_hex(buf.begin() + static_cast<std::ptrdiff_t>(offset), buf.end()));
+    // Skip the rest of the input rather than clearing it, so that the frame handed out above
+    // stays valid.
+    offset = buf.size();
+  }
+  return result::ok;
+}
+
+auto
+mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
+{
+  mcbp_frame_view frame{};
+  if (auto rc = next(frame); rc != result::ok) {
+    return rc;
+  }
+  msg.header = frame.header;
+  msg.body.clear();
+
+  // A compressed value is inflated straight into msg.body (normally a buffer recycled from
+  // tls_response_body_pool() by the session), sized up front from the length snappy records in
+  // the stream, so the only copy of the value is the decompression itself.
+  const bool is_compressed =
+    protocol::has_flag(static_cast<std::byte>(msg.header.datatype), protocol::datatype::snappy);
+  std::size_t uncompressed_size{ 0 };
+  if (is_compressed &&
+      snappy::GetUncompressedLength(reinterpret_cast<const char*>(frame.value.data()),
+                                    frame.value.size(),
+                                    &uncompressed_size)) {
+    msg.body.resize(frame.prefix.size() + uncompressed_size);
+    std::copy(frame.prefix.begin(), frame.prefix.end(), msg.body.begin());
+    if (snappy::RawUncompress(reinterpret_cast<const char*>(frame.value.data()),
+                              frame.value.size(),
+                              reinterpret_cast<char*>(msg.body.data() + frame.prefix.size()))) {
+      compressed_bytes += frame.value.size();
+      decompressed_bytes += uncompressed_size;
+      // patch header with new body size
+      msg.header.bodylen = utils::byte_swap(static_cast<std::uint32_t>(msg.body.size()));
+      return result::ok;
+    }
+    msg.body.clear();
   }
+
+  msg.body.reserve(frame.prefix.size() + frame.value.size());
+  msg.body.insert(msg.body.end(), frame.prefix.begin(), frame.prefix.end());
+  msg.body.insert(msg.body.end(), frame.value.begin(), frame.value.end());
   return result::ok;
 }
 } // namespace couchbase::core::io
@@ -19,10 +19,33 @@
 
 #include "mcbp_message.hxx"
 
+#include <gsl/span>
+
+#include <cstdint>
 #include <iterator>
 
 namespace couchbase::core::io
 {
+/**
+ * A frame located in the parser's buffer. The spans point into mcbp_parser::buf and stay valid
+ * only until the next call to mcbp_parser::feed() or mcbp_parser::reset().
+ */
+struct mcbp_frame_view {
+  binary_header header{};
+  // framing extras + extras + key
+  gsl::span<const std::byte> prefix{};
+  // the value, still compressed when the datatype has the snappy flag
+  gsl::span<const std::byte> value{};
+};
+
+/**
+ * Splits the byte stream of a KV connection into frames.
+ *
+ * Parsed frames are not erased from the front of the buffer. Instead a read cursor moves past
+ * them, and the consumed bytes are dropped once per feed(), when only the tail of an incomplete
+ * frame (if any) has to be moved. A read that carries many small pipelined responses therefore
+ * costs a single pass over the buffer, rather than one memmove of the remainder per frame.
+ */
 struct mcbp_parser {
   enum class result {
     ok,
@@ -33,6 +56,7 @@ struct mcbp_parser {
   template<typename Iterator>
   void feed(Iterator begin, Iterator end)
   {
+    compact();
     buf.reserve(buf.size() + static_cast<std::size_t>(std::distance(begin, end)));
     buf.insert(buf.end(), begin, end);
   }
@@ -40,10 +64,45 @@ struct mcbp_parser {
   void reset()
   {
     buf.clear();
+    offset = 0;
   }
 
+  /**
+   * Locates the next complete frame without copying it.
+   */
+  auto next(mcbp_frame_view& frame) -> result;
+
+  /**
+   * Copies the next complete frame into @p msg, decompressing the value if necessary. The message
+   * owns its body and may outlive the parser's buffer.
+   */
   auto next(mcbp_message& msg) -> result;
 
+  [[nodiscard]] auto bytes_to_parse() const -> std::size_t
+  {
+    return buf.size() - offset;
+  }
+
   std::vector<std::byte> buf;
+  // read cursor: everything before it has already been parsed
+  std::size_t offset{ 0 };
+  // values inflated by next(mcbp_message&), before and after decompression (running totals, which
+  // reset() keeps)
+  std::uint64_t compressed_bytes{ 0 };
+  std::uint64_t decompressed_bytes{ 0 };
+
+private:
+  void compact()
+  {
+    if (offset == 0) {
+      return;
+    }
+    if (offset >= buf.size()) {
+      buf.clear();
+    } else {
+      buf.erase(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(offset));
+    }
+    offset = 0;
+  }
 };
 } // namespace couchbase::core::io
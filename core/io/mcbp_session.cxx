@@ -23,7 +23,9 @@
 #include "core/columnar/background_bootstrap_listener.hxx"
 #endif
 #include "configuration_belongs_to_session.hxx"
+#include "connection_counters.hxx"
 #include "opaque_ring_table.hxx"
+#include "opaque_slab.hxx"
 
 #include "core/app_telemetry_meter.hxx"
 #include "core/config_listener.hxx"
@@ -70,7 +72,9 @@
 #include <spdlog/fmt/bin_to_hex.h>
 #include <spdlog/fmt/chrono.h>
 
+#include <algorithm>
 #include <cstring>
+#include <tuple>
 #include <utility>
 
 namespace
@@ -189,33 +193,10 @@ struct connection_endpoints {
   std::string local_address_with_port{};
 };
 
-class collection_cache
+namespace
 {
-private:
-  std::map<std::string, std::uint32_t> cid_map_{ { "_default._default", 0 } };
-
-public:
-  [[nodiscard]] auto get(const std::string& path) -> std::optional<std::uint32_t>
-  {
-    Expects(!path.empty());
-    if (auto ptr = cid_map_.find(path); ptr != cid_map_.end()) {
-      return ptr->second;
-    }
-    return std::nullopt;
-  }
-
-  void update(const std::string& path, std::uint32_t id)
-  {
-    Expects(!path.empty());
-    cid_map_[path] = id;
-  }
-
-  void reset()
-  {
-    cid_map_.clear();
-    cid_map_["_default._default"] = 0;
-  }
-};
+thread_local mcbp_write_batch* current_write_batch{ nullptr };
+} // namespace
 
 class mcbp_session_impl
   : public std::enable_shared_from_this<mcbp_session_impl>
@@ -971,6 +952,39 @@ public:
              bucket_name_ };
   }
 
+  [[nodiscard]] auto connection_stats() const -> diag::endpoint_connection_stats
+  {
+    diag::endpoint_connection_stats stats{};
+    stats.type = service_type::key_value;
+    stats.id = id_;
+    stats.remote = remote_address();
+    stats.local = local_address();
+    stats.state = state_;
+    stats.bucket = bucket_name_;
+    counters_.export_to(stats);
+    {
+      const std::scoped_lock lock(command_handlers_mutex_);
+      stats.in_flight += command_handlers_.size();
+      stats.opaque_overflow_spills += command_handlers_.overflow_spills();
+    }
+    {
+      const std::scoped_lock lock(operations_mutex_);
+      stats.in_flight += operations_.size();
+      stats.opaque_overflow_spills += operations_.overflow_spills();
+    }
+    stats.write_queue_bytes = output_queue_.queued_bytes();
+    stats.parser_buffered_bytes = parser_buffered_bytes_.load(std::memory_order_relaxed);
+    stats.compressed_bytes_received = compressed_bytes_received_.load(std::memory_order_relaxed);
+    stats.decompressed_bytes_received =
+      decompressed_bytes_received_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  void record_retry()
+  {
+    connection_counters::add(counters_.retries);
+  }
+
   auto sasl_mechanisms() -> std::vector<std::string>
   {
     auto credentials = origin_.credentials();
@@ -1456,8 +1470,12 @@ public:
       }
     }
     {
-      const std::scoped_lock lock(operations_mutex_);
-      auto operations = std::move(operations_);
+      std::vector<std::pair<std::uint32_t, pending_operation>> operations{};
+      {
+        const std::scoped_lock lock(operations_mutex_);
+        operations = operations_.drain();
+      }
+      // the handlers may cancel requests, which calls back into remove_request()
       for (auto& [opaque, operation] : operations) {
         auto& [request, handler] = operation;
         if (handler) {
@@ -1469,7 +1487,6 @@ public:
             std::move(request), io::mcbp_session(shared_from_this()), ec, reason, {}, {});
         }
       }
-      operations_.clear();
     }
     {
       const std::scoped_lock lock(session_info_mutex_);
@@ -1510,13 +1527,24 @@ public:
   }
 
   void write_and_flush(std::vector<std::byte>&& buf)
+  {
+    write_and_flush(std::move(buf), {});
+  }
+
+  // Writes a frame followed by a value kept in its own buffer (see client_request::gathered_data).
+  void write_and_flush(std::vector<std::byte>&& buf, std::vector<std::byte>&& value)
   {
     if (stopped_) {
       return;
     }
     CB_LOG_TRACE("{} MCBP send {}", log_prefix_, mcbp_header_view(buf));
+    if (auto* batch = mcbp_write_batch::current(); batch != nullptr) {
+      // the batch flushes this session once the caller has sent the rest of its operations
+      output_queue_.stage(std::move(buf), std::move(value));
+      return batch->add(shared_from_this());
+    }
     // Stage the buffer and post do_write only on the idle -> scheduled transition (single lock).
-    if (output_queue_.enqueue(std::move(buf))) {
+    if (output_queue_.enqueue(std::move(buf), std::move(value))) {
       asio::post(asio::bind_executor(ctx_, [self = shared_from_this()]() {
         self->do_write();
       }));
@@ -1525,9 +1553,13 @@ public:
 
   void remove_request(std::shared_ptr<mcbp::queue_request> request) override
   {
-    const std::scoped_lock lock(operations_mutex_);
-    if (auto iter = operations_.find(request->opaque_); iter != operations_.end()) {
-      operations_.erase(iter);
+    pending_operation removed{};
+    {
+      const std::scoped_lock lock(operations_mutex_);
+      if (auto* operation = operations_.find(request->opaque_);
+          operation != nullptr && operation->first == request) {
+        removed = operations_.take(request->opaque_);
+      }
     }
   }
 
@@ -1537,7 +1569,7 @@ public:
   {
     const std::scoped_lock lock(operations_mutex_);
     request->waiting_in_ = this;
-    operations_.try_emplace(opaque, request, handler);
+    operations_.insert(opaque, { request, handler });
   }
 
   auto handle_request(protocol::client_opcode opcode,
@@ -1568,11 +1600,11 @@ public:
     std::shared_ptr<response_handler> handler{};
     {
       const std::scoped_lock lock(operations_mutex_);
-      if (auto pair = operations_.find(opaque); pair != operations_.end() && pair->second.first) {
-        request = pair->second.first;
-        handler = pair->second.second;
-        if (!request->persistent_) {
-          operations_.erase(pair);
+      if (auto* operation = operations_.find(opaque); operation != nullptr && operation->first) {
+        if (operation->first->persistent_) {
+          std::tie(request, handler) = *operation;
+        } else {
+          std::tie(request, handler) = operations_.take(opaque);
         }
       }
     }
@@ -1611,6 +1643,7 @@ public:
       return;
     }
     enqueue_request(opaque, request, handler);
+    connection_counters::add(counters_.requests_sent);
     if (bootstrapped_ && stream_->is_open()) {
       write_and_flush(std::move(data.value()));
     } else {
@@ -1629,6 +1662,14 @@ public:
   void write_and_subscribe(std::uint32_t opaque,
                            std::vector<std::byte>&& data,
                            command_handler&& handler)
+  {
+    write_and_subscribe(opaque, std::move(data), {}, std::move(handler));
+  }
+
+  void write_and_subscribe(std::uint32_t opaque,
+                           std::vector<std::byte>&& data,
+                           std::vector<std::byte>&& value,
+                           command_handler&& handler)
   {
     if (stopped_) {
       CB_LOG_WARNING("{} MCBP cancel operation, while trying to write to closed session, opaque={}",
@@ -1641,17 +1682,20 @@ public:
       const std::scoped_lock lock(command_handlers_mutex_);
       command_handlers_.insert(opaque, std::move(handler));
     }
+    connection_counters::add(counters_.requests_sent);
     if (bootstrapped_ && stream_->is_open()) {
-      write_and_flush(std::move(data));
+      write_and_flush(std::move(data), std::move(value));
     } else {
       CB_LOG_DEBUG("{} the stream is not ready yet, put the message into pending buffer, opaque={}",
                    log_prefix_,
                    opaque);
       const std::scoped_lock lock(pending_buffer_mutex_);
       if (bootstrapped_ && stream_->is_open()) {
-        write_and_flush(std::move(data));
+        write_and_flush(std::move(data), std::move(value));
       } else {
-        pending_buffer_.emplace_back(data);
+        // rare enough to not bother keeping the value apart until the session is bootstrapped
+        data.insert(data.end(), value.begin(), value.end());
+        pending_buffer_.emplace_back(std::move(data));
       }
     }
   }
@@ -1899,19 +1943,6 @@ public:
     }
   }
 
-  auto get_collection_uid(const std::string& collection_path) -> std::optional<std::uint32_t>
-  {
-    return collection_cache_.get(collection_path);
-  }
-
-  void update_collection_uid(const std::string& path, std::uint32_t uid)
-  {
-    if (stopped_) {
-      return;
-    }
-    collection_cache_.update(path, uid);
-  }
-
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
   void add_background_bootstrap_listener(
     std::shared_ptr<columnar::background_bootstrap_listener> listener)
@@ -2208,6 +2239,7 @@ private:
                        ec.message());
           return self->stop(retry_reason::socket_closed_while_in_flight);
         }
+        connection_counters::add(self->counters_.bytes_received, bytes_transferred);
         self->parser_.feed(self->input_buffer_.data(),
                            self->input_buffer_.data() +
                              static_cast<std::ptrdiff_t>(bytes_transferred));
@@ -2225,6 +2257,7 @@ private:
               }
               CB_LOG_TRACE(
                 "{} MCBP recv {}", self->log_prefix_, mcbp_header_view(msg.header_data()));
+              connection_counters::add(self->counters_.responses_received);
               // Copy the handler's shared_ptr into a local before dispatching.
               // handle() can trigger a nested stop() (e.g. reauth failure) that
               // releases the session's own strong ref to the handler; the local
@@ -2245,6 +2278,7 @@ private:
               // The frame is incomplete, so next() did not consume the buffer we handed it; return
               // it to the pool instead of letting this partial-read iteration drain the pool.
               tls_response_body_pool().release(std::move(msg.body));
+              self->publish_parser_stats();
               self->reading_ = false;
               if (!self->stopped_ && self->stream_->is_open()) {
                 self->do_read();
@@ -2257,6 +2291,15 @@ private:
       });
   }
 
+  // The parser is only touched on the IO thread, so its numbers are copied out for
+  // connection_stats() once a read has been consumed.
+  void publish_parser_stats()
+  {
+    parser_buffered_bytes_.store(parser_.bytes_to_parse(), std::memory_order_relaxed);
+    compressed_bytes_received_.store(parser_.compressed_bytes, std::memory_order_relaxed);
+    decompressed_bytes_received_.store(parser_.decompressed_bytes, std::memory_order_relaxed);
+  }
+
   void do_write()
   {
     if (stopped_ || !stream_->is_open()) {
@@ -2288,6 +2331,7 @@ private:
           return;
         }
         self->last_active_ = std::chrono::steady_clock::now();
+        connection_counters::add(self->counters_.bytes_sent, bytes_transferred);
 
         if (ec) {
           CB_LOG_ERROR(R"({} IO error while writing to the socket("{}"): {} ({}))",
@@ -2326,7 +2370,7 @@ private:
   std::shared_ptr<message_handler> handler_{ nullptr };
   utils::movable_function<void(std::error_code, const topology::configuration&)>
     bootstrap_callback_{};
-  std::mutex command_handlers_mutex_{};
+  mutable std::mutex command_handlers_mutex_{};
   opaque_ring_table<command_handler> command_handlers_{};
   std::vector<std::shared_ptr<config_listener>> config_listeners_{};
   utils::movable_function<void()> on_stop_handler_{};
@@ -2357,7 +2401,6 @@ private:
   mutable std::mutex config_mutex_{};
   std::atomic_bool configured_{ false };
   std::optional<error_map> error_map_;
-  collection_cache collection_cache_;
 
   // Only used for tracing & metrics. They represent the address of the node as given in the config.
   std::string canonical_hostname_{};
@@ -2367,16 +2410,20 @@ private:
   std::shared_ptr<impl::bootstrap_state_listener> state_listener_{ nullptr };
 
   mcbp::codec codec_;
-  std::recursive_mutex operations_mutex_{};
-  std::map<std::uint32_t,
-           std::pair<std::shared_ptr<mcbp::queue_request>, std::shared_ptr<response_handler>>>
-    operations_{};
+  using pending_operation =
+    std::pair<std::shared_ptr<mcbp::queue_request>, std::shared_ptr<response_handler>>;
+  mutable std::mutex operations_mutex_{};
+  opaque_slab<pending_operation> operations_{};
 
   std::atomic_bool reading_{ false };
 
   std::string log_prefix_{};
   std::chrono::time_point<std::chrono::steady_clock> last_active_{};
   std::atomic<diag::endpoint_state> state_{ diag::endpoint_state::disconnected };
+  connection_counters counters_{};
+  std::atomic<std::size_t> parser_buffered_bytes_{ 0 };
+  std::atomic<std::uint64_t> compressed_bytes_received_{ 0 };
+  std::atomic<std::uint64_t> decompressed_bytes_received_{ 0 };
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
   std::shared_ptr<columnar::background_bootstrap_listener> background_bootstrap_listener_{
     nullptr
@@ -2455,12 +2502,6 @@ mcbp_session::next_opaque() -> std::uint32_t
   return impl_->next_opaque();
 }
 
-auto
-mcbp_session::get_collection_uid(const std::string& collection_path) -> std::optional<std::uint32_t>
-{
-  return impl_->get_collection_uid(collection_path);
-}
-
 auto
 mcbp_session::context() const -> mcbp_context
 {
@@ -2573,6 +2614,15 @@ mcbp_session::write_and_subscribe(std::uint32_t opaque,
   return impl_->write_and_subscribe(opaque, std::move(data), std::move(handler));
 }
 
+void
+mcbp_session::write_and_subscribe(std::uint32_t opaque,
+                                  std::vector<std::byte>&& data,
+                                  std::vector<std::byte>&& value,
+                                  command_handler&& handler)
+{
+  return impl_->write_and_subscribe(opaque, std::move(data), std::move(value), std::move(handler));
+}
+
 void
 mcbp_session::bootstrap(
   utils::movable_function<void(std::error_code, topology::configuration)>&& handler,
@@ -2629,6 +2679,18 @@ mcbp_session::diag_info() const -> diag::endpoint_diag_info
   return impl_->diag_info();
 }
 
+auto
+mcbp_session::connection_stats() const -> diag::endpoint_connection_stats
+{
+  return impl_->connection_stats();
+}
+
+void
+mcbp_session::record_retry()
+{
+  return impl_->record_retry();
+}
+
 void
 mcbp_session::on_configuration_update(std::shared_ptr<config_listener> handler)
 {
@@ -2666,12 +2728,6 @@ mcbp_session::handle_not_my_vbucket(const mcbp_message& msg) const
   return impl_->handle_not_my_vbucket(msg);
 }
 
-void
-mcbp_session::update_collection_uid(const std::string& path, std::uint32_t uid)
-{
-  return impl_->update_collection_uid(path, uid);
-}
-
 void
 mcbp_session::write_and_subscribe(const std::shared_ptr<mcbp::queue_request>& request,
                                   const std::shared_ptr<response_handler>& handler)
@@ -2694,4 +2750,36 @@ mcbp_session::add_background_bootstrap_listener(
 }
 #endif
 
+mcbp_write_batch::mcbp_write_batch()
+  : outermost_{ current_write_batch == nullptr }
+{
+  if (outermost_) {
+    current_write_batch = this;
+  }
+}
+
+mcbp_write_batch::~mcbp_write_batch()
+{
+  if (!outermost_) {
+    return;
+  }
+  current_write_batch = nullptr;
+  for (const auto& session : sessions_) {
+    session->flush();
+  }
+}
+
+auto
+mcbp_write_batch::current() -> mcbp_write_batch*
+{
+  return current_write_batch;
+}
+
+void
+mcbp_write_batch::add(std::shared_ptr<mcbp_session_impl> session)
+{
+  if (std::find(sessions_.begin(), sessions_.end(), session) == sessions_.end()) {
+    sessions_.emplace_back(std::move(session));
+  }
+}
 } // namespace couchbase::core::io
@@ -132,8 +132,6 @@ public:
   [[nodiscard]] auto is_stopped() const -> bool;
   [[nodiscard]] auto is_bootstrapped() const -> bool;
   [[nodiscard]] auto next_opaque() -> std::uint32_t;
-  [[nodiscard]] auto get_collection_uid(const std::string& collection_path)
-    -> std::optional<std::uint32_t>;
   [[nodiscard]] auto context() const -> mcbp_context;
   [[nodiscard]] auto supports_feature(protocol::hello_feature feature) -> bool;
   [[nodiscard]] auto supported_features() const -> std::vector<protocol::hello_feature>;
@@ -162,6 +160,10 @@ public:
   void write_and_subscribe(std::uint32_t opaque,
                            std::vector<std::byte>&& data,
                            command_handler&& handler);
+  void write_and_subscribe(std::uint32_t opaque,
+                           std::vector<std::byte>&& data,
+                           std::vector<std::byte>&& value,
+                           command_handler&& handler);
   void bootstrap(utils::movable_function<void(std::error_code, topology::configuration)>&& handler,
                  bool retry_on_bucket_not_found = false);
   void reauthenticate();
@@ -172,6 +174,8 @@ public:
   [[nodiscard]] auto has_config() const -> bool;
   [[nodiscard]] auto config() const -> std::optional<topology::configuration>;
   [[nodiscard]] auto diag_info() const -> diag::endpoint_diag_info;
+  [[nodiscard]] auto connection_stats() const -> diag::endpoint_connection_stats;
+  void record_retry();
   void on_configuration_update(std::shared_ptr<config_listener> handler);
   void ping(const std::shared_ptr<diag::ping_reporter>& handler,
             std::optional<std::chrono::milliseconds> timeout = {}) const;
@@ -179,7 +183,6 @@ public:
   [[nodiscard]] auto decode_error_code(std::uint16_t code)
     -> std::optional<key_value_error_map_info>;
   void handle_not_my_vbucket(const io::mcbp_message& msg) const;
-  void update_collection_uid(const std::string& path, std::uint32_t uid);
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
   void add_background_bootstrap_listener(
     std::shared_ptr<columnar::background_bootstrap_listener> listener);
@@ -188,5 +191,39 @@ public:
 private:
   std::shared_ptr<mcbp_session_impl> impl_{ nullptr };
 };
+
+/**
+ * While alive, holds back the socket writes of the KV operations that the current thread sends,
+ * and flushes every session they went to when destroyed. Operations dispatched in a loop under
+ * one batch therefore leave in one write per connection, instead of the first one going out alone
+ * while the others queue up behind it.
+ *
+ * Only the outermost batch of a thread has an effect. Operations that cannot be sent right away
+ * (e.g. before the bucket is configured) are written as usual whenever they are sent.
+ */
+class mcbp_write_batch
+{
+public:
+  mcbp_write_batch();
+  ~mcbp_write_batch();
+  mcbp_write_batch(const mcbp_write_batch& other) = delete;
+  auto operator=(const mcbp_write_batch& other) -> mcbp_write_batch& = delete;
+  mcbp_write_batch(mcbp_write_batch&& other) = delete;
+  auto operator=(mcbp_write_batch&& other) -> mcbp_write_batch& = delete;
+
+  /**
+   * The batch of the current thread, or nullptr.
+   */
+  [[nodiscard]] static auto current() -> mcbp_write_batch*;
+
+  /**
+   * Remembers a session that has writes staged, so that it is flushed with the batch.
+   */
+  void add(std::shared_ptr<mcbp_session_impl> session);
+
+private:
+  bool outermost_;
+  std::vector<std::shared_ptr<mcbp_session_impl>> sessions_{};
+};
 } // namespace io
 } // namespace couchbase::core
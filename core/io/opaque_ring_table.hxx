@@ -70,6 +70,19 @@ public:
   // the sole remaining owners, hence [[nodiscard]].
   [[nodiscard]] auto drain() -> std::vector<std::pair<std::uint32_t, Handler>>;
 
+  // Number of registered handlers, in the ring and in the overflow map.
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return size_;
+  }
+
+  // Number of inserts that spilled to the overflow map since the table was created. A growing
+  // value means that operations stay in flight for longer than a lap of the ring.
+  [[nodiscard]] auto overflow_spills() const -> std::uint64_t
+  {
+    return overflow_spills_;
+  }
+
 private:
   static constexpr std::size_t ring_size = 512;
   static constexpr std::uint32_t ring_mask = ring_size - 1;
@@ -84,6 +97,8 @@ private:
 
   std::array<slot, ring_size> ring_{};
   std::unordered_map<std::uint32_t, Handler> overflow_{};
+  std::size_t size_{ 0 };
+  std::uint64_t overflow_spills_{ 0 };
 };
 
 template<typename Handler>
@@ -95,13 +110,17 @@ opaque_ring_table<Handler>::insert(std::uint32_t opaque, Handler&& handler)
     s.opaque = opaque;
     s.occupied = true;
     s.handler = std::move(handler);
+    ++size_;
     return;
   }
   if (s.opaque == opaque) {
     return; // keep the existing handler (not expected under the unique-opaque precondition)
   }
   // the slot is held by a different in-flight opaque (ring collision) — spill to the overflow map
-  overflow_.try_emplace(opaque, std::move(handler));
+  if (overflow_.try_emplace(opaque, std::move(handler)).second) {
+    ++size_;
+    ++overflow_spills_;
+  }
 }
 
 template<typename Handler>
@@ -113,11 +132,13 @@ opaque_ring_table<Handler>::take(std::uint32_t opaque) -> Handler
     Handler h = std::move(s.handler);
     s.handler = Handler{};
     s.occupied = false;
+    --size_;
     return h;
   }
   if (auto it = overflow_.find(opaque); it != overflow_.end()) {
     Handler h = std::move(it->second);
     overflow_.erase(it);
+    --size_;
     return h;
   }
   return Handler{};
@@ -140,6 +161,7 @@ opaque_ring_table<Handler>::drain() -> std::vector<std::pair<std::uint32_t, Hand
     result.emplace_back(opaque, std::move(h));
   }
   overflow_.clear();
+  size_ = 0;
   return result;
 }
 } // namespace couchbase::core::io
@@ -0,0 +1,180 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Maps the opaque of an in-flight operation to its entry in a flat, preallocated array of slots,
+ * indexed by `opaque & mask`.
+ *
+ * Opaques come from a per-session counter, so the bits above the mask act as a generation: a slot
+ * is reused by a later opaque only after the previous one has left, and a lookup checks the full
+ * opaque, so a stale opaque never reaches the entry that took its slot. When a new opaque lands on
+ * a slot that is still held (an operation kept open across a full lap of the slab, or a persistent
+ * one), it spills to an overflow map, like in opaque_ring_table. The slab never grows: its size is
+ * fixed at construction and capped at `max_capacity`, so a slot held for the whole life of the
+ * session costs one map entry per lap. Insert, find and take allocate only when they spill.
+ *
+ * Precondition: an opaque is unique while it is in flight.
+ *
+ * Not thread-safe: callers serialize access.
+ */
+template<typename Entry>
+class opaque_slab
+{
+public:
+  static constexpr std::size_t initial_capacity = 1024;
+  static constexpr std::size_t max_capacity = 65536;
+
+  explicit opaque_slab(std::size_t capacity = initial_capacity)
+  {
+    std::size_t size = 1;
+    while (size < capacity && size < max_capacity) {
+      size <<= 1U;
+    }
+    slots_.resize(size);
+  }
+
+  void insert(std::uint32_t opaque, Entry&& entry)
+  {
+    auto& s = slots_[index(opaque)];
+    if (!s.occupied) {
+      s.opaque = opaque;
+      s.occupied = true;
+      s.entry = std::move(entry);
+      ++size_;
+      return;
+    }
+    // the slot is held by a different in-flight opaque -- spill to the overflow map
+    if (overflow_.try_emplace(opaque, std::move(entry)).second) {
+      ++size_;
+      ++overflow_spills_;
+    }
+  }
+
+  /**
+   * The entry of @p opaque, or nullptr. The pointer is valid until the entry is taken.
+   */
+  [[nodiscard]] auto find(std::uint32_t opaque) -> Entry*
+  {
+    auto& s = slots_[index(opaque)];
+    if (s.occupied && s.opaque == opaque) {
+      return &s.entry;
+    }
+    if (overflow_.empty()) {
+      return nullptr;
+    }
+    if (auto it = overflow_.find(opaque); it != overflow_.end()) {
+      return &it->second;
+    }
+    return nullptr;
+  }
+
+  /**
+   * Remove and return the entry of @p opaque, or a default-constructed entry if absent.
+   */
+  [[nodiscard]] auto take(std::uint32_t opaque) -> Entry
+  {
+    auto& s = slots_[index(opaque)];
+    if (s.occupied && s.opaque == opaque) {
+      s.occupied = false;
+      --size_;
+      return std::exchange(s.entry, Entry{});
+    }
+    if (overflow_.empty()) {
+      return Entry{};
+    }
+    if (auto it = overflow_.find(opaque); it != overflow_.end()) {
+      Entry entry = std::move(it->second);
+      overflow_.erase(it);
+      --size_;
+      return entry;
+    }
+    return Entry{};
+  }
+
+  /**
+   * Move out every (opaque, entry) pair and leave the slab empty, keeping its capacity.
+   */
+  [[nodiscard]] auto drain() -> std::vector<std::pair<std::uint32_t, Entry>>
+  {
+    std::vector<std::pair<std::uint32_t, Entry>> result;
+    result.reserve(size_);
+    for (auto& s : slots_) {
+      if (s.occupied) {
+        s.occupied = false;
+        result.emplace_back(s.opaque, std::exchange(s.entry, Entry{}));
+      }
+    }
+    for (auto& [opaque, entry] : overflow_) {
+      result.emplace_back(opaque, std::move(entry));
+    }
+    overflow_.clear();
+    size_ = 0;
+    return result;
+  }
+
+  /**
+   * Number of entries, in the slots and in the overflow map.
+   */
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return size_;
+  }
+
+  /**
+   * Number of slots. It does not change after construction.
+   */
+  [[nodiscard]] auto capacity() const -> std::size_t
+  {
+    return slots_.size();
+  }
+
+  /**
+   * Number of inserts that spilled to the overflow map since the slab was created.
+   */
+  [[nodiscard]] auto overflow_spills() const -> std::uint64_t
+  {
+    return overflow_spills_;
+  }
+
+private:
+  struct slot {
+    std::uint32_t opaque{ 0 };
+    bool occupied{ false };
+    Entry entry{};
+  };
+
+  [[nodiscard]] auto index(std::uint32_t opaque) const -> std::size_t
+  {
+    return opaque & (slots_.size() - 1);
+  }
+
+  std::vector<slot> slots_{};
+  std::unordered_map<std::uint32_t, Entry> overflow_{};
+  std::size_t size_{ 0 };
+  std::uint64_t overflow_spills_{ 0 };
+};
+} // namespace couchbase::core::io
@@ -0,0 +1,254 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "query_cache.hxx"
+
+#include "core/metrics/constants.hxx"
+#include "core/metrics/meter_wrapper.hxx"
+#include "core/tracing/constants.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace couchbase::core
+{
+namespace
+{
+void
+record(const std::shared_ptr<couchbase::metrics::value_recorder>& recorder, std::size_t value)
+{
+  if (recorder && value > 0) {
+    recorder->record_value(static_cast<std::int64_t>(value));
+  }
+}
+} // namespace
+
+query_cache::query_cache(std::size_t capacity)
+  : capacity_{ std::max<std::size_t>(capacity, 1) }
+{
+}
+
+void
+query_cache::set_capacity(std::size_t capacity)
+{
+  capacity = std::max<std::size_t>(capacity, 1);
+  std::array<std::unique_lock<std::mutex>, number_of_shards> locks{};
+  for (std::size_t i = 0; i < number_of_shards; ++i) {
+    locks[i] = std::unique_lock(shards_[i].mutex);
+  }
+  const auto old_shards = shards_in_use(capacity_.load(std::memory_order_relaxed));
+  const auto new_shards = shards_in_use(capacity);
+  capacity_.store(capacity, std::memory_order_relaxed);
+
+  if (old_shards != new_shards) {
+    // move the statements to their new shards, behind the ones already there
+    for (std::size_t i = 0; i < old_shards; ++i) {
+      auto& from = shards_[i];
+      for (auto node = from.lru.begin(); node != from.lru.end();) {
+        const auto index = std::hash<std::string>{}(node->first) % new_shards;
+        auto next = std::next(node);
+        if (index != i) {
+          auto& to = shards_[index];
+          from.index.erase(node->first);
+          to.lru.splice(to.lru.end(), from.lru, node);
+          to.index.emplace(node->first, node);
+        }
+        node = next;
+      }
+    }
+  }
+
+  std::size_t evicted{ 0 };
+  for (std::size_t i = 0; i < number_of_shards; ++i) {
+    evicted += trim(shards_[i], shard_capacity(capacity, i));
+  }
+  for (auto& lock : locks) {
+    lock.unlock();
+  }
+  if (auto r = std::atomic_load(&recorders_); r) {
+    record(r->evictions, evicted);
+  }
+}
+
+void
+query_cache::set_meter(const std::shared_ptr<metrics::meter_wrapper>& meter)
+{
+  if (!meter) {
+    return;
+  }
+  auto wrapped = meter->wrapped();
+  const std::map<std::string, std::string> tags{
+    { tracing::attributes::common::system, "couchbase" },
+    { tracing::attributes::op::service, tracing::service::query },
+  };
+  auto next = std::make_shared<recorders>(recorders{
+    wrapped->get_value_recorder(metrics::query_cache_hit_meter_name, tags),
+    wrapped->get_value_recorder(metrics::query_cache_miss_meter_name, tags),
+    wrapped->get_value_recorder(metrics::query_cache_eviction_meter_name, tags),
+  });
+  std::atomic_store(&recorders_, std::shared_ptr<const recorders>{ std::move(next) });
+}
+
+void
+query_cache::erase(const std::string& statement)
+{
+  auto locked = lock_shard_for(statement);
+  auto& s = locked.s;
+  if (auto it = s.index.find(statement); it != s.index.end()) {
+    auto node = it->second;
+    s.index.erase(it);
+    s.lru.erase(node);
+  }
+}
+
+void
+query_cache::put(const std::string& statement, const std::string& prepared)
+{
+  insert(statement, entry{ prepared });
+}
+
+void
+query_cache::put(const std::string& statement,
+                 const std::string& name,
+                 const std::string& encoded_plan)
+{
+  insert(statement, entry{ name, encoded_plan });
+}
+
+auto
+query_cache::get(const std::string& statement) -> std::optional<entry>
+{
+  std::optional<entry> result{};
+  {
+    auto locked = lock_shard_for(statement);
+    auto& s = locked.s;
+    if (auto it = s.index.find(statement); it != s.index.end()) {
+      s.lru.splice(s.lru.begin(), s.lru, it->second);
+      result = it->second->second;
+    }
+  }
+  const auto r = std::atomic_load(&recorders_);
+  if (result) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    if (r) {
+      record(r->hits, 1);
+    }
+  } else {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    if (r) {
+      record(r->misses, 1);
+    }
+  }
+  return result;
+}
+
+auto
+query_cache::capacity() const -> std::size_t
+{
+  return capacity_.load(std::memory_order_relaxed);
+}
+
+auto
+query_cache::size() const -> std::size_t
+{
+  std::size_t total{ 0 };
+  for (const auto& s : shards_) {
+    const std::scoped_lock lock(s.mutex);
+    total += s.lru.size();
+  }
+  return total;
+}
+
+auto
+query_cache::stats() const -> counters
+{
+  return {
+    hits_.load(std::memory_order_relaxed),
+    misses_.load(std::memory_order_relaxed),
+    evictions_.load(std::memory_order_relaxed),
+  };
+}
+
+auto
+query_cache::shards_in_use(std::size_t capacity) -> std::size_t
+{
+  return std::min(capacity, number_of_shards);
+}
+
+auto
+query_cache::shard_capacity(std::size_t capacity, std::size_t index) -> std::size_t
+{
+  const auto shards = shards_in_use(capacity);
+  if (index >= shards) {
+    return 0;
+  }
+  return capacity / shards + (index < capacity % shards ? 1 : 0);
+}
+
+auto
+query_cache::lock_shard_for(const std::string& statement) -> locked_shard
+{
+  const auto hash = std::hash<std::string>{}(statement);
+  while (true) {
+    const auto capacity = capacity_.load(std::memory_order_relaxed);
+    const auto index = hash % shards_in_use(capacity);
+    std::unique_lock lock(shards_[index].mutex);
+    if (capacity_.load(std::memory_order_relaxed) == capacity) {
+      return { shards_[index], std::move(lock), shard_capacity(capacity, index) };
+    }
+  }
+}
+
+void
+query_cache::insert(const std::string& statement, entry&& value)
+{
+  std::size_t evicted{ 0 };
+  {
+    auto locked = lock_shard_for(statement);
+    auto& s = locked.s;
+    if (auto it = s.index.find(statement); it != s.index.end()) {
+      // keep the entry that is already there, like the statement was just used
+      s.lru.splice(s.lru.begin(), s.lru, it->second);
+      return;
+    }
+    evicted = trim(s, locked.capacity - 1);
+    s.lru.emplace_front(statement, std::move(value));
+    s.index.emplace(s.lru.front().first, s.lru.begin());
+  }
+  if (auto r = std::atomic_load(&recorders_); r) {
+    record(r->evictions, evicted);
+  }
+}
+
+auto
+query_cache::trim(shard& s, std::size_t keep) -> std::size_t
+{
+  std::size_t evicted{ 0 };
+  while (s.lru.size() > keep) {
+    s.index.erase(s.lru.back().first);
+    s.lru.pop_back();
+    ++evicted;
+  }
+  evictions_.fetch_add(evicted, std::memory_order_relaxed);
+  return evicted;
+}
+} // namespace couchbase::core
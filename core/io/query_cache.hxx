@@ -17,13 +17,42 @@
 
 #pragma once
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace couchbase::metrics
+{
+class value_recorder;
+} // namespace couchbase::metrics
 
 namespace couchbase::core
 {
+namespace metrics
+{
+class meter_wrapper;
+} // namespace metrics
+
+/**
+ * Prepared statements of the query service, keyed by the statement text.
+ *
+ * The cache is split into shards by the hash of the statement, each with its own lock and its own
+ * least-recently-used list, so concurrent queries rarely contend and a lookup is a hash probe
+ * rather than a walk of an ordered tree. Once a shard holds its share of the capacity, adding a
+ * statement evicts the one that was used least recently in that shard.
+ *
+ * The shares add up to the capacity exactly. A capacity below the number of shards uses only that
+ * many shards, with one statement each.
+ */
 class query_cache
 {
 public:
@@ -32,40 +61,83 @@ public:
     std::optional<std::string> plan{};
   };
 
-  void erase(const std::string& statement)
-  {
-    std::scoped_lock lock(store_mutex_);
-    auto it = store_.find(statement);
-    if (it == store_.end()) {
-      return;
-    }
-    store_.erase(it);
-  }
-
-  void put(const std::string& statement, const std::string& prepared)
-  {
-    std::scoped_lock lock(store_mutex_);
-    store_.try_emplace(statement, entry{ prepared });
-  }
-
-  void put(const std::string& statement, const std::string& name, const std::string& encoded_plan)
-  {
-    std::scoped_lock lock(store_mutex_);
-    store_.try_emplace(statement, entry{ name, encoded_plan });
-  }
-
-  auto get(const std::string& statement) -> std::optional<entry>
-  {
-    std::scoped_lock lock(store_mutex_);
-    auto it = store_.find(statement);
-    if (it == store_.end()) {
-      return {};
-    }
-    return it->second;
-  }
+  struct counters {
+    std::uint64_t hits{ 0 };
+    std::uint64_t misses{ 0 };
+    std::uint64_t evictions{ 0 };
+  };
+
+  static constexpr std::size_t default_capacity{ 5000 };
+
+  explicit query_cache(std::size_t capacity = default_capacity);
+
+  /**
+   * Changes the maximum number of statements, evicting the least recently used ones if the cache
+   * holds more than that. Zero is treated as one.
+   */
+  void set_capacity(std::size_t capacity);
+
+  /**
+   * Reports hits, misses and evictions to the meter. Every hit or miss records the value 1, and
+   * every insert or resize that evicts statements records how many it evicted. The meter may be
+   * replaced while queries run.
+   */
+  void set_meter(const std::shared_ptr<metrics::meter_wrapper>& meter);
+
+  void erase(const std::string& statement);
+  void put(const std::string& statement, const std::string& prepared);
+  void put(const std::string& statement, const std::string& name, const std::string& encoded_plan);
+  auto get(const std::string& statement) -> std::optional<entry>;
+
+  [[nodiscard]] auto capacity() const -> std::size_t;
+  [[nodiscard]] auto size() const -> std::size_t;
+  [[nodiscard]] auto stats() const -> counters;
 
 private:
-  std::map<std::string, entry> store_;
-  std::mutex store_mutex_{};
+  static constexpr std::size_t number_of_shards{ 16 };
+
+  struct shard {
+    mutable std::mutex mutex{};
+    // most recently used first
+    std::list<std::pair<std::string, entry>> lru{};
+    // the keys are views of the statements stored in lru, whose nodes never move
+    std::unordered_map<std::string_view, std::list<std::pair<std::string, entry>>::iterator>
+      index{};
+  };
+
+  struct locked_shard {
+    shard& s;
+    std::unique_lock<std::mutex> lock;
+    std::size_t capacity;
+  };
+
+  // How many shards a capacity is spread over, and the share of the shard at index.
+  static auto shards_in_use(std::size_t capacity) -> std::size_t;
+  static auto shard_capacity(std::size_t capacity, std::size_t index) -> std::size_t;
+
+  // Locks the shard of the statement. A concurrent set_capacity() may move the statement to
+  // another shard, so the shard is picked again until the capacity is the same under its lock.
+  auto lock_shard_for(const std::string& statement) -> locked_shard;
+  void insert(const std::string& statement, entry&& value);
+  // Precondition: s.mutex held. Returns the number of evicted statements, to be reported to the
+  // meter once the lock is released.
+  auto trim(shard& s, std::size_t keep) -> std::size_t;
+
+  std::array<shard, number_of_shards> shards_{};
+  // only changed by set_capacity() while it holds the locks of all shards
+  std::atomic<std::size_t> capacity_;
+
+  std::atomic<std::uint64_t> hits_{ 0 };
+  std::atomic<std::uint64_t> misses_{ 0 };
+  std::atomic<std::uint64_t> evictions_{ 0 };
+
+  struct recorders {
+    std::shared_ptr<couchbase::metrics::value_recorder> hits;
+    std::shared_ptr<couchbase::metrics::value_recorder> misses;
+    std::shared_ptr<couchbase::metrics::value_recorder> evictions;
+  };
+
+  // read with std::atomic_load, replaced as a whole with std::atomic_store by set_meter()
+  std::shared_ptr<const recorders> recorders_{};
 };
 } // namespace couchbase::core
@@ -19,6 +19,7 @@
 
 #include "core/logger/logger.hxx"
 #include "core/protocol/client_opcode_fmt.hxx"
+#include "core/tracing/constants.hxx"
 
 #include <couchbase/best_effort_retry_strategy.hxx>
 #include <couchbase/fmt/retry_reason.hxx>
@@ -68,6 +69,12 @@ retry_with_duration(std::shared_ptr<Manager> manager,
     reason,
     command->request.retries.retry_attempts(),
     command->session_ ? command->session_->remote_address() : "");
+  if (auto meter = manager->meter(); meter) {
+    meter->record_retry(tracing::service::key_value, reason);
+  }
+  if (command->session_) {
+    command->session_->record_retry();
+  }
   manager->schedule_for_retry(command, duration);
 }
 
@@ -0,0 +1,385 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "timer_wheel.hxx"
+
+#include <asio/bind_executor.hpp>
+#include <asio/post.hpp>
+
+#include <algorithm>
+
+namespace couchbase::core::io
+{
+namespace
+{
+constexpr std::uint64_t slot_mask{ timer_wheel::slots_per_level - 1 };
+
+// the first tick at or after the given one at which the slots of a level are cascaded
+constexpr auto
+next_cascade(std::uint64_t tick, std::size_t level) -> std::uint64_t
+{
+  const std::uint64_t mask = (std::uint64_t{ 1 } << (timer_wheel::slot_bits * level)) - 1;
+  return (tick + mask) & ~mask;
+}
+
+constexpr auto
+make_handle(std::uint32_t index, std::uint32_t generation) -> timer_wheel::handle
+{
+  return (static_cast<timer_wheel::handle>(generation) << 32U) | index;
+}
+} // namespace
+
+asio::execution_context::id timer_wheel::id;
+
+timer_wheel::timer_wheel(asio::io_context& ctx)
+  : asio::execution_context::service(ctx)
+  , strand_{ asio::make_strand(ctx) }
+  , driver_{ ctx }
+{
+  heads_.fill(npos);
+}
+
+void
+timer_wheel::shutdown()
+{
+  std::vector<handler_type> dropped{};
+  {
+    const std::scoped_lock lock(mutex_);
+    stopped_ = true;
+    for (auto& e : entries_) {
+      if (e.slot != npos) {
+        dropped.emplace_back(std::move(e.handler));
+      }
+    }
+    entries_.clear();
+    heads_.fill(npos);
+    level_size_.fill(0);
+    size_ = 0;
+    free_ = npos;
+  }
+  // handlers might own objects that use the io_context, destroy them before it goes away
+  dropped.clear();
+}
+
+auto
+timer_wheel::to_tick(clock::time_point time, bool round_up) const -> std::uint64_t
+{
+  if (time <= epoch_) {
+    return 0;
+  }
+  const auto elapsed = time - epoch_;
+  auto ticks = static_cast<std::uint64_t>(elapsed / tick);
+  if (round_up && elapsed % tick != clock::duration::zero()) {
+    ++ticks;
+  }
+  return ticks;
+}
+
+auto
+timer_wheel::slot_for(std::uint64_t expiry_tick) const -> std::uint32_t
+{
+  const std::uint64_t delta = expiry_tick - current_tick_;
+  for (std::size_t level = 0; level < levels - 1; ++level) {
+    if (delta < (std::uint64_t{ 1 } << (slot_bits * (level + 1)))) {
+      return static_cast<std::uint32_t>(level * slots_per_level +
+                                        ((expiry_tick >> (slot_bits * level)) & slot_mask));
+    }
+  }
+  // the last level covers the rest of the range; timers even further out wait in its last slot and
+  // are placed again when the wheel gets there
+  constexpr std::size_t top = levels - 1;
+  const std::uint64_t horizon = (std::uint64_t{ 1 } << (slot_bits * levels)) - 1;
+  const auto clamped = current_tick_ + (delta < horizon ? delta : horizon);
+  return static_cast<std::uint32_t>(top * slots_per_level +
+                                    ((clamped >> (slot_bits * top)) & slot_mask));
+}
+
+void
+timer_wheel::link(std::uint32_t index)
+{
+  auto& e = entries_[index];
+  e.slot = slot_for(e.expiry_tick);
+  e.prev = npos;
+  e.next = heads_[e.slot];
+  if (e.next != npos) {
+    entries_[e.next].prev = index;
+  }
+  heads_[e.slot] = index;
+  ++level_size_[e.slot / slots_per_level];
+}
+
+void
+timer_wheel::unlink(std::uint32_t index)
+{
+  auto& e = entries_[index];
+  if (e.prev != npos) {
+    entries_[e.prev].next = e.next;
+  } else {
+    heads_[e.slot] = e.next;
+  }
+  if (e.next != npos) {
+    entries_[e.next].prev = e.prev;
+  }
+  --level_size_[e.slot / slots_per_level];
+  e.slot = npos;
+  e.prev = npos;
+  e.next = npos;
+}
+
+auto
+timer_wheel::release(std::uint32_t index) -> handler_type
+{
+  auto& e = entries_[index];
+  unlink(index);
+  auto handler = std::move(e.handler);
+  if (++e.generation == 0) {
+    e.generation = 1;
+  }
+  e.next = free_;
+  free_ = index;
+  --size_;
+  return handler;
+}
+
+auto
+timer_wheel::schedule(clock::time_point expiry, handler_type&& handler) -> handle
+{
+  handle result{ 0 };
+  bool rearm{ false };
+  {
+    const std::scoped_lock lock(mutex_);
+    if (stopped_) {
+      return result;
+    }
+    if (size_ == 0) {
+      // nothing to cascade, skip the idle ticks instead of walking them in expire()
+      const auto now_tick = to_tick(clock::now(), false);
+      if (now_tick > current_tick_) {
+        current_tick_ = now_tick;
+      }
+    }
+    std::uint32_t index{ free_ };
+    if (index != npos) {
+      free_ = entries_[index].next;
+    } else {
+      index = static_cast<std::uint32_t>(entries_.size());
+      entries_.emplace_back();
+    }
+    auto& e = entries_[index];
+    e.handler = std::move(handler);
+    e.expiry_tick = std::max(to_tick(expiry, true), current_tick_);
+    link(index);
+    ++size_;
+    result = make_handle(index, e.generation);
+
+    if (e.expiry_tick < armed_tick_) {
+      armed_tick_ = e.expiry_tick;
+      rearm = !rearm_pending_;
+      rearm_pending_ = true;
+    }
+  }
+  if (rearm) {
+    request_rearm();
+  }
+  return result;
+}
+
+auto
+timer_wheel::cancel(handle timer) -> bool
+{
+  const auto index = static_cast<std::uint32_t>(timer & 0xffff'ffffU);
+  const auto generation = static_cast<std::uint32_t>(timer >> 32U);
+  handler_type handler{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (index >= entries_.size() || entries_[index].generation != generation ||
+        entries_[index].slot == npos) {
+      return false;
+    }
+    handler = release(index);
+  }
+  // the handler is destroyed outside the lock, as it may own the last reference to an object
+  // whose destructor cancels another timer
+  return true;
+}
+
+auto
+timer_wheel::size() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return size_;
+}
+
+void
+timer_wheel::cascade(std::size_t level, std::size_t slot)
+{
+  auto index = heads_[level * slots_per_level + slot];
+  while (index != npos) {
+    const auto next = entries_[index].next;
+    unlink(index);
+    link(index);
+    index = next;
+  }
+}
+
+auto
+timer_wheel::expire(clock::time_point now) -> std::size_t
+{
+  std::vector<handler_type> due{};
+  {
+    const std::scoped_lock lock(mutex_);
+    const auto now_tick = to_tick(now, false);
+    while (current_tick_ <= now_tick) {
+      if (size_ == 0) {
+        current_tick_ = now_tick + 1;
+        break;
+      }
+      // at the start of every rotation pull the next slot of the coarser levels down
+      for (std::size_t level = 1; level < levels; ++level) {
+        const auto shift = slot_bits * level;
+        if ((current_tick_ & ((std::uint64_t{ 1 } << shift) - 1)) != 0) {
+          break;
+        }
+        cascade(level, (current_tick_ >> shift) & slot_mask);
+      }
+      auto index = heads_[current_tick_ & slot_mask];
+      while (index != npos) {
+        const auto next = entries_[index].next;
+        due.emplace_back(release(index));
+        index = next;
+      }
+      ++current_tick_;
+      if (level_size_[0] == 0) {
+        // nothing can become due before the next cascade of the finest non-empty level
+        current_tick_ = std::min(next_cascade(current_tick_, lowest_coarse_level()), now_tick + 1);
+      }
+    }
+  }
+
+  for (auto& handler : due) {
+    handler(std::error_code{});
+  }
+  return due.size();
+}
+
+auto
+timer_wheel::lowest_coarse_level() const -> std::size_t
+{
+  std::size_t level{ 1 };
+  while (level < levels - 1 && level_size_[level] == 0) {
+    ++level;
+  }
+  return level;
+}
+
+auto
+timer_wheel::next_due_tick() const -> std::uint64_t
+{
+  if (size_ == 0) {
+    return never;
+  }
+  std::uint64_t due{ never };
+  if (level_size_[0] != 0) {
+    for (auto tick = current_tick_; tick < current_tick_ + slots_per_level; ++tick) {
+      if (heads_[tick & slot_mask] != npos) {
+        due = tick;
+        break;
+      }
+    }
+  }
+  if (size_ != level_size_[0]) {
+    due = std::min(due, next_cascade(current_tick_, lowest_coarse_level()));
+  }
+  return due;
+}
+
+void
+timer_wheel::request_rearm()
+{
+  if (strand_.running_in_this_thread()) {
+    return rearm();
+  }
+  asio::post(strand_, [this]() {
+    rearm();
+  });
+}
+
+void
+timer_wheel::rearm()
+{
+  std::uint64_t target{ never };
+  {
+    const std::scoped_lock lock(mutex_);
+    rearm_pending_ = false;
+    target = armed_tick_;
+  }
+  if (target == never) {
+    driver_.cancel();
+    return;
+  }
+  driver_.expires_at(epoch_ + target * tick);
+  driver_.async_wait(asio::bind_executor(strand_, [this](std::error_code ec) {
+    if (ec == asio::error::operation_aborted) {
+      return;
+    }
+    expire(clock::now());
+    {
+      const std::scoped_lock lock(mutex_);
+      armed_tick_ = next_due_tick();
+    }
+    rearm();
+  }));
+}
+
+wheel_timer::wheel_timer(asio::io_context& ctx)
+  : wheel_{ &asio::use_service<timer_wheel>(ctx) }
+{
+}
+
+wheel_timer::~wheel_timer()
+{
+  cancel();
+}
+
+void
+wheel_timer::expires_after(clock::duration duration)
+{
+  expires_at(clock::now() + duration);
+}
+
+void
+wheel_timer::expires_at(clock::time_point expiry)
+{
+  cancel();
+  expiry_.store(expiry.time_since_epoch().count(), std::memory_order_release);
+}
+
+auto
+wheel_timer::expiry() const -> clock::time_point
+{
+  return clock::time_point{ clock::duration{ expiry_.load(std::memory_order_acquire) } };
+}
+
+auto
+wheel_timer::cancel() -> std::size_t
+{
+  if (auto pending = pending_.exchange(0, std::memory_order_acq_rel); pending != 0) {
+    return wheel_->cancel(pending) ? 1 : 0;
+  }
+  return 0;
+}
+} // namespace couchbase::core::io
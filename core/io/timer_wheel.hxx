@@ -0,0 +1,193 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <asio/execution_context.hpp>
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/strand.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Hierarchical timing wheel shared by every command running on an io_context.
+ *
+ * Operation deadlines and retry backoffs are registered here instead of each owning an
+ * asio::steady_timer, so arming and cancelling one is O(1) and does not touch the timer queue of
+ * the io_context. Expiries are rounded up to the next tick, so a timer never fires early, but may
+ * fire up to one tick late. The wheel has four levels of 256 slots; level 0 holds the timers due
+ * within the next 256 ticks, and the timers of a coarser slot are redistributed to the finer levels
+ * when the wheel reaches it.
+ *
+ * The wheel is an asio service, so there is exactly one per io_context (see
+ * asio::use_service<timer_wheel>()). Timers may be scheduled and cancelled from any thread; the
+ * handlers run on the io_context, driven by a single steady_timer that is armed for the next slot
+ * that holds timers (and left idle when the wheel is empty).
+ */
+class timer_wheel : public asio::execution_context::service
+{
+public:
+  using clock = std::chrono::steady_clock;
+  using handler_type = utils::movable_function<void(std::error_code)>;
+
+  static constexpr std::chrono::milliseconds tick{ 1 };
+  static constexpr std::size_t slot_bits{ 8 };
+  static constexpr std::size_t slots_per_level{ std::size_t{ 1 } << slot_bits };
+  static constexpr std::size_t levels{ 4 };
+
+  /**
+   * Identifies a scheduled timer. Zero is never handed out, so it can be used as "no timer".
+   */
+  using handle = std::uint64_t;
+
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  static asio::execution_context::id id;
+
+  explicit timer_wheel(asio::io_context& ctx);
+  timer_wheel(const timer_wheel&) = delete;
+  timer_wheel(timer_wheel&&) = delete;
+  auto operator=(const timer_wheel&) -> timer_wheel& = delete;
+  auto operator=(timer_wheel&&) -> timer_wheel& = delete;
+  ~timer_wheel() override = default;
+
+  /**
+   * Registers @p handler to be invoked with a default std::error_code once @p expiry has passed.
+   */
+  auto schedule(clock::time_point expiry, handler_type&& handler) -> handle;
+
+  /**
+   * Removes a timer that has not fired yet. Its handler is destroyed without being invoked.
+   *
+   * @return true if the timer was still pending
+   */
+  auto cancel(handle timer) -> bool;
+
+  /**
+   * Invokes the handlers of every timer that is due at @p now. This is what the driving timer does;
+   * it is exposed for tests and benchmarks.
+   *
+   * @return number of handlers invoked
+   */
+  auto expire(clock::time_point now) -> std::size_t;
+
+  /**
+   * Number of pending timers.
+   */
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  static constexpr std::uint32_t npos{ std::numeric_limits<std::uint32_t>::max() };
+  static constexpr std::uint64_t never{ std::numeric_limits<std::uint64_t>::max() };
+
+  struct entry {
+    handler_type handler{};
+    std::uint64_t expiry_tick{ 0 };
+    std::uint32_t prev{ npos };
+    std::uint32_t next{ npos };
+    std::uint32_t generation{ 1 };
+    std::uint32_t slot{ npos };
+  };
+
+  void shutdown() override;
+
+  [[nodiscard]] auto to_tick(clock::time_point time, bool round_up) const -> std::uint64_t;
+  [[nodiscard]] auto slot_for(std::uint64_t expiry_tick) const -> std::uint32_t;
+  [[nodiscard]] auto lowest_coarse_level() const -> std::size_t;
+  [[nodiscard]] auto next_due_tick() const -> std::uint64_t;
+  void link(std::uint32_t index);
+  void unlink(std::uint32_t index);
+  auto release(std::uint32_t index) -> handler_type;
+  void cascade(std::size_t level, std::size_t slot);
+  void request_rearm();
+  void rearm();
+
+  // serializes the driving timer, as the io_context might be run by several threads
+  asio::strand<asio::io_context::executor_type> strand_;
+  asio::steady_timer driver_;
+  const clock::time_point epoch_{ clock::now() };
+
+  mutable std::mutex mutex_{};
+  std::vector<entry> entries_{};
+  std::uint32_t free_{ npos };
+  std::array<std::uint32_t, levels * slots_per_level> heads_{};
+  std::array<std::size_t, levels> level_size_{};
+  std::size_t size_{ 0 };
+  std::uint64_t current_tick_{ 0 };
+  std::uint64_t armed_tick_{ never };
+  bool rearm_pending_{ false };
+  bool stopped_{ false };
+};
+
+/**
+ * Timer with the interface of asio::steady_timer that the KV and HTTP commands need, backed by the
+ * timer_wheel of the io_context.
+ *
+ * Unlike asio::steady_timer, cancelling (or re-arming) a pending wait drops its handler without
+ * invoking it with asio::error::operation_aborted. Both may be called from any thread.
+ */
+class wheel_timer
+{
+public:
+  using clock = timer_wheel::clock;
+
+  explicit wheel_timer(asio::io_context& ctx);
+  wheel_timer(const wheel_timer&) = delete;
+  wheel_timer(wheel_timer&&) = delete;
+  auto operator=(const wheel_timer&) -> wheel_timer& = delete;
+  auto operator=(wheel_timer&&) -> wheel_timer& = delete;
+  ~wheel_timer();
+
+  void expires_after(clock::duration duration);
+  void expires_at(clock::time_point expiry);
+  [[nodiscard]] auto expiry() const -> clock::time_point;
+
+  template<typename Handler>
+  void async_wait(Handler&& handler)
+  {
+    auto previous = pending_.exchange(
+      wheel_->schedule(expiry(), timer_wheel::handler_type{ std::forward<Handler>(handler) }),
+      std::memory_order_acq_rel);
+    if (previous != 0) {
+      wheel_->cancel(previous);
+    }
+  }
+
+  /**
+   * @return the number of waits that were cancelled (zero or one)
+   */
+  auto cancel() -> std::size_t;
+
+private:
+  timer_wheel* wheel_;
+  std::atomic<clock::rep> expiry_{ 0 };
+  std::atomic<timer_wheel::handle> pending_{ 0 };
+};
+} // namespace couchbase::core::io
@@ -0,0 +1,176 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "connection_stats_openmetrics.hxx"
+
+#include "core/tracing/constants.hxx"
+#include "openmetrics_writer.hxx"
+
+#include <cstdint>
+#include <string>
+
+namespace couchbase::core::metrics
+{
+namespace
+{
+auto
+labels_for(service_type type, const diag::endpoint_connection_stats& stats)
+  -> openmetrics_writer::labels_type
+{
+  openmetrics_writer::labels_type labels{
+    { tracing::attributes::op::service,
+      type == service_type::key_value ? tracing::service::key_value
+                                      : tracing::service_name_for_http_service(type) },
+    { tracing::attributes::dispatch::peer_address, stats.remote },
+    { tracing::attributes::dispatch::local_id, stats.id },
+  };
+  if (stats.bucket) {
+    labels.emplace(tracing::attributes::op::bucket_name, stats.bucket.value());
+  }
+  return labels;
+}
+
+// Writes one family, with a sample for every connection. Counters and gauges only differ in how
+// the family is introduced and how the value is spelled.
+template<typename Value>
+void
+write_family(openmetrics_writer& writer,
+             const diag::connection_stats_result& stats,
+             const char* name,
+             const char* help,
+             bool is_counter,
+             Value value)
+{
+  if (is_counter) {
+    writer.counter_family(name, help);
+  } else {
+    writer.gauge_family(name, help);
+  }
+  for (const auto& [type, endpoints] : stats.services) {
+    for (const auto& endpoint : endpoints) {
+      const auto labels = labels_for(type, endpoint);
+      const std::uint64_t sample = value(endpoint);
+      if (is_counter) {
+        writer.counter(labels, sample);
+      } else {
+        writer.gauge(labels, static_cast<double>(sample));
+      }
+    }
+  }
+}
+} // namespace
+
+void
+write_connection_stats(openmetrics_writer& writer, const diag::connection_stats_result& stats)
+{
+  if (stats.services.empty()) {
+    return;
+  }
+  using endpoint_stats = diag::endpoint_connection_stats;
+  constexpr bool counter{ true };
+  constexpr bool gauge{ false };
+
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.sent_bytes",
+               "Bytes written to the socket",
+               counter,
+               [](const endpoint_stats& s) {
+                 return s.bytes_sent;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.received_bytes",
+               "Bytes read from the socket",
+               counter,
+               [](const endpoint_stats& s) {
+                 return s.bytes_received;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.requests",
+               "Requests sent",
+               counter,
+               [](const endpoint_stats& s) {
+                 return s.requests_sent;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.responses",
+               "Responses received",
+               counter,
+               [](const endpoint_stats& s) {
+                 return s.responses_received;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.retries",
+               "Operations retried after being dispatched to the connection",
+               counter,
+               [](const endpoint_stats& s) {
+                 return s.retries;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.opaque_overflow_spills",
+               "Requests that did not fit in the handler ring or the operation slab",
+               counter,
+               [](const endpoint_stats& s) {
+                 return s.opaque_overflow_spills;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.compressed_received_bytes",
+               "Compressed values received, before decompression",
+               counter,
+               [](const endpoint_stats& s) {
+                 return s.compressed_bytes_received;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.decompressed_received_bytes",
+               "Compressed values received, after decompression",
+               counter,
+               [](const endpoint_stats& s) {
+                 return s.decompressed_bytes_received;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.in_flight",
+               "Requests waiting for their response",
+               gauge,
+               [](const endpoint_stats& s) {
+                 return s.in_flight;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.write_queue_bytes",
+               "Bytes waiting to be written to the socket",
+               gauge,
+               [](const endpoint_stats& s) {
+                 return s.write_queue_bytes;
+               });
+  write_family(writer,
+               stats,
+               "db.couchbase.connection.parser_buffered_bytes",
+               "Bytes received, but not parsed yet",
+               gauge,
+               [](const endpoint_stats& s) {
+                 return s.parser_buffered_bytes;
+               });
+}
+} // namespace couchbase::core::metrics
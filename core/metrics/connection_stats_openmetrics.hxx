@@ -0,0 +1,33 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/diagnostics.hxx"
+
+namespace couchbase::core::metrics
+{
+class openmetrics_writer;
+
+/**
+ * Writes the connection statistics as OpenMetrics families, one sample per connection, labelled
+ * by service, remote address, connection id and (for KV) bucket. The totals become counters, the
+ * instantaneous values gauges.
+ */
+void
+write_connection_stats(openmetrics_writer& writer, const diag::connection_stats_result& stats);
+} // namespace couchbase::core::metrics
@@ -20,4 +20,13 @@
 namespace couchbase::core::metrics
 {
 constexpr auto operation_meter_name = "db.client.operation.duration";
+
+// Events of the prepared statement cache of the query service. Hits and misses record the value 1
+// each, evictions record the number of statements evicted at once.
+constexpr auto query_cache_hit_meter_name = "db.couchbase.query.prepared_cache.hits";
+constexpr auto query_cache_miss_meter_name = "db.couchbase.query.prepared_cache.misses";
+constexpr auto query_cache_eviction_meter_name = "db.couchbase.query.prepared_cache.evictions";
+
+// Operations scheduled for another attempt. Each retry records the value 1.
+constexpr auto retry_meter_name = "db.couchbase.operation.retries";
 } // namespace couchbase::core::metrics
@@ -24,31 +24,158 @@
 #include "core/tracing/constants.hxx"
 #include "core/utils/json.hxx"
 #include "noop_meter.hxx"
+#include "openmetrics_writer.hxx"
 
 #include <gsl/assert>
 #include <hdr/hdr_histogram.h>
 #include <tao/json/value.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace couchbase::core::metrics
 {
 class logging_value_recorder : public couchbase::metrics::value_recorder
 {
 private:
+  // Values are recorded into one of several histograms, picked by the recording thread, so that
+  // threads recording the same operation do not contend on the same counters. The histograms are
+  // created on first use, and drained into histogram_ (the values not yet logged) and totals_ (all
+  // the values ever recorded, for the OpenMetrics exposition) when a report is made. There are no
+  // more of them than cores, and they keep two significant figures (about 30 KB each instead of
+  // the 210 KB of the histograms they are drained into): percentiles within 1% are plenty for
+  // values that are logged in whole microseconds.
+  static constexpr std::size_t max_number_of_shards{ 8 };
+
+  // A report does not read a histogram that threads may still be recording into. It swaps an empty
+  // one in, waits for the threads that could have picked the old one to leave it (the writer/reader
+  // phaser of HdrHistogram's interval recorders), and only then merges and resets it.
+  struct shard {
+    std::atomic<hdr_histogram*> histogram{ nullptr };
+    std::atomic_int64_t start_epoch{ 0 };
+    std::atomic_int64_t even_end_epoch{ 0 };
+    std::atomic_int64_t odd_end_epoch{ std::numeric_limits<std::int64_t>::min() };
+
+    auto enter() -> std::int64_t
+    {
+      return start_epoch.fetch_add(1);
+    }
+
+    void leave(std::int64_t epoch_at_enter)
+    {
+      (epoch_at_enter < 0 ? odd_end_epoch : even_end_epoch).fetch_add(1);
+    }
+
+    // Returns once every thread that entered before the call has left.
+    void flip_phase()
+    {
+      const bool next_phase_is_even = start_epoch.load() < 0;
+      const std::int64_t initial_epoch =
+        next_phase_is_even ? 0 : std::numeric_limits<std::int64_t>::min();
+      (next_phase_is_even ? even_end_epoch : odd_end_epoch).store(initial_epoch);
+      const auto epoch_at_flip = start_epoch.exchange(initial_epoch);
+      const auto& previous_end_epoch = next_phase_is_even ? odd_end_epoch : even_end_epoch;
+      while (previous_end_epoch.load() != epoch_at_flip) {
+        std::this_thread::yield();
+      }
+    }
+  };
+
   std::string name_;
   std::map<std::string, std::string> tags_;
   hdr_histogram* histogram_{ nullptr };
+  hdr_histogram* totals_{ nullptr };
+  mutable std::array<shard, max_number_of_shards> shards_{};
+  // the empty histogram the next drained shard gets, guarded by report_mutex_
+  mutable hdr_histogram* spare_shard_{ nullptr };
+  mutable std::mutex report_mutex_{};
 
-  void initialize_histogram()
+  static auto number_of_shards() -> std::size_t
+  {
+    static const std::size_t number{ std::clamp<std::size_t>(
+      std::thread::hardware_concurrency(), 1, max_number_of_shards) };
+    return number;
+  }
+
+  static auto create_histogram(std::int32_t significant_figures = 3) -> hdr_histogram*
   {
-    histogram_ = nullptr;
+    hdr_histogram* histogram{ nullptr };
     hdr_init(/* minimum - 1 ns*/ 1,
              /* maximum - 30 s*/ 30'000'000'000LL,
-             /* significant figures */ 3,
-             /* pointer */ &histogram_);
-    Expects(histogram_ != nullptr);
+             /* significant figures */ significant_figures,
+             /* pointer */ &histogram);
+    Expects(histogram != nullptr);
+    return histogram;
+  }
+
+  static auto create_shard_histogram() -> hdr_histogram*
+  {
+    return create_histogram(/* significant figures */ 2);
+  }
+
+  void initialize_histogram()
+  {
+    histogram_ = create_histogram();
+    totals_ = create_histogram();
+  }
+
+  // Requires report_mutex_.
+  void drain_shards() const
+  {
+    for (auto& shard : shards_) {
+      if (shard.histogram.load() == nullptr) {
+        continue;
+      }
+      if (spare_shard_ == nullptr) {
+        spare_shard_ = create_shard_histogram();
+      }
+      auto* drained = shard.histogram.exchange(spare_shard_);
+      shard.flip_phase();
+      hdr_add(histogram_, drained);
+      hdr_add(totals_, drained);
+      hdr_reset(drained);
+      spare_shard_ = drained;
+    }
+  }
+
+  // Drops the values not drained yet: drain_shards() first to keep them.
+  void close_shards()
+  {
+    for (auto& shard : shards_) {
+      if (auto* histogram = shard.histogram.exchange(nullptr); histogram != nullptr) {
+        hdr_close(histogram);
+      }
+    }
+    if (spare_shard_ != nullptr) {
+      hdr_close(spare_shard_);
+      spare_shard_ = nullptr;
+    }
+  }
+
+  auto shard_for_this_thread() -> shard&
+  {
+    static std::atomic_size_t next_index{ 0 };
+    thread_local const std::size_t index{ next_index.fetch_add(1, std::memory_order_relaxed) };
+
+    auto& shard = shards_[index % number_of_shards()];
+    if (auto* histogram = shard.histogram.load(); histogram == nullptr) {
+      auto* created = create_shard_histogram();
+      if (!shard.histogram.compare_exchange_strong(histogram, created)) {
+        hdr_close(created);
+      }
+    }
+    return shard;
   }
 
 public:
@@ -83,7 +210,11 @@ public:
     }
     name_ = other.name_;
     tags_ = other.tags_;
-    initialize_histogram();
+    {
+      const std::scoped_lock lock(report_mutex_);
+      drain_shards();
+    }
+    close_shards();
     return *this;
   }
 
@@ -94,28 +225,42 @@ public:
     }
     name_ = std::move(other.name_);
     tags_ = std::move(other.tags_);
-    initialize_histogram();
+    {
+      const std::scoped_lock lock(report_mutex_);
+      drain_shards();
+    }
+    close_shards();
     return *this;
   }
 
   ~logging_value_recorder() override
   {
+    close_shards();
     if (histogram_ != nullptr) {
       hdr_close(histogram_);
       histogram_ = nullptr;
     }
+    if (totals_ != nullptr) {
+      hdr_close(totals_);
+      totals_ = nullptr;
+    }
   }
 
   void record_value(std::int64_t value) override
   {
-    if (histogram_ == nullptr) {
-      return;
-    }
-    hdr_record_value_atomic(histogram_, value);
+    // The shard is only ever shared with the (rare) threads that hash onto the same index, hence
+    // the atomic increments.
+    auto& shard = shard_for_this_thread();
+    const auto epoch = shard.enter();
+    hdr_record_value_atomic(shard.histogram.load(), value);
+    shard.leave(epoch);
   }
 
   [[nodiscard]] auto emit() const -> tao::json::value
   {
+    const std::scoped_lock lock(report_mutex_);
+    drain_shards();
+
     auto total_count = histogram_->total_count;
     auto val_50_0 = hdr_value_at_percentile(histogram_, 50.0);
     auto val_90_0 = hdr_value_at_percentile(histogram_, 90.0);
@@ -137,10 +282,66 @@ public:
         } },
     };
   }
+
+  // Writes every value recorded so far, as a cumulative histogram in seconds. Unlike emit(), this
+  // does not start a new interval, so it may be called as often as the metrics are scraped.
+  void write_openmetrics(openmetrics_writer& writer,
+                         const openmetrics_writer::labels_type& labels) const
+  {
+    // Upper bounds of the buckets, in microseconds (the unit the values are recorded in).
+    static constexpr std::array<std::int64_t, 16> bucket_bounds_us{
+      100,     250,     500,       1'000,     2'500,     5'000,     10'000,    25'000,
+      50'000,  100'000, 250'000,   500'000,   1'000'000, 2'500'000, 5'000'000, 10'000'000,
+    };
+
+    std::vector<std::pair<double, std::uint64_t>> buckets{};
+    buckets.reserve(bucket_bounds_us.size());
+    for (const auto bound : bucket_bounds_us) {
+      buckets.emplace_back(static_cast<double>(bound) / 1e6, 0);
+    }
+    double sum_us{ 0 };
+    std::uint64_t count{ 0 };
+    {
+      const std::scoped_lock lock(report_mutex_);
+      drain_shards();
+      hdr_iter iter{};
+      hdr_iter_recorded_init(&iter, totals_);
+      while (hdr_iter_next(&iter)) {
+        const auto bucket_count = static_cast<std::uint64_t>(iter.count);
+        sum_us += static_cast<double>(iter.value) * static_cast<double>(bucket_count);
+        count += bucket_count;
+        for (std::size_t i = 0; i < bucket_bounds_us.size(); ++i) {
+          if (iter.value <= bucket_bounds_us[i]) {
+            buckets[i].second += bucket_count;
+          }
+        }
+      }
+    }
+    writer.histogram(labels, buckets, sum_us / 1e6, count);
+  }
 };
 
-void
-logging_meter::log_report() const
+// Any meter other than the operation durations (e.g. the prepared statement cache hits) is kept as
+// a counter, the sum of the values recorded to it.
+class logging_counter_recorder : public couchbase::metrics::value_recorder
+{
+public:
+  void record_value(std::int64_t value) override
+  {
+    total_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto total() const -> std::int64_t
+  {
+    return total_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic_int64_t total_{ 0 };
+};
+
+auto
+logging_meter::build_report() const -> tao::json::value
 {
   tao::json::value report{
     {
@@ -155,12 +356,21 @@ logging_meter::log_report() const
       },
     },
   };
-  for (const auto& [service, operations] : recorders_) {
-    for (const auto& [operation, recorder] : operations) {
-      report["operations"][service][operation] = recorder->emit();
+  {
+    const std::scoped_lock lock(recorders_mutex_);
+    for (const auto& [service, operations] : recorders_) {
+      for (const auto& [operation, recorder] : operations) {
+        report["operations"][service][operation] = recorder->emit();
+      }
     }
   }
-  if (report.find("operations") != nullptr) {
+  return report;
+}
+
+void
+logging_meter::log_report() const
+{
+  if (auto report = build_report(); report.find("operations") != nullptr) {
     CB_LOG_INFO("Metrics: {}", utils::json::generate(report));
   }
 }
@@ -212,7 +422,12 @@ logging_meter::get_value_recorder(const std::string& name,
   };
 
   if (name != operation_meter_name) {
-    return noop_recorder;
+    const std::scoped_lock lock(recorders_mutex_);
+    auto& counter = counters_[name][tags];
+    if (!counter) {
+      counter = std::make_shared<logging_counter_recorder>();
+    }
+    return counter;
   }
 
   const auto service = tags.find(tracing::attributes::op::service);
@@ -232,4 +447,30 @@ logging_meter::get_value_recorder(const std::string& name,
     operation->second, std::make_shared<logging_value_recorder>(operation->second, tags));
   return it->second;
 }
+
+void
+logging_meter::write_openmetrics(openmetrics_writer& writer) const
+{
+  const std::scoped_lock lock(recorders_mutex_);
+  if (!recorders_.empty()) {
+    writer.histogram_family(std::string{ operation_meter_name } + "_seconds",
+                            "Duration of the operations, by service and operation");
+    for (const auto& [service, operations] : recorders_) {
+      for (const auto& [operation, recorder] : operations) {
+        recorder->write_openmetrics(writer,
+                                    {
+                                      { tracing::attributes::op::service, service },
+                                      { tracing::attributes::op::operation_name, operation },
+                                    });
+      }
+    }
+  }
+  for (const auto& [name, recorders] : counters_) {
+    writer.counter_family(name, name);
+    for (const auto& [tags, recorder] : recorders) {
+      writer.counter(tags,
+                     static_cast<std::uint64_t>(std::max<std::int64_t>(recorder->total(), 0)));
+    }
+  }
+}
 } // namespace couchbase::core::metrics
@@ -22,12 +22,18 @@
 #include <couchbase/metrics/meter.hxx>
 
 #include <asio/steady_timer.hpp>
+#include <tao/json/forward.hpp>
 
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace couchbase::core::metrics
 {
 class logging_value_recorder;
+class logging_counter_recorder;
+class openmetrics_writer;
 
 class logging_meter
   : public couchbase::metrics::meter
@@ -36,10 +42,14 @@ class logging_meter
 private:
   asio::steady_timer emit_report_;
   logging_meter_options options_;
-  std::mutex recorders_mutex_{};
+  mutable std::mutex recorders_mutex_{};
   // service name -> operation name -> recorder
   std::map<std::string, std::map<std::string, std::shared_ptr<logging_value_recorder>>>
     recorders_{};
+  // meter name -> tags -> recorder, for every meter other than the operation durations
+  std::map<std::string,
+           std::map<std::map<std::string, std::string>, std::shared_ptr<logging_counter_recorder>>>
+    counters_{};
 
   void log_report() const;
 
@@ -56,6 +66,19 @@ public:
 
   auto get_value_recorder(const std::string& name, const std::map<std::string, std::string>& tags)
     -> std::shared_ptr<couchbase::metrics::value_recorder> override;
+
+  /**
+   * Collects the operation durations recorded since the previous report, as logged every emit
+   * interval, and starts a new interval.
+   */
+  [[nodiscard]] auto build_report() const -> tao::json::value;
+
+  /**
+   * Writes the metrics in the OpenMetrics text format: a cumulative histogram of the operation
+   * durations, and a counter for every other meter. It does not interfere with the periodic log
+   * report, and is cheap enough to be scraped every few seconds.
+   */
+  void write_openmetrics(openmetrics_writer& writer) const;
 };
 
 } // namespace couchbase::core::metrics
@@ -17,16 +17,24 @@
 
 #include "meter_wrapper.hxx"
 
+#include <spdlog/fmt/bundled/core.h>
+
 #include <couchbase/error_codes.hxx>
+#include <couchbase/fmt/retry_reason.hxx>
 
 #include "core/metrics/constants.hxx"
 #include "core/tracing/constants.hxx"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -58,17 +66,81 @@ snake_case_to_camel_case(const std::string& s) -> std::string
 auto
 extract_error_name(std::error_code ec) -> std::string
 {
-  const std::string::size_type pos = ec.message().find(' ');
-  if (pos != std::string::npos) {
-    return ec.message().substr(0, pos);
+  auto message = ec.message();
+  if (const std::string::size_type pos = message.find(' '); pos != std::string::npos) {
+    message.resize(pos);
   }
-  return ec.message();
+  return message;
 }
 
+// The name of a Couchbase error code, as it goes into the error_type tag. The values of the
+// Couchbase categories do not overlap, so one table indexed by value covers all of them. The
+// category is kept with the name regardless, so that a code can never be given the name of a code
+// from another category.
+struct error_type_name {
+  const std::error_category* category;
+  metric_label name;
+};
+
+// Couchbase codes from 1000 up are all reported as "CouchbaseError", and need no entry.
+constexpr int max_named_error_value{ 1000 };
+
+// Filled in on first use of each code. An entry is never replaced nor freed once published, which
+// is what lets it be read without a lock. There are as many entries as there are error codes, so
+// the table is bounded.
+std::array<std::atomic<const error_type_name*>, max_named_error_value> error_type_names{};
+
+auto
+error_type_name_for(std::error_code ec) -> metric_label
+{
+  auto& slot = error_type_names[static_cast<std::size_t>(ec.value())];
+  const auto* cached = slot.load(std::memory_order_acquire);
+  if (cached == nullptr) {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): published for the life of the process
+    auto* computed = new error_type_name{ &ec.category(),
+                                          snake_case_to_camel_case(extract_error_name(ec)) };
+    if (slot.compare_exchange_strong(cached, computed, std::memory_order_acq_rel)) {
+      cached = computed;
+    } else {
+      delete computed; // NOLINT(cppcoreguidelines-owning-memory): lost the race, use the winner
+    }
+  }
+  if (cached->category != &ec.category()) {
+    return snake_case_to_camel_case(extract_error_name(ec));
+  }
+  return cached->name;
+}
+
+// The recorders a thread has used last, in a small direct-mapped table private to that thread, so
+// that recording against a known attribute set takes no lock. A slot points at the entry of the
+// wrapper that resolved it, and is only followed when the id of the wrapper asking matches: wrapper
+// ids are never reused, and a wrapper never erases its entries, so a matching slot always points at
+// a live entry.
+struct recorder_cache_slot {
+  std::uint64_t owner{ 0 };
+  std::size_t hash{ 0 };
+  const void* entry{ nullptr };
+};
+
+thread_local std::array<recorder_cache_slot, 64> t_recorder_cache{};
+
+std::atomic_uint64_t next_meter_wrapper_id{ 1 };
+
+void
+hash_combine(std::size_t& seed, std::size_t value)
+{
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+void
+hash_combine(std::size_t& seed, const std::optional<metric_label>& value)
+{
+  hash_combine(seed, value ? value->hash() : 0);
+}
 } // namespace
 
 auto
-standardized_error_type(std::error_code ec) -> std::string
+standardized_error_type(std::error_code ec) -> metric_label
 {
   if (!ec) {
     return {};
@@ -91,21 +163,41 @@ standardized_error_type(std::error_code ec) -> std::string
       return &ec.category() == cat;
     });
   if (!couchbase_error) {
-    return "_OTHER";
+    static const metric_label other{ "_OTHER" };
+    return other;
   }
 
   // The SDK's network errors (couchbase::errc::network) use values >= 1000 and are reported under a
   // single generic bucket rather than by individual name.
   if (ec.value() >= 1000) {
-    return "CouchbaseError";
+    static const metric_label couchbase_error_type{ "CouchbaseError" };
+    return couchbase_error_type;
   }
 
   // Errors where message and RFC-message don't match
   if (ec == errc::field_level_encryption::generic_cryptography_failure) {
-    return "CryptoError";
+    static const metric_label crypto_error_type{ "CryptoError" };
+    return crypto_error_type;
   }
 
-  return snake_case_to_camel_case(extract_error_name(ec));
+  if (ec.value() < 0) {
+    return snake_case_to_camel_case(extract_error_name(ec));
+  }
+  return error_type_name_for(ec);
+}
+
+auto
+metric_attributes_hash::operator()(const metric_attributes& attrs) const noexcept -> std::size_t
+{
+  std::size_t seed{ attrs.service.hash() };
+  hash_combine(seed, attrs.operation.hash());
+  hash_combine(seed, attrs.error_type.hash());
+  hash_combine(seed, attrs.bucket_name);
+  hash_combine(seed, attrs.scope_name);
+  hash_combine(seed, attrs.collection_name);
+  hash_combine(seed, attrs.internal.cluster_name);
+  hash_combine(seed, attrs.internal.cluster_uuid);
+  return seed;
 }
 
 auto
@@ -114,27 +206,27 @@ metric_attributes::encode() const -> std::map<std::string, std::string>
   std::map<std::string, std::string> tags = {
     { tracing::attributes::reserved::target_unit, "s" },
     { tracing::attributes::common::system, "couchbase" },
-    { tracing::attributes::op::service, service },
-    { tracing::attributes::op::operation_name, operation },
+    { tracing::attributes::op::service, service.str() },
+    { tracing::attributes::op::operation_name, operation.str() },
   };
 
   if (internal.cluster_name.has_value()) {
-    tags.emplace(tracing::attributes::common::cluster_name, internal.cluster_name.value());
+    tags.emplace(tracing::attributes::common::cluster_name, internal.cluster_name->str());
   }
   if (internal.cluster_uuid.has_value()) {
-    tags.emplace(tracing::attributes::common::cluster_uuid, internal.cluster_uuid.value());
+    tags.emplace(tracing::attributes::common::cluster_uuid, internal.cluster_uuid->str());
   }
   if (bucket_name) {
-    tags.emplace(tracing::attributes::op::bucket_name, bucket_name.value());
+    tags.emplace(tracing::attributes::op::bucket_name, bucket_name->str());
   }
   if (scope_name) {
-    tags.emplace(tracing::attributes::op::scope_name, scope_name.value());
+    tags.emplace(tracing::attributes::op::scope_name, scope_name->str());
   }
   if (collection_name) {
-    tags.emplace(tracing::attributes::op::collection_name, collection_name.value());
+    tags.emplace(tracing::attributes::op::collection_name, collection_name->str());
   }
   if (!error_type.empty()) {
-    tags.emplace(tracing::attributes::op::error_type, error_type);
+    tags.emplace(tracing::attributes::op::error_type, error_type.str());
   }
 
   return tags;
@@ -144,6 +236,7 @@ meter_wrapper::meter_wrapper(std::shared_ptr<couchbase::metrics::meter> meter,
                              std::shared_ptr<cluster_label_listener> label_listener)
   : meter_{ std::move(meter) }
   , cluster_label_listener_{ std::move(label_listener) }
+  , id_{ next_meter_wrapper_id.fetch_add(1, std::memory_order_relaxed) }
 {
 }
 
@@ -163,10 +256,27 @@ auto
 meter_wrapper::value_recorder_for(const metric_attributes& attrs)
   -> std::shared_ptr<couchbase::metrics::value_recorder>
 {
+  return cached_recorder_for(attrs).second;
+}
+
+auto
+meter_wrapper::cached_recorder_for(const metric_attributes& attrs)
+  -> const recorder_cache_type::value_type&
+{
+  const auto hash = metric_attributes_hash{}(attrs);
+  auto& slot = t_recorder_cache[hash % t_recorder_cache.size()];
+  if (slot.owner == id_ && slot.hash == hash) {
+    if (const auto* entry = static_cast<const recorder_cache_type::value_type*>(slot.entry);
+        entry->first == attrs) {
+      return *entry;
+    }
+  }
+
   {
     const std::scoped_lock lock(recorder_cache_mutex_);
     if (auto it = recorder_cache_.find(attrs); it != recorder_cache_.end()) {
-      return it->second;
+      slot = { id_, hash, &*it };
+      return *it;
     }
   }
 
@@ -180,7 +290,9 @@ meter_wrapper::value_recorder_for(const metric_attributes& attrs)
   const std::scoped_lock lock(recorder_cache_mutex_);
   // A concurrent caller may have inserted this key while the lock was released; emplace keeps the
   // first-inserted recorder and returns it, so all callers share one recorder per key.
-  return recorder_cache_.emplace(attrs, std::move(recorder)).first->second;
+  const auto& entry = *recorder_cache_.emplace(attrs, std::move(recorder)).first;
+  slot = { id_, hash, &entry };
+  return entry;
 }
 
 void
@@ -190,7 +302,7 @@ meter_wrapper::record_value(metric_attributes attrs,
   // The listener is optional -- the wrapper can be constructed without one -- so only enrich the
   // attributes with cluster labels when it is present.
   if (cluster_label_listener_) {
-    auto [cluster_name, cluster_uuid] = cluster_label_listener_->cluster_labels();
+    auto [cluster_name, cluster_uuid] = cluster_label_listener_->cluster_metric_labels();
     if (cluster_name) {
       attrs.internal.cluster_name = cluster_name;
     }
@@ -199,9 +311,19 @@ meter_wrapper::record_value(metric_attributes attrs,
     }
   }
 
-  value_recorder_for(attrs)->record_value(std::chrono::duration_cast<std::chrono::microseconds>(
-                                            std::chrono::steady_clock::now() - start_time)
-                                            .count());
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start_time);
+  cached_recorder_for(attrs).second->record_value(elapsed.count());
+}
+
+void
+meter_wrapper::record_retry(const std::string& service, retry_reason reason)
+{
+  const std::map<std::string, std::string> tags{
+    { tracing::attributes::op::service, service },
+    { tracing::attributes::op::retry_reason, fmt::format("{}", reason) },
+  };
+  meter_->get_value_recorder(retry_meter_name, tags)->record_value(1);
 }
 
 auto
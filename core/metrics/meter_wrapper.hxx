@@ -18,12 +18,16 @@
 #pragma once
 
 #include "core/config_listener.hxx"
+#include "core/metrics/metric_label.hxx"
 #include "core/service_type.hxx"
 #include "core/topology/configuration.hxx"
 
 #include <couchbase/metrics/meter.hxx>
+#include <couchbase/retry_reason.hxx>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -31,26 +35,29 @@
 #include <string>
 #include <system_error>
 #include <tuple>
+#include <unordered_map>
 
 #include "core/cluster_label_listener.hxx"
 
 namespace couchbase::core::metrics
 {
+// The attributes are interned labels, so that building them, copying them and looking up their
+// recorder neither allocates nor hashes strings.
 struct metric_attributes {
-  std::string service;
-  std::string operation;
+  metric_label service;
+  metric_label operation;
   // The standardized error type, precomputed once from the operation's error code (see
   // standardized_error_type()). Stored rather than the raw error code so that both the encoded tag
-  // set and the recorder-cache key (operator<) use it without recomputing a string per comparison.
+  // set and the recorder-cache key (operator==) use it without recomputing a string per comparison.
   // Empty denotes "no error".
-  std::string error_type{};
-  std::optional<std::string> bucket_name{};
-  std::optional<std::string> scope_name{};
-  std::optional<std::string> collection_name{};
+  metric_label error_type{};
+  std::optional<metric_label> bucket_name{};
+  std::optional<metric_label> scope_name{};
+  std::optional<metric_label> collection_name{};
 
   struct {
-    std::optional<std::string> cluster_name{};
-    std::optional<std::string> cluster_uuid{};
+    std::optional<metric_label> cluster_name{};
+    std::optional<metric_label> cluster_uuid{};
   } internal{};
 
   [[nodiscard]] auto encode() const -> std::map<std::string, std::string>;
@@ -58,19 +65,21 @@ struct metric_attributes {
 
 // Map an error code to the standardized error-type string used as the metric's error_type tag (see
 // metric_attributes::encode()). The empty string denotes "no error". Exposed so the recorder cache
-// can key on the same bounded set of error types that actually reach the tags.
+// can key on the same bounded set of error types that actually reach the tags. The name of a
+// Couchbase error code is worked out on its first use only, and remembered from then on.
 [[nodiscard]] auto
-standardized_error_type(std::error_code ec) -> std::string;
+standardized_error_type(std::error_code ec) -> metric_label;
 
 inline auto
-operator<(const metric_attributes& lhs, const metric_attributes& rhs) -> bool
+operator==(const metric_attributes& lhs, const metric_attributes& rhs) -> bool
 {
-  // Order by the precomputed standardized error type, not the raw error code. encode() only ever
+  // Compare the precomputed standardized error type, not the raw error code. encode() only ever
   // emits the standardized type in the tag set, so keying on it collapses the many distinct codes
   // that share a type onto one recorder and keeps the cache bounded by the tag cardinality (rather
   // than one entry per raw code, unbounded for high-cardinality system/asio codes). Because the
-  // type is stored on the attributes, every comparison is a plain string compare -- no per-lookup
-  // string construction or allocation, which is what keeps the cache lookup cheap on the hot path.
+  // type is stored on the attributes, and every attribute is an interned label, each comparison is
+  // a pointer compare -- no per-lookup string construction, allocation or scan, which is what keeps
+  // the cache lookup cheap on the hot path.
   return std::tie(lhs.service,
                   lhs.operation,
                   lhs.error_type,
@@ -78,16 +87,21 @@ operator<(const metric_attributes& lhs, const metric_attributes& rhs) -> bool
                   lhs.scope_name,
                   lhs.collection_name,
                   lhs.internal.cluster_name,
-                  lhs.internal.cluster_uuid) < std::tie(rhs.service,
-                                                        rhs.operation,
-                                                        rhs.error_type,
-                                                        rhs.bucket_name,
-                                                        rhs.scope_name,
-                                                        rhs.collection_name,
-                                                        rhs.internal.cluster_name,
-                                                        rhs.internal.cluster_uuid);
+                  lhs.internal.cluster_uuid) == std::tie(rhs.service,
+                                                         rhs.operation,
+                                                         rhs.error_type,
+                                                         rhs.bucket_name,
+                                                         rhs.scope_name,
+                                                         rhs.collection_name,
+                                                         rhs.internal.cluster_name,
+                                                         rhs.internal.cluster_uuid);
 }
 
+// Hashes the same fields operator== compares.
+struct metric_attributes_hash {
+  [[nodiscard]] auto operator()(const metric_attributes& attrs) const noexcept -> std::size_t;
+};
+
 class meter_wrapper
 {
 public:
@@ -99,6 +113,9 @@ public:
 
   void record_value(metric_attributes attrs, std::chrono::steady_clock::time_point start_time);
 
+  // Retries are rare compared to completed operations, so these go straight to the meter.
+  void record_retry(const std::string& service, retry_reason reason);
+
   // Resolve (and cache) the value recorder for a set of attributes. The underlying meter returns a
   // stable recorder for a given name/tag set, so resolving once per distinct attribute set keeps
   // the per-operation tag-map construction and recorder lookup off the hot path.
@@ -112,16 +129,27 @@ public:
     -> std::shared_ptr<meter_wrapper>;
 
 private:
+  using recorder_cache_type =
+    std::unordered_map<metric_attributes,
+                       std::shared_ptr<couchbase::metrics::value_recorder>,
+                       metric_attributes_hash>;
+
+  [[nodiscard]] auto cached_recorder_for(const metric_attributes& attrs)
+    -> const recorder_cache_type::value_type&;
+
   std::shared_ptr<couchbase::metrics::meter> meter_;
   std::shared_ptr<cluster_label_listener> cluster_label_listener_;
+  // Tags the entries this wrapper leaves in the per-thread recorder caches. Never reused, so that
+  // an entry cannot be mistaken for one of a wrapper that has since been destroyed.
+  const std::uint64_t id_;
   std::mutex recorder_cache_mutex_{};
   // Keyed by the full attribute set (not just service/operation): the meter is pluggable, and a
   // custom meter may hand out a distinct recorder per tag combination, so the cache must ask it
   // once for each distinct attribute set rather than assume any particular dedup granularity. The
-  // key mirrors what encode() emits -- in particular it orders by the standardized error type (see
-  // operator<), not the raw error code -- so the key space is finite (services x operations x
-  // scope/collection x standardized error type x cluster) and the cache stays bounded.
-  std::map<metric_attributes, std::shared_ptr<couchbase::metrics::value_recorder>>
-    recorder_cache_{};
+  // key mirrors what encode() emits -- in particular it holds the standardized error type, not the
+  // raw error code -- so the key space is finite (services x operations x scope/collection x
+  // standardized error type x cluster) and the cache stays bounded. Entries are never erased, so
+  // the per-thread caches may point at them for as long as the wrapper lives.
+  recorder_cache_type recorder_cache_{};
 };
 } // namespace couchbase::core::metrics
@@ -0,0 +1,107 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "metric_label.hxx"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace couchbase::core::metrics
+{
+namespace
+{
+struct label_table {
+  std::shared_mutex mutex{};
+  // the keys are views of the strings they own, which never move nor go away
+  std::unordered_map<std::string_view, std::unique_ptr<const std::string>> labels{};
+};
+
+auto
+labels() -> label_table&
+{
+  // never destroyed, so that labels stay valid while other statics are destroyed
+  static auto* table = new label_table{}; // NOLINT(cppcoreguidelines-owning-memory)
+  return *table;
+}
+
+struct label_cache_slot {
+  std::size_t hash{ 0 };
+  const std::string* value{ nullptr };
+};
+
+// The labels this thread has interned last, so that most lookups do not take the lock.
+thread_local std::array<label_cache_slot, 256> t_label_cache{};
+
+auto
+intern(std::string_view value) -> const std::string*
+{
+  const auto hash = std::hash<std::string_view>{}(value);
+  auto& slot = t_label_cache[hash % t_label_cache.size()];
+  if (slot.value != nullptr && slot.hash == hash && *slot.value == value) {
+    return slot.value;
+  }
+
+  auto& table = labels();
+  const std::string* interned{ nullptr };
+  {
+    const std::shared_lock lock(table.mutex);
+    if (auto it = table.labels.find(value); it != table.labels.end()) {
+      interned = it->second.get();
+    }
+  }
+  if (interned == nullptr) {
+    auto owned = std::make_unique<const std::string>(value);
+    const std::scoped_lock lock(table.mutex);
+    // a concurrent caller may have interned the same value while the lock was released
+    auto [it, _] = table.labels.try_emplace(std::string_view{ *owned }, std::move(owned));
+    interned = it->second.get();
+  }
+  slot = { hash, interned };
+  return interned;
+}
+
+auto
+empty_label() -> const std::string*
+{
+  static const std::string* const empty{ intern({}) };
+  return empty;
+}
+} // namespace
+
+metric_label::metric_label()
+  : value_{ empty_label() }
+{
+}
+
+metric_label::metric_label(std::string_view value)
+  : value_{ intern(value) }
+{
+}
+
+metric_label::metric_label(const std::string& value)
+  : value_{ intern(value) }
+{
+}
+
+metric_label::metric_label(const char* value)
+  : value_{ intern(value) }
+{
+}
+} // namespace couchbase::core::metrics
@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace couchbase::core::metrics
+{
+/**
+ * A value of a metric attribute (a service, an operation, a bucket name, an error type...),
+ * interned for the life of the process.
+ *
+ * Labels compare and hash by address, and copying one allocates nothing, so the attributes of an
+ * operation can key the recorder cache without hashing or copying strings. Interning a string
+ * hashes it once, and a small per-thread table usually answers without taking a lock. The values
+ * are the tag values of the metrics, so there are few of them and they are never freed.
+ */
+class metric_label
+{
+public:
+  // the empty label
+  metric_label();
+  // implicit, so that attributes can still be filled in with strings
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  metric_label(std::string_view value);
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  metric_label(const std::string& value);
+  // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+  metric_label(const char* value);
+
+  [[nodiscard]] auto str() const -> const std::string&
+  {
+    return *value_;
+  }
+
+  [[nodiscard]] auto empty() const -> bool
+  {
+    return value_->empty();
+  }
+
+  [[nodiscard]] auto hash() const noexcept -> std::size_t
+  {
+    return std::hash<const std::string*>{}(value_);
+  }
+
+  friend auto operator==(const metric_label& lhs, const metric_label& rhs) -> bool
+  {
+    return lhs.value_ == rhs.value_;
+  }
+
+  friend auto operator!=(const metric_label& lhs, const metric_label& rhs) -> bool
+  {
+    return lhs.value_ != rhs.value_;
+  }
+
+private:
+  const std::string* value_;
+};
+} // namespace couchbase::core::metrics
@@ -0,0 +1,179 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "openmetrics_writer.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <cmath>
+#include <iterator>
+
+namespace couchbase::core::metrics
+{
+namespace
+{
+void
+append_escaped(std::string& output, std::string_view value)
+{
+  for (const char c : value) {
+    switch (c) {
+      case '\\':
+        output += R"(\\)";
+        break;
+      case '"':
+        output += R"(\")";
+        break;
+      case '\n':
+        output += R"(\n)";
+        break;
+      default:
+        output += c;
+        break;
+    }
+  }
+}
+
+// Floating point values keep their decimal point ("1.0" rather than "1"), which is how OpenMetrics
+// spells them, in "le" labels especially. Infinities and NaN use the spelling of the format too.
+auto
+format_float(double value) -> std::string
+{
+  if (std::isnan(value)) {
+    return "NaN";
+  }
+  if (std::isinf(value)) {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  auto formatted = fmt::format("{}", value);
+  if (formatted.find_first_of(".eEn") == std::string::npos) {
+    formatted += ".0";
+  }
+  return formatted;
+}
+} // namespace
+
+auto
+openmetrics_writer::sanitize_name(std::string_view name) -> std::string
+{
+  std::string sanitized{};
+  sanitized.reserve(name.size());
+  for (const char c : name) {
+    const bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                         (c >= '0' && c <= '9' && !sanitized.empty()) || c == '_' || c == ':';
+    sanitized += allowed ? c : '_';
+  }
+  return sanitized;
+}
+
+void
+openmetrics_writer::counter_family(std::string_view name, std::string_view help)
+{
+  family(name, "counter", help);
+}
+
+void
+openmetrics_writer::gauge_family(std::string_view name, std::string_view help)
+{
+  family(name, "gauge", help);
+}
+
+void
+openmetrics_writer::histogram_family(std::string_view name, std::string_view help)
+{
+  family(name, "histogram", help);
+}
+
+void
+openmetrics_writer::counter(const labels_type& labels, std::uint64_t value)
+{
+  sample("_total", labels, nullptr, fmt::format("{}", value));
+}
+
+void
+openmetrics_writer::gauge(const labels_type& labels, double value)
+{
+  sample({}, labels, nullptr, format_float(value));
+}
+
+void
+openmetrics_writer::histogram(const labels_type& labels,
+                              const std::vector<std::pair<double, std::uint64_t>>& buckets,
+                              double sum,
+                              std::uint64_t count)
+{
+  for (const auto& [bound, cumulative_count] : buckets) {
+    if (std::isinf(bound) && bound > 0) {
+      // the +Inf bucket is always written below, from the total count
+      continue;
+    }
+    const std::pair<std::string_view, std::string> le{ "le", format_float(bound) };
+    sample("_bucket", labels, &le, fmt::format("{}", cumulative_count));
+  }
+  const std::pair<std::string_view, std::string> le{ "le", "+Inf" };
+  sample("_bucket", labels, &le, fmt::format("{}", count));
+  sample("_sum", labels, nullptr, format_float(sum));
+  sample("_count", labels, nullptr, fmt::format("{}", count));
+}
+
+auto
+openmetrics_writer::finish() && -> std::string
+{
+  output_ += "# EOF\n";
+  return std::move(output_);
+}
+
+void
+openmetrics_writer::family(std::string_view name, std::string_view type, std::string_view help)
+{
+  family_ = sanitize_name(name);
+  fmt::format_to(std::back_inserter(output_), "# TYPE {} {}\n# HELP {} ", family_, type, family_);
+  append_escaped(output_, help);
+  output_ += '\n';
+}
+
+void
+openmetrics_writer::sample(std::string_view suffix,
+                           const labels_type& labels,
+                           const std::pair<std::string_view, std::string>* extra_label,
+                           std::string_view value)
+{
+  output_ += family_;
+  output_ += suffix;
+  if (!labels.empty() || extra_label != nullptr) {
+    char separator = '{';
+    for (const auto& [name, label_value] : labels) {
+      output_ += separator;
+      output_ += sanitize_name(name);
+      output_ += "=\"";
+      append_escaped(output_, label_value);
+      output_ += '"';
+      separator = ',';
+    }
+    if (extra_label != nullptr) {
+      output_ += separator;
+      output_ += extra_label->first;
+      output_ += "=\"";
+      append_escaped(output_, extra_label->second);
+      output_ += '"';
+    }
+    output_ += '}';
+  }
+  output_ += ' ';
+  output_ += value;
+  output_ += '\n';
+}
+} // namespace couchbase::core::metrics
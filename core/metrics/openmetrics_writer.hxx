@@ -0,0 +1,75 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::metrics
+{
+/**
+ * Renders metrics in the OpenMetrics text format (the format Prometheus scrapes).
+ *
+ * Every sample has to follow the family it belongs to, so a family is opened with one of the
+ * *_family() calls, and then its samples are written. Metric and label names are sanitized to
+ * the characters the format allows, and label values are escaped.
+ */
+class openmetrics_writer
+{
+public:
+  using labels_type = std::map<std::string, std::string>;
+
+  void counter_family(std::string_view name, std::string_view help);
+  void gauge_family(std::string_view name, std::string_view help);
+  void histogram_family(std::string_view name, std::string_view help);
+
+  void counter(const labels_type& labels, std::uint64_t value);
+  void gauge(const labels_type& labels, double value);
+
+  /**
+   * @param buckets pairs of upper bound and the number of values up to that bound (cumulative),
+   * in ascending order of bound. The "+Inf" bucket is added from @p count, so an infinite bound
+   * in @p buckets is skipped rather than written twice.
+   */
+  void histogram(const labels_type& labels,
+                 const std::vector<std::pair<double, std::uint64_t>>& buckets,
+                 double sum,
+                 std::uint64_t count);
+
+  /**
+   * Terminates the exposition, and hands it out.
+   */
+  [[nodiscard]] auto finish() && -> std::string;
+
+  [[nodiscard]] static auto sanitize_name(std::string_view name) -> std::string;
+
+private:
+  void family(std::string_view name, std::string_view type, std::string_view help);
+  void sample(std::string_view suffix,
+              const labels_type& labels,
+              const std::pair<std::string_view, std::string>* extra_label,
+              std::string_view value);
+
+  std::string output_{};
+  std::string family_{};
+};
+} // namespace couchbase::core::metrics
@@ -20,6 +20,7 @@
 #include "core/cluster_options.hxx"
 #include "core/logger/logger.hxx"
 #include "core/utils/json.hxx"
+#include "core/utils/json_streaming_lexer.hxx"
 #include "core/utils/name_codec.hxx"
 
 #include <couchbase/error_codes.hxx>
@@ -121,9 +122,15 @@ analytics_request::make_response(error_context::analytics&& ctx,
   response.ctx.statement = statement;
   response.ctx.parameters = body_str;
   if (!response.ctx.ec) {
+    // Only the metadata is parsed into a DOM, the rows are sliced out of the body as they are.
+    auto body = utils::json::split_rows(encoded.body.data(), "/results/^", 4);
+    if (body.ec) {
+      response.ctx.ec = errc::common::parsing_failure;
+      return response;
+    }
     tao::json::value payload;
     try {
-      payload = utils::json::parse(encoded.body.data());
+      payload = utils::json::parse(body.meta);
     } catch (const tao::pegtl::parse_error&) {
       response.ctx.ec = errc::common::parsing_failure;
       return response;
@@ -136,12 +143,7 @@ analytics_request::make_response(error_context::analytics&& ctx,
                      response.ctx.client_context_id);
     }
 
-    if (const auto* r = payload.find("results"); r != nullptr) {
-      response.rows.reserve(r->get_array().size());
-      for (const auto& row : r->get_array()) {
-        response.rows.emplace_back(couchbase::core::utils::json::generate(row));
-      }
-    }
+    response.rows = std::move(body.rows);
 
     if (response.meta.status != analytics_response::analytics_status::success) {
       if (!response.meta.errors.empty()) {
@@ -19,6 +19,7 @@
 
 #include "core/error_context/key_value.hxx"
 #include "core/impl/get_replica.hxx"
+#include "core/impl/hedged_read.hxx"
 #include "core/impl/replica_utils.hxx"
 #include "core/impl/with_cancellation.hxx"
 #include "core/operations/document_get.hxx"
@@ -26,6 +27,7 @@
 #include "core/utils/movable_function.hxx"
 #include "couchbase/error_codes.hxx"
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -54,6 +56,18 @@ struct get_any_replica_request {
   couchbase::read_preference read_preference{ couchbase::read_preference::no_preference };
   std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
 
+  /**
+   * Ask the active first, and a replica only when the active has not answered within its recent
+   * 95th percentile latency (or has failed), instead of asking every node at once.
+   */
+  bool hedged{ false };
+
+  /**
+   * Set by a hedged collection#get(): the answer of the active is final, even an error, and a
+   * replica only wins by returning the document before the active answers.
+   */
+  bool authoritative_active{ false };
+
   template<typename Core, typename Handler>
   void execute(Core core, Handler handler)
   {
@@ -63,6 +77,8 @@ struct get_any_replica_request {
        id = id,
        timeout = timeout,
        read_preference = read_preference,
+       hedged = hedged,
+       authoritative_active = authoritative_active,
        parent_span = std::move(parent_span),
        h = std::forward<Handler>(handler)](
         std::error_code ec, std::shared_ptr<topology::configuration> config) mutable {
@@ -116,10 +132,14 @@ struct get_any_replica_request {
           std::mutex mutex_{};
           std::vector<std::shared_ptr<impl::cancellation_token>> cancel_tokens_{};
           std::mutex cancel_tokens_mutex_{};
+          std::shared_ptr<impl::hedged_read> hedge_{};
         };
         auto ctx = std::make_shared<replica_context>(std::move(h), nodes.size());
 
-        for (const auto& node : nodes) {
+        auto send = [core, id, timeout, parent_span, authoritative_active](
+                      const std::shared_ptr<replica_context>& ctx,
+                      const impl::readable_node& node,
+                      std::size_t position) {
           auto subop_span = core->tracer()->create_span(
             node.is_replica ? tracing::operation::mcbp_get_replica : tracing::operation::mcbp_get,
             parent_span);
@@ -134,6 +154,67 @@ struct get_any_replica_request {
             subop_span->add_tag(tracing::attributes::op::collection_name, id.collection());
           }
 
+          auto on_response = [ctx,
+                              subop_span,
+                              position,
+                              authoritative_active,
+                              is_replica = node.is_replica,
+                              started = std::chrono::steady_clock::now()](auto&& resp) {
+            {
+              if (subop_span->uses_tags()) {
+                subop_span->add_tag(tracing::attributes::op::retry_count,
+                                    resp.ctx.retry_attempts());
+              }
+              subop_span->end();
+            }
+            if (ctx->hedge_ && resp.ctx.ec() != errc::common::request_canceled) {
+              ctx->hedge_->record(position, std::chrono::steady_clock::now() - started);
+            }
+            handler_type local_handler{};
+            std::vector<std::shared_ptr<impl::cancellation_token>> cancel_tokens;
+            bool ignored{ false };
+            {
+              std::scoped_lock lock(ctx->mutex_);
+              if (ctx->done_) {
+                return;
+              }
+              --ctx->expected_responses_;
+              // an error from an authoritative active is the answer, not a reason to wait for
+              // the replicas
+              if (resp.ctx.ec() && (is_replica || !authoritative_active)) {
+                if (ctx->expected_responses_ > 0) {
+                  // just ignore the response
+                  ignored = true;
+                } else {
+                  // consider document irretrievable and give up
+                  resp.ctx.override_ec(errc::key_value::document_irretrievable);
+                }
+              }
+              if (!ignored) {
+                ctx->done_ = true;
+                std::swap(local_handler, ctx->handler_);
+                cancel_tokens = ctx->get_cancellation_tokens();
+              }
+            }
+            if (ignored) {
+              // a hedged read does not wait out the delay of a node that has already failed
+              if (ctx->hedge_) {
+                ctx->hedge_->hedge_now();
+              }
+              return;
+            }
+            if (ctx->hedge_) {
+              ctx->hedge_->stop();
+            }
+            for (const auto& token : cancel_tokens) {
+              token->cancel();
+            }
+            if (local_handler) {
+              return local_handler(response_type{
+                std::move(resp.ctx), std::move(resp.value), resp.cas, resp.flags, is_replica });
+            }
+          };
+
           if (node.is_replica) {
             document_id replica_id{ id };
             replica_id.node_index(node.index);
@@ -148,43 +229,7 @@ struct get_any_replica_request {
               },
             };
             ctx->add_cancellation_token(req.cancel_token);
-            core->execute(
-              std::move(req), [ctx, subop_span](auto&& resp) {
-                {
-                  if (subop_span->uses_tags()) {
-                    subop_span->add_tag(tracing::attributes::op::retry_count,
-                                        resp.ctx.retry_attempts());
-                  }
-                  subop_span->end();
-                }
-                handler_type local_handler;
-                std::vector<std::shared_ptr<impl::cancellation_token>> cancel_tokens;
-                {
-                  std::scoped_lock lock(ctx->mutex_);
-                  if (ctx->done_) {
-                    return;
-                  }
-                  --ctx->expected_responses_;
-                  if (resp.ctx.ec()) {
-                    if (ctx->expected_responses_ > 0) {
-                      // just ignore the response
-                      return;
-                    }
-                    // consider document irretrievable and give up
-                    resp.ctx.override_ec(errc::key_value::document_irretrievable);
-                  }
-                  ctx->done_ = true;
-                  std::swap(local_handler, ctx->handler_);
-                  cancel_tokens = ctx->get_cancellation_tokens();
-                }
-                for (const auto& token : cancel_tokens) {
-                  token->cancel();
-                }
-                if (local_handler) {
-                  return local_handler(response_type{
-                    std::move(resp.ctx), std::move(resp.value), resp.cas, resp.flags, true });
-                }
-              });
+            core->execute(std::move(req), std::move(on_response));
           } else {
             impl::with_cancellation<get_request> req{
               {
@@ -197,44 +242,30 @@ struct get_any_replica_request {
               },
             };
             ctx->add_cancellation_token(req.cancel_token);
-            core->execute(std::move(req), [ctx, subop_span](auto&& resp) {
-              {
-                if (subop_span->uses_tags()) {
-                  subop_span->add_tag(tracing::attributes::op::retry_count,
-                                      resp.ctx.retry_attempts());
-                }
-                subop_span->end();
-              }
-              handler_type local_handler{};
-              std::vector<std::shared_ptr<impl::cancellation_token>> cancel_tokens;
-              {
-                std::scoped_lock lock(ctx->mutex_);
-                if (ctx->done_) {
-                  return;
-                }
-                --ctx->expected_responses_;
-                if (resp.ctx.ec()) {
-                  if (ctx->expected_responses_ > 0) {
-                    // just ignore the response
-                    return;
-                  }
-                  // consider document irretrievable and give up
-                  resp.ctx.override_ec(errc::key_value::document_irretrievable);
-                }
-                ctx->done_ = true;
-                std::swap(local_handler, ctx->handler_);
-                cancel_tokens = ctx->get_cancellation_tokens();
-              }
-              for (const auto& token : cancel_tokens) {
-                token->cancel();
-              }
-              if (local_handler) {
-                return local_handler(response_type{
-                  std::move(resp.ctx), std::move(resp.value), resp.cas, resp.flags, false });
-              }
-            });
+            core->execute(std::move(req), std::move(on_response));
           }
+        };
+
+        if (!hedged) {
+          for (std::size_t position = 0; position < nodes.size(); ++position) {
+            send(ctx, nodes[position], position);
+          }
+          return;
         }
+
+        auto endpoints = impl::order_for_hedged_read(id, nodes, config, *core->read_latencies());
+        ctx->hedge_ = std::make_shared<impl::hedged_read>(
+          core->io_context(),
+          core->read_latencies(),
+          std::move(endpoints),
+          [weak_ctx = std::weak_ptr<replica_context>{ ctx },
+           send = std::move(send),
+           nodes = std::move(nodes)](std::size_t position) {
+            if (auto ctx = weak_ctx.lock(); ctx) {
+              send(ctx, nodes[position], position);
+            }
+          });
+        ctx->hedge_->start();
       });
   }
 };
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "core/error_context/key_value.hxx"
+#include "core/impl/hedged_read.hxx"
 #include "core/impl/lookup_in_replica.hxx"
 #include "core/impl/replica_utils.hxx"
 #include "core/impl/subdoc/command.hxx"
@@ -31,6 +32,8 @@
 #include <couchbase/error_codes.hxx>
 #include <couchbase/read_preference.hxx>
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -70,6 +73,19 @@ struct lookup_in_any_replica_request {
   couchbase::read_preference read_preference{ couchbase::read_preference::no_preference };
   bool access_deleted{ false };
 
+  /**
+   * Ask the active first, and a replica only when the active has not answered within its recent
+   * 95th percentile latency (or has not found the document), instead of asking every node at once.
+   */
+  bool hedged{ false };
+
+  /**
+   * Set by a hedged collection#lookup_in(): the answer of the active is final, even an error, and a
+   * replica only wins by returning the document before the active answers. When the cluster cannot
+   * read subdocuments from replicas, only the active is asked.
+   */
+  bool authoritative_active{ false };
+
   template<typename Core, typename Handler>
   void execute(Core core, Handler handler)
   {
@@ -82,6 +98,8 @@ struct lookup_in_any_replica_request {
        parent_span = parent_span,
        read_preference = read_preference,
        access_deleted = access_deleted,
+       hedged = hedged,
+       authoritative_active = authoritative_active,
        h = std::forward<Handler>(handler)](std::error_code ec) mutable {
         if (ec) {
           std::optional<std::string> first_error_path{};
@@ -102,9 +120,12 @@ struct lookup_in_any_replica_request {
            parent_span,
            read_preference,
            access_deleted,
+           hedged,
+           authoritative_active,
            h = std::forward<Handler>(h)](std::error_code ec,
                                          std::shared_ptr<topology::configuration> config) mutable {
-            if (!config->capabilities.supports_subdoc_read_replica()) {
+            const bool replicas_readable = config->capabilities.supports_subdoc_read_replica();
+            if (!replicas_readable && !authoritative_active) {
               ec = errc::common::feature_not_available;
             }
             const auto [e, origin] = core->origin();
@@ -114,6 +135,14 @@ struct lookup_in_any_replica_request {
 
             auto nodes =
               impl::effective_nodes(id, config, read_preference, origin.options().server_group);
+            if (!replicas_readable) {
+              nodes.erase(std::remove_if(nodes.begin(),
+                                         nodes.end(),
+                                         [](const impl::readable_node& node) {
+                                           return node.is_replica;
+                                         }),
+                          nodes.end());
+            }
             if (nodes.empty()) {
               CB_LOG_DEBUG(
                 "Unable to retrieve replicas for \"{}\", server_group={}, number_of_replicas={}",
@@ -164,10 +193,19 @@ struct lookup_in_any_replica_request {
               std::mutex mutex_{};
               std::vector<std::shared_ptr<impl::cancellation_token>> cancel_tokens_{};
               std::mutex cancel_tokens_mutex_{};
+              std::shared_ptr<impl::hedged_read> hedge_{};
             };
             auto ctx = std::make_shared<replica_context>(std::move(h), nodes.size());
 
-            for (const auto& node : nodes) {
+            auto send = [core,
+                         id,
+                         specs,
+                         timeout,
+                         parent_span,
+                         access_deleted,
+                         authoritative_active](const std::shared_ptr<replica_context>& ctx,
+                                               const impl::readable_node& node,
+                                               std::size_t position) {
               auto subop_span = core->tracer()->create_span(
                 node.is_replica ? tracing::operation::mcbp_lookup_in_replica
                                 : tracing::operation::mcbp_lookup_in,
@@ -183,6 +221,87 @@ struct lookup_in_any_replica_request {
                 subop_span->add_tag(tracing::attributes::op::collection_name, id.collection());
               }
 
+              auto on_response = [ctx,
+                                  subop_span,
+                                  position,
+                                  authoritative_active,
+                                  is_replica = node.is_replica,
+                                  started = std::chrono::steady_clock::now()](auto&& resp) {
+                {
+                  if (subop_span->uses_tags()) {
+                    subop_span->add_tag(tracing::attributes::op::retry_count,
+                                        resp.ctx.retry_attempts());
+                  }
+                  subop_span->end();
+                }
+                if (ctx->hedge_ && resp.ctx.ec() != errc::common::request_canceled) {
+                  ctx->hedge_->record(position, std::chrono::steady_clock::now() - started);
+                }
+                handler_type local_handler{};
+                std::vector<std::shared_ptr<impl::cancellation_token>> cancel_tokens;
+                bool ignored{ false };
+                {
+                  std::scoped_lock lock(ctx->mutex_);
+                  if (ctx->done_) {
+                    return;
+                  }
+                  --ctx->expected_responses_;
+                  // a failed read of an authoritative active is the answer, not a reason to
+                  // wait for the replicas
+                  if (resp.fields.empty() && (is_replica || !authoritative_active)) {
+                    // document was not retrieved (e.g. not_found, access error) —
+                    // for lookup_in, fields are only populated when the document
+                    // is successfully fetched; ctx.ec() is used only for
+                    // document-level errors, and per-path failures (such as
+                    // subdoc_multi_path_failure) still produce non-empty fields
+                    if (ctx->expected_responses_ > 0) {
+                      // just ignore the response
+                      ignored = true;
+                    } else {
+                      // consider document irretrievable and give up
+                      resp.ctx.override_ec(errc::key_value::document_irretrievable);
+                    }
+                  }
+                  if (!ignored) {
+                    ctx->done_ = true;
+                    std::swap(local_handler, ctx->handler_);
+                    cancel_tokens = ctx->get_cancellation_tokens();
+                  }
+                }
+                if (ignored) {
+                  // a hedged read does not wait out the delay of a node that has already failed
+                  if (ctx->hedge_) {
+                    ctx->hedge_->hedge_now();
+                  }
+                  return;
+                }
+                if (ctx->hedge_) {
+                  ctx->hedge_->stop();
+                }
+                for (const auto& token : cancel_tokens) {
+                  token->cancel();
+                }
+                if (local_handler) {
+                  response_type res{};
+                  res.ctx = resp.ctx;
+                  res.cas = resp.cas;
+                  res.deleted = resp.deleted;
+                  res.is_replica = is_replica;
+                  for (auto& field : resp.fields) {
+                    auto lookup_in_entry = lookup_in_any_replica_response::entry{};
+                    lookup_in_entry.path = field.path;
+                    lookup_in_entry.value = field.value;
+                    lookup_in_entry.status = field.status;
+                    lookup_in_entry.ec = field.ec;
+                    lookup_in_entry.exists = field.exists;
+                    lookup_in_entry.original_index = field.original_index;
+                    lookup_in_entry.opcode = field.opcode;
+                    res.fields.emplace_back(lookup_in_entry);
+                  }
+                  return local_handler(res);
+                }
+              };
+
               if (node.is_replica) {
                 document_id replica_id{ id };
                 replica_id.node_index(node.index);
@@ -196,62 +315,7 @@ struct lookup_in_any_replica_request {
                 };
                 ctx->add_cancellation_token(replica_req.cancel_token);
                 replica_req.access_deleted = access_deleted;
-                core->execute(replica_req, [ctx, subop_span](auto&& resp) {
-                  {
-                    if (subop_span->uses_tags()) {
-                      subop_span->add_tag(tracing::attributes::op::retry_count,
-                                          resp.ctx.retry_attempts());
-                    }
-                    subop_span->end();
-                  }
-                  handler_type local_handler;
-                  std::vector<std::shared_ptr<impl::cancellation_token>> cancel_tokens;
-                  {
-                    std::scoped_lock lock(ctx->mutex_);
-                    if (ctx->done_) {
-                      return;
-                    }
-                    --ctx->expected_responses_;
-                    if (resp.fields.empty()) {
-                      // document was not retrieved (e.g. not_found, access error) —
-                      // for lookup_in, fields are only populated when the document
-                      // is successfully fetched; ctx.ec() is used only for
-                      // document-level errors, and per-path failures (such as
-                      // subdoc_multi_path_failure) still produce non-empty fields
-                      if (ctx->expected_responses_ > 0) {
-                        // just ignore the response
-                        return;
-                      }
-                      // consider document irretrievable and give up
-                      resp.ctx.override_ec(errc::key_value::document_irretrievable);
-                    }
-                    ctx->done_ = true;
-                    std::swap(local_handler, ctx->handler_);
-                    cancel_tokens = ctx->get_cancellation_tokens();
-                  }
-                  for (const auto& token : cancel_tokens) {
-                    token->cancel();
-                  }
-                  if (local_handler) {
-                    response_type res{};
-                    res.ctx = resp.ctx;
-                    res.cas = resp.cas;
-                    res.deleted = resp.deleted;
-                    res.is_replica = true;
-                    for (auto& field : resp.fields) {
-                      auto lookup_in_entry = lookup_in_any_replica_response::entry{};
-                      lookup_in_entry.path = field.path;
-                      lookup_in_entry.value = field.value;
-                      lookup_in_entry.status = field.status;
-                      lookup_in_entry.ec = field.ec;
-                      lookup_in_entry.exists = field.exists;
-                      lookup_in_entry.original_index = field.original_index;
-                      lookup_in_entry.opcode = field.opcode;
-                      res.fields.emplace_back(lookup_in_entry);
-                    }
-                    return local_handler(res);
-                  }
-                });
+                core->execute(replica_req, std::move(on_response));
               } else {
                 impl::with_cancellation<lookup_in_request> req{
                   {
@@ -266,62 +330,31 @@ struct lookup_in_any_replica_request {
                   },
                 };
                 ctx->add_cancellation_token(req.cancel_token);
-                core->execute(std::move(req), [subop_span, ctx](auto&& resp) {
-                  {
-                    if (subop_span->uses_tags()) {
-                      subop_span->add_tag(tracing::attributes::op::retry_count,
-                                          resp.ctx.retry_attempts());
-                    }
-                    subop_span->end();
-                  }
-                  handler_type local_handler{};
-                  std::vector<std::shared_ptr<impl::cancellation_token>> cancel_tokens;
-                  {
-                    std::scoped_lock lock(ctx->mutex_);
-                    if (ctx->done_) {
-                      return;
-                    }
-                    --ctx->expected_responses_;
-                    if (resp.fields.empty()) {
-                      // document was not retrieved (e.g. not_found, access error) —
-                      // use fields.empty() to distinguish this from successful multi-lookups
-                      // (including those with per-path failures), which still return fields
-                      if (ctx->expected_responses_ > 0) {
-                        // just ignore the response
-                        return;
-                      }
-                      // consider document irretrievable and give up
-                      resp.ctx.override_ec(errc::key_value::document_irretrievable);
-                    }
-                    ctx->done_ = true;
-                    std::swap(local_handler, ctx->handler_);
-                    cancel_tokens = ctx->get_cancellation_tokens();
-                  }
-                  for (const auto& token : cancel_tokens) {
-                    token->cancel();
-                  }
-                  if (local_handler) {
-                    auto res = response_type{};
-                    res.ctx = resp.ctx;
-                    res.cas = resp.cas;
-                    res.deleted = resp.deleted;
-                    res.is_replica = false;
-                    for (auto& field : resp.fields) {
-                      auto lookup_in_entry = lookup_in_any_replica_response::entry{};
-                      lookup_in_entry.path = field.path;
-                      lookup_in_entry.value = field.value;
-                      lookup_in_entry.status = field.status;
-                      lookup_in_entry.ec = field.ec;
-                      lookup_in_entry.exists = field.exists;
-                      lookup_in_entry.original_index = field.original_index;
-                      lookup_in_entry.opcode = field.opcode;
-                      res.fields.emplace_back(lookup_in_entry);
-                    }
-                    return local_handler(res);
-                  }
-                });
+                core->execute(std::move(req), std::move(on_response));
               }
+            };
+
+            if (!hedged) {
+              for (std::size_t position = 0; position < nodes.size(); ++position) {
+                send(ctx, nodes[position], position);
+              }
+              return;
             }
+
+            auto endpoints =
+              impl::order_for_hedged_read(id, nodes, config, *core->read_latencies());
+            ctx->hedge_ = std::make_shared<impl::hedged_read>(
+              core->io_context(),
+              core->read_latencies(),
+              std::move(endpoints),
+              [weak_ctx = std::weak_ptr<replica_context>{ ctx },
+               send = std::move(send),
+               nodes = std::move(nodes)](std::size_t position) {
+                if (auto ctx = weak_ctx.lock(); ctx) {
+                  send(ctx, nodes[position], position);
+                }
+              });
+            ctx->hedge_->start();
           });
       });
   }
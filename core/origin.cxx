@@ -291,6 +291,8 @@ origin::to_json() const -> std::string
         { "tcp_keep_alive_interval", options_.tcp_keep_alive_interval },
         { "config_idle_redial_timeout", options_.config_idle_redial_timeout },
         { "max_http_connections", options_.max_http_connections },
+        { "kv_connections_per_node", options_.kv_connections_per_node },
+        { "query_cache_capacity", options_.query_cache_capacity },
         { "idle_http_connection_timeout", options_.idle_http_connection_timeout },
         { "metrics_options", options_.metrics_options },
         { "tracing_options", options_.tracing_options },
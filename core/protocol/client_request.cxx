@@ -16,24 +16,48 @@
  */
 
 #include "client_request.hxx"
-#include "core/utils/binary.hxx"
 
 #include <snappy.h>
 
+#include <cstring>
+
 namespace couchbase::core::protocol
 {
+namespace
+{
+// Values up to this size are compressed in a buffer that the thread keeps for the next one; the
+// buffer for a larger value is released right after use.
+constexpr std::size_t max_retained_compression_buffer{ 1024 * 1024 };
+} // namespace
+
 auto
-compress_value(const std::vector<std::byte>& value, const std::vector<std::byte>::iterator& output)
-  -> std::pair<bool, std::uint32_t>
+compress_value(const std::vector<std::byte>& value,
+               const std::vector<std::byte>::iterator& output,
+               const compression_policy& policy) -> std::pair<bool, std::uint32_t>
 {
-  static const double min_ratio = 0.83;
+  thread_local std::vector<char> buffer{};
+
+  const auto max_size = snappy::MaxCompressedLength(value.size());
+  if (buffer.size() < max_size) {
+    buffer.resize(max_size);
+  }
+  std::size_t compressed_size{ 0 };
+  snappy::RawCompress(
+    reinterpret_cast<const char*>(value.data()), value.size(), buffer.data(), &compressed_size);
 
-  std::string compressed;
-  const std::size_t compressed_size =
-    snappy::Compress(reinterpret_cast<const char*>(value.data()), value.size(), &compressed);
-  if (gsl::narrow_cast<double>(compressed_size) / gsl::narrow_cast<double>(value.size()) <
-      min_ratio) {
-    utils::to_binary(compressed, output);
+  const auto ratio =
+    gsl::narrow_cast<double>(compressed_size) / gsl::narrow_cast<double>(value.size());
+  if (policy.sampler != nullptr) {
+    policy.sampler->record(ratio);
+  }
+  const bool use_compressed = ratio <= policy.min_ratio && compressed_size < value.size();
+  if (use_compressed) {
+    std::memcpy(&*output, buffer.data(), compressed_size);
+  }
+  if (buffer.size() > max_retained_compression_buffer) {
+    buffer = {};
+  }
+  if (use_compressed) {
     return { true, gsl::narrow_cast<std::uint32_t>(compressed_size) };
   }
   return { false, 0 };
@@ -21,6 +21,7 @@
 
 #include "client_opcode.hxx"
 #include "client_response.hxx"
+#include "compression_policy.hxx"
 #include "core/utils/binary.hxx"
 #include "core/utils/byteswap.hxx"
 #include "datatype.hxx"
@@ -29,12 +30,45 @@
 #include <algorithm>
 #include <cstring>
 #include <gsl/util>
+#include <type_traits>
+#include <utility>
 
 namespace couchbase::core::protocol
 {
+/**
+ * Compresses @p value and, if the result satisfies @p policy, copies it to @p output (which must
+ * have room for value.size() bytes). The compression itself runs in a buffer reused by the thread.
+ * The achieved ratio is recorded in the sampler of the policy, if any.
+ *
+ * @return whether the value was compressed, and its compressed size
+ */
 auto
-compress_value(const std::vector<std::byte>& value, const std::vector<std::byte>::iterator& output)
-  -> std::pair<bool, std::uint32_t>;
+compress_value(const std::vector<std::byte>& value,
+               const std::vector<std::byte>::iterator& output,
+               const compression_policy& policy) -> std::pair<bool, std::uint32_t>;
+
+/**
+ * A request encoded for a gathered write. When the value is detached, `frame` holds the header,
+ * framing extras, extras and key, and the value follows it on the wire from its own buffer.
+ * Otherwise `frame` is the complete request and `value` is empty.
+ */
+struct gathered_payload {
+  std::vector<std::byte> frame{};
+  std::vector<std::byte> value{};
+};
+
+/**
+ * Bodies that can give up their value buffer (take_value()) so that it is written to the socket
+ * as it is, instead of being copied into the frame.
+ */
+template<typename Body, typename = void>
+struct has_detachable_value : std::false_type {
+};
+
+template<typename Body>
+struct has_detachable_value<Body, std::void_t<decltype(std::declval<Body&>().take_value())>>
+  : std::true_type {
+};
 
 template<typename Body>
 class client_request
@@ -56,11 +90,32 @@ private:
   Body body_;
 
 public:
+  // Smallest value that gathered_data() detaches from the frame. Below it, copying the value is
+  // cheaper than giving the write one more buffer to gather.
+  static constexpr std::size_t min_size_to_gather = 16 * 1024;
+
   [[nodiscard]] auto opcode() const -> client_opcode
   {
     return opcode_;
   }
 
+  /**
+   * @return true if the request carries a document value that may be sent compressed, i.e. the
+   * compression policy passed to data() or gathered_data() is consulted at all
+   */
+  [[nodiscard]] auto compresses_value() const -> bool
+  {
+    switch (opcode_) {
+      case protocol::client_opcode::insert:
+      case protocol::client_opcode::upsert:
+      case protocol::client_opcode::replace:
+        return true;
+      default:
+        break;
+    }
+    return false;
+  }
+
   void opaque(std::uint32_t val)
   {
     opaque_ = utils::byte_swap(val);
@@ -103,19 +158,44 @@ public:
 
   [[nodiscard]] auto data(bool try_to_compress = false) -> std::vector<std::byte>
   {
-    switch (opcode_) {
-      case protocol::client_opcode::insert:
-      case protocol::client_opcode::upsert:
-      case protocol::client_opcode::replace:
-        return generate_payload(try_to_compress);
-      default:
-        break;
+    if (compresses_value()) {
+      return generate_payload(try_to_compress ? &default_compression_policy : nullptr);
     }
-    return generate_payload(false);
+    return generate_payload(nullptr);
+  }
+
+  /**
+   * Encodes the request like data(), but leaves a large document value out of the frame, so that
+   * the value reaches the socket without being copied.
+   *
+   * The value is moved out of the body, so the request has to be encoded again before it can be
+   * sent another time (mcbp_command::send() does so on every attempt).
+   *
+   * @param compression when the value of a mutation is sent compressed, or nullptr to never
+   * compress it (e.g. when the connection did not negotiate snappy)
+   */
+  [[nodiscard]] auto gathered_data(const compression_policy* compression = nullptr)
+    -> gathered_payload
+  {
+    if (!compresses_value()) {
+      return { generate_payload(nullptr), {} };
+    }
+    if constexpr (has_detachable_value<Body>::value) {
+      if (body_.value().size() >= min_size_to_gather) {
+        gathered_payload payload{};
+        payload.frame = generate_payload(compression, &payload.value);
+        return payload;
+      }
+    }
+    return { generate_payload(compression), {} };
   }
 
 private:
-  [[nodiscard]] auto generate_payload(bool try_to_compress) -> std::vector<std::byte>
+  // When detached_value is given, the value is not copied after the key but moved into
+  // *detached_value, unless it ends up compressed in the frame.
+  [[nodiscard]] auto generate_payload(const compression_policy* compression,
+                                      std::vector<std::byte>* detached_value = nullptr)
+    -> std::vector<std::byte>
   {
     // Bind the body's four wire regions once. Note that value()/extras() on some bodies (e.g.
     // hello, mutate_in) lazily populate their buffers on first access, so this also materialises
@@ -139,7 +219,9 @@ private:
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wnull-dereference"
 #endif
-    std::vector<std::byte> payload(header_size + body_size_bytes, std::byte{});
+    const std::size_t value_offset = header_size + body_size_bytes - value.size();
+    std::vector<std::byte> payload(
+      detached_value == nullptr ? header_size + body_size_bytes : value_offset, std::byte{});
     payload[0] = static_cast<std::byte>(magic_);
     payload[1] = static_cast<std::byte>(opcode_);
 #if defined(__GNUC__) && __GNUC__ >= 8 && __GNUC__ < 12
@@ -178,9 +260,16 @@ private:
     body_itr = std::copy(extras.begin(), extras.end(), body_itr);
     body_itr = utils::to_binary(key, body_itr);
 
-    if (static const std::size_t min_size_to_compress = 32;
-        try_to_compress && value.size() > min_size_to_compress) {
-      if (auto [compressed, new_value_size] = compress_value(value, body_itr); compressed) {
+    if (compression != nullptr && !value.empty() && value.size() >= compression->min_size &&
+        (compression->sampler == nullptr ||
+         compression->sampler->should_try(compression->min_ratio))) {
+      if (payload.size() < header_size + body_size_bytes) {
+        // the value was going to be detached, make room for its compressed form
+        payload.resize(header_size + body_size_bytes);
+        body_itr = payload.begin() + static_cast<std::ptrdiff_t>(value_offset);
+      }
+      if (auto [compressed, new_value_size] = compress_value(value, body_itr, *compression);
+          compressed) {
         /* the compressed value meets requirements and was copied to the payload */
         protocol::set_flag(payload[5], protocol::datatype::snappy);
         std::uint32_t new_body_size = utils::byte_swap(body_size) -
@@ -192,6 +281,13 @@ private:
         return payload;
       }
     }
+    if constexpr (has_detachable_value<Body>::value) {
+      if (detached_value != nullptr) {
+        payload.resize(value_offset);
+        *detached_value = body_.take_value();
+        return payload;
+      }
+    }
     std::copy(value.begin(), value.end(), body_itr);
     return payload;
   }
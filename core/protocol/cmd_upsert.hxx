@@ -111,6 +111,11 @@ public:
     return content_;
   }
 
+  [[nodiscard]] auto take_value() -> std::vector<std::byte>
+  {
+    return std::move(content_);
+  }
+
   [[nodiscard]] auto size() -> std::size_t
   {
     if (extras_.empty()) {
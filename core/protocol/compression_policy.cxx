@@ -0,0 +1,64 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "compression_policy.hxx"
+
+#include <algorithm>
+
+namespace couchbase::core::protocol
+{
+namespace
+{
+constexpr double fixed_point_one{ 65536.0 };
+// weight of a new sample in the moving average
+constexpr std::uint32_t smoothing_shift{ 3 };
+} // namespace
+
+auto
+compression_sampler::should_try(double min_ratio) -> bool
+{
+  const auto average = average_ratio();
+  if (average == 0.0 || average <= min_ratio) {
+    return true;
+  }
+  return skipped_.fetch_add(1, std::memory_order_relaxed) % probe_interval == probe_interval - 1;
+}
+
+void
+compression_sampler::record(double ratio)
+{
+  // snappy can grow incompressible input slightly, clamp so that one outlier does not dominate
+  const auto sample =
+    static_cast<std::uint32_t>(std::clamp(ratio, 1.0 / fixed_point_one, 2.0) * fixed_point_one);
+  const auto average = average_.load(std::memory_order_relaxed);
+  if (average == 0) {
+    average_.store(sample, std::memory_order_relaxed);
+    return;
+  }
+  const auto updated = static_cast<std::int64_t>(average) +
+                       ((static_cast<std::int64_t>(sample) - static_cast<std::int64_t>(average)) /
+                        (std::int64_t{ 1 } << smoothing_shift));
+  average_.store(static_cast<std::uint32_t>(std::max<std::int64_t>(updated, 1)),
+                 std::memory_order_relaxed);
+}
+
+auto
+compression_sampler::average_ratio() const -> double
+{
+  return static_cast<double>(average_.load(std::memory_order_relaxed)) / fixed_point_one;
+}
+} // namespace couchbase::core::protocol
@@ -0,0 +1,74 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace couchbase::core::protocol
+{
+/**
+ * Keeps a moving average of how well the values written to one collection compressed, so that
+ * adaptive compression can stop spending CPU on values that do not shrink (already compressed
+ * media, encrypted fields and the like).
+ *
+ * The state is two relaxed atomics. Concurrent updates may occasionally lose a sample, which is
+ * fine for a heuristic.
+ */
+class compression_sampler
+{
+public:
+  // While the average is above the threshold, one write in this many is still compressed to
+  // notice when the values become compressible again.
+  static constexpr std::uint32_t probe_interval{ 16 };
+
+  /**
+   * @return true if the next value is worth compressing.
+   */
+  [[nodiscard]] auto should_try(double min_ratio) -> bool;
+
+  /**
+   * Records the compressed-to-original size ratio of a value.
+   */
+  void record(double ratio);
+
+  /**
+   * @return the moving average of the recorded ratios, or zero if nothing was recorded yet.
+   */
+  [[nodiscard]] auto average_ratio() const -> double;
+
+private:
+  // ratio in 16.16 fixed point, zero until the first sample
+  std::atomic<std::uint32_t> average_{ 0 };
+  std::atomic<std::uint32_t> skipped_{ 0 };
+};
+
+/**
+ * When a document value is sent compressed: it has at least @c min_size bytes, and snappy shrinks
+ * it to at most @c min_ratio of its size. With a @c sampler (adaptive mode), values of collections
+ * that have recently been incompressible are mostly not even tried.
+ */
+struct compression_policy {
+  std::size_t min_size{ 32 };
+  double min_ratio{ 0.83 };
+  compression_sampler* sampler{ nullptr };
+};
+
+inline constexpr compression_policy default_compression_policy{};
+} // namespace couchbase::core::protocol
@@ -18,10 +18,12 @@
 #pragma once
 
 #include "core/operations/document_query.hxx"
+#include "row_batch.hxx"
 #include "row_streamer.hxx"
 #include "stream_error_details.hxx"
 #include "utils/movable_function.hxx"
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -86,6 +88,16 @@ public:
   void next_row(
     utils::movable_function<void(std::optional<std::string> row, std::error_code)>&& handler);
 
+  /**
+   * Retrieves the rows that are ready, up to max_rows and max_bytes of row data (see
+   * row_streamer::next_rows), waiting only for the first one. A non-empty batch is delivered with a
+   * falsy error_code. An empty batch signals the end, with the same error_code next_row would
+   * report for it.
+   */
+  void next_rows(std::size_t max_rows,
+                 std::size_t max_bytes,
+                 utils::movable_function<void(row_batch, std::error_code)>&& handler);
+
   /**
    * Signature captured from the preamble (available after start resolves).
    */
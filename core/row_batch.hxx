@@ -0,0 +1,60 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace couchbase::core
+{
+/**
+ * A run of rows stored back to back in one buffer. Row @c i spans
+ * <tt>[offsets[i], offsets[i + 1])</tt> of @c data, so @c offsets holds one entry more than there
+ * are rows (or none at all for an empty batch).
+ */
+struct row_batch {
+  std::string data{};
+  std::vector<std::size_t> offsets{};
+
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return offsets.empty() ? 0 : offsets.size() - 1;
+  }
+
+  [[nodiscard]] auto empty() const -> bool
+  {
+    return size() == 0;
+  }
+
+  [[nodiscard]] auto operator[](std::size_t index) const -> std::string_view
+  {
+    return std::string_view{ data }.substr(offsets[index], offsets[index + 1] - offsets[index]);
+  }
+
+  void append(std::string_view row)
+  {
+    if (offsets.empty()) {
+      offsets.push_back(0);
+    }
+    data.append(row);
+    offsets.push_back(data.size());
+  }
+};
+} // namespace couchbase::core
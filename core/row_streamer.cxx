@@ -34,8 +34,10 @@
 #include <asio/steady_timer.hpp>
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -137,6 +139,9 @@ public:
 
   void next_row(utils::movable_function<void(std::string, std::error_code)>&& handler)
   {
+    if (auto end = take_pending_end(); end.has_value()) {
+      return handler({}, end.value());
+    }
     if (!rows_.is_open()) {
       handler({}, errc::common::request_canceled);
       return;
@@ -151,12 +156,7 @@ public:
           return handler({}, ec);
         }
         if (std::holds_alternative<row_stream_end_signal>(row)) {
-          auto& signal = std::get<row_stream_end_signal>(row);
-          if (!signal.metadata.empty()) {
-            const std::scoped_lock<std::mutex> lock{ self->metadata_mutex_ };
-            self->metadata_ = std::move(signal.metadata);
-          }
-          return handler({}, signal.ec);
+          return handler({}, self->end_of_stream(std::get<row_stream_end_signal>(row)));
         }
         auto row_content = std::move(std::get<std::string>(row));
         const auto row_bytes = row_content.size();
@@ -171,6 +171,59 @@ public:
       });
   }
 
+  void next_rows(std::size_t max_rows,
+                 std::size_t max_bytes,
+                 utils::movable_function<void(row_batch, std::error_code)>&& handler)
+  {
+    if (auto end = take_pending_end(); end.has_value()) {
+      return handler({}, end.value());
+    }
+    if (!rows_.is_open()) {
+      handler({}, errc::common::request_canceled);
+      return;
+    }
+    rows_.async_receive(
+      [self = shared_from_this(), max_rows, max_bytes, handler = std::move(handler)](
+        auto ec, auto row) mutable {
+        if (ec) {
+          if (ec == asio::experimental::error::channel_closed ||
+              ec == asio::experimental::error::channel_cancelled) {
+            return handler({}, errc::common::request_canceled);
+          }
+          return handler({}, ec);
+        }
+        if (std::holds_alternative<row_stream_end_signal>(row)) {
+          return handler({}, self->end_of_stream(std::get<row_stream_end_signal>(row)));
+        }
+
+        row_batch batch{};
+        batch.append(std::get<std::string>(row));
+        // Top the batch up with the rows that are already in the channel, without waiting for more.
+        // An end signal found on the way is kept for the next pull, so these rows go out first.
+        bool more = true;
+        while (more && batch.size() < max_rows && batch.data.size() < max_bytes) {
+          more = self->rows_.try_receive([&self, &batch, &more](auto next_ec, auto next) {
+            if (next_ec) {
+              more = false;
+            } else if (std::holds_alternative<row_stream_end_signal>(next)) {
+              const std::scoped_lock<std::mutex> lock{ self->metadata_mutex_ };
+              self->pending_end_ = std::move(std::get<row_stream_end_signal>(next));
+              more = false;
+            } else {
+              batch.append(std::get<std::string>(next));
+            }
+          });
+        }
+        const auto batch_bytes = batch.data.size();
+        handler(std::move(batch), {});
+
+        self->release_buffered_bytes(batch_bytes);
+        if (self->should_resume()) {
+          self->maybe_feed_lexer();
+        }
+      });
+  }
+
   void cancel()
   {
     // Tear the HTTP body (and the socket + timers it owns on the session) down on the io_context
@@ -205,6 +258,30 @@ public:
   }
 
 private:
+  // Records the metadata carried by the end signal and returns the terminal error.
+  auto end_of_stream(row_stream_end_signal& signal) -> std::error_code
+  {
+    if (!signal.metadata.empty()) {
+      const std::scoped_lock<std::mutex> lock{ metadata_mutex_ };
+      metadata_ = std::move(signal.metadata);
+    }
+    return signal.ec;
+  }
+
+  // The end signal that next_rows() came across while filling a batch, if any.
+  auto take_pending_end() -> std::optional<std::error_code>
+  {
+    std::optional<row_stream_end_signal> signal{};
+    {
+      const std::scoped_lock<std::mutex> lock{ metadata_mutex_ };
+      std::swap(signal, pending_end_);
+    }
+    if (!signal.has_value()) {
+      return {};
+    }
+    return end_of_stream(signal.value());
+  }
+
   // Resolve start()'s preamble handler exactly once. The lexer delivers it on a well-formed
   // response (rows-array open or clean root pop); the terminal paths in maybe_feed_lexer call this
   // with an error so a response that never produces a metadata header (empty body, or a valid but
@@ -386,6 +463,8 @@ private:
   // Bumped on every arm/cancel of the idle timer so a superseded timer completion is ignored.
   std::atomic_uint64_t idle_generation_{ 0 };
   std::optional<std::string> metadata_;
+  // An end signal next_rows() took off the channel behind the rows of a batch (metadata_mutex_).
+  std::optional<row_stream_end_signal> pending_end_{};
   utils::json::streaming_lexer lexer_;
   std::mutex data_feed_mutex_{};
   std::mutex metadata_mutex_{};
@@ -417,6 +496,14 @@ row_streamer::cancel()
   impl_->cancel();
 }
 
+void
+row_streamer::next_rows(std::size_t max_rows,
+                        std::size_t max_bytes,
+                        utils::movable_function<void(row_batch, std::error_code)>&& handler)
+{
+  impl_->next_rows(max_rows, max_bytes, std::move(handler));
+}
+
 auto
 row_streamer::metadata() -> std::optional<std::string>
 {
@@ -17,9 +17,11 @@
 
 #pragma once
 
+#include "row_batch.hxx"
 #include "row_streamer_options.hxx"
 #include "utils/movable_function.hxx"
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -54,6 +56,16 @@ public:
    */
   void next_row(utils::movable_function<void(std::string, std::error_code)>&& handler);
 
+  /**
+   * Retrieves up to max_rows rows at once. Only the first row is waited for; the batch then takes
+   * whatever rows are already buffered, and stops once it holds max_bytes of row data (so it can
+   * exceed max_bytes by one row). An empty batch signals the end, like an empty row does for
+   * next_row().
+   */
+  void next_rows(std::size_t max_rows,
+                 std::size_t max_bytes,
+                 utils::movable_function<void(row_batch, std::error_code)>&& handler);
+
   /**
    * Cancels the row stream & closes the HTTP connection
    */
@@ -0,0 +1,252 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "salted_password_cache.h"
+
+#include "core/crypto/cbcrypto.h"
+#include "core/platform/random.h"
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace couchbase::core::sasl::mechanism::scram
+{
+namespace
+{
+auto
+page_size() -> std::size_t
+{
+#ifdef _WIN32
+  SYSTEM_INFO info{};
+  GetSystemInfo(&info);
+  return info.dwPageSize;
+#else
+  return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void
+wipe(char* data, std::size_t size)
+{
+  // the volatile access keeps the compiler from dropping the stores as dead
+  volatile char* ptr = data;
+  for (std::size_t i = 0; i < size; ++i) {
+    ptr[i] = 0;
+  }
+}
+
+// The key of the password checks, drawn once per process.
+auto
+password_check_key() -> const locked_secret&
+{
+  static const locked_secret key = []() {
+    std::array<char, 32> bytes{};
+    if (!RandomGenerator::getBytes(bytes.data(), bytes.size())) {
+      throw std::runtime_error("salted_password_cache: failed to generate the password check key");
+    }
+    const std::string_view view{ bytes.data(), bytes.size() };
+    // constructed in place (guaranteed copy elision), the key is never copied
+    struct wipe_bytes {
+      std::array<char, 32>& bytes;
+      ~wipe_bytes()
+      {
+        wipe(bytes.data(), bytes.size());
+      }
+    } guard{ bytes };
+    return locked_secret{ view };
+  }();
+  return key;
+}
+} // namespace
+
+locked_secret::locked_secret(std::string_view value)
+  : size_{ value.size() }
+{
+  const auto page = page_size();
+  mapped_size_ = std::max<std::size_t>((size_ + page - 1) / page, 1) * page;
+#ifdef _WIN32
+  data_ = static_cast<char*>(
+    VirtualAlloc(nullptr, mapped_size_, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+  if (data_ == nullptr) {
+    throw std::bad_alloc();
+  }
+  locked_ = VirtualLock(data_, mapped_size_) != 0;
+#else
+  void* mapped =
+    mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  data_ = static_cast<char*>(mapped);
+  locked_ = mlock(data_, mapped_size_) == 0;
+#if defined(MADV_DONTDUMP)
+  madvise(data_, mapped_size_, MADV_DONTDUMP);
+#elif defined(MADV_NOCORE)
+  madvise(data_, mapped_size_, MADV_NOCORE);
+#endif
+#endif
+  std::copy(value.begin(), value.end(), data_);
+}
+
+locked_secret::~locked_secret()
+{
+  wipe(data_, size_);
+#ifdef _WIN32
+  if (locked_) {
+    VirtualUnlock(data_, mapped_size_);
+  }
+  VirtualFree(data_, 0, MEM_RELEASE);
+#else
+  if (locked_) {
+    munlock(data_, mapped_size_);
+  }
+  munmap(data_, mapped_size_);
+#endif
+}
+
+auto
+locked_secret::view() const -> std::string_view
+{
+  return { data_, size_ };
+}
+
+auto
+locked_secret::equals(std::string_view other) const -> bool
+{
+  if (other.size() != size_) {
+    return false;
+  }
+  unsigned char difference{ 0 };
+  for (std::size_t i = 0; i < size_; ++i) {
+    difference |= static_cast<unsigned char>(data_[i] ^ other[i]);
+  }
+  return difference == 0;
+}
+
+salted_password_cache::salted_password_cache(std::size_t capacity)
+  : capacity_{ std::max<std::size_t>(capacity, 1) }
+{
+}
+
+auto
+salted_password_cache::instance() -> salted_password_cache&
+{
+  static salted_password_cache cache{};
+  return cache;
+}
+
+auto
+salted_password_cache::get(Mechanism mechanism,
+                           const std::string& username,
+                           std::string_view password,
+                           std::string_view salt,
+                           unsigned int iteration_count,
+                           const std::function<std::string()>& derive) -> std::string
+{
+  auto check =
+    crypto::CBC_HMAC(crypto::Algorithm::ALG_SHA256, password_check_key().view(), password);
+  key_type key{ mechanism, username, std::string{ salt }, iteration_count };
+
+  std::promise<std::shared_ptr<const locked_secret>> promise{};
+  std::shared_future<std::shared_ptr<const locked_secret>> salted_password{};
+  std::uint64_t generation{ 0 };
+  {
+    const std::scoped_lock lock(mutex_);
+    if (auto it = entries_.find(key);
+        it != entries_.end() && it->second.password_check->equals(check)) {
+      it->second.last_used = ++clock_;
+      salted_password = it->second.salted_password;
+    } else {
+      // first connection with these parameters, or the password has changed since
+      salted_password = promise.get_future().share();
+      generation = ++clock_;
+      entries_.insert_or_assign(key,
+                                entry{
+                                  std::make_unique<const locked_secret>(check),
+                                  salted_password,
+                                  generation,
+                                  generation,
+                                });
+      evict_locked();
+    }
+  }
+  crypto::secure_erase(check);
+
+  if (generation != 0) {
+    try {
+      auto derived = derive();
+      auto value = std::make_shared<const locked_secret>(derived);
+      crypto::secure_erase(derived);
+      promise.set_value(std::move(value));
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+      const std::scoped_lock lock(mutex_);
+      if (auto it = entries_.find(key);
+          it != entries_.end() && it->second.generation == generation) {
+        entries_.erase(it);
+      }
+    }
+  }
+  return std::string{ salted_password.get()->view() };
+}
+
+void
+salted_password_cache::evict_locked()
+{
+  while (entries_.size() > capacity_) {
+    auto oldest =
+      std::min_element(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+        return a.second.last_used < b.second.last_used;
+      });
+    entries_.erase(oldest);
+  }
+}
+
+void
+salted_password_cache::clear()
+{
+  const std::scoped_lock lock(mutex_);
+  entries_.clear();
+}
+
+auto
+salted_password_cache::size() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+auto
+salted_password_cache::capacity() const -> std::size_t
+{
+  return capacity_;
+}
+} // namespace couchbase::core::sasl::mechanism::scram
@@ -0,0 +1,129 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/sasl/mechanism.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace couchbase::core::sasl::mechanism::scram
+{
+/**
+ * Bytes kept in their own pages, which are locked in memory so that they are never swapped out and,
+ * where the platform supports it, left out of core dumps. The bytes are wiped before the pages are
+ * released. Locking is best-effort: when the process is over its locked memory limit, the bytes
+ * are still kept out of core dumps and wiped.
+ */
+class locked_secret
+{
+public:
+  explicit locked_secret(std::string_view value);
+  locked_secret(const locked_secret&) = delete;
+  locked_secret(locked_secret&&) = delete;
+  auto operator=(const locked_secret&) -> locked_secret& = delete;
+  auto operator=(locked_secret&&) -> locked_secret& = delete;
+  ~locked_secret();
+
+  [[nodiscard]] auto view() const -> std::string_view;
+
+  /**
+   * Compares in time that depends only on the sizes, not on where the bytes differ.
+   */
+  [[nodiscard]] auto equals(std::string_view other) const -> bool;
+
+private:
+  char* data_{ nullptr };
+  std::size_t size_{ 0 };
+  std::size_t mapped_size_{ 0 };
+  bool locked_{ false };
+};
+
+/**
+ * Process-wide cache of SCRAM SaltedPassword values.
+ *
+ * Deriving the SaltedPassword runs PBKDF2 with the iteration count chosen by the server, which is
+ * by far the most expensive part of a SCRAM exchange. The salt and iteration count are fixed per
+ * user on the server side, so every connection authenticating as the same user derives the same
+ * value. When a whole cluster reconnects at once this turns into one PBKDF2 per socket; with the
+ * cache it is one per credential.
+ *
+ * Entries are keyed by mechanism, username, salt and iteration count, and also remember an HMAC of
+ * the password, so that a changed password misses the cache instead of reusing a stale value. The
+ * HMAC is keyed with a random secret of the process, so it cannot be used to guess the password
+ * without that secret, and the plaintext password is never stored. The SaltedPassword values, the
+ * HMACs and the secret are all held in @ref locked_secret memory, and wiped once the last
+ * reference to them is gone. Concurrent misses for the same key wait for a single derivation. The
+ * cache holds at most @ref capacity entries, evicting the least recently used one.
+ */
+class salted_password_cache
+{
+public:
+  static constexpr std::size_t default_capacity{ 64 };
+
+  explicit salted_password_cache(std::size_t capacity = default_capacity);
+
+  /**
+   * The instance shared by all SCRAM client backends of the process.
+   */
+  static auto instance() -> salted_password_cache&;
+
+  /**
+   * Returns the SaltedPassword for the given parameters, calling @p derive to compute it when the
+   * cache does not have a matching entry.
+   *
+   * @throws whatever @p derive throws; a failed derivation is not cached
+   */
+  auto get(Mechanism mechanism,
+           const std::string& username,
+           std::string_view password,
+           std::string_view salt,
+           unsigned int iteration_count,
+           const std::function<std::string()>& derive) -> std::string;
+
+  void clear();
+
+  [[nodiscard]] auto size() const -> std::size_t;
+  [[nodiscard]] auto capacity() const -> std::size_t;
+
+private:
+  using key_type = std::tuple<Mechanism, std::string, std::string, unsigned int>;
+
+  struct entry {
+    std::unique_ptr<const locked_secret> password_check{};
+    std::shared_future<std::shared_ptr<const locked_secret>> salted_password{};
+    std::uint64_t generation{};
+    std::uint64_t last_used{};
+  };
+
+  void evict_locked();
+
+  const std::size_t capacity_;
+  mutable std::mutex mutex_{};
+  std::map<key_type, entry> entries_{};
+  std::uint64_t clock_{ 0 };
+};
+} // namespace couchbase::core::sasl::mechanism::scram
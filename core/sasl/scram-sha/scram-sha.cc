@@ -16,6 +16,7 @@
  */
 
 #include "scram-sha.h"
+#include "salted_password_cache.h"
 
 #include "core/crypto/cbcrypto.h"
 #include "core/logger/logger.hxx"
@@ -264,6 +265,11 @@ ClientBackend::ClientBackend(GetUsernameCallback& user_cb,
   clientNonce = couchbase::core::to_hex({ nonce.data(), nonce.size() });
 }
 
+ClientBackend::~ClientBackend()
+{
+  couchbase::core::crypto::secure_erase(saltedPassword);
+}
+
 auto
 ClientBackend::start() -> std::pair<error, std::string_view>
 {
@@ -370,7 +376,10 @@ auto
 ClientBackend::generateSaltedPassword(const std::string& secret) -> bool
 {
   try {
-    saltedPassword = couchbase::core::crypto::PBKDF2_HMAC(algorithm, secret, salt, iterationCount);
+    saltedPassword = salted_password_cache::instance().get(
+      mechanism, usernameCallback(), secret, salt, iterationCount, [this, &secret]() {
+        return couchbase::core::crypto::PBKDF2_HMAC(algorithm, secret, salt, iterationCount);
+      });
     return true;
   } catch (...) {
     return false;
@@ -119,6 +119,11 @@ public:
                 ClientContext& ctx,
                 Mechanism mech,
                 couchbase::core::crypto::Algorithm algo);
+  ClientBackend(const ClientBackend&) = delete;
+  ClientBackend(ClientBackend&&) = delete;
+  auto operator=(const ClientBackend&) -> ClientBackend& = delete;
+  auto operator=(ClientBackend&&) -> ClientBackend& = delete;
+  ~ClientBackend() override;
 
   std::pair<error, std::string_view> start() override;
   std::pair<error, std::string_view> step(std::string_view input) override;
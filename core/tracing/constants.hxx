@@ -145,6 +145,7 @@ namespace op
 {
 constexpr auto service = "couchbase.service";
 constexpr auto retry_count = "couchbase.retries";
+constexpr auto retry_reason = "couchbase.retry.reason";
 constexpr auto durability_level = "couchbase.durability";
 constexpr auto bucket_name = "db.namespace";
 constexpr auto scope_name = "couchbase.scope.name";
@@ -2544,11 +2544,119 @@ attempt_context_impl::rollback_with_query(VoidCallback&& cb)
     });
 }
 void
-attempt_context_impl::atr_commit(bool ambiguity_resolution_mode)
+attempt_context_impl::atr_commit(bool ambiguity_resolution_mode,
+                                 std::shared_ptr<async_constant_delay> delay,
+                                 VoidCallback&& cb)
 {
-  retry_op<void>([self = shared_from_this(), &ambiguity_resolution_mode]() {
-    try {
+  auto on_error = [self = shared_from_this(), ambiguity_resolution_mode, delay](
+                    const client_error& e, VoidCallback&& cb) mutable {
+    auto retry = [self, delay](bool ambiguity_resolution_mode, VoidCallback&& cb) mutable {
+      (*delay)([self, delay, ambiguity_resolution_mode, cb = std::move(cb)](
+                 const std::exception_ptr& exc) mutable {
+        if (exc) {
+          return cb(exc);
+        }
+        self->atr_commit(ambiguity_resolution_mode, std::move(delay), std::move(cb));
+      });
+    };
+    const error_class ec = e.ec();
+    switch (ec) {
+      case FAIL_EXPIRY: {
+        self->expiry_overtime_mode_ = true;
+        auto out = transaction_operation_failed(ec, e.what()).no_rollback();
+        if (ambiguity_resolution_mode) {
+          out.ambiguous();
+        } else {
+          out.expired();
+        }
+        return cb(std::make_exception_ptr(out));
+      }
+      case FAIL_AMBIGUOUS:
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr_commit got FAIL_AMBIGUOUS, resolving ambiguity...");
+        return retry(true, std::move(cb));
+      case FAIL_TRANSIENT:
+        if (ambiguity_resolution_mode) {
+          return retry(true, std::move(cb));
+        }
+        return cb(std::make_exception_ptr(transaction_operation_failed(ec, e.what()).retry()));
+
+      case FAIL_PATH_ALREADY_EXISTS:
+        // the ambiguity resolution retries on its own delay
+        return self->atr_commit_ambiguity_resolution(
+          std::make_shared<async_constant_delay>(
+            std::make_shared<asio::steady_timer>(self->cluster_ref().io_context())),
+          std::move(cb));
+      case FAIL_HARD: {
+        auto out = transaction_operation_failed(ec, e.what()).no_rollback();
+        if (ambiguity_resolution_mode) {
+          out.ambiguous();
+        }
+        return cb(std::make_exception_ptr(out));
+      }
+      case FAIL_DOC_NOT_FOUND: {
+        auto out = transaction_operation_failed(ec, e.what())
+                     .cause(external_exception::ACTIVE_TRANSACTION_RECORD_NOT_FOUND)
+                     .no_rollback();
+        if (ambiguity_resolution_mode) {
+          out.ambiguous();
+        }
+        return cb(std::make_exception_ptr(out));
+      }
+      case FAIL_PATH_NOT_FOUND: {
+        auto out = transaction_operation_failed(ec, e.what())
+                     .cause(external_exception::ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)
+                     .no_rollback();
+        if (ambiguity_resolution_mode) {
+          out.ambiguous();
+        }
+        return cb(std::make_exception_ptr(out));
+      }
+      case FAIL_ATR_FULL: {
+        auto out = transaction_operation_failed(ec, e.what())
+                     .cause(external_exception::ACTIVE_TRANSACTION_RECORD_FULL)
+                     .no_rollback();
+        if (ambiguity_resolution_mode) {
+          out.ambiguous();
+        }
+        return cb(std::make_exception_ptr(out));
+      }
+      default: {
+        CB_ATTEMPT_CTX_LOG_ERROR(self,
+                                 "failed to commit transaction {}, attempt {}, "
+                                 "ambiguity_resolution_mode {}, with error {}",
+                                 self->transaction_id(),
+                                 self->id(),
+                                 ambiguity_resolution_mode,
+                                 e.what());
+        auto out = transaction_operation_failed(ec, e.what());
+        if (ambiguity_resolution_mode) {
+          out.no_rollback().ambiguous();
+        }
+        return cb(std::make_exception_ptr(out));
+      }
+    }
+  };
+
+  auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_COMMIT, {});
+  if (ec) {
+    return on_error(
+      client_error(
+        *ec, fmt::format("atr_commit check for expiry threw error, error_class={}", ec.value())),
+      std::move(cb));
+  }
+  hooks_.before_atr_commit(
+    shared_from_this(),
+    [self = shared_from_this(), on_error, cb = std::move(cb)](
+      std::optional<error_class> ec) mutable {
+      if (ec) {
+        return on_error(
+          client_error(
+            *ec, fmt::format("before_atr_commit hook raised error, error_class={}", ec.value())),
+          std::move(cb));
+      }
       const std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id() + ".");
+      // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+      // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
       core::operations::mutate_in_request req{ self->atr_id_.value() };
       req.specs =
         couchbase::mutate_in_specs{
@@ -2562,528 +2670,467 @@ attempt_context_impl::atr_commit(bool ambiguity_resolution_mode)
         }
           .specs();
       wrap_durable_request(req, self->overall()->config());
-      auto ec = self->error_if_expired_and_not_in_overtime(STAGE_ATR_COMMIT, {});
-      if (ec) {
-        throw client_error(
-          *ec, fmt::format("atr_commit check for expiry threw error, error_class={}", ec.value()));
-      }
-      ec = wait_for_hook([self](auto handler) mutable {
-        return self->hooks_.before_atr_commit(self, std::move(handler));
-      });
-      if (ec) {
-        // for now, throw.  Later, if this is async, we will use error handler
-        // no doubt.
-        throw client_error(
-          *ec, fmt::format("before_atr_commit hook raised error, error_class={}", ec.value()));
-      }
       self->staged_mutations_->extract_to(prefix, req);
-      auto barrier = std::make_shared<std::promise<result>>();
-      auto f = barrier->get_future();
       CB_ATTEMPT_CTX_LOG_TRACE(self,
                                "updating atr {}, setting to {}",
                                req.id,
                                attempt_state_name(attempt_state::COMMITTED));
       self->overall()->cluster_ref().execute(
-        req, [barrier](const core::operations::mutate_in_response& resp) {
-          barrier->set_value(result::create_from_subdoc_response(resp));
-        });
-      auto res = wrap_operation_future(f, false);
-      ec = wait_for_hook([self](auto handler) mutable {
-        return self->hooks_.after_atr_commit(self, std::move(handler));
-      });
-      if (ec) {
-        throw client_error(*ec, "after_atr_commit hook raised error");
-      }
-      self->state(attempt_state::COMMITTED);
-    } catch (const client_error& e) {
-      const error_class ec = e.ec();
-      switch (ec) {
-        case FAIL_EXPIRY: {
-          self->expiry_overtime_mode_ = true;
-          auto out = transaction_operation_failed(ec, e.what()).no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          } else {
-            out.expired();
-          }
-          throw out;
-        }
-        case FAIL_AMBIGUOUS:
-          CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr_commit got FAIL_AMBIGUOUS, resolving ambiguity...");
-          ambiguity_resolution_mode = true;
-          throw retry_operation(e.what());
-        case FAIL_TRANSIENT:
-          if (ambiguity_resolution_mode) {
-            throw retry_operation(e.what());
-          }
-          throw transaction_operation_failed(ec, e.what()).retry();
-
-        case FAIL_PATH_ALREADY_EXISTS:
-          // Need retry_op as atr_commit_ambiguity_resolution can throw
-          // retry_operation
-          return retry_op<void>([self]() {
-            return self->atr_commit_ambiguity_resolution();
-          });
-        case FAIL_HARD: {
-          auto out = transaction_operation_failed(ec, e.what()).no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          }
-          throw out;
-        }
-        case FAIL_DOC_NOT_FOUND: {
-          auto out = transaction_operation_failed(ec, e.what())
-                       .cause(external_exception::ACTIVE_TRANSACTION_RECORD_NOT_FOUND)
-                       .no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          }
-          throw out;
-        }
-        case FAIL_PATH_NOT_FOUND: {
-          auto out = transaction_operation_failed(ec, e.what())
-                       .cause(external_exception::ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)
-                       .no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          }
-          throw out;
-        }
-        case FAIL_ATR_FULL: {
-          auto out = transaction_operation_failed(ec, e.what())
-                       .cause(external_exception::ACTIVE_TRANSACTION_RECORD_FULL)
-                       .no_rollback();
-          if (ambiguity_resolution_mode) {
-            out.ambiguous();
-          }
-          throw out;
-        }
-        default: {
-          CB_ATTEMPT_CTX_LOG_ERROR(self,
-                                   "failed to commit transaction {}, attempt {}, "
-                                   "ambiguity_resolution_mode {}, with error {}",
-                                   self->transaction_id(),
-                                   self->id(),
-                                   ambiguity_resolution_mode,
-                                   e.what());
-          auto out = transaction_operation_failed(ec, e.what());
-          if (ambiguity_resolution_mode) {
-            out.no_rollback().ambiguous();
+        req,
+        [self, on_error, cb = std::move(cb)](
+          const core::operations::mutate_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res, false);
+          } catch (const client_error& e) {
+            return on_error(e, std::move(cb));
           }
-          throw out;
-        }
-      }
-    }
-  });
+          self->hooks_.after_atr_commit(
+            self,
+            [self, on_error, cb = std::move(cb)](std::optional<error_class> ec) mutable {
+              if (ec) {
+                return on_error(client_error(*ec, "after_atr_commit hook raised error"),
+                                std::move(cb));
+              }
+              self->state(attempt_state::COMMITTED);
+              cb({});
+            });
+        });
+    });
 }
 
 void
-attempt_context_impl::atr_commit_ambiguity_resolution()
+attempt_context_impl::atr_commit_ambiguity_resolution(std::shared_ptr<async_constant_delay> delay,
+                                                      VoidCallback&& cb)
 {
-  try {
-    auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_COMMIT_AMBIGUITY_RESOLUTION, {});
-    if (ec) {
-      throw client_error(*ec, "atr_commit_ambiguity_resolution raised error");
-    }
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.before_atr_commit_ambiguity_resolution(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "before_atr_commit_ambiguity_resolution hook threw error");
-    }
-    const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id() + ".");
-    // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    core::operations::lookup_in_request req{ atr_id_.value() };
-    req.specs = lookup_in_specs{ lookup_in_specs::get(prefix + ATR_FIELD_STATUS).xattr() }.specs();
-    auto barrier = std::make_shared<std::promise<result>>();
-    auto f = barrier->get_future();
-    overall()->cluster_ref().execute(
-      req, [barrier](const core::operations::lookup_in_response& resp) {
-        barrier->set_value(result::create_from_subdoc_response(resp));
-      });
-    auto res = wrap_operation_future(f);
-    auto atr_status_raw = res.values[0].content_as<std::string>();
-    CB_ATTEMPT_CTX_LOG_DEBUG(
-      this, "atr_commit_ambiguity_resolution read atr state {}", atr_status_raw);
-    auto atr_status = attempt_state_value(atr_status_raw);
-    switch (atr_status) {
-      case attempt_state::COMMITTED:
-        return;
-      case attempt_state::ABORTED:
-        // aborted by another process?
-        throw transaction_operation_failed(FAIL_OTHER, "transaction aborted externally").retry();
-      default:
-        throw transaction_operation_failed(FAIL_OTHER,
-                                           "unexpected state found on ATR ambiguity resolution")
-          .cause(ILLEGAL_STATE_EXCEPTION)
-          .no_rollback();
-    }
-  } catch (const client_error& e) {
+  auto on_error = [self = shared_from_this(), delay](const client_error& e,
+                                                     VoidCallback&& cb) mutable {
     const error_class ec = e.ec();
     switch (ec) {
       case FAIL_EXPIRY:
       case FAIL_HARD:
-        throw transaction_operation_failed(ec, e.what()).no_rollback().ambiguous();
+        return cb(std::make_exception_ptr(
+          transaction_operation_failed(ec, e.what()).no_rollback().ambiguous()));
       case FAIL_TRANSIENT:
       case FAIL_OTHER:
-        throw retry_operation(e.what());
+        return (*delay)([self, delay, cb = std::move(cb)](const std::exception_ptr& exc) mutable {
+          if (exc) {
+            return cb(exc);
+          }
+          self->atr_commit_ambiguity_resolution(std::move(delay), std::move(cb));
+        });
       case FAIL_PATH_NOT_FOUND:
-        throw transaction_operation_failed(ec, e.what())
-          .cause(ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)
-          .no_rollback()
-          .ambiguous();
+        return cb(std::make_exception_ptr(transaction_operation_failed(ec, e.what())
+                                            .cause(ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)
+                                            .no_rollback()
+                                            .ambiguous()));
       case FAIL_DOC_NOT_FOUND:
-        throw transaction_operation_failed(ec, e.what())
-          .cause(ACTIVE_TRANSACTION_RECORD_NOT_FOUND)
-          .no_rollback()
-          .ambiguous();
+        return cb(std::make_exception_ptr(transaction_operation_failed(ec, e.what())
+                                            .cause(ACTIVE_TRANSACTION_RECORD_NOT_FOUND)
+                                            .no_rollback()
+                                            .ambiguous()));
       default:
-        throw transaction_operation_failed(ec, e.what()).no_rollback().ambiguous();
+        return cb(std::make_exception_ptr(
+          transaction_operation_failed(ec, e.what()).no_rollback().ambiguous()));
     }
+  };
+
+  auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_COMMIT_AMBIGUITY_RESOLUTION, {});
+  if (ec) {
+    return on_error(client_error(*ec, "atr_commit_ambiguity_resolution raised error"),
+                    std::move(cb));
   }
+  hooks_.before_atr_commit_ambiguity_resolution(
+    shared_from_this(),
+    [self = shared_from_this(), on_error, cb = std::move(cb)](
+      std::optional<error_class> ec) mutable {
+      if (ec) {
+        return on_error(
+          client_error(*ec, "before_atr_commit_ambiguity_resolution hook threw error"),
+          std::move(cb));
+      }
+      const std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id() + ".");
+      // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+      // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+      core::operations::lookup_in_request req{ self->atr_id_.value() };
+      req.specs =
+        lookup_in_specs{ lookup_in_specs::get(prefix + ATR_FIELD_STATUS).xattr() }.specs();
+      self->overall()->cluster_ref().execute(
+        req,
+        [self, on_error, cb = std::move(cb)](
+          const core::operations::lookup_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res);
+          } catch (const client_error& e) {
+            return on_error(e, std::move(cb));
+          }
+          std::string atr_status_raw;
+          try {
+            atr_status_raw = res.values[0].content_as<std::string>();
+          } catch (const std::exception& e) {
+            return cb(std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what())));
+          }
+          CB_ATTEMPT_CTX_LOG_DEBUG(
+            self, "atr_commit_ambiguity_resolution read atr state {}", atr_status_raw);
+          switch (attempt_state_value(atr_status_raw)) {
+            case attempt_state::COMMITTED:
+              return cb({});
+            case attempt_state::ABORTED:
+              // aborted by another process?
+              return cb(std::make_exception_ptr(
+                transaction_operation_failed(FAIL_OTHER, "transaction aborted externally")
+                  .retry()));
+            default:
+              return cb(std::make_exception_ptr(
+                transaction_operation_failed(FAIL_OTHER,
+                                             "unexpected state found on ATR ambiguity resolution")
+                  .cause(ILLEGAL_STATE_EXCEPTION)
+                  .no_rollback()));
+          }
+        });
+    });
 }
 
 void
-attempt_context_impl::atr_complete()
+attempt_context_impl::atr_complete(VoidCallback&& cb)
 {
-  try {
-    const result atr_res;
-    auto ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.before_atr_complete(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "before_atr_complete hook threw error");
-    }
-    // if we have expired (and not in overtime mode), just raise the final
-    // error.
-    ec = error_if_expired_and_not_in_overtime(STAGE_ATR_COMPLETE, {});
-    if (ec) {
-      throw client_error(*ec, "atr_complete threw error");
+  // only FAIL_HARD is reported, otherwise the lost attempts cleanup removes the entry later
+  auto on_error = [self = shared_from_this()](const client_error& er) -> std::exception_ptr {
+    if (const error_class ec = er.ec(); ec == FAIL_HARD) {
+      return std::make_exception_ptr(
+        transaction_operation_failed(ec, er.what()).no_rollback().failed_post_commit());
     }
-    // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
-    // NOLINTBEGIN(bugprone-unchecked-optional-access)
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "removing attempt {} from atr", atr_id_.value());
-    const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id());
-    core::operations::mutate_in_request req{ atr_id_.value() };
-    // NOLINTEND(bugprone-unchecked-optional-access)
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::remove(prefix).xattr(),
+    CB_ATTEMPT_CTX_LOG_INFO(self, "ignoring error in atr_complete {}", er.what());
+    return {};
+  };
+  hooks_.before_atr_complete(
+    shared_from_this(),
+    [self = shared_from_this(), on_error, cb = std::move(cb)](
+      std::optional<error_class> ec) mutable {
+      if (ec) {
+        return cb(on_error(client_error(*ec, "before_atr_complete hook threw error")));
       }
-        .specs();
-    wrap_durable_request(req, overall()->config());
-    auto barrier = std::make_shared<std::promise<result>>();
-    auto f = barrier->get_future();
-    overall()->cluster_ref().execute(
-      req, [barrier](const core::operations::mutate_in_response& resp) {
-        barrier->set_value(result::create_from_subdoc_response(resp));
-      });
-    wrap_operation_future(f);
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.after_atr_complete(self, std::move(handler));
+      // if we have expired (and not in overtime mode), just raise the final
+      // error.
+      ec = self->error_if_expired_and_not_in_overtime(STAGE_ATR_COMPLETE, {});
+      if (ec) {
+        return cb(on_error(client_error(*ec, "atr_complete threw error")));
+      }
+      // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+      // NOLINTBEGIN(bugprone-unchecked-optional-access)
+      CB_ATTEMPT_CTX_LOG_DEBUG(self, "removing attempt {} from atr", self->atr_id_.value());
+      const std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id());
+      core::operations::mutate_in_request req{ self->atr_id_.value() };
+      // NOLINTEND(bugprone-unchecked-optional-access)
+      req.specs =
+        couchbase::mutate_in_specs{
+          couchbase::mutate_in_specs::remove(prefix).xattr(),
+        }
+          .specs();
+      wrap_durable_request(req, self->overall()->config());
+      self->overall()->cluster_ref().execute(
+        req,
+        [self, on_error, cb = std::move(cb)](
+          const core::operations::mutate_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res);
+          } catch (const client_error& er) {
+            return cb(on_error(er));
+          }
+          self->hooks_.after_atr_complete(
+            self,
+            [self, on_error, cb = std::move(cb)](std::optional<error_class> ec) mutable {
+              if (ec) {
+                return cb(on_error(client_error(*ec, "after_atr_complete hook threw error")));
+              }
+              self->state(attempt_state::COMPLETED);
+              cb({});
+            });
+        });
     });
-    if (ec) {
-      throw client_error(*ec, "after_atr_complete hook threw error");
-    }
-    state(attempt_state::COMPLETED);
-  } catch (const client_error& er) {
-    switch (const error_class ec = er.ec(); ec) {
-      case FAIL_HARD:
-        throw transaction_operation_failed(ec, er.what()).no_rollback().failed_post_commit();
-      default:
-        CB_ATTEMPT_CTX_LOG_INFO(this, "ignoring error in atr_complete {}", er.what());
-    }
-  }
 }
 
 void
 attempt_context_impl::commit(VoidCallback&& cb)
 {
-  // for now, lets keep the blocking implementation
-  std::thread([cb = std::move(cb), self = shared_from_this()]() mutable {
+  CB_ATTEMPT_CTX_LOG_DEBUG(this, "waiting on ops to finish...");
+  op_list_.block_ops_when_done([self = shared_from_this(), cb = std::move(cb)]() mutable {
     try {
-      self->commit();
-      return cb({});
+      self->existing_error(false);
+      CB_ATTEMPT_CTX_LOG_DEBUG(self, "commit {}", self->id());
+      if (self->op_list_.get_mode().is_query()) {
+        return self->commit_with_query(std::move(cb));
+      }
+      if (self->check_expiry_pre_commit(STAGE_BEFORE_COMMIT, {})) {
+        throw transaction_operation_failed(FAIL_EXPIRY, "transaction expired").expired();
+      }
+      if (!self->atr_id_ || self->atr_id_->key().empty() || self->is_done_) {
+        // no mutation, no need to commit
+        if (!self->is_done_) {
+          CB_ATTEMPT_CTX_LOG_DEBUG(
+            self, "calling commit on attempt that has got no mutations, skipping");
+          self->is_done_ = true;
+          return cb({});
+        } // do not rollback or retry
+        throw transaction_operation_failed(FAIL_OTHER,
+                                           "calling commit on attempt that is already completed")
+          .no_rollback();
+      }
     } catch (const transaction_operation_failed&) {
       return cb(std::current_exception());
     } catch (const std::exception& e) {
       return cb(std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what())));
     }
-  }).detach();
+    auto delay = std::make_shared<async_constant_delay>(
+      std::make_shared<asio::steady_timer>(self->cluster_ref().io_context()));
+    self->atr_commit(
+      false, std::move(delay), [self, cb = std::move(cb)](std::exception_ptr err) mutable {
+        if (err) {
+          try {
+            std::rethrow_exception(err);
+          } catch (const transaction_operation_failed&) {
+            return cb(std::move(err));
+          } catch (const std::exception& e) {
+            // the retries ran out
+            return cb(std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what())));
+          }
+        }
+        // the transaction is committed now, unstage the documents
+        self->staged_mutations_->commit(
+          self, [self, cb = std::move(cb)](std::exception_ptr err) mutable {
+            if (err) {
+              return cb(std::move(err));
+            }
+            self->atr_complete([self, cb = std::move(cb)](std::exception_ptr err) mutable {
+              if (!err) {
+                self->is_done_ = true;
+              }
+              cb(std::move(err));
+            });
+          });
+      });
+  });
 }
 
 void
 attempt_context_impl::commit()
 {
-  CB_ATTEMPT_CTX_LOG_DEBUG(this, "waiting on ops to finish...");
-  op_list_.wait_and_block_ops();
-  existing_error(false);
-  CB_ATTEMPT_CTX_LOG_DEBUG(this, "commit {}", id());
-  if (op_list_.get_mode().is_query()) {
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto f = barrier->get_future();
-    commit_with_query([barrier](const std::exception_ptr& err) {
-      if (err) {
-        barrier->set_exception(err);
-      } else {
-        barrier->set_value();
-      }
-    });
-    f.get();
-  } else {
-    if (check_expiry_pre_commit(STAGE_BEFORE_COMMIT, {})) {
-      throw transaction_operation_failed(FAIL_EXPIRY, "transaction expired").expired();
-    }
-    if (atr_id_ && !atr_id_->key().empty() && !is_done_) {
-      retry_op_exp<void>([self = shared_from_this()]() {
-        self->atr_commit(false);
-      });
-      staged_mutations_->commit(shared_from_this());
-      atr_complete();
-      is_done_ = true;
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto f = barrier->get_future();
+  commit([barrier](const std::exception_ptr& err) {
+    if (err) {
+      barrier->set_exception(err);
     } else {
-      // no mutation, no need to commit
-      if (!is_done_) {
-        CB_ATTEMPT_CTX_LOG_DEBUG(this,
-                                 "calling commit on attempt that has got no mutations, skipping");
-        is_done_ = true;
-        return;
-      } // do not rollback or retry
-      throw transaction_operation_failed(FAIL_OTHER,
-                                         "calling commit on attempt that is already completed")
-        .no_rollback();
+      barrier->set_value();
     }
-  }
+  });
+  f.get();
 }
 
 void
-attempt_context_impl::atr_abort()
+attempt_context_impl::atr_abort(std::shared_ptr<async_exp_delay> delay, VoidCallback&& cb)
 {
-  try {
-    auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_ABORT, {});
-    if (ec) {
-      throw client_error(*ec, "atr_abort check for expiry threw error");
-    }
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.before_atr_aborted(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "before_atr_aborted hook threw error");
-    }
-    const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id() + ".");
-    // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    core::operations::mutate_in_request req{ atr_id_.value() };
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_STATUS,
-                                           attempt_state_name(attempt_state::ABORTED))
-          .xattr()
-          .create_path(),
-        couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_TIMESTAMP_ROLLBACK_START,
-                                           subdoc::mutate_in_macro::cas)
-          .xattr()
-          .create_path(),
-      }
-        .specs();
-    staged_mutations_->extract_to(prefix, req);
-    wrap_durable_request(req, overall()->config());
-    auto barrier = std::make_shared<std::promise<result>>();
-    auto f = barrier->get_future();
-    overall()->cluster_ref().execute(
-      req, [barrier](const core::operations::mutate_in_response& resp) {
-        barrier->set_value(result::create_from_subdoc_response(resp));
-      });
-    wrap_operation_future(f);
-    state(attempt_state::ABORTED);
-
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.after_atr_aborted(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "after_atr_aborted hook threw error");
-    }
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback completed atr abort phase");
-  } catch (const client_error& e) {
+  auto on_error = [self = shared_from_this(), delay](const client_error& e,
+                                                     VoidCallback&& cb) mutable {
     auto ec = e.ec();
-    CB_ATTEMPT_CTX_LOG_TRACE(this, "atr_abort got {} {}", ec, e.what());
-    if (expiry_overtime_mode_.load()) {
-      CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_abort got error \"{}\" while in overtime mode", e.what());
-      throw transaction_operation_failed(FAIL_EXPIRY,
-                                         std::string("expired in atr_abort with {} ") + e.what())
-        .no_rollback()
-        .expired();
+    CB_ATTEMPT_CTX_LOG_TRACE(self, "atr_abort got {} {}", ec, e.what());
+    if (self->expiry_overtime_mode_.load()) {
+      CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr_abort got error \"{}\" while in overtime mode", e.what());
+      return cb(std::make_exception_ptr(
+        transaction_operation_failed(FAIL_EXPIRY,
+                                     std::string("expired in atr_abort with {} ") + e.what())
+          .no_rollback()
+          .expired()));
     }
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_abort got error {}", ec);
+    CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr_abort got error {}", ec);
     switch (ec) {
       case FAIL_EXPIRY:
-        expiry_overtime_mode_ = true;
-        throw retry_operation("expired, setting overtime mode and retry atr_abort");
+        // set overtime mode and retry
+        self->expiry_overtime_mode_ = true;
+        break;
       case FAIL_PATH_NOT_FOUND:
-        throw transaction_operation_failed(ec, e.what())
-          .no_rollback()
-          .cause(ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND);
+        return cb(std::make_exception_ptr(transaction_operation_failed(ec, e.what())
+                                            .no_rollback()
+                                            .cause(ACTIVE_TRANSACTION_RECORD_ENTRY_NOT_FOUND)));
       case FAIL_DOC_NOT_FOUND:
-        throw transaction_operation_failed(ec, e.what())
-          .no_rollback()
-          .cause(ACTIVE_TRANSACTION_RECORD_NOT_FOUND);
+        return cb(std::make_exception_ptr(transaction_operation_failed(ec, e.what())
+                                            .no_rollback()
+                                            .cause(ACTIVE_TRANSACTION_RECORD_NOT_FOUND)));
       case FAIL_ATR_FULL:
-        throw transaction_operation_failed(ec, e.what())
-          .no_rollback()
-          .cause(ACTIVE_TRANSACTION_RECORD_FULL);
+        return cb(std::make_exception_ptr(transaction_operation_failed(ec, e.what())
+                                            .no_rollback()
+                                            .cause(ACTIVE_TRANSACTION_RECORD_FULL)));
       case FAIL_HARD:
-        throw transaction_operation_failed(ec, e.what()).no_rollback();
+        return cb(
+          std::make_exception_ptr(transaction_operation_failed(ec, e.what()).no_rollback()));
       default:
-        throw retry_operation("retry atr_abort");
+        break;
     }
+    (*delay)([self, delay, cb = std::move(cb)](const std::exception_ptr& exc) mutable {
+      if (exc) {
+        return cb(exc);
+      }
+      self->atr_abort(std::move(delay), std::move(cb));
+    });
+  };
+
+  auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_ABORT, {});
+  if (ec) {
+    return on_error(client_error(*ec, "atr_abort check for expiry threw error"), std::move(cb));
   }
+  hooks_.before_atr_aborted(
+    shared_from_this(),
+    [self = shared_from_this(), on_error, cb = std::move(cb)](
+      std::optional<error_class> ec) mutable {
+      if (ec) {
+        return on_error(client_error(*ec, "before_atr_aborted hook threw error"), std::move(cb));
+      }
+      const std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id() + ".");
+      // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+      // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+      core::operations::mutate_in_request req{ self->atr_id_.value() };
+      req.specs =
+        couchbase::mutate_in_specs{
+          couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_STATUS,
+                                             attempt_state_name(attempt_state::ABORTED))
+            .xattr()
+            .create_path(),
+          couchbase::mutate_in_specs::upsert(prefix + ATR_FIELD_TIMESTAMP_ROLLBACK_START,
+                                             subdoc::mutate_in_macro::cas)
+            .xattr()
+            .create_path(),
+        }
+          .specs();
+      self->staged_mutations_->extract_to(prefix, req);
+      wrap_durable_request(req, self->overall()->config());
+      self->overall()->cluster_ref().execute(
+        req,
+        [self, on_error, cb = std::move(cb)](
+          const core::operations::mutate_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res);
+          } catch (const client_error& e) {
+            return on_error(e, std::move(cb));
+          }
+          self->state(attempt_state::ABORTED);
+          self->hooks_.after_atr_aborted(
+            self,
+            [self, on_error, cb = std::move(cb)](std::optional<error_class> ec) mutable {
+              if (ec) {
+                return on_error(client_error(*ec, "after_atr_aborted hook threw error"),
+                                std::move(cb));
+              }
+              CB_ATTEMPT_CTX_LOG_DEBUG(self, "rollback completed atr abort phase");
+              cb({});
+            });
+        });
+    });
 }
 
 void
-attempt_context_impl::atr_rollback_complete()
+attempt_context_impl::atr_rollback_complete(std::shared_ptr<async_exp_delay> delay,
+                                            VoidCallback&& cb)
 {
-  try {
-    auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_ROLLBACK_COMPLETE, std::nullopt);
-    if (ec) {
-      throw client_error(*ec, "atr_rollback_complete raised error");
-    }
-
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.before_atr_rolled_back(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "before_atr_rolled_back hook threw error");
-    }
-    const std::string prefix(ATR_FIELD_ATTEMPTS + "." + id());
-    // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
-    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
-    core::operations::mutate_in_request req{ atr_id_.value() };
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::remove(prefix).xattr(),
-      }
-        .specs();
-    wrap_durable_request(req, overall()->config());
-    auto barrier = std::make_shared<std::promise<result>>();
-    auto f = barrier->get_future();
-    overall()->cluster_ref().execute(
-      req, [barrier](const core::operations::mutate_in_response& resp) {
-        barrier->set_value(result::create_from_subdoc_response(resp));
-      });
-    wrap_operation_future(f);
-    state(attempt_state::ROLLED_BACK);
-    ec = wait_for_hook([self = shared_from_this()](auto handler) mutable {
-      return self->hooks_.after_atr_rolled_back(self, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "after_atr_rolled_back hook threw error");
-    }
-    is_done_ = true;
-
-  } catch (const client_error& e) {
+  auto on_error = [self = shared_from_this(), delay](const client_error& e,
+                                                     VoidCallback&& cb) mutable {
     auto ec = e.ec();
-    if (expiry_overtime_mode_.load()) {
+    if (self->expiry_overtime_mode_.load()) {
       CB_ATTEMPT_CTX_LOG_DEBUG(
-        this, "atr_rollback_complete error while in overtime mode {}", e.what());
-      throw transaction_operation_failed(
-        FAIL_EXPIRY, std::string("expired in atr_rollback_complete with {} ") + e.what())
-        .no_rollback()
-        .expired();
+        self, "atr_rollback_complete error while in overtime mode {}", e.what());
+      return cb(std::make_exception_ptr(
+        transaction_operation_failed(
+          FAIL_EXPIRY, std::string("expired in atr_rollback_complete with {} ") + e.what())
+          .no_rollback()
+          .expired()));
     }
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr_rollback_complete got error {}", ec);
+    CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr_rollback_complete got error {}", ec);
     // FIXME(SA): if atr_id_ is optional, we should report an error somehow
     // TODO(CXXCBC-549)
     // NOLINTBEGIN(bugprone-unchecked-optional-access)
     switch (ec) {
       case FAIL_DOC_NOT_FOUND:
       case FAIL_PATH_NOT_FOUND:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr {} not found, ignoring", atr_id_->key());
-        is_done_ = true;
-        break;
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr {} not found, ignoring", self->atr_id_->key());
+        self->is_done_ = true;
+        return cb({});
       case FAIL_ATR_FULL:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "atr {} full!", atr_id_->key());
-        throw retry_operation(e.what());
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "atr {} full!", self->atr_id_->key());
+        break;
       case FAIL_HARD:
-        throw transaction_operation_failed(ec, e.what()).no_rollback();
+        return cb(
+          std::make_exception_ptr(transaction_operation_failed(ec, e.what()).no_rollback()));
       case FAIL_EXPIRY:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "timed out writing atr {}", atr_id_->key());
-        throw transaction_operation_failed(ec, e.what()).no_rollback().expired();
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "timed out writing atr {}", self->atr_id_->key());
+        return cb(std::make_exception_ptr(
+          transaction_operation_failed(ec, e.what()).no_rollback().expired()));
       default:
-        CB_ATTEMPT_CTX_LOG_DEBUG(this, "retrying atr_rollback_complete");
-        throw retry_operation(e.what());
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "retrying atr_rollback_complete");
+        break;
     }
     // NOLINTEND(bugprone-unchecked-optional-access)
-  }
-}
-void
-attempt_context_impl::rollback(VoidCallback&& cb)
-{
-  // for now, lets keep the blocking implementation
-  std::thread([cb = std::move(cb), this]() mutable {
-    if (op_list_.get_mode().is_query()) {
-      return rollback_with_query(std::move(cb));
-    }
-    try {
-      rollback();
-      return cb({});
-    } catch (const transaction_operation_failed&) {
-      return cb(std::current_exception());
-    } catch (const std::exception& e) {
-      return cb(
-        std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, e.what()).no_rollback()));
-    } catch (...) {
-      return cb(std::make_exception_ptr(
-        transaction_operation_failed(FAIL_OTHER, "unexpected exception during rollback")));
-    }
-  }).detach();
-}
-
-void
-attempt_context_impl::rollback()
-{
-  op_list_.wait_and_block_ops();
-  CB_ATTEMPT_CTX_LOG_DEBUG(this, "rolling back {}", id());
-  if (op_list_.get_mode().is_query()) {
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto f = barrier->get_future();
-    rollback_with_query([barrier](const std::exception_ptr& err) {
-      if (err) {
-        barrier->set_exception(err);
-      } else {
-        barrier->set_value();
+    (*delay)([self, delay, cb = std::move(cb)](const std::exception_ptr& exc) mutable {
+      if (exc) {
+        return cb(exc);
       }
+      self->atr_rollback_complete(std::move(delay), std::move(cb));
     });
-    return f.get();
-  }
-  // check for expiry
-  check_expiry_during_commit_or_rollback(STAGE_ROLLBACK, std::nullopt);
-  if (!atr_id_ || atr_id_->key().empty() || state() == attempt_state::NOT_STARTED) {
-    // TODO(SA): check this, but if we try to rollback an empty txn, we should
-    // prevent a subsequent commit
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback called on txn with no mutations");
-    is_done_ = true;
-    return;
-  }
-  if (is_done()) {
-    std::string msg("Transaction already done, cannot rollback");
-    CB_ATTEMPT_CTX_LOG_ERROR(this, "{}", msg);
-    // need to raise a FAIL_OTHER which is not retryable or rollback-able
-    throw transaction_operation_failed(FAIL_OTHER, msg).no_rollback();
+  };
+
+  auto ec = error_if_expired_and_not_in_overtime(STAGE_ATR_ROLLBACK_COMPLETE, std::nullopt);
+  if (ec) {
+    return on_error(client_error(*ec, "atr_rollback_complete raised error"), std::move(cb));
   }
-  try {
-    // (1) atr_abort
-    retry_op_exp<void>([self = shared_from_this()]() {
-      self->atr_abort();
+  hooks_.before_atr_rolled_back(
+    shared_from_this(),
+    [self = shared_from_this(), on_error, cb = std::move(cb)](
+      std::optional<error_class> ec) mutable {
+      if (ec) {
+        return on_error(client_error(*ec, "before_atr_rolled_back hook threw error"),
+                        std::move(cb));
+      }
+      const std::string prefix(ATR_FIELD_ATTEMPTS + "." + self->id());
+      // FIXME(CXXCBC-549): if atr_id_ is optional, we should report an error somehow
+      // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+      core::operations::mutate_in_request req{ self->atr_id_.value() };
+      req.specs =
+        couchbase::mutate_in_specs{
+          couchbase::mutate_in_specs::remove(prefix).xattr(),
+        }
+          .specs();
+      wrap_durable_request(req, self->overall()->config());
+      self->overall()->cluster_ref().execute(
+        req,
+        [self, on_error, cb = std::move(cb)](
+          const core::operations::mutate_in_response& resp) mutable {
+          auto res = result::create_from_subdoc_response(resp);
+          try {
+            validate_operation_result(res);
+          } catch (const client_error& e) {
+            return on_error(e, std::move(cb));
+          }
+          self->state(attempt_state::ROLLED_BACK);
+          self->hooks_.after_atr_rolled_back(
+            self,
+            [self, on_error, cb = std::move(cb)](std::optional<error_class> ec) mutable {
+              if (ec) {
+                return on_error(client_error(*ec, "after_atr_rolled_back hook threw error"),
+                                std::move(cb));
+              }
+              self->is_done_ = true;
+              cb({});
+            });
+        });
     });
-    // (2) rollback staged mutations
-    staged_mutations_->rollback(shared_from_this());
-    CB_ATTEMPT_CTX_LOG_DEBUG(this, "rollback completed unstaging docs");
+}
 
-    // (3) atr_rollback
-    retry_op_exp<void>([self = shared_from_this()]() {
-      self->atr_rollback_complete();
-    });
+auto
+attempt_context_impl::rollback_error(const std::exception_ptr& err) -> std::exception_ptr
+{
+  try {
+    std::rethrow_exception(err);
   } catch (const client_error& e) {
     const error_class ec = e.ec();
     CB_ATTEMPT_CTX_LOG_ERROR(this,
@@ -3092,11 +3139,91 @@ attempt_context_impl::rollback()
                              id(),
                              e.what());
     if (ec == FAIL_HARD) {
-      throw transaction_operation_failed(ec, e.what()).no_rollback();
+      return std::make_exception_ptr(transaction_operation_failed(ec, e.what()).no_rollback());
     }
+    return {};
+  } catch (const transaction_operation_failed&) {
+    return std::current_exception();
+  } catch (const std::exception& e) {
+    return std::make_exception_ptr(
+      transaction_operation_failed(FAIL_OTHER, e.what()).no_rollback());
+  } catch (...) {
+    return std::make_exception_ptr(
+      transaction_operation_failed(FAIL_OTHER, "unexpected exception during rollback"));
   }
 }
 
+void
+attempt_context_impl::rollback(VoidCallback&& cb)
+{
+  op_list_.block_ops_when_done([self = shared_from_this(), cb = std::move(cb)]() mutable {
+    try {
+      CB_ATTEMPT_CTX_LOG_DEBUG(self, "rolling back {}", self->id());
+      if (self->op_list_.get_mode().is_query()) {
+        return self->rollback_with_query(std::move(cb));
+      }
+      // check for expiry
+      self->check_expiry_during_commit_or_rollback(STAGE_ROLLBACK, std::nullopt);
+      if (!self->atr_id_ || self->atr_id_->key().empty() ||
+          self->state() == attempt_state::NOT_STARTED) {
+        // TODO(SA): check this, but if we try to rollback an empty txn, we should
+        // prevent a subsequent commit
+        CB_ATTEMPT_CTX_LOG_DEBUG(self, "rollback called on txn with no mutations");
+        self->is_done_ = true;
+        return cb({});
+      }
+      if (self->is_done()) {
+        std::string msg("Transaction already done, cannot rollback");
+        CB_ATTEMPT_CTX_LOG_ERROR(self, "{}", msg);
+        // need to raise a FAIL_OTHER which is not retryable or rollback-able
+        throw transaction_operation_failed(FAIL_OTHER, msg).no_rollback();
+      }
+    } catch (...) {
+      return cb(self->rollback_error(std::current_exception()));
+    }
+    // (1) atr_abort
+    auto delay = std::make_shared<async_exp_delay>(
+      std::make_shared<asio::steady_timer>(self->cluster_ref().io_context()));
+    self->atr_abort(
+      std::move(delay), [self, cb = std::move(cb)](const std::exception_ptr& err) mutable {
+        if (err) {
+          return cb(self->rollback_error(err));
+        }
+        // (2) rollback staged mutations
+        self->staged_mutations_->rollback(
+          self, [self, cb = std::move(cb)](const std::exception_ptr& err) mutable {
+            if (err) {
+              return cb(self->rollback_error(err));
+            }
+            CB_ATTEMPT_CTX_LOG_DEBUG(self, "rollback completed unstaging docs");
+
+            // (3) atr_rollback
+            auto delay = std::make_shared<async_exp_delay>(
+              std::make_shared<asio::steady_timer>(self->cluster_ref().io_context()));
+            self->atr_rollback_complete(
+              std::move(delay), [self, cb = std::move(cb)](const std::exception_ptr& err) mutable {
+                cb(err ? self->rollback_error(err) : std::exception_ptr{});
+              });
+          });
+      });
+  });
+}
+
+void
+attempt_context_impl::rollback()
+{
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto f = barrier->get_future();
+  rollback([barrier](const std::exception_ptr& err) {
+    if (err) {
+      barrier->set_exception(err);
+    } else {
+      barrier->set_value();
+    }
+  });
+  f.get();
+}
+
 auto
 attempt_context_impl::has_expired_client_side(std::string place,
                                               std::optional<const std::string> doc_id) -> bool
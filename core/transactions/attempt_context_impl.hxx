@@ -75,6 +75,8 @@ enum class forward_compat_stage : std::uint8_t;
 class staged_mutation_queue;
 class staged_mutation;
 struct attempt_context_testing_hooks;
+struct async_exp_delay;
+struct async_constant_delay;
 
 class attempt_context_impl
   : public attempt_context
@@ -291,7 +293,7 @@ private:
           err.cause(TRANSACTION_ALREADY_COMMITTED);
           break;
         default:
-          // Ops are only blocked once commit or rollback has begun (wait_and_block_ops), but the
+          // Ops are only blocked once commit or rollback has begun (block_ops_when_done), but the
           // attempt state is published later -- and the empty-commit fast path never reaches
           // COMMITTED at all. So a racing op can land here with the state still PENDING: report it
           // as a concurrent operation rather than an opaque unknown cause.
@@ -493,15 +495,20 @@ private:
   template<typename Handler>
   void check_if_done(Handler& cb);
 
-  void atr_commit(bool ambiguity_resolution_mode);
+  void atr_commit(bool ambiguity_resolution_mode,
+                  std::shared_ptr<async_constant_delay> delay,
+                  VoidCallback&& cb);
 
-  void atr_commit_ambiguity_resolution();
+  void atr_commit_ambiguity_resolution(std::shared_ptr<async_constant_delay> delay,
+                                       VoidCallback&& cb);
 
-  void atr_complete();
+  void atr_complete(VoidCallback&& cb);
 
-  void atr_abort();
+  void atr_abort(std::shared_ptr<async_exp_delay> delay, VoidCallback&& cb);
 
-  void atr_rollback_complete();
+  void atr_rollback_complete(std::shared_ptr<async_exp_delay> delay, VoidCallback&& cb);
+
+  auto rollback_error(const std::exception_ptr& err) -> std::exception_ptr;
 
   void select_atr_if_needed_unlocked(
     const core::document_id& id,
@@ -99,6 +99,18 @@ public:
     return false;
   }
 
+  /**
+   * @brief Returns the CAS-time in milliseconds after which the transaction has expired, or an
+   * empty optional if the entry carries no start time or no timeout.
+   */
+  [[nodiscard]] std::optional<std::uint64_t> expires_at_ms() const
+  {
+    if (timestamp_start_ms_ && expires_after_ms_) {
+      return *timestamp_start_ms_ + *expires_after_ms_;
+    }
+    return {};
+  }
+
   [[nodiscard]] std::uint32_t age_ms() const
   {
     return static_cast<std::uint32_t>((cas_ / 1000000) - timestamp_start_ms_.value_or(0));
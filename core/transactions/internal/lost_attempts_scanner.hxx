@@ -0,0 +1,217 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "atr_entry.hxx"
+#include "client_record.hxx"
+
+#include "core/cluster.hxx"
+#include "core/topology/configuration.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <couchbase/transactions/transaction_keyspace.hxx>
+
+#include <asio/steady_timer.hpp>
+#include <asio/thread_pool.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::operations
+{
+struct lookup_in_response;
+} // namespace couchbase::core::operations
+
+namespace couchbase::core::transactions
+{
+class active_transaction_record;
+class transactions_cleanup;
+
+/**
+ * What the scanner remembers of an ATR it has read.
+ */
+struct known_atr {
+  std::uint64_t cas{ 0 };
+  // earliest expiry of its attempts, in vbucket clock milliseconds
+  std::optional<std::uint64_t> expires_at_ms{};
+};
+
+/**
+ * Builds the @ref known_atr of an ATR from its CAS and attempts.
+ */
+auto
+remember_atr(std::uint64_t cas, const std::vector<atr_entry>& entries) -> known_atr;
+
+enum class light_read_outcome : std::uint8_t {
+  // same CAS, and no attempt seen last time has expired since
+  unchanged,
+  // the ATR has to be read in full
+  changed,
+  // same CAS, but an attempt seen last time has expired by the vbucket clock
+  expired,
+  missing,
+};
+
+/**
+ * Decides what to do with an ATR seen before, given the result of the lookup of its vbucket clock.
+ * @p now_ms is the vbucket clock in milliseconds, if the lookup returned one that could be parsed.
+ */
+auto
+classify_light_read(const known_atr& known,
+                    std::error_code ec,
+                    std::uint64_t cas,
+                    std::optional<std::uint64_t> now_ms) -> light_read_outcome;
+
+/**
+ * The ATR checks of one pass of a @ref lost_attempts_scanner, grouped by the node that owns them.
+ *
+ * The checks due at a point of the pass are proportional to the share of the cleanup window that
+ * has elapsed, and each node has at most `window_per_node` of them in flight. Not thread safe.
+ */
+class lost_attempts_pass
+{
+public:
+  static constexpr std::size_t window_per_node{ 16 };
+  static constexpr std::chrono::milliseconds min_tick{ 10 };
+
+  lost_attempts_pass() = default;
+  lost_attempts_pass(const std::vector<std::string>& all_atrs,
+                     const client_record_details& details,
+                     const std::shared_ptr<topology::configuration>& config,
+                     std::chrono::milliseconds cleanup_window,
+                     std::chrono::steady_clock::time_point start);
+
+  /**
+   * Takes the checks that are due at @p now and fit in the window of their node, as pairs of lane
+   * index and ATR id.
+   */
+  auto launch(std::chrono::steady_clock::time_point now)
+    -> std::vector<std::pair<std::size_t, std::string>>;
+
+  /**
+   * Records a completed check, and returns true if it was the last one of the pass.
+   */
+  auto finish(std::size_t lane_index) -> bool;
+
+  [[nodiscard]] auto all_launched() const -> bool;
+  [[nodiscard]] auto tick_interval() const -> std::chrono::steady_clock::duration;
+  /**
+   * How long to wait before the next pass: a pass does not end before its window, even when
+   * every check was quick.
+   */
+  [[nodiscard]] auto next_pass_delay(std::chrono::steady_clock::time_point now) const
+    -> std::chrono::steady_clock::duration;
+  [[nodiscard]] auto elapsed(std::chrono::steady_clock::time_point now) const
+    -> std::chrono::steady_clock::duration;
+  [[nodiscard]] auto total() const -> std::size_t;
+  [[nodiscard]] auto number_of_lanes() const -> std::size_t;
+  [[nodiscard]] auto in_flight(std::size_t lane_index) const -> std::size_t;
+
+private:
+  struct lane {
+    std::vector<std::string> atr_ids{};
+    std::size_t next{ 0 };
+    std::size_t in_flight{ 0 };
+  };
+
+  std::chrono::milliseconds cleanup_window_{};
+  std::chrono::steady_clock::time_point start_{};
+  std::vector<lane> lanes_{};
+  std::size_t total_{ 0 };
+  std::size_t launched_{ 0 };
+  std::size_t in_flight_{ 0 };
+};
+
+/**
+ * Looks for lost transactions in the ATRs of one collection, one @ref lost_attempts_pass per
+ * cleanup window.
+ *
+ * A pass reads the client records on the cleanup pool, then checks the ATRs that belong to this
+ * client from timers on the IO context. An ATR seen before is checked with a small lookup of the
+ * vbucket clock: if its CAS has not changed and none of its attempts has expired since, it is not
+ * read again. Only an ATR with an expired attempt is handed to the cleanup pool, which cleans it
+ * with the blocking atr_cleanup_entry logic. Handlers on the IO context never touch the cleanup
+ * itself, only the work on the pool does.
+ */
+class lost_attempts_scanner : public std::enable_shared_from_this<lost_attempts_scanner>
+{
+public:
+  static constexpr std::chrono::seconds retry_delay{ 3 };
+
+  lost_attempts_scanner(transactions_cleanup& cleanup,
+                        couchbase::transactions::transaction_keyspace keyspace,
+                        asio::thread_pool& pool);
+
+  void start();
+
+  /**
+   * Stops scheduling and posting work, without waiting for anything, so it can be called from
+   * any thread. The handlers still pending find the scanner stopped and return, and the last of
+   * them releases it. Work already running on the pool may still use the cleanup, so the owner
+   * joins the pool before the cleanup goes away.
+   */
+  void stop();
+
+private:
+  auto stopped() -> bool;
+  void post_to_pool(utils::movable_function<void()> work);
+  void begin_pass();
+  void plan_pass(const client_record_details& details,
+                 const std::shared_ptr<topology::configuration>& config);
+  void schedule(std::chrono::steady_clock::duration delay, bool new_pass);
+  void tick();
+  void launch_allowed();
+  void check_atr(std::size_t lane_index, const std::string& atr_id);
+  void on_light_read(std::size_t lane_index,
+                     const std::string& atr_id,
+                     const known_atr& known,
+                     const operations::lookup_in_response& resp);
+  void read_atr(std::size_t lane_index, const std::string& atr_id);
+  void on_atr(std::size_t lane_index,
+              const std::string& atr_id,
+              std::error_code ec,
+              const std::optional<active_transaction_record>& atr);
+  void clean_atr(std::size_t lane_index, const std::string& atr_id);
+  void finish_check(std::size_t lane_index);
+
+  transactions_cleanup& cleanup_;
+  const core::cluster cluster_;
+  const couchbase::transactions::transaction_keyspace keyspace_;
+  const std::chrono::milliseconds cleanup_window_;
+  asio::thread_pool& pool_;
+  asio::steady_timer timer_;
+
+  std::mutex mutex_{};
+  bool stopped_{ false };
+
+  std::map<std::string, known_atr> known_{};
+  lost_attempts_pass pass_{};
+  std::size_t skipped_{ 0 };
+  std::size_t read_{ 0 };
+  std::size_t cleaned_{ 0 };
+};
+} // namespace couchbase::core::transactions
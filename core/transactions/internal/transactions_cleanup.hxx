@@ -35,6 +35,8 @@ namespace couchbase::core
 class cluster;
 namespace transactions
 {
+class lost_attempts_scanner;
+
 // only really used when we force cleanup, in tests
 class transactions_cleanup_attempt
 {
@@ -91,6 +93,8 @@ struct atr_cleanup_stats {
 
 class transactions_cleanup
 {
+  friend class lost_attempts_scanner;
+
 public:
   transactions_cleanup(core::cluster cluster,
                        couchbase::transactions::transactions_config::built config);
@@ -148,17 +152,12 @@ private:
   atr_cleanup_queue atr_queue_;
   mutable std::condition_variable cv_;
   mutable std::mutex mutex_;
-  std::list<std::thread> lost_attempt_cleanup_workers_;
-
-  // Bounded, shared pool of threads for the blocking per-ATR cleanup checks. These checks block on
-  // KV, so they must not run on the single Asio IO thread. The pool is shared across every
-  // collection cleanup worker, so this count bounds the TOTAL number of concurrent get_atr checks
-  // across the whole cleanup subsystem -- deliberately, to cap load on the cluster regardless of
-  // how many keyspaces are registered for cleanup. The same value doubles as each worker's
-  // in-flight cap: with one collection a worker saturates the pool; with many collections the
-  // shared pool multiplexes them (fair FIFO) and per-collection throughput drops accordingly, which
-  // is the intended trade-off (bounded cluster load over guaranteed per-collection pacing).
-  static constexpr std::size_t max_in_flight_atr_checks_{ 16 };
+  std::list<std::shared_ptr<lost_attempts_scanner>> lost_attempts_scanners_;
+
+  // Small pool for the blocking parts of lost attempts cleanup: reading the client records at the
+  // start of each pass, and cleaning the ATRs found with expired attempts. Checking the ATRs is
+  // asynchronous and runs on the IO context, so this does not bound the scan rate.
+  static constexpr std::size_t atr_cleanup_pool_threads_{ 2 };
   std::optional<asio::thread_pool> atr_cleanup_pool_;
 
   const std::string client_uuid_;
@@ -176,7 +175,8 @@ private:
   auto interruptable_wait(std::chrono::duration<R, P> time) -> bool;
 
   void lost_attempts_loop();
-  void clean_collection(const couchbase::transactions::transaction_keyspace& keyspace);
+  // call with mutex_ held, while running
+  void start_scanner(const couchbase::transactions::transaction_keyspace& keyspace);
   void create_client_record(const couchbase::transactions::transaction_keyspace& keyspace);
   auto handle_atr_cleanup(const core::document_id& atr_id,
                           std::vector<transactions_cleanup_attempt>* result = nullptr)
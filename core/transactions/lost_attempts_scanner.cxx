@@ -0,0 +1,506 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "internal/lost_attempts_scanner.hxx"
+
+#include "active_transaction_record.hxx"
+#include "atr_ids.hxx"
+#include "core/cluster.hxx"
+#include "core/operations/document_lookup_in.hxx"
+#include "core/utils/json.hxx"
+#include "internal/logging.hxx"
+#include "internal/transactions_cleanup.hxx"
+#include "internal/utils.hxx"
+
+#include <couchbase/error_codes.hxx>
+#include <couchbase/fmt/transaction_keyspace.hxx>
+#include <couchbase/lookup_in_specs.hxx>
+
+#include <asio/post.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace couchbase::core::transactions
+{
+auto
+remember_atr(std::uint64_t cas, const std::vector<atr_entry>& entries) -> known_atr
+{
+  known_atr known{ cas, {} };
+  for (const auto& entry : entries) {
+    if (auto expires_at_ms = entry.expires_at_ms(); expires_at_ms) {
+      known.expires_at_ms =
+        std::min(known.expires_at_ms.value_or(expires_at_ms.value()), expires_at_ms.value());
+    }
+  }
+  return known;
+}
+
+auto
+classify_light_read(const known_atr& known,
+                    std::error_code ec,
+                    std::uint64_t cas,
+                    std::optional<std::uint64_t> now_ms) -> light_read_outcome
+{
+  if (ec == errc::key_value::document_not_found) {
+    return light_read_outcome::missing;
+  }
+  if (ec || cas != known.cas) {
+    return light_read_outcome::changed;
+  }
+  if (known.expires_at_ms) {
+    if (!now_ms) {
+      return light_read_outcome::changed;
+    }
+    if (now_ms.value() > known.expires_at_ms.value()) {
+      return light_read_outcome::expired;
+    }
+  }
+  return light_read_outcome::unchanged;
+}
+
+lost_attempts_pass::lost_attempts_pass(const std::vector<std::string>& all_atrs,
+                                       const client_record_details& details,
+                                       const std::shared_ptr<topology::configuration>& config,
+                                       std::chrono::milliseconds cleanup_window,
+                                       std::chrono::steady_clock::time_point start)
+  : cleanup_window_{ cleanup_window }
+  , start_{ start }
+{
+  const std::size_t stride = std::max<std::size_t>(1, details.num_active_clients);
+  std::map<std::optional<std::size_t>, std::size_t> lane_by_node{};
+  for (std::size_t index = details.index_of_this_client; index < all_atrs.size();
+       index += stride) {
+    std::optional<std::size_t> server{};
+    if (config) {
+      server = config->map_key(all_atrs[index], 0).second;
+    }
+    auto [it, inserted] = lane_by_node.try_emplace(server, lanes_.size());
+    if (inserted) {
+      lanes_.emplace_back();
+    }
+    lanes_[it->second].atr_ids.push_back(all_atrs[index]);
+    ++total_;
+  }
+}
+
+auto
+lost_attempts_pass::launch(std::chrono::steady_clock::time_point now)
+  -> std::vector<std::pair<std::size_t, std::string>>
+{
+  // Only the share of the pass that is due by now is launched, so that the checks are spread
+  // across the cleanup window rather than issued as a burst.
+  const auto elapsed = now - start_;
+  std::size_t due = total_;
+  if (cleanup_window_.count() > 0 && elapsed < cleanup_window_) {
+    const double share = std::chrono::duration<double>(elapsed) / cleanup_window_;
+    due = std::min(total_, static_cast<std::size_t>(static_cast<double>(total_) * share) + 1);
+  }
+
+  std::vector<std::pair<std::size_t, std::string>> batch{};
+  bool progress{ true };
+  while (launched_ < due && progress) {
+    progress = false;
+    for (std::size_t index = 0; index < lanes_.size() && launched_ < due; ++index) {
+      auto& l = lanes_[index];
+      if (l.in_flight < window_per_node && l.next < l.atr_ids.size()) {
+        batch.emplace_back(index, l.atr_ids[l.next++]);
+        ++l.in_flight;
+        ++in_flight_;
+        ++launched_;
+        progress = true;
+      }
+    }
+  }
+  return batch;
+}
+
+auto
+lost_attempts_pass::finish(std::size_t lane_index) -> bool
+{
+  --lanes_[lane_index].in_flight;
+  --in_flight_;
+  return launched_ == total_ && in_flight_ == 0;
+}
+
+auto
+lost_attempts_pass::all_launched() const -> bool
+{
+  return launched_ >= total_;
+}
+
+auto
+lost_attempts_pass::tick_interval() const -> std::chrono::steady_clock::duration
+{
+  return std::max<std::chrono::steady_clock::duration>(
+    cleanup_window_ / std::max<std::size_t>(total_, 1), min_tick);
+}
+
+auto
+lost_attempts_pass::next_pass_delay(std::chrono::steady_clock::time_point now) const
+  -> std::chrono::steady_clock::duration
+{
+  return std::max<std::chrono::steady_clock::duration>(cleanup_window_ - elapsed(now),
+                                                       std::chrono::milliseconds::zero());
+}
+
+auto
+lost_attempts_pass::elapsed(std::chrono::steady_clock::time_point now) const
+  -> std::chrono::steady_clock::duration
+{
+  return now - start_;
+}
+
+auto
+lost_attempts_pass::total() const -> std::size_t
+{
+  return total_;
+}
+
+auto
+lost_attempts_pass::number_of_lanes() const -> std::size_t
+{
+  return lanes_.size();
+}
+
+auto
+lost_attempts_pass::in_flight(std::size_t lane_index) const -> std::size_t
+{
+  return lanes_[lane_index].in_flight;
+}
+
+lost_attempts_scanner::lost_attempts_scanner(transactions_cleanup& cleanup,
+                                             couchbase::transactions::transaction_keyspace keyspace,
+                                             asio::thread_pool& pool)
+  : cleanup_{ cleanup }
+  , cluster_{ cleanup.cluster_ref() }
+  , keyspace_{ std::move(keyspace) }
+  , cleanup_window_{ cleanup.config().cleanup_config.cleanup_window }
+  , pool_{ pool }
+  , timer_{ cluster_.io_context() }
+{
+}
+
+void
+lost_attempts_scanner::start()
+{
+  schedule(std::chrono::milliseconds::zero(), true);
+}
+
+void
+lost_attempts_scanner::stop()
+{
+  const std::scoped_lock lock(mutex_);
+  stopped_ = true;
+  timer_.cancel();
+}
+
+auto
+lost_attempts_scanner::stopped() -> bool
+{
+  const std::scoped_lock lock(mutex_);
+  return stopped_;
+}
+
+void
+lost_attempts_scanner::post_to_pool(utils::movable_function<void()> work)
+{
+  // under the lock, so that nothing reaches the pool once stop() has returned
+  const std::scoped_lock lock(mutex_);
+  if (stopped_) {
+    return;
+  }
+  asio::post(pool_, std::move(work));
+}
+
+void
+lost_attempts_scanner::schedule(std::chrono::steady_clock::duration delay, bool new_pass)
+{
+  const std::scoped_lock lock(mutex_);
+  if (stopped_) {
+    return;
+  }
+  timer_.expires_after(delay);
+  timer_.async_wait([self = shared_from_this(), new_pass](std::error_code ec) {
+    if (ec == asio::error::operation_aborted || self->stopped()) {
+      return;
+    }
+    if (new_pass) {
+      self->begin_pass();
+    } else {
+      self->tick();
+    }
+  });
+}
+
+void
+lost_attempts_scanner::begin_pass()
+{
+  CB_LOST_ATTEMPT_CLEANUP_LOG_INFO("cleanup for {} starting", keyspace_);
+  // the client records are read and written with the blocking client record logic
+  post_to_pool([self = shared_from_this()]() {
+    if (self->stopped()) {
+      return;
+    }
+    client_record_details details{};
+    try {
+      details = self->cleanup_.get_active_clients(self->keyspace_, self->cleanup_.client_uuid_);
+    } catch (const std::exception& e) {
+      CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
+        "cleanup of {} failed with {}, trying again in {}s", self->keyspace_, e.what(), 3);
+      return self->schedule(retry_delay, true);
+    }
+    self->cluster_.with_bucket_configuration(
+      self->keyspace_.bucket,
+      [self, details = std::move(details)](std::error_code ec,
+                                           std::shared_ptr<topology::configuration> config) {
+        if (self->stopped()) {
+          return;
+        }
+        // without a configuration the ATRs are still checked, as if they all lived on one node
+        self->plan_pass(details, ec ? nullptr : config);
+      });
+  });
+}
+
+void
+lost_attempts_scanner::plan_pass(const client_record_details& details,
+                                 const std::shared_ptr<topology::configuration>& config)
+{
+  lost_attempts_pass pass{
+    atr_ids::all(), details, config, cleanup_window_, std::chrono::steady_clock::now()
+  };
+  CB_LOST_ATTEMPT_CLEANUP_LOG_INFO(
+    "{} active clients (including this one), {} ATRs to check on {} nodes in {}ms",
+    details.num_active_clients,
+    pass.total(),
+    pass.number_of_lanes(),
+    cleanup_window_.count());
+  const bool empty = pass.total() == 0;
+  {
+    const std::scoped_lock lock(mutex_);
+    pass_ = std::move(pass);
+    skipped_ = 0;
+    read_ = 0;
+    cleaned_ = 0;
+  }
+  if (empty) {
+    return schedule(cleanup_window_, true);
+  }
+  tick();
+}
+
+void
+lost_attempts_scanner::tick()
+{
+  launch_allowed();
+
+  std::chrono::steady_clock::duration interval{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (pass_.all_launched()) {
+      // the last checks to complete start the next pass
+      return;
+    }
+    interval = pass_.tick_interval();
+  }
+  schedule(interval, false);
+}
+
+void
+lost_attempts_scanner::launch_allowed()
+{
+  std::vector<std::pair<std::size_t, std::string>> batch{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    batch = pass_.launch(std::chrono::steady_clock::now());
+  }
+  for (const auto& [lane_index, atr_id] : batch) {
+    check_atr(lane_index, atr_id);
+  }
+}
+
+void
+lost_attempts_scanner::check_atr(std::size_t lane_index, const std::string& atr_id)
+{
+  std::optional<known_atr> known{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (auto it = known_.find(atr_id); it != known_.end()) {
+      known = it->second;
+    }
+  }
+  if (!known) {
+    return read_atr(lane_index, atr_id);
+  }
+
+  // The vbucket clock is the smallest thing to ask for: it tells whether the ATR changed (CAS),
+  // and whether one of the attempts seen last time has expired since.
+  core::operations::lookup_in_request req{ core::document_id{
+    keyspace_.bucket, keyspace_.scope, keyspace_.collection, atr_id } };
+  req.specs =
+    lookup_in_specs{
+      lookup_in_specs::get(subdoc::lookup_in_macro::vbucket).xattr(),
+    }
+      .specs();
+  cluster_.execute(req,
+                   [self = shared_from_this(), lane_index, atr_id, last_seen = *known](
+                     const core::operations::lookup_in_response& resp) {
+                     if (self->stopped()) {
+                       return;
+                     }
+                     self->on_light_read(lane_index, atr_id, last_seen, resp);
+                   });
+}
+
+void
+lost_attempts_scanner::on_light_read(std::size_t lane_index,
+                                     const std::string& atr_id,
+                                     const known_atr& known,
+                                     const operations::lookup_in_response& resp)
+{
+  std::optional<std::uint64_t> now_ms{};
+  if (known.expires_at_ms && !resp.ctx.ec() && !resp.fields.empty()) {
+    try {
+      now_ms =
+        now_ns_from_vbucket(core::utils::json::parse_binary(resp.fields[0].value)) / 1'000'000;
+    } catch (const std::exception&) {
+      // without the clock the ATR is read in full
+    }
+  }
+  switch (classify_light_read(known, resp.ctx.ec(), resp.cas.value(), now_ms)) {
+    case light_read_outcome::changed:
+      return read_atr(lane_index, atr_id);
+    case light_read_outcome::expired:
+      return clean_atr(lane_index, atr_id);
+    case light_read_outcome::missing: {
+      const std::scoped_lock lock(mutex_);
+      known_[atr_id] = known_atr{};
+      ++skipped_;
+    } break;
+    case light_read_outcome::unchanged: {
+      const std::scoped_lock lock(mutex_);
+      ++skipped_;
+    } break;
+  }
+  finish_check(lane_index);
+}
+
+void
+lost_attempts_scanner::read_atr(std::size_t lane_index, const std::string& atr_id)
+{
+  active_transaction_record::get_atr(
+    cluster_,
+    { keyspace_.bucket, keyspace_.scope, keyspace_.collection, atr_id },
+    [self = shared_from_this(), lane_index, atr_id](
+      std::error_code ec, std::optional<active_transaction_record> atr) {
+      if (self->stopped()) {
+        return;
+      }
+      self->on_atr(lane_index, atr_id, ec, atr);
+    });
+}
+
+void
+lost_attempts_scanner::on_atr(std::size_t lane_index,
+                              const std::string& atr_id,
+                              std::error_code ec,
+                              const std::optional<active_transaction_record>& atr)
+{
+  if (ec) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG(
+      "reading atr {} of {} failed with {}, moving on", atr_id, keyspace_, ec.message());
+    {
+      const std::scoped_lock lock(mutex_);
+      known_.erase(atr_id);
+    }
+    return finish_check(lane_index);
+  }
+
+  known_atr known{};
+  bool expired{ false };
+  if (atr) {
+    known = remember_atr(atr->cas(), atr->entries());
+    expired = std::any_of(atr->entries().begin(), atr->entries().end(), [](const auto& entry) {
+      return entry.has_expired();
+    });
+  }
+  {
+    const std::scoped_lock lock(mutex_);
+    known_[atr_id] = known;
+    ++read_;
+  }
+  if (expired) {
+    return clean_atr(lane_index, atr_id);
+  }
+  finish_check(lane_index);
+}
+
+void
+lost_attempts_scanner::clean_atr(std::size_t lane_index, const std::string& atr_id)
+{
+  // cleaning an attempt is rare, and done with the blocking atr_cleanup_entry logic
+  post_to_pool([self = shared_from_this(), lane_index, atr_id]() {
+    if (self->stopped()) {
+      return;
+    }
+    try {
+      self->cleanup_.handle_atr_cleanup(
+        { self->keyspace_.bucket, self->keyspace_.scope, self->keyspace_.collection, atr_id });
+    } catch (const std::exception& e) {
+      CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
+        "cleanup of atr {} failed with {}, moving on", atr_id, e.what());
+    }
+    {
+      // cleaning changes the ATR, the next pass reads it in full
+      const std::scoped_lock lock(self->mutex_);
+      self->known_.erase(atr_id);
+      ++self->cleaned_;
+    }
+    self->finish_check(lane_index);
+  });
+}
+
+void
+lost_attempts_scanner::finish_check(std::size_t lane_index)
+{
+  bool pass_done{ false };
+  std::chrono::steady_clock::duration delay{};
+  {
+    const std::scoped_lock lock(mutex_);
+    pass_done = pass_.finish(lane_index);
+    if (pass_done) {
+      const auto now = std::chrono::steady_clock::now();
+      delay = pass_.next_pass_delay(now);
+      CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG(
+        "cleanup of {} complete in {}ms: {} ATRs unchanged, {} read, {} cleaned",
+        keyspace_,
+        std::chrono::duration_cast<std::chrono::milliseconds>(pass_.elapsed(now)).count(),
+        skipped_,
+        read_,
+        cleaned_);
+    }
+  }
+  if (!pass_done) {
+    return launch_allowed();
+  }
+  schedule(delay, true);
+}
+} // namespace couchbase::core::transactions
@@ -33,6 +33,11 @@
 #include <asio/bind_executor.hpp>
 #include <asio/post.hpp>
 
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <utility>
+
 namespace couchbase::core::transactions
 {
 staged_mutation::staged_mutation(staged_mutation_type type,
@@ -129,38 +134,211 @@ staged_mutation::cas(couchbase::cas cas)
   cas_ = cas;
 }
 
-auto
-unstaging_state::wait_until_unstage_possible() -> bool
+unstaging_pipeline::unstaging_pipeline(std::vector<staged_mutation*> items,
+                                       std::size_t window,
+                                       configuration_lookup lookup,
+                                       unstage_function unstage,
+                                       std::exception_ptr aborted_error,
+                                       completion_handler handler)
+  : items_{ std::move(items) }
+  , window_{ std::max<std::size_t>(window, 1) }
+  , lookup_{ std::move(lookup) }
+  , unstage_{ std::move(unstage) }
+  , aborted_error_{ std::move(aborted_error) }
+  , handler_{ std::move(handler) }
 {
-  std::unique_lock lock(mutex_);
-  auto success = cv_.wait_for(lock, ctx_->overall()->remaining(), [this] {
-    return (in_flight_count_ < MAX_PARALLELISM) || abort_;
-  });
-  if (!abort_) {
-    if (success) {
-      in_flight_count_++;
-    } else {
-      abort_ = true;
+}
+
+void
+unstaging_pipeline::start()
+{
+  std::set<std::string> bucket_names{};
+  for (const auto* item : items_) {
+    bucket_names.insert(item->id().bucket());
+  }
+  {
+    const std::scoped_lock lock(mutex_);
+    pending_configs_ = bucket_names.size();
+  }
+  if (bucket_names.empty()) {
+    return finish_if_done();
+  }
+  for (const auto& bucket_name : bucket_names) {
+    lookup_(bucket_name,
+            [self = shared_from_this(), bucket_name](
+              std::error_code ec, std::shared_ptr<topology::configuration> config) mutable {
+              // without a configuration the mutations of the bucket still get unstaged, in one
+              // group
+              self->on_configuration(bucket_name, ec ? nullptr : std::move(config));
+            });
+  }
+}
+
+void
+unstaging_pipeline::on_configuration(const std::string& bucket_name,
+                                     std::shared_ptr<topology::configuration> config)
+{
+  {
+    const std::scoped_lock lock(mutex_);
+    configs_[bucket_name] = std::move(config);
+    if (--pending_configs_ > 0) {
+      return;
+    }
+    build_lanes();
+  }
+  pump();
+}
+
+void
+unstaging_pipeline::build_lanes()
+{
+  std::map<std::pair<std::string, std::optional<std::size_t>>, std::size_t> lane_by_node{};
+  std::vector<std::vector<std::pair<std::uint16_t, staged_mutation*>>> groups{};
+  for (auto* item : items_) {
+    std::uint16_t vbucket{ 0 };
+    std::optional<std::size_t> server{};
+    if (const auto& config = configs_[item->id().bucket()]; config) {
+      std::tie(vbucket, server) = config->map_key(item->id().key(), 0);
+    }
+    auto [it, inserted] = lane_by_node.try_emplace({ item->id().bucket(), server }, groups.size());
+    if (inserted) {
+      groups.emplace_back();
+    }
+    groups[it->second].emplace_back(vbucket, item);
+  }
+
+  lanes_.reserve(groups.size());
+  for (auto& group : groups) {
+    std::stable_sort(group.begin(), group.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.first < rhs.first;
+    });
+    lane l{};
+    l.items.reserve(group.size());
+    for (const auto& [vbucket, item] : group) {
+      l.items.push_back(item);
+    }
+    lanes_.emplace_back(std::move(l));
+  }
+  CB_TXN_LOG_TRACE("unstaging {} mutations on {} nodes, at most {} at once per node",
+                   items_.size(),
+                   lanes_.size(),
+                   window_);
+}
+
+void
+unstaging_pipeline::pump()
+{
+  {
+    const std::scoped_lock lock(mutex_);
+    if (pumping_) {
+      // the dispatching thread rescans the lanes under the lock before it stops, so it sees the
+      // slot this completion freed
+      return;
+    }
+    pumping_ = true;
+  }
+  while (true) {
+    staged_mutation* item{ nullptr };
+    std::size_t lane_index{ 0 };
+    {
+      const std::scoped_lock lock(mutex_);
+      if (!aborted_) {
+        for (; lane_index < lanes_.size(); ++lane_index) {
+          auto& l = lanes_[lane_index];
+          if (l.in_flight < window_ && l.next < l.items.size()) {
+            item = l.items[l.next++];
+            ++l.in_flight;
+            ++in_flight_;
+            break;
+          }
+        }
+      }
+      if (item == nullptr) {
+        pumping_ = false;
+        break;
+      }
+    }
+
+    try {
+      unstage_(*item, [self = shared_from_this(), lane_index](std::exception_ptr exc) {
+        self->on_unstaged(lane_index, std::move(exc));
+      });
+    } catch (...) {
+      // This should not happen, but catching it to ensure that we wait for in-flight operations
+      CB_TXN_LOG_ERROR("caught exception while trying to initiate unstaging for {}. "
+                       "Aborting the rest and waiting for in-flight operations to finish",
+                       item->id());
+      const std::scoped_lock lock(mutex_);
+      --lanes_[lane_index].in_flight;
+      --in_flight_;
+      aborted_ = true;
     }
   }
-  return !abort_;
+  finish_if_done();
 }
 
 void
-unstaging_state::notify_unstage_complete()
+unstaging_pipeline::on_unstaged(std::size_t lane_index, std::exception_ptr exc)
 {
-  const std::scoped_lock lock(mutex_);
-  in_flight_count_--;
-  cv_.notify_one();
+  {
+    const std::scoped_lock lock(mutex_);
+    --lanes_[lane_index].in_flight;
+    --in_flight_;
+    if (exc) {
+      aborted_ = true;
+      if (!error_) {
+        error_ = std::move(exc);
+      }
+    }
+  }
+  pump();
 }
 
 void
-unstaging_state::notify_unstage_error()
+unstaging_pipeline::finish_if_done()
 {
-  const std::scoped_lock lock(mutex_);
-  abort_ = true;
-  in_flight_count_--;
-  cv_.notify_all();
+  completion_handler handler{};
+  std::exception_ptr result{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (finished_ || pending_configs_ > 0 || in_flight_ > 0) {
+      return;
+    }
+    if (!aborted_ && std::any_of(lanes_.begin(), lanes_.end(), [](const auto& l) {
+          return l.next < l.items.size();
+        })) {
+      return;
+    }
+    finished_ = true;
+    if (error_) {
+      result = error_;
+    } else if (aborted_) {
+      result = aborted_error_;
+    }
+    std::swap(handler, handler_);
+  }
+  handler(std::move(result));
+}
+
+auto
+staged_mutation_queue::document_id_hash::operator()(const core::document_id& id) const noexcept
+  -> std::size_t
+{
+  std::size_t seed{ std::hash<std::string>{}(id.key()) };
+  auto combine = [&seed](const std::string& part) {
+    seed ^= std::hash<std::string>{}(part) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  };
+  combine(id.bucket());
+  combine(id.scope());
+  combine(id.collection());
+  return seed;
+}
+
+auto
+staged_mutation_queue::document_id_equal::operator()(const core::document_id& lhs,
+                                                     const core::document_id& rhs) const -> bool
+{
+  return document_ids_equal(lhs, rhs);
 }
 
 auto
@@ -175,12 +353,11 @@ staged_mutation_queue::add(staged_mutation&& mutation)
 {
   const std::scoped_lock<std::mutex> lock(mutex_);
   // Can only have one staged mutation per document.
-  queue_.erase(std::remove_if(queue_.begin(),
-                              queue_.end(),
-                              [&mutation](const staged_mutation& item) {
-                                return document_ids_equal(item.id(), mutation.id());
-                              }),
-               queue_.end());
+  if (auto it = index_.find(mutation.id()); it != index_.end()) {
+    queue_[it->second] = std::move(mutation);
+    return;
+  }
+  index_.try_emplace(mutation.id(), queue_.size());
   queue_.emplace_back(std::move(mutation));
 }
 
@@ -238,59 +415,60 @@ void
 staged_mutation_queue::remove_any(const core::document_id& id)
 {
   const std::scoped_lock<std::mutex> lock(mutex_);
-  auto new_end = std::remove_if(queue_.begin(), queue_.end(), [&id](const staged_mutation& item) {
-    return document_ids_equal(item.id(), id);
-  });
-  queue_.erase(new_end, queue_.end());
+  auto it = index_.find(id);
+  if (it == index_.end()) {
+    return;
+  }
+  const auto position = it->second;
+  index_.erase(it);
+  // The order of the queue carries no meaning, so the last mutation takes the freed slot.
+  if (position + 1 != queue_.size()) {
+    queue_[position] = std::move(queue_.back());
+    index_[queue_[position].id()] = position;
+  }
+  queue_.pop_back();
 }
 
 auto
-staged_mutation_queue::find_any(const core::document_id& id) -> staged_mutation*
+staged_mutation_queue::find_locked(const core::document_id& id) -> staged_mutation*
 {
-  const std::scoped_lock<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (document_ids_equal(item.id(), id)) {
-      return &item;
-    }
+  if (auto it = index_.find(id); it != index_.end()) {
+    return &queue_[it->second];
   }
   return nullptr;
 }
 
+auto
+staged_mutation_queue::find_any(const core::document_id& id) -> staged_mutation*
+{
+  const std::scoped_lock<std::mutex> lock(mutex_);
+  return find_locked(id);
+}
+
 auto
 staged_mutation_queue::find_replace(const core::document_id& id) -> staged_mutation*
 {
   const std::scoped_lock<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::REPLACE && document_ids_equal(item.id(), id)) {
-      return &item;
-    }
-  }
-  return nullptr;
+  auto* item = find_locked(id);
+  return item != nullptr && item->type() == staged_mutation_type::REPLACE ? item : nullptr;
 }
 
 auto
 staged_mutation_queue::find_insert(const core::document_id& id) -> staged_mutation*
 {
   const std::scoped_lock<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::INSERT && document_ids_equal(item.id(), id)) {
-      return &item;
-    }
-  }
-  return nullptr;
+  auto* item = find_locked(id);
+  return item != nullptr && item->type() == staged_mutation_type::INSERT ? item : nullptr;
 }
 
 auto
 staged_mutation_queue::find_remove(const core::document_id& id) -> staged_mutation*
 {
   const std::scoped_lock<std::mutex> lock(mutex_);
-  for (auto& item : queue_) {
-    if (item.type() == staged_mutation_type::REMOVE && document_ids_equal(item.id(), id)) {
-      return &item;
-    }
-  }
-  return nullptr;
+  auto* item = find_locked(id);
+  return item != nullptr && item->type() == staged_mutation_type::REMOVE ? item : nullptr;
 }
+
 void
 staged_mutation_queue::iterate(const std::function<void(staged_mutation&)>& op)
 {
@@ -301,184 +479,80 @@ staged_mutation_queue::iterate(const std::function<void(staged_mutation&)>& op)
 }
 
 void
-staged_mutation_queue::commit(const std::shared_ptr<attempt_context_impl>& ctx)
+staged_mutation_queue::commit(const std::shared_ptr<attempt_context_impl>& ctx,
+                              utils::movable_function<void(std::exception_ptr)>&& callback)
 {
   CB_ATTEMPT_CTX_LOG_TRACE(ctx, "committing staged mutations...");
-  const std::scoped_lock<std::mutex> lock(mutex_);
-
-  unstaging_state state{ ctx };
-  std::vector<std::future<void>> futures{};
-  futures.reserve(queue_.size());
-
-  bool aborted = false;
-
-  for (auto& item : queue_) {
-    aborted = !state.wait_until_unstage_possible();
-    if (aborted) {
-      // Do not commit any more mutations
-      break;
+  std::vector<staged_mutation*> items{};
+  {
+    const std::scoped_lock<std::mutex> lock(mutex_);
+    items.reserve(queue_.size());
+    for (auto& item : queue_) {
+      items.push_back(&item);
     }
+  }
 
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto future = barrier->get_future();
-
-    try {
+  auto pipeline = std::make_shared<unstaging_pipeline>(
+    std::move(items),
+    ctx->overall()->config().unstaging_window,
+    [ctx](const std::string& bucket_name, unstaging_pipeline::configuration_handler handler) {
+      ctx->cluster_ref().with_bucket_configuration(bucket_name, std::move(handler));
+    },
+    [this, ctx](staged_mutation& item, unstaging_pipeline::completion_handler&& handler) {
       auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
       async_constant_delay delay(timer);
 
       switch (item.type()) {
         case staged_mutation_type::REMOVE:
-          remove_doc(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
+          return remove_doc(ctx, item, delay, std::move(handler));
         case staged_mutation_type::INSERT:
         case staged_mutation_type::REPLACE:
-          commit_doc(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
-      }
-    } catch (...) {
-      // This should not happen, but catching it to ensure that we wait for in-flight operations
-      CB_ATTEMPT_CTX_LOG_ERROR(ctx,
-                               "caught exception while trying to initiate commit for {}. Aborting "
-                               "rest of commit and waiting for "
-                               "in-flight rollback operations to finish",
-                               item.id());
-      aborted = true;
-      break;
-    }
-
-#ifdef __clang_analyzer__
-    // TODO(CXXCBC-549): clang-tidy reports potential memory leak here
-    [[clang::suppress]]
-#endif
-    futures.push_back(std::move(future));
-  }
-
-  std::exception_ptr exc{};
-  for (auto& future : futures) {
-    try {
-      future.get();
-    } catch (...) {
-      if (!exc) {
-        exc = std::current_exception();
+          return commit_doc(ctx, item, delay, std::move(handler));
       }
-    }
-  }
-  if (exc) {
-    rethrow_exception(exc);
-  }
-  if (aborted) {
-    // Commit was aborted but no exception was raised from the futures (possibly timeout during
-    // wait_until_unstage_possible())
-    throw transaction_operation_failed(FAIL_OTHER, "commit aborted")
-      .no_rollback()
-      .failed_post_commit();
-  }
+    },
+    std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, "commit aborted")
+                              .no_rollback()
+                              .failed_post_commit()),
+    std::move(callback));
+  pipeline->start();
 }
 
 void
-staged_mutation_queue::rollback(const std::shared_ptr<attempt_context_impl>& ctx)
+staged_mutation_queue::rollback(const std::shared_ptr<attempt_context_impl>& ctx,
+                                utils::movable_function<void(std::exception_ptr)>&& callback)
 {
   CB_ATTEMPT_CTX_LOG_TRACE(ctx, "rolling back staged mutations...");
-  const std::scoped_lock<std::mutex> lock(mutex_);
-
-  unstaging_state state{ ctx };
-  std::vector<std::future<void>> futures{};
-  futures.reserve(queue_.size());
-
-  bool aborted = false;
-
-  for (auto& item : queue_) {
-    aborted = !state.wait_until_unstage_possible();
-    if (aborted) {
-      // Do not roll back any more mutations
-      break;
+  std::vector<staged_mutation*> items{};
+  {
+    const std::scoped_lock<std::mutex> lock(mutex_);
+    items.reserve(queue_.size());
+    for (auto& item : queue_) {
+      items.push_back(&item);
     }
+  }
 
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto future = barrier->get_future();
-
-    try {
+  auto pipeline = std::make_shared<unstaging_pipeline>(
+    std::move(items),
+    ctx->overall()->config().unstaging_window,
+    [ctx](const std::string& bucket_name, unstaging_pipeline::configuration_handler handler) {
+      ctx->cluster_ref().with_bucket_configuration(bucket_name, std::move(handler));
+    },
+    [this, ctx](staged_mutation& item, unstaging_pipeline::completion_handler&& handler) {
       auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
       async_exp_delay delay(timer);
 
       switch (item.type()) {
         case staged_mutation_type::INSERT:
-          rollback_insert(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
+          return rollback_insert(ctx, item, delay, std::move(handler));
         case staged_mutation_type::REMOVE:
         case staged_mutation_type::REPLACE:
-          rollback_remove_or_replace(
-            ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-              if (exc) {
-                state.notify_unstage_error();
-                barrier->set_exception(exc);
-              } else {
-                state.notify_unstage_complete();
-                barrier->set_value();
-              }
-            });
-          break;
-      }
-    } catch (...) {
-      // This should not happen, but catching it to ensure that we wait for in-flight operations
-      CB_ATTEMPT_CTX_LOG_ERROR(ctx,
-                               "caught exception while trying to initiate rollback for {}. "
-                               "Aborting rollback and waiting for "
-                               "in-flight rollback operations to finish",
-                               item.id());
-      aborted = true;
-      break;
-    }
-
-#ifdef __clang_analyzer__
-    // TODO(CXXCBC-549): clang-tidy reports potential memory leak here
-    [[clang::suppress]]
-#endif
-    futures.push_back(std::move(future));
-  }
-
-  std::exception_ptr exc{};
-  for (auto& future : futures) {
-    try {
-      future.get();
-    } catch (...) {
-      if (!exc) {
-        exc = std::current_exception();
+          return rollback_remove_or_replace(ctx, item, delay, std::move(handler));
       }
-    }
-  }
-  if (exc) {
-    rethrow_exception(exc);
-  }
-  if (aborted) {
-    // Rollback was aborted but no exception was raised from the futures (possibly timeout during
-    // wait_until_unstage_possible())
-    throw transaction_operation_failed(FAIL_OTHER, "rollback aborted").no_rollback();
-  }
+    },
+    std::make_exception_ptr(
+      transaction_operation_failed(FAIL_OTHER, "rollback aborted").no_rollback()),
+    std::move(callback));
+  pipeline->start();
 }
 
 void
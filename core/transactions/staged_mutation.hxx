@@ -17,18 +17,22 @@
 #pragma once
 
 #include "attempt_context_impl.hxx"
+#include "core/topology/configuration.hxx"
 #include "internal/utils.hxx"
 #include "transaction_get_result.hxx"
 #include "uid_generator.hxx"
 
 #include <couchbase/codec/encoded_value.hxx>
 
-#include <atomic>
-#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <unordered_map>
 #include <vector>
 
 namespace couchbase::core::transactions
@@ -88,25 +92,87 @@ private:
   std::string operation_id_;
 };
 
-struct unstaging_state {
-  static constexpr std::size_t MAX_PARALLELISM{ 1000 };
+/**
+ * Commits or rolls back the staged mutations of a transaction, grouped by the node that owns their
+ * documents, and within a node ordered by vbucket.
+ *
+ * Each node has at most `window` operations in flight, and the next mutation of a node is sent as
+ * soon as one of them completes. After the first failure nothing more is sent, and the handler
+ * receives the failure once the operations in flight have completed.
+ *
+ * Only one thread dispatches at a time: a completion that arrives while another thread dispatches,
+ * including one that completes synchronously inside `unstage`, leaves its freed slot to that
+ * thread instead of recursing.
+ */
+class unstaging_pipeline : public std::enable_shared_from_this<unstaging_pipeline>
+{
+public:
+  using completion_handler = utils::movable_function<void(std::exception_ptr)>;
+  using unstage_function = utils::movable_function<void(staged_mutation&, completion_handler)>;
+  using configuration_handler =
+    utils::movable_function<void(std::error_code, std::shared_ptr<topology::configuration>)>;
+  using configuration_lookup =
+    utils::movable_function<void(const std::string& bucket_name, configuration_handler)>;
 
-  std::shared_ptr<attempt_context_impl> ctx_;
-  std::mutex mutex_{};
-  std::condition_variable cv_{};
-  std::atomic_size_t in_flight_count_{ 0 };
-  bool abort_{ false };
+  unstaging_pipeline(std::vector<staged_mutation*> items,
+                     std::size_t window,
+                     configuration_lookup lookup,
+                     unstage_function unstage,
+                     std::exception_ptr aborted_error,
+                     completion_handler handler);
+
+  void start();
+
+private:
+  struct lane {
+    std::vector<staged_mutation*> items{};
+    std::size_t next{ 0 };
+    std::size_t in_flight{ 0 };
+  };
+
+  void on_configuration(const std::string& bucket_name,
+                        std::shared_ptr<topology::configuration> config);
+  void build_lanes();
+  void pump();
+  void on_unstaged(std::size_t lane_index, std::exception_ptr exc);
+  void finish_if_done();
 
-  auto wait_until_unstage_possible() -> bool;
-  void notify_unstage_complete();
-  void notify_unstage_error();
+  std::vector<staged_mutation*> items_;
+  const std::size_t window_;
+  const configuration_lookup lookup_;
+  const unstage_function unstage_;
+  // reported when unstaging stopped early without an error of its own
+  const std::exception_ptr aborted_error_;
+  completion_handler handler_;
+
+  std::mutex mutex_{};
+  std::map<std::string, std::shared_ptr<topology::configuration>> configs_{};
+  std::size_t pending_configs_{ 0 };
+  std::vector<lane> lanes_{};
+  std::size_t in_flight_{ 0 };
+  bool pumping_{ false };
+  bool aborted_{ false };
+  bool finished_{ false };
+  std::exception_ptr error_{};
 };
 
 class staged_mutation_queue
 {
 private:
+  struct document_id_hash {
+    auto operator()(const core::document_id& id) const noexcept -> std::size_t;
+  };
+  struct document_id_equal {
+    auto operator()(const core::document_id& lhs, const core::document_id& rhs) const -> bool;
+  };
+
   std::mutex mutex_;
   std::vector<staged_mutation> queue_;
+  // Position of each staged document in queue_, so that read-your-own-writes lookups do not scan
+  // the whole transaction.
+  std::unordered_map<core::document_id, std::size_t, document_id_hash, document_id_equal> index_;
+
+  auto find_locked(const core::document_id& id) -> staged_mutation*;
 
   using client_error_handler = utils::movable_function<void(const std::optional<client_error>&)>;
 
@@ -175,8 +241,14 @@ public:
   auto empty() -> bool;
   void add(staged_mutation&& mutation);
   void extract_to(const std::string& prefix, core::operations::mutate_in_request& req);
-  void commit(const std::shared_ptr<attempt_context_impl>& ctx);
-  void rollback(const std::shared_ptr<attempt_context_impl>& ctx);
+  /**
+   * Unstages the queue through an @ref unstaging_pipeline, and calls @p callback once every
+   * mutation has been committed, or with the first failure. The queue must not change until then.
+   */
+  void commit(const std::shared_ptr<attempt_context_impl>& ctx,
+              utils::movable_function<void(std::exception_ptr)>&& callback);
+  void rollback(const std::shared_ptr<attempt_context_impl>& ctx,
+                utils::movable_function<void(std::exception_ptr)>&& callback);
   void iterate(const std::function<void(staged_mutation& /*mutation*/)>&);
   void remove_any(const core::document_id& /*id*/);
 
@@ -22,6 +22,7 @@
 
 #include "internal/client_record.hxx"
 #include "internal/logging.hxx"
+#include "internal/lost_attempts_scanner.hxx"
 #include "internal/transaction_fields.hxx"
 #include "internal/transactions_cleanup.hxx"
 #include "internal/utils.hxx"
@@ -33,7 +34,6 @@
 
 #include <asio/post.hpp>
 
-#include <deque>
 #include <functional>
 #include <future>
 #include <list>
@@ -107,165 +107,6 @@ transactions_cleanup::interruptable_wait(std::chrono::duration<R, P> time) -> bo
   return running_;
 }
 
-void
-transactions_cleanup::clean_collection(
-  const couchbase::transactions::transaction_keyspace& keyspace)
-{
-  // first make sure the collection is in the list
-  while (is_running()) {
-    {
-      const std::scoped_lock<std::mutex> lock(mutex_);
-      if (collections_.end() == std::find(collections_.begin(), collections_.end(), keyspace)) {
-        CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG(
-          "cleanup for {} ending, no longer in collection cleanup list", keyspace);
-        return;
-      }
-    }
-    CB_LOST_ATTEMPT_CLEANUP_LOG_INFO("cleanup for {} starting", keyspace);
-    // we are running, and collection is in the list, so lets clean it.
-    try {
-      auto details = get_active_clients(keyspace, client_uuid_);
-
-      auto all_atrs = atr_ids::all();
-
-      const auto cleanup_window = std::chrono::duration_cast<std::chrono::microseconds>(
-        config_.cleanup_config.cleanup_window);
-      auto start = std::chrono::steady_clock::now();
-      CB_LOST_ATTEMPT_CLEANUP_LOG_INFO(
-        "{} active clients (including this one), {} ATRs to check in {}ms",
-        details.num_active_clients,
-        all_atrs.size(),
-        config_.cleanup_config.cleanup_window.count());
-
-      // Each ATR is checked with a blocking get_atr. If those were run strictly one-at-a-time the
-      // scan rate would be capped by the per-ATR KV latency rather than the cleanup window: on a
-      // slow or loaded KV node a single window could fail to scan all ATRs, leaving lost
-      // transactions (and the documents they block) uncleaned for far longer than configured. So
-      // run the checks with a bounded number in flight: launches are still paced across the window
-      // (to avoid flooding the cluster), but a slow lookup no longer holds up the ones behind it.
-      std::deque<std::future<void>> in_flight;
-      // The pool is created in start() whenever lost-attempts cleanup is enabled, which is the only
-      // configuration that spawns collection workers, so it is always present here. Bind a checked
-      // reference now rather than dereferencing the optional at each launch.
-      if (!atr_cleanup_pool_.has_value()) {
-        // Should be unreachable (see above). If the invariant is ever broken, surface it: a silent
-        // return here disables lost-attempts cleanup for this collection with no other signal.
-        CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
-          "atr cleanup pool is not initialized; skipping lost-attempts cleanup for {}", keyspace);
-        return;
-      }
-      auto& atr_cleanup_pool = *atr_cleanup_pool_;
-      const auto reclaim_one = [&in_flight]() {
-        const auto reclaim = [](std::future<void>& f) {
-          // get() only rethrows if the task itself threw, which it is written not to, but guard
-          // anyway so one bad ATR cannot abort the whole scan.
-          try {
-            f.get();
-            // NOLINTNEXTLINE(bugprone-empty-catch) -- task already logged any error
-          } catch (...) {
-            // already handled in the task
-          }
-        };
-        // Reclaim any already-finished check first, so a slow lookup at the front does not hold up
-        // the ready ones queued behind it.
-        for (auto it = in_flight.begin(); it != in_flight.end(); ++it) {
-          if (it->wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-            reclaim(*it);
-            in_flight.erase(it);
-            return;
-          }
-        }
-        // None ready yet: block on the oldest, since a slot must be freed before launching more.
-        reclaim(in_flight.front());
-        in_flight.pop_front();
-      };
-
-      for (auto it = all_atrs.begin() + details.index_of_this_client; it < all_atrs.end();
-           it += details.num_active_clients) {
-        if (!is_running()) {
-          break;
-        }
-        // This client visits every num_active_clients-th ATR from `it`, so the number it still has
-        // to launch is ceil(remaining / stride). Floor division would undercount at the tail,
-        // inflating budget_for_this_atr below and over-pacing the scan past the cleanup window.
-        const auto stride = std::max<decltype(it)::difference_type>(1, details.num_active_clients);
-        const auto atrs_left_for_this_client =
-          (std::distance(it, all_atrs.end()) + stride - 1) / stride;
-        const auto now = std::chrono::steady_clock::now();
-        const auto elapsed_in_cleanup_window =
-          std::chrono::duration_cast<std::chrono::microseconds>(now - start);
-        const auto remaining_in_cleanup_window = cleanup_window - elapsed_in_cleanup_window;
-        // Divide the time left in the window evenly among the ATRs still to launch, so the scan is
-        // spread across the window rather than issued as a burst.
-        const auto budget_for_this_atr = std::chrono::microseconds(
-          remaining_in_cleanup_window.count() /
-          std::max<decltype(it)::difference_type>(1, atrs_left_for_this_client));
-        // Bound concurrency: reclaim a finished slot before launching the next check.
-        while (in_flight.size() >= max_in_flight_atr_checks_) {
-          reclaim_one();
-        }
-
-        const std::string atr_id = *it;
-        // Offload the blocking check to the shared bounded pool (never the IO thread); keep its
-        // future so the loop can bound how many run concurrently and drain them at the end.
-        // packaged_task is wrapped in a shared_ptr because asio::post needs a copyable handler.
-        auto task = std::make_shared<std::packaged_task<void()>>([this, keyspace, atr_id]() {
-          try {
-            handle_atr_cleanup({ keyspace.bucket, keyspace.scope, keyspace.collection, atr_id });
-          } catch (const std::exception& e) {
-            CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
-              "cleanup of atr {} failed with {}, moving on", atr_id, e.what());
-          }
-        });
-        auto future = task->get_future();
-        // Post before recording the future. If asio::post() throws (e.g. allocation failure) the
-        // task never runs; recording its future first would leave a future in `in_flight` that
-        // never becomes ready, deadlocking reclaim_one()/the drain. On throw, `future` is discarded
-        // and the exception unwinds to the per-collection retry below.
-        asio::post(atr_cleanup_pool, [task]() {
-          (*task)();
-        });
-        in_flight.emplace_back(std::move(future));
-
-        // Pace the launch cadence so the scan spreads across the window rather than bursting.
-        // Subtract the time already spent this iteration -- reclaiming a slot can block on a slow
-        // lookup, and posting takes time -- from the budget, so a slow iteration does not push the
-        // scan past the cleanup window. If we are already behind, the remainder is <= 0 and we
-        // proceed immediately.
-        const auto work_time = std::chrono::duration_cast<std::chrono::microseconds>(
-          std::chrono::steady_clock::now() - now);
-        const auto sleep_for_this_atr = budget_for_this_atr - work_time;
-        if (sleep_for_this_atr.count() > 0 &&
-            sleep_for_this_atr.count() < 1000000000) { // safety check protects against bugs
-          if (!interruptable_wait(sleep_for_this_atr)) {
-            break;
-          }
-        }
-      }
-
-      // Wait for any still-running checks before completing the run. On stop() the launch loop
-      // above has already stopped starting new checks (it breaks on !is_running()), so this only
-      // drains the
-      // <= max_in_flight_atr_checks_ already in flight. They are reclaimed rather than abandoned
-      // because each task references this cleanup state; teardown therefore blocks on them, bounded
-      // by the KV read timeout (an in-flight get_atr is not cancelled).
-      while (!in_flight.empty()) {
-        reclaim_one();
-      }
-      if (!is_running()) {
-        CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("cleanup of {} complete", keyspace);
-        return;
-      }
-    } catch (const std::exception& ex) {
-      CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR("cleanup failed with {}, trying again in 3 sec...",
-                                        ex.what());
-      // we must have gotten an exception trying to get the client records.   Let's wait 3 sec and
-      // try again
-      std::this_thread::sleep_for(std::chrono::seconds(3));
-    }
-  }
-}
-
 auto
 transactions_cleanup::handle_atr_cleanup(const core::document_id& atr_id,
                                          std::vector<transactions_cleanup_attempt>* results)
@@ -663,16 +504,13 @@ transactions_cleanup::add_collection(const couchbase::transactions::transaction_
     auto it = std::find(collections_.begin(), collections_.end(), keyspace);
     if (it == collections_.end()) {
       collections_.emplace_back(keyspace);
-      // Spawn only while running. stop() takes the worker handles out and joins them, so a
-      // handle appended after that point is one nothing has agreed to join -- and a
-      // joinable std::thread that reaches its destructor terminates. Registering the
-      // keyspace is still right: start() spawns a worker for everything in collections_,
+      // Start a scanner only while running. stop() takes the scanners out and stops them, so
+      // one added after that point would be left scanning with nothing to stop it. Registering
+      // the keyspace is still right: start() creates a scanner for everything in collections_,
       // so cleanup resumes for it on the next start.
       if (running_) {
         // start cleaning right away
-        lost_attempt_cleanup_workers_.emplace_back([this, keyspace = collections_.back()]() {
-          this->clean_collection(keyspace);
-        });
+        start_scanner(collections_.back());
       }
     }
     lock.unlock();
@@ -683,11 +521,9 @@ transactions_cleanup::add_collection(const couchbase::transactions::transaction_
 void
 transactions_cleanup::start()
 {
-  // The pool has to exist before any worker does: clean_collection() treats a missing pool
-  // as a broken invariant and gives up on the keyspace.
+  // The pool has to exist before any scanner does, as the scanners post their blocking work to it.
   if (config_.cleanup_config.cleanup_lost_attempts) {
-    // Blocking per-ATR checks are offloaded to this bounded pool, never the single IO thread.
-    atr_cleanup_pool_.emplace(max_in_flight_atr_checks_);
+    atr_cleanup_pool_.emplace(atr_cleanup_pool_threads_);
   }
 
   {
@@ -695,26 +531,24 @@ transactions_cleanup::start()
     // add_collection() and stop() -- so it is written under it here too, rather than being
     // the one unsynchronized access to it.
     //
-    // Publishing it in the same critical section as the respawn below also settles who
-    // spawns what. A concurrent add_collection() either runs before this section and only
-    // registers its keyspace, which the loop then spawns for, or after it and spawns for
-    // itself, by which point the loop has already gone past. Exactly one worker per
+    // Publishing it in the same critical section as the restart below also settles who
+    // starts what. A concurrent add_collection() either runs before this section and only
+    // registers its keyspace, which the loop then starts a scanner for, or after it and starts
+    // one itself, by which point the loop has already gone past. Exactly one scanner per
     // keyspace either way.
     const std::unique_lock<std::mutex> lock(mutex_);
     running_ = config_.cleanup_config.cleanup_client_attempts ||
                config_.cleanup_config.cleanup_lost_attempts;
 
     if (config_.cleanup_config.cleanup_lost_attempts) {
-      // Re-spawn a worker for every keyspace still registered from before a previous
+      // Restart a scanner for every keyspace still registered from before a previous
       // stop(). add_collection() below cannot do it: it dedupes on collections_, so
-      // for an already-registered keyspace it skips the worker and lost-attempt
+      // for an already-registered keyspace it skips the scanner and lost-attempt
       // cleanup stays dead for the rest of the process. Any fork leaves exactly that
       // state behind -- notify_fork(prepare) stops cleanup, notify_fork(parent)
       // starts it again.
       for (const auto& keyspace : collections_) {
-        lost_attempt_cleanup_workers_.emplace_back([this, keyspace]() {
-          this->clean_collection(keyspace);
-        });
+        start_scanner(keyspace);
       }
     }
   }
@@ -745,36 +579,31 @@ transactions_cleanup::stop()
     cleanup_thr_.join();
     CB_ATTEMPT_CLEANUP_LOG_DEBUG("cleanup attempt thread closed");
   }
-  // Take the handles out under mutex_, then join them with the lock released.
+  // Take the scanners out under mutex_, then stop them with the lock released.
   //
   // Under the lock, because add_collection() and start() append to this list while
-  // holding mutex_. Walking it while another thread appends is a data race on the
-  // list itself, and an append that lands after it was emptied would leave a
-  // joinable std::thread to be destroyed later, which terminates.
-  //
-  // With the lock released, because the workers themselves take mutex_ to see
-  // running_ (interruptable_wait, and the collections_ lookup in clean_collection),
-  // so joining while holding it deadlocks.
+  // holding mutex_. With the lock released, because the scanners' work on the pool may be
+  // reading the client records through this object.
   //
-  // Moving the handles out also drops them, which a later start() needs in order to
-  // spawn fresh workers. collections_ is deliberately kept: it also holds keyspaces
-  // registered at runtime, and discarding those would silently stop cleaning them.
-  std::list<std::thread> workers;
+  // collections_ is deliberately kept: it also holds keyspaces registered at runtime, and
+  // discarding those would silently stop cleaning them.
+  std::list<std::shared_ptr<lost_attempts_scanner>> scanners;
   {
     const std::unique_lock<std::mutex> lock(mutex_);
-    workers.swap(lost_attempt_cleanup_workers_);
+    scanners.swap(lost_attempts_scanners_);
   }
-  for (auto& t : workers) {
-    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("shutting down all lost attempt threads...");
-    if (t.joinable()) {
-      t.join();
-    }
+  if (!scanners.empty()) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("shutting down all lost attempt scanners...");
   }
-  // Workers drain their in-flight checks before returning, so the pool is now idle. stop() before
-  // join(): the pool's threads wait for work, so join() alone would block indefinitely on an idle
-  // pool; stop() requests shutdown so join() returns (there is no pending work left to abandon).
-  // Reset afterwards so stop() is idempotent: close() calls stop() from the destructor and the user
-  // may also call it explicitly, and a joined pool must not be joined again.
+  for (const auto& scanner : scanners) {
+    scanner->stop();
+  }
+  // Stopping a scanner does not wait for anything. Stopped scanners post no more work, the work
+  // they had queued returns without touching this object, and joining the pool waits for the
+  // work that is running right now. stop() before join(): the pool's threads wait for work, so
+  // join() alone would block indefinitely on an idle pool. Reset afterwards so stop() is
+  // idempotent: close() calls stop() from the destructor and the user may also call it
+  // explicitly, and a joined pool must not be joined again.
   if (atr_cleanup_pool_) {
     atr_cleanup_pool_->stop();
     atr_cleanup_pool_->join();
@@ -782,6 +611,14 @@ transactions_cleanup::stop()
   }
 }
 
+void
+transactions_cleanup::start_scanner(const couchbase::transactions::transaction_keyspace& keyspace)
+{
+  auto scanner = std::make_shared<lost_attempts_scanner>(*this, keyspace, *atr_cleanup_pool_);
+  scanner->start();
+  lost_attempts_scanners_.emplace_back(std::move(scanner));
+}
+
 void
 transactions_cleanup::close()
 {
@@ -42,6 +42,7 @@ transactions_config::transactions_config(const transactions_config& config)
   , metadata_collection_(config.metadata_collection())
   , query_config_(config.query_config())
   , cleanup_config_(config.cleanup_config())
+  , unstaging_window_(config.unstaging_window())
 {
 }
 
@@ -56,6 +57,7 @@ transactions_config::operator=(const transactions_config& c) -> transactions_con
     query_config_ = c.query_config_;
     metadata_collection_ = c.metadata_collection_;
     cleanup_config_ = c.cleanup_config_;
+    unstaging_window_ = c.unstaging_window_;
   }
   return *this;
 }
@@ -69,7 +71,8 @@ transactions_config::build() const -> transactions_config::built
            cleanup_hooks_,
            metadata_collection_,
            query_config_.build(),
-           cleanup_config_.build() };
+           cleanup_config_.build(),
+           unstaging_window_ };
 }
 
 } // namespace couchbase::transactions
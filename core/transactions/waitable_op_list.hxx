@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include "core/utils/movable_function.hxx"
 #include "internal/logging.hxx"
 
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 namespace couchbase::core::transactions
 {
@@ -70,14 +72,20 @@ public:
   {
     change_count(-1);
   }
-  void wait_and_block_ops()
+  // Blocks all further ops once the ones in progress have finished, then calls the handler (without
+  // the lock held). That happens right away when there are none, otherwise on the thread that
+  // finishes the last one, so the caller never waits. The handler must not throw: it may run inside
+  // decrement_ops().
+  void block_ops_when_done(utils::movable_function<void()>&& handler)
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    cv_ops_.wait(lock, [this]() {
-      return (0 == count_);
-    });
-    // we have the lock.  Block all further ops
+    if (0 != count_) {
+      ops_done_handlers_.emplace_back(std::move(handler));
+      return;
+    }
     allow_ops_ = false;
+    lock.unlock();
+    handler();
   }
   // Peek at whether query mode has already been entered.  Briefly acquires mutex_ but, unlike
   // get_mode(), never waits on cv_query_ for the query node to be set, so it returns immediately.
@@ -181,7 +189,7 @@ public:
 private:
   void change_count(int32_t val)
   {
-    std::scoped_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     if (allow_ops_) {
       count_ += val;
       if (val > 0) {
@@ -190,12 +198,19 @@ private:
       CB_TXN_LOG_TRACE("op count changed by {} to {}, {} in_flight", val, count_, in_flight_);
       assert(count_ >= 0);
       assert(in_flight_ >= 0);
-      if (0 == count_) {
-        cv_ops_.notify_all();
-      }
       if (0 == in_flight_) {
         cv_in_flight_.notify_all();
       }
+      if (0 == count_ && !ops_done_handlers_.empty()) {
+        // we have the lock.  Block all further ops
+        allow_ops_ = false;
+        auto handlers = std::move(ops_done_handlers_);
+        ops_done_handlers_.clear();
+        lock.unlock();
+        for (auto& handler : handlers) {
+          handler();
+        }
+      }
     } else {
       CB_TXN_LOG_ERROR("operation attempted after commit/rollback");
       throw async_operation_conflict("Operation attempted after commit or rollback");
@@ -207,7 +222,7 @@ private:
   bool allow_ops_;
   attempt_mode mode_;
   int32_t in_flight_;
-  std::condition_variable cv_ops_;
+  std::vector<utils::movable_function<void()>> ops_done_handlers_;
   std::condition_variable cv_query_;
   std::condition_variable cv_in_flight_;
   mutable std::mutex mutex_;
@@ -311,6 +311,49 @@ parse_option(tls_verify_mode& receiver,
   }
 }
 
+// The service of a "<service>_node_selection" parameter.
+auto
+node_selection_service(const std::string& name) -> std::optional<service_type>
+{
+  if (name == "query_node_selection") {
+    return service_type::query;
+  }
+  if (name == "analytics_node_selection") {
+    return service_type::analytics;
+  }
+  if (name == "search_node_selection") {
+    return service_type::search;
+  }
+  if (name == "view_node_selection") {
+    return service_type::view;
+  }
+  if (name == "eventing_node_selection") {
+    return service_type::eventing;
+  }
+  if (name == "management_node_selection") {
+    return service_type::management;
+  }
+  return {};
+}
+
+void
+parse_option(io::http_node_selection& receiver,
+             const std::string& name,
+             const std::string& value,
+             std::vector<std::string>& warnings)
+{
+  if (value == "round_robin") {
+    receiver = io::http_node_selection::round_robin;
+  } else if (value == "least_latency") {
+    receiver = io::http_node_selection::least_latency;
+  } else {
+    warnings.push_back(fmt::format(
+      R"(unable to parse "{}" parameter in connection string (value "{}" is not a valid node selection))",
+      name,
+      value));
+  }
+}
+
 void
 parse_option(std::size_t& receiver,
              const std::string& name,
@@ -550,6 +593,13 @@ extract_options(connection_string& connstr)
        * indicates an unlimited number of connections are permitted.
        */
       parse_option(connstr.options.max_http_connections, name, value, connstr.warnings);
+    } else if (auto service = node_selection_service(name); service.has_value()) {
+      /**
+       * How to pick the node for requests of the service: "round_robin" (default), or
+       * "least_latency" to prefer nodes that answer faster and have fewer requests in flight.
+       */
+      parse_option(
+        connstr.options.http_node_selection[service.value()], name, value, connstr.warnings);
     } else if (name == "idle_http_connection_timeout") {
       /**
        * The period of time an HTTP connection can be idle before it is forcefully disconnected.
@@ -611,6 +661,21 @@ extract_options(connection_string& connstr)
       parse_option(connstr.options.allow_enterprise_analytics, name, value, connstr.warnings);
     } else if (name == "enable_lazy_connections") {
       parse_option(connstr.options.enable_lazy_connections, name, value, connstr.warnings);
+    } else if (name == "query_cache_capacity") {
+      /**
+       * Maximum number of prepared statements kept by the query service cache. The least recently
+       * used statements are evicted beyond it.
+       */
+      parse_option(connstr.options.query_cache_capacity, name, value, connstr.warnings);
+    } else if (name == "kv_connections_per_node") {
+      /**
+       * Number of KV connections opened to every node of a bucket. Operations are spread over them
+       * by vbucket.
+       */
+      parse_option(connstr.options.kv_connections_per_node, name, value, connstr.warnings);
+      if (connstr.options.kv_connections_per_node == 0) {
+        connstr.options.kv_connections_per_node = 1;
+      }
     } else {
       connstr.warnings.push_back(
         fmt::format(R"(unknown parameter "{}" in connection string (value "{}"))", name, value));
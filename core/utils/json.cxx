@@ -19,6 +19,7 @@
 
 #include <tao/json.hpp>
 #include <tao/json/contrib/traits.hpp>
+#include <tao/json/events/virtual_ref.hpp>
 
 #include <gsl/span>
 
@@ -307,4 +308,15 @@ generate_binary(const tao::json::value& object) -> std::vector<std::byte>
   tao::json::events::from_value(consumer, object);
   return out;
 }
+
+auto
+generate_binary(const std::function<void(tao::json::events::virtual_base&)>& producer)
+  -> std::vector<std::byte>
+{
+  std::vector<std::byte> out;
+  tao::json::events::transformer<to_byte_vector> consumer(out);
+  tao::json::events::virtual_ref<tao::json::events::transformer<to_byte_vector>> ref(consumer);
+  producer(ref);
+  return out;
+}
 } // namespace couchbase::core::utils::json
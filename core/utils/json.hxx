@@ -19,8 +19,11 @@
 
 #include "core/json_string.hxx"
 
+#include <tao/json/events/virtual_base.hpp>
 #include <tao/json/forward.hpp>
 
+#include <functional>
+
 namespace couchbase::core::utils::json
 {
 auto
@@ -40,4 +43,12 @@ parse_binary(const std::vector<std::byte>& input) -> tao::json::value;
 
 auto
 generate_binary(const tao::json::value& object) -> std::vector<std::byte>;
+
+/**
+ * Lets the producer emit JSON events straight into the returned buffer, without building a
+ * tao::json::value first.
+ */
+auto
+generate_binary(const std::function<void(tao::json::events::virtual_base&)>& producer)
+  -> std::vector<std::byte>;
 } // namespace couchbase::core::utils::json
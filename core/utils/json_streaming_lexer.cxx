@@ -21,6 +21,8 @@
 #include "third_party/jsonsl/jsonsl.h"
 
 #include <stdexcept>
+#include <string>
+#include <string_view>
 
 namespace couchbase::core::utils::json
 {
@@ -498,4 +500,35 @@ streaming_lexer::on_row(std::function<stream_control(std::string&&)> handler)
 {
   impl_->on_row_ = std::move(handler);
 }
+
+auto
+split_rows(std::string_view body, const std::string& pointer_expression, std::uint32_t depth)
+  -> split_rows_result
+{
+  split_rows_result result{};
+  bool complete{ false };
+  streaming_lexer lexer{ pointer_expression, depth };
+  lexer.on_row([&result](std::string&& row) {
+    result.rows.emplace_back(std::move(row));
+    return stream_control::next_row;
+  });
+  lexer.on_complete([&result, &complete](std::error_code ec, std::size_t, std::string&& meta) {
+    complete = true;
+    result.ec = ec;
+    result.meta = std::move(meta);
+  });
+
+  /* The lexer copies what it is fed, and drops it again once the rows in it have been emitted.
+   * Feeding the body in slices keeps that copy down to a slice plus the row being lexed, instead
+   * of a second copy of the whole body. */
+  constexpr std::size_t slice_size{ 64 * 1024 };
+  for (std::size_t offset = 0; offset < body.size() && !complete; offset += slice_size) {
+    lexer.feed(body.substr(offset, slice_size));
+  }
+  if (!complete) {
+    /* empty or truncated body: the root object has never been closed */
+    result.ec = errc::streaming_json_lexer::generic;
+  }
+  return result;
+}
 } // namespace couchbase::core::utils::json
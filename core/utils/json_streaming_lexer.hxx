@@ -28,6 +28,8 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace couchbase::core::utils::json
 {
@@ -67,4 +69,27 @@ public:
 private:
   std::shared_ptr<detail::streaming_lexer_impl> impl_{};
 };
+
+/**
+ * A complete response body, split into its rows and the metadata around them.
+ */
+struct split_rows_result {
+  std::error_code ec{};
+  std::vector<std::string> rows{};
+  /**
+   * The body with the rows taken out of it, e.g. <tt>{"results":[],"status":"success"}</tt>.
+   */
+  std::string meta{};
+};
+
+/**
+ * Runs a complete, already received body through the streaming lexer, so that the rows are sliced
+ * out of it verbatim and only the (small) metadata is left to be parsed into a DOM.
+ *
+ * @param pointer_expression expression that describes where the rows are located.
+ * @param depth see streaming_lexer.
+ */
+auto
+split_rows(std::string_view body, const std::string& pointer_expression, std::uint32_t depth)
+  -> split_rows_result;
 } // namespace couchbase::core::utils::json
@@ -30,7 +30,7 @@ class json_transcoder
 {
 public:
   template<typename Document>
-  static auto encode(Document document) -> encoded_value
+  static auto encode(const Document& document) -> encoded_value
   {
     return { Serializer::serialize(document), codec_flags::json_common_flags };
   }
@@ -21,8 +21,18 @@
 #include <couchbase/codec/serializer_traits.hxx>
 #include <couchbase/error_codes.hxx>
 
+#include <tao/json/consume_string.hpp>
+#include <tao/json/events/produce.hpp>
+#include <tao/json/events/virtual_base.hpp>
 #include <tao/json/value.hpp>
 
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 namespace couchbase
 {
 #ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
@@ -31,6 +41,10 @@ namespace core::utils::json
 auto
 generate_binary(const tao::json::value& object) -> std::vector<std::byte>;
 
+auto
+generate_binary(const std::function<void(tao::json::events::virtual_base&)>& producer)
+  -> std::vector<std::byte>;
+
 auto
 parse_binary(const std::vector<std::byte>& input) -> tao::json::value;
 } // namespace core::utils::json
@@ -38,17 +52,34 @@ parse_binary(const std::vector<std::byte>& input) -> tao::json::value;
 
 namespace codec
 {
+/**
+ * Serializer for documents that tao::json knows how to convert.
+ *
+ * When the `tao::json::traits` of a document can produce JSON events (like the traits generated
+ * with `tao::json::binding`), the document is written straight into the output buffer. When they
+ * can consume them, the document is parsed straight from the input. For containers, the traits of
+ * the elements must support the events too. Otherwise the document goes through a
+ * `tao::json::value`.
+ */
 class tao_json_serializer
 {
 public:
   using document_type = tao::json::value;
 
   template<typename Document>
-  static auto serialize([[maybe_unused]] Document document) -> binary
+  static auto serialize([[maybe_unused]] const Document& document) -> binary
   {
+    using value_type = std::decay_t<Document>;
     try {
-      if constexpr (std::is_null_pointer_v<std::remove_reference_t<Document>>) {
+      if constexpr (std::is_null_pointer_v<value_type>) {
         return core::utils::json::generate_binary(tao::json::null);
+      } else if constexpr (std::is_same_v<value_type, tao::json::value>) {
+        return core::utils::json::generate_binary(document);
+      } else if constexpr (handles_events<declares_produce, value_type>()) {
+        return core::utils::json::generate_binary(
+          [&document](tao::json::events::virtual_base& consumer) {
+            tao::json::events::produce<tao::json::traits>(consumer, document);
+          });
       } else {
         return core::utils::json::generate_binary(tao::json::value(document));
       }
@@ -65,6 +96,8 @@ public:
     try {
       if constexpr (std::is_same_v<Document, tao::json::value>) {
         return core::utils::json::parse_binary(data);
+      } else if constexpr (handles_events<consumes_events, Document>()) {
+        return consume_events<Document>(data);
       } else {
         return core::utils::json::parse_binary(data).as<Document>();
       }
@@ -78,6 +111,151 @@ public:
         std::string("json_transcoder cannot parse document: ").append(e.what()));
     }
   }
+
+private:
+  template<typename Document>
+  static auto consume_events(const binary& data) -> Document
+  {
+    try {
+      return tao::json::consume_string<Document>(
+        std::string_view{ reinterpret_cast<const char*>(data.data()), data.size() });
+    } catch (const tao::pegtl::parse_error&) {
+      throw;
+    } catch (const std::system_error&) {
+      throw;
+    } catch (const std::runtime_error&) {
+      // The parts parser reports duplicated, missing and unknown keys of bindings this way.
+      // parse_binary() keeps the last of duplicated keys, so parse the document again like it does.
+    }
+    try {
+      return core::utils::json::parse_binary(data).as<Document>();
+    } catch (const tao::pegtl::parse_error&) {
+      throw;
+    } catch (const std::system_error&) {
+      throw;
+    } catch (const std::runtime_error& e) {
+      throw std::system_error(
+        errc::common::decoding_failure,
+        std::string("json_transcoder cannot parse document: ").append(e.what()));
+    }
+  }
+
+  template<typename T, typename = void>
+  struct produces_events : std::false_type {
+  };
+
+  template<typename T>
+  struct produces_events<T,
+                         std::void_t<decltype(tao::json::traits<T>::template produce<
+                                              tao::json::traits>(
+                           std::declval<tao::json::events::virtual_base&>(),
+                           std::declval<const T&>()))>> : std::true_type {
+  };
+
+  // takes a single parameter, like consumes_events, to be passed to handles_events()
+  template<typename T>
+  using declares_produce = produces_events<T>;
+
+  // the traits either return the document, or fill one that already exists (like bindings do)
+  template<typename T, typename = void>
+  struct consumes_events_by_value : std::false_type {
+  };
+
+  template<typename T>
+  struct consumes_events_by_value<T,
+                                  std::void_t<decltype(tao::json::traits<T>::template consume<
+                                                       tao::json::traits>(
+                                    std::declval<tao::json::parts_parser&>()))>> : std::true_type {
+  };
+
+  template<typename T, typename = void>
+  struct consumes_events_in_place : std::false_type {
+  };
+
+  template<typename T>
+  struct consumes_events_in_place<
+    T,
+    std::void_t<decltype(tao::json::traits<T>::template consume<tao::json::traits>(
+      std::declval<tao::json::parts_parser&>(),
+      std::declval<T&>()))>> : std::true_type {
+  };
+
+  template<typename T>
+  struct consumes_events
+    : std::disjunction<consumes_events_by_value<T>, consumes_events_in_place<T>> {
+  };
+
+  template<typename T, typename = void>
+  struct has_value_type : std::false_type {
+  };
+
+  template<typename T>
+  struct has_value_type<T, std::void_t<typename T::value_type>> : std::true_type {
+  };
+
+  template<typename T, typename = void>
+  struct has_mapped_type : std::false_type {
+  };
+
+  template<typename T>
+  struct has_mapped_type<T, std::void_t<typename T::mapped_type>> : std::true_type {
+  };
+
+  template<typename T, typename = void>
+  struct has_element_type : std::false_type {
+  };
+
+  template<typename T>
+  struct has_element_type<T, std::void_t<typename T::element_type>> : std::true_type {
+  };
+
+  template<typename T, typename = void>
+  struct has_tuple_size : std::false_type {
+  };
+
+  template<typename T>
+  struct has_tuple_size<T, std::void_t<decltype(std::tuple_size<T>::value)>> : std::true_type {
+  };
+
+  template<typename T, typename = void>
+  struct is_binary : std::false_type {
+  };
+
+  template<typename T>
+  struct is_binary<T, std::enable_if_t<std::is_same_v<std::remove_cv_t<typename T::value_type>,
+                                                       std::byte>>> : std::true_type {
+  };
+
+  // The container traits of tao/json/contrib declare produce and consume for any element type,
+  // and fail to compile when the elements only have assign/as, so look into the elements too.
+  template<template<typename> class Supports, typename T>
+  static constexpr auto handles_events() -> bool
+  {
+    using type = std::remove_cv_t<T>;
+    if constexpr (!Supports<type>::value) {
+      return false;
+    } else if constexpr (std::is_convertible_v<const type&, std::string_view> ||
+                         is_binary<type>::value) {
+      return true;
+    } else if constexpr (has_mapped_type<type>::value) {
+      return handles_events<Supports, typename type::mapped_type>();
+    } else if constexpr (has_value_type<type>::value) {
+      return handles_events<Supports, typename type::value_type>();
+    } else if constexpr (has_element_type<type>::value) {
+      return handles_events<Supports, typename type::element_type>();
+    } else if constexpr (has_tuple_size<type>::value) {
+      return handles_tuple_events<Supports, type>(
+        std::make_index_sequence<std::tuple_size_v<type>>{});
+    } else {
+      return true;
+    }
+  }
+
+  template<template<typename> class Supports, typename T, std::size_t... I>
+  static constexpr auto handles_tuple_events(std::index_sequence<I...> /* indexes */) -> bool
+  {
+    return (handles_events<Supports, std::tuple_element_t<I, T>>() && ...);
+  }
 };
 
 #ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
@@ -49,6 +49,9 @@
 
 #include <future>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -1311,6 +1314,186 @@ public:
   [[nodiscard]] auto node_ids(const node_ids_options& options = {}) const
     -> std::future<std::pair<error, std::vector<node_id>>>;
 
+  /**
+   * Fetches several full documents from this collection.
+   *
+   * The ids are grouped by the node that owns them, and the operations for a node are written to
+   * its connection together, which saves most of the per-operation overhead of calling @ref get in
+   * a loop. Apart from that every document is fetched by its own get operation with the given
+   * options, including the timeout and retry strategy.
+   *
+   * The handler is invoked once, when every document has completed. The results are in the order
+   * of @p document_ids, and each carries its own error: a missing document or a timeout of one key
+   * does not fail the others. If the bucket configuration cannot be obtained within the timeout
+   * (or the bucket does not exist), every result carries that error.
+   *
+   * @param document_ids the ids of the documents to fetch.
+   * @param options options to customize every get request.
+   * @param handler the handler that implements @ref get_multi_handler
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  void get_multi(std::vector<std::string> document_ids,
+                 const get_options& options,
+                 get_multi_handler&& handler) const;
+
+  /**
+   * Fetches several full documents from this collection.
+   *
+   * See the handler overload for how the operations are dispatched and how errors are reported.
+   *
+   * @param document_ids the ids of the documents to fetch.
+   * @param options options to customize every get request.
+   * @return future object that carries the results in the order of @p document_ids
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto get_multi(std::vector<std::string> document_ids,
+                               const get_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, get_result>>>;
+
+  /**
+   * Upserts several encoded documents, with the same options for all of them.
+   *
+   * The operations are grouped by node and reported the same way as for @ref get_multi: the
+   * handler receives one result per document, in the order of @p documents, and each mutation
+   * succeeds or fails on its own.
+   *
+   * @param documents pairs of document id and encoded content.
+   * @param options custom options to customize every upsert.
+   * @param handler the handler that implements @ref upsert_multi_handler
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const;
+
+  /**
+   * Upserts several encoded documents, with the same options for all of them.
+   *
+   * @param documents pairs of document id and encoded content.
+   * @param options custom options to customize every upsert.
+   * @return future object that carries the results in the order of @p documents
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto upsert_multi(
+    std::vector<std::pair<std::string, codec::encoded_value>> documents,
+    const upsert_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>;
+
+  /**
+   * Upserts several documents, with the same options for all of them.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the documents
+   *
+   * @param documents pairs of document id and content.
+   * @param options custom options to customize every upsert.
+   * @param handler the handler that implements @ref upsert_multi_handler
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  void upsert_multi(std::vector<std::pair<std::string, Document>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const
+  {
+    return upsert_multi(
+      encode_documents<Transcoder, Document>(std::move(documents)), options, std::move(handler));
+  }
+
+  /**
+   * Upserts several documents, with the same options for all of them.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the documents
+   *
+   * @param documents pairs of document id and content.
+   * @param options custom options to customize every upsert.
+   * @return future object that carries the results in the order of @p documents
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  [[nodiscard]] auto upsert_multi(std::vector<std::pair<std::string, Document>> documents,
+                                  const upsert_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>
+  {
+    return upsert_multi(encode_documents<Transcoder, Document>(std::move(documents)), options);
+  }
+
+  /**
+   * Removes several documents, with the same options for all of them.
+   *
+   * The operations are grouped by node and reported the same way as for @ref get_multi.
+   *
+   * @param document_ids the ids of the documents to remove.
+   * @param options custom options to customize every remove.
+   * @param handler the handler that implements @ref remove_multi_handler
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  void remove_multi(std::vector<std::string> document_ids,
+                    const remove_options& options,
+                    remove_multi_handler&& handler) const;
+
+  /**
+   * Removes several documents, with the same options for all of them.
+   *
+   * @param document_ids the ids of the documents to remove.
+   * @param options custom options to customize every remove.
+   * @return future object that carries the results in the order of @p document_ids
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto remove_multi(std::vector<std::string> document_ids,
+                                  const remove_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, mutation_result>>>;
+
+  /**
+   * Updates the expiration of several documents.
+   *
+   * The operations are grouped by node and reported the same way as for @ref get_multi.
+   *
+   * @param document_ids the ids of the documents to touch.
+   * @param duration the new expiration time for every document.
+   * @param options custom options to customize every touch.
+   * @param handler the handler that implements @ref touch_multi_handler
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  void touch_multi(std::vector<std::string> document_ids,
+                   std::chrono::seconds duration,
+                   const touch_options& options,
+                   touch_multi_handler&& handler) const;
+
+  /**
+   * Updates the expiration of several documents.
+   *
+   * @param document_ids the ids of the documents to touch.
+   * @param duration the new expiration time for every document.
+   * @param options custom options to customize every touch.
+   * @return future object that carries the results in the order of @p document_ids
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto touch_multi(std::vector<std::string> document_ids,
+                                 std::chrono::seconds duration,
+                                 const touch_options& options = {}) const
+    -> std::future<std::vector<std::pair<error, result>>>;
+
   [[nodiscard]] auto query_indexes() const -> collection_query_index_manager;
 
 private:
@@ -1335,6 +1518,22 @@ private:
     }
   }
 
+  template<typename Transcoder, typename Document>
+  [[nodiscard]] auto encode_documents(std::vector<std::pair<std::string, Document>> documents) const
+    -> std::vector<std::pair<std::string, codec::encoded_value>>
+  {
+    std::vector<std::pair<std::string, codec::encoded_value>> encoded;
+    encoded.reserve(documents.size());
+    for (auto& [id, document] : documents) {
+      if constexpr (codec::is_crypto_transcoder_v<Transcoder>) {
+        encoded.emplace_back(std::move(id), Transcoder::encode(document, crypto_manager()));
+      } else {
+        encoded.emplace_back(std::move(id), Transcoder::encode(document));
+      }
+    }
+    return encoded;
+  }
+
   void replace(std::string document_id,
                std::function<codec::encoded_value()> document_fn,
                const replace_options& options,
@@ -42,10 +42,28 @@ public:
     return *this;
   }
 
+  /**
+   * Tracks how well the documents of each collection compress, and mostly stops trying to compress
+   * documents of a collection whose recent documents did not reach the minimum ratio. A small
+   * share of them is still compressed, to notice when the data becomes compressible again.
+   *
+   * @param adaptive true to enable adaptive compression
+   * @return this object for chaining purposes
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  auto adaptive(bool adaptive) -> compression_options&
+  {
+    adaptive_ = adaptive;
+    return *this;
+  }
+
   struct built {
     bool enabled;
     std::size_t min_size;
     double min_ratio;
+    bool adaptive;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -54,6 +72,7 @@ public:
       enabled_,
       min_size_,
       min_ratio_,
+      adaptive_,
     };
   }
 
@@ -61,5 +80,6 @@ private:
   bool enabled_{ true };
   std::size_t min_size_{ 32 };
   double min_ratio_{ 0.83 };
+  bool adaptive_{ false };
 };
 } // namespace couchbase
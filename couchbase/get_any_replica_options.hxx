@@ -41,6 +41,7 @@ struct get_any_replica_options : public common_options<get_any_replica_options>
    */
   struct built : public common_options<get_any_replica_options>::built {
     couchbase::read_preference read_preference;
+    bool hedged;
   };
 
   /**
@@ -60,6 +61,26 @@ struct get_any_replica_options : public common_options<get_any_replica_options>
     return self();
   }
 
+  /**
+   * Ask the active node first, and ask a replica only when the active has not answered within
+   * the 95th percentile of its recent read latencies, or failed. The response that arrives
+   * first wins and the other request is cancelled.
+   *
+   * By default all nodes allowed by the read preference are asked at once, which multiplies the
+   * read load by the number of replicas plus one.
+   *
+   * @param hedged
+   * @return this options builder for chaining purposes.
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  auto hedged(bool hedged) -> get_any_replica_options&
+  {
+    hedged_ = hedged;
+    return self();
+  }
+
   /**
    * Validates options and returns them as an immutable value.
    *
@@ -76,11 +97,13 @@ struct get_any_replica_options : public common_options<get_any_replica_options>
     return {
       build_common_options(),
       read_preference_,
+      hedged_,
     };
   }
 
 private:
   couchbase::read_preference read_preference_{ read_preference::no_preference };
+  bool hedged_{ false };
 };
 
 /**
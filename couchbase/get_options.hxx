@@ -25,6 +25,8 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -44,6 +46,7 @@ struct get_options : public common_options<get_options> {
   struct built : public common_options<get_options>::built {
     const bool with_expiry;
     const std::vector<std::string> projections;
+    const bool hedged;
   };
 
   /**
@@ -59,7 +62,7 @@ struct get_options : public common_options<get_options> {
    */
   [[nodiscard]] auto build() const -> built
   {
-    return { build_common_options(), with_expiry_, projections_ };
+    return { build_common_options(), with_expiry_, projections_, hedged_ };
   }
 
   /**
@@ -97,9 +100,31 @@ struct get_options : public common_options<get_options> {
     return self();
   }
 
+  /**
+   * Ask the active node first, and also ask a replica when the active has not answered within the
+   * 95th percentile of its recent read latencies. The answer of the active is final, including an
+   * error such as document_not_found, but a replica that returns the document first wins, in which
+   * case the value may be older than the one on the active.
+   *
+   * Only applies to plain gets: with @ref with_expiry or @ref project the read always goes to the
+   * active.
+   *
+   * @param hedged true to hedge the read.
+   * @return this options builder for chaining purposes.
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  auto hedged(bool hedged) -> get_options&
+  {
+    hedged_ = hedged;
+    return self();
+  }
+
 private:
   bool with_expiry_{ false };
   std::vector<std::string> projections_{};
+  bool hedged_{ false };
 };
 
 /**
@@ -109,4 +134,13 @@ private:
  * @uncommitted
  */
 using get_handler = std::function<void(error, get_result)>;
+
+/**
+ * The signature for the handler of the @ref collection#get_multi() operation. The results are in
+ * the order of the document ids that were passed in, each with its own error.
+ *
+ * @since 1.4.0
+ * @volatile
+ */
+using get_multi_handler = std::function<void(std::vector<std::pair<error, get_result>>)>;
 } // namespace couchbase
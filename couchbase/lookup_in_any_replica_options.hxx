@@ -46,6 +46,7 @@ struct lookup_in_any_replica_options : common_options<lookup_in_any_replica_opti
    */
   struct built : public common_options<lookup_in_any_replica_options>::built {
     couchbase::read_preference read_preference;
+    bool hedged;
   };
 
   /**
@@ -65,6 +66,26 @@ struct lookup_in_any_replica_options : common_options<lookup_in_any_replica_opti
     return self();
   }
 
+  /**
+   * Ask the active node first, and ask a replica only when the active has not answered within
+   * the 95th percentile of its recent read latencies, or could not find the document. The response that arrives
+   * first wins and the other request is cancelled.
+   *
+   * By default all nodes allowed by the read preference are asked at once, which multiplies the
+   * read load by the number of replicas plus one.
+   *
+   * @param hedged
+   * @return this options builder for chaining purposes.
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  auto hedged(bool hedged) -> lookup_in_any_replica_options&
+  {
+    hedged_ = hedged;
+    return self();
+  }
+
   /**
    * Validates options and returns them as an immutable value.
    *
@@ -81,11 +102,13 @@ struct lookup_in_any_replica_options : common_options<lookup_in_any_replica_opti
     return {
       build_common_options(),
       read_preference_,
+      hedged_,
     };
   }
 
 private:
   couchbase::read_preference read_preference_{ read_preference::no_preference };
+  bool hedged_{ false };
 };
 
 /**
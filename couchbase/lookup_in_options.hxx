@@ -50,6 +50,7 @@ struct lookup_in_options : public common_durability_options<lookup_in_options> {
    */
   struct built : public common_durability_options<lookup_in_options>::built {
     const bool access_deleted;
+    const bool hedged;
   };
 
   /**
@@ -66,7 +67,7 @@ struct lookup_in_options : public common_durability_options<lookup_in_options> {
   [[nodiscard]] auto build() const -> built
   {
     auto base = build_common_durability_options();
-    return { base, access_deleted_ };
+    return { base, access_deleted_, hedged_ };
   }
 
   /**
@@ -81,8 +82,29 @@ struct lookup_in_options : public common_durability_options<lookup_in_options> {
     return self();
   }
 
+  /**
+   * Ask the active node first, and also ask a replica when the active has not answered within the
+   * 95th percentile of its recent read latencies. The answer of the active is final, including an
+   * error such as document_not_found, but a replica that returns the document first wins, in which
+   * case the result may be older than the document on the active.
+   *
+   * Replicas are only asked when the cluster supports subdocument reads from replicas.
+   *
+   * @param hedged true to hedge the lookup.
+   * @return this options builder for chaining purposes.
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  auto hedged(bool hedged) -> lookup_in_options&
+  {
+    hedged_ = hedged;
+    return self();
+  }
+
 private:
   bool access_deleted_{ false };
+  bool hedged_{ false };
 };
 
 /**
@@ -20,6 +20,7 @@
 #include <couchbase/ip_protocol.hxx>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -130,6 +131,46 @@ public:
     return *this;
   }
 
+  /**
+   * Sets the number of threads that run the I/O of the cluster.
+   *
+   * With more than one thread, every KV and HTTP endpoint is pinned to one of them, so the traffic
+   * of different nodes is handled in parallel while all connections to the same node stay on a
+   * single thread. Timers and configuration handling always run on the first thread.
+   *
+   * @param number_of_threads number of I/O threads, zero is treated as one.
+   * @return this object for chaining purposes.
+   *
+   * @volatile This option is considered unstable and may change in future releases.
+   *
+   * @since 1.4.0
+   */
+  auto io_threads(std::size_t number_of_threads) -> network_options&
+  {
+    io_threads_ = number_of_threads == 0 ? 1 : number_of_threads;
+    return *this;
+  }
+
+  /**
+   * Sets the number of KV connections opened to every node of a bucket.
+   *
+   * Operations are spread over the connections of a node by vbucket, so operations on the same
+   * document keep their order, while the traffic of one node is no longer limited to a single
+   * socket.
+   *
+   * @param number_of_connections number of connections per node, zero is treated as one.
+   * @return this object for chaining purposes.
+   *
+   * @volatile This option is considered unstable and may change in future releases.
+   *
+   * @since 1.4.0
+   */
+  auto kv_connections_per_node(std::size_t number_of_connections) -> network_options&
+  {
+    kv_connections_per_node_ = number_of_connections == 0 ? 1 : number_of_connections;
+    return *this;
+  }
+
   struct built {
     std::string network;
     std::string server_group;
@@ -140,6 +181,8 @@ public:
     std::chrono::milliseconds idle_http_connection_timeout;
     std::optional<std::size_t> max_http_connections;
     bool enable_lazy_connections;
+    std::size_t io_threads;
+    std::size_t kv_connections_per_node;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -154,6 +197,8 @@ public:
       idle_http_connection_timeout_,
       max_http_connections_,
       enable_lazy_connections_,
+      io_threads_,
+      kv_connections_per_node_,
     };
   }
 
@@ -168,5 +213,7 @@ private:
   std::chrono::milliseconds idle_http_connection_timeout_{ default_idle_http_connection_timeout };
   std::optional<std::size_t> max_http_connections_{};
   bool enable_lazy_connections_{ false };
+  std::size_t io_threads_{ 1 };
+  std::size_t kv_connections_per_node_{ 1 };
 };
 } // namespace couchbase
@@ -0,0 +1,156 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/codec/encoded_value.hxx>
+#include <couchbase/codec/serializer_traits.hxx>
+#include <couchbase/query_row.hxx>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace couchbase
+{
+
+namespace codec
+{
+class tao_json_serializer;
+} // namespace codec
+
+/**
+ * A batch of rows of a streaming query result, as returned by
+ * @ref query_stream_result#next_rows().
+ *
+ * The rows are stored back to back in a single buffer: row @c i is
+ * <tt>content_as_binary()[offsets()[i], offsets()[i + 1])</tt>. Consumers that can work with the
+ * raw JSON bytes read them in place; @ref row() and @ref content_as() copy a single row out.
+ *
+ * @since 1.4.0
+ * @volatile
+ */
+class query_row_batch
+{
+public:
+  /**
+   * @since 1.4.0
+   * @volatile
+   */
+  query_row_batch() = default;
+
+  /**
+   * Constructs a batch from the rows buffer and the offsets of the rows in it.
+   *
+   * @param content raw JSON bytes of all rows, back to back
+   * @param offsets start offset of every row, followed by the end offset of the last one
+   *
+   * @since 1.4.0
+   * @internal
+   */
+  query_row_batch(codec::binary content, std::vector<std::size_t> offsets)
+    : content_{ std::move(content) }
+    , offsets_{ std::move(offsets) }
+  {
+  }
+
+  /**
+   * @return number of rows in the batch
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+
+  /**
+   * @return true if the batch has no rows, which marks the end of the stream
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto empty() const -> bool
+  {
+    return size() == 0;
+  }
+
+  /**
+   * Copies a single row out of the batch.
+   *
+   * @param index position of the row, less than @ref size()
+   * @return the row
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto row(std::size_t index) const -> query_row
+  {
+    const auto first = content_.begin() + static_cast<std::ptrdiff_t>(offsets_[index]);
+    const auto last = content_.begin() + static_cast<std::ptrdiff_t>(offsets_[index + 1]);
+    return query_row{ codec::binary{ first, last } };
+  }
+
+  /**
+   * Decodes a single row into the requested document type using the given serializer.
+   *
+   * @tparam Serializer the serializer to use (defaults to @ref codec::tao_json_serializer)
+   * @tparam Document the document type to decode into (defaults to the serializer's document_type)
+   * @param index position of the row, less than @ref size()
+   * @return the decoded document
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  template<typename Serializer = codec::tao_json_serializer,
+           typename Document = typename Serializer::document_type,
+           std::enable_if_t<codec::is_serializer_v<Serializer>, bool> = true>
+  [[nodiscard]] auto content_as(std::size_t index) const -> Document
+  {
+    return row(index).template content_as<Serializer, Document>();
+  }
+
+  /**
+   * @return raw JSON bytes of all rows, back to back
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto content_as_binary() const -> const codec::binary&
+  {
+    return content_;
+  }
+
+  /**
+   * @return start offset of every row in @ref content_as_binary(), followed by the end offset of
+   * the last row (empty for an empty batch)
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto offsets() const -> const std::vector<std::size_t>&
+  {
+    return offsets_;
+  }
+
+private:
+  codec::binary content_{};
+  std::vector<std::size_t> offsets_{};
+};
+
+} // namespace couchbase
@@ -21,7 +21,9 @@
 #include <couchbase/error.hxx>
 #include <couchbase/query_meta_data.hxx>
 #include <couchbase/query_row.hxx>
+#include <couchbase/query_row_batch.hxx>
 
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <memory>
@@ -42,6 +44,14 @@ class internal_query_stream_result;
  */
 using query_row_handler = std::function<void(error, std::optional<query_row>)>;
 
+/**
+ * The signature for the handler of the @ref query_stream_result#next_rows() operation.
+ *
+ * @since 1.4.0
+ * @volatile
+ */
+using query_rows_handler = std::function<void(error, query_row_batch)>;
+
 /**
  * A streaming result handle for N1QL queries.
  *
@@ -124,6 +134,40 @@ public:
    */
   [[nodiscard]] auto next() const -> std::future<std::pair<error, std::optional<query_row>>>;
 
+  /**
+   * Fetches the rows that are ready, up to a limit, invoking the handler with them as one batch.
+   *
+   * Only the first row is waited for. The batch then takes the rows already received, until it
+   * holds @p max_rows rows or at least @p max_bytes bytes of row data. Pulling rows in batches pays
+   * the cost of a callback once per batch rather than once per row, which matters for results with
+   * many small rows.
+   *
+   * The handler receives ({}, batch) for a non-empty batch, ({}, {}) at clean end-of-stream, or
+   * (error, {}) if the stream ended with an error. Batches and single rows may be pulled from the
+   * same stream, and the single-outstanding-call rule covers both.
+   *
+   * @param max_rows the largest number of rows to deliver at once
+   * @param max_bytes the number of bytes of row data after which the batch is closed
+   * @param handler callable that implements @ref query_rows_handler
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  void next_rows(std::size_t max_rows, std::size_t max_bytes, query_rows_handler&& handler) const;
+
+  /**
+   * Fetches the rows that are ready, up to a limit, returning a future.
+   *
+   * @param max_rows the largest number of rows to deliver at once
+   * @param max_bytes the number of bytes of row data after which the batch is closed
+   * @return future object that carries the result of the operation
+   *
+   * @since 1.4.0
+   * @volatile
+   */
+  [[nodiscard]] auto next_rows(std::size_t max_rows, std::size_t max_bytes) const
+    -> std::future<std::pair<error, query_row_batch>>;
+
   /**
    * Returns the query signature captured from the response metadata, if present.
    *
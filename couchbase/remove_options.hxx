@@ -27,6 +27,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace couchbase
@@ -101,4 +102,13 @@ private:
  * @uncommitted
  */
 using remove_handler = std::function<void(error, mutation_result)>;
+
+/**
+ * The signature for the handler of the @ref collection#remove_multi() operation. The results are in
+ * the order of the document ids that were passed in, each with its own error.
+ *
+ * @since 1.4.0
+ * @volatile
+ */
+using remove_multi_handler = std::function<void(std::vector<std::pair<error, mutation_result>>)>;
 } // namespace couchbase
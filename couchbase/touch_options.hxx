@@ -25,6 +25,8 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -68,4 +70,13 @@ struct touch_options : public common_options<touch_options> {
  * @uncommitted
  */
 using touch_handler = std::function<void(error, result)>;
+
+/**
+ * The signature for the handler of the @ref collection#touch_multi() operation. The results are in
+ * the order of the document ids that were passed in, each with its own error.
+ *
+ * @since 1.4.0
+ * @volatile
+ */
+using touch_multi_handler = std::function<void(std::vector<std::pair<error, result>>)>;
 } // namespace couchbase
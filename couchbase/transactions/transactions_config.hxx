@@ -22,6 +22,7 @@
 #include <couchbase/transactions/transactions_query_config.hxx>
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <optional>
 
@@ -189,6 +190,32 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Get the number of documents that are committed or rolled back at once on each node
+   *
+   * @return the unstaging window per node.
+   */
+  [[nodiscard]] auto unstaging_window() const -> std::size_t
+  {
+    return unstaging_window_;
+  }
+
+  /**
+   * @brief Set the number of documents that are committed or rolled back at once on each node
+   *
+   * When a transaction commits or rolls back, its staged documents are grouped by the node that
+   * owns them. Each node has at most this many of them in flight; the next document is sent as
+   * soon as one of them completes.
+   *
+   * @param window desired unstaging window per node, must be greater than zero.
+   * @return reference to this, so calls can be chained.
+   */
+  auto unstaging_window(std::size_t window) -> transactions_config&
+  {
+    unstaging_window_ = window;
+    return *this;
+  }
+
   /** @private */
   auto test_factories(std::shared_ptr<core::transactions::attempt_context_testing_hooks> hooks,
                       std::shared_ptr<core::transactions::cleanup_testing_hooks> cleanup_hooks)
@@ -221,6 +248,7 @@ public:
     std::optional<couchbase::transactions::transaction_keyspace> metadata_collection;
     transactions_query_config::built query_config;
     transactions_cleanup_config::built cleanup_config;
+    std::size_t unstaging_window;
   };
 
   /** @internal */
@@ -234,5 +262,6 @@ private:
   std::optional<couchbase::transactions::transaction_keyspace> metadata_collection_;
   transactions_query_config query_config_{};
   transactions_cleanup_config cleanup_config_{};
+  std::size_t unstaging_window_{ 128 };
 };
 } // namespace couchbase::transactions
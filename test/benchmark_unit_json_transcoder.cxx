@@ -0,0 +1,124 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/utils/json.hxx"
+
+#include <couchbase/codec/codec_flags.hxx>
+#include <couchbase/codec/default_json_transcoder.hxx>
+#include <couchbase/codec/tao_json_serializer.hxx>
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <tao/json.hpp>
+#include <tao/json/binding.hpp>
+#include <tao/json/contrib/traits.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct line_item {
+  std::string sku{};
+  std::string description{};
+  std::uint32_t quantity{};
+  double unit_price{};
+  bool gift_wrap{};
+};
+
+struct order {
+  std::string id{};
+  std::string customer{};
+  std::string status{};
+  std::uint64_t placed_at{};
+  std::vector<line_item> items{};
+};
+} // namespace
+
+template<>
+struct tao::json::traits<line_item>
+  : tao::json::binding::object<TAO_JSON_BIND_REQUIRED("sku", &line_item::sku),
+                               TAO_JSON_BIND_REQUIRED("description", &line_item::description),
+                               TAO_JSON_BIND_REQUIRED("quantity", &line_item::quantity),
+                               TAO_JSON_BIND_REQUIRED("unit_price", &line_item::unit_price),
+                               TAO_JSON_BIND_REQUIRED("gift_wrap", &line_item::gift_wrap)> {
+};
+
+template<>
+struct tao::json::traits<order>
+  : tao::json::binding::object<TAO_JSON_BIND_REQUIRED("id", &order::id),
+                               TAO_JSON_BIND_REQUIRED("customer", &order::customer),
+                               TAO_JSON_BIND_REQUIRED("status", &order::status),
+                               TAO_JSON_BIND_REQUIRED("placed_at", &order::placed_at),
+                               TAO_JSON_BIND_REQUIRED("items", &order::items)> {
+};
+
+namespace
+{
+auto
+make_order(std::size_t number_of_items) -> order
+{
+  order result{ "order::42", "customer::7", "shipped", 1'700'000'000'000, {} };
+  result.items.reserve(number_of_items);
+  for (std::size_t i = 0; i < number_of_items; ++i) {
+    result.items.push_back({
+      fmt::format("sku-{:06}", i),
+      fmt::format("item {} of the order, with a \"quoted\" description", i),
+      static_cast<std::uint32_t>(i % 5 + 1),
+      9.99 + static_cast<double>(i % 100),
+      i % 7 == 0,
+    });
+  }
+  return result;
+}
+} // namespace
+
+// Compares the default transcoder, which converts bound types straight to and from bytes, with
+// the tao::json::value round trip it used before.
+TEST_CASE("benchmark: default_json_transcoder with small and large documents", "[benchmark]")
+{
+  constexpr std::array<std::size_t, 3> sizes{ 1, 100, 10'000 };
+  for (const auto size : sizes) {
+    const auto document = make_order(size);
+    const auto encoded = couchbase::codec::default_json_transcoder::encode(document);
+
+    BENCHMARK(fmt::format("encode, {} items ({} bytes)", size, encoded.data.size()))
+    {
+      return couchbase::codec::default_json_transcoder::encode(document);
+    };
+
+    BENCHMARK(fmt::format("encode through tao::json::value, {} items", size))
+    {
+      return couchbase::core::utils::json::generate_binary(tao::json::value(document));
+    };
+
+    BENCHMARK(fmt::format("decode, {} items ({} bytes)", size, encoded.data.size()))
+    {
+      return couchbase::codec::default_json_transcoder::decode<order>(encoded);
+    };
+
+    BENCHMARK(fmt::format("decode through tao::json::value, {} items", size))
+    {
+      return couchbase::core::utils::json::parse_binary(encoded.data).as<order>();
+    };
+  }
+}
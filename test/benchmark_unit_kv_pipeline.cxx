@@ -0,0 +1,360 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "utils/integration_shortcuts.hxx"
+#include "utils/mock_kv_server.hxx"
+
+#include "core/agent.hxx"
+#include "core/agent_group.hxx"
+#include "core/cluster.hxx"
+#include "core/crud_options.hxx"
+#include "core/operations/document_get.hxx"
+#include "core/operations/document_upsert.hxx"
+#include "core/origin.hxx"
+#include "core/timeout_defaults.hxx"
+#include "core/utils/binary.hxx"
+#include "core/utils/connection_string.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <asio/io_context.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Sanitizer builds provide their own operator new/delete, so the allocation counters are only
+// compiled in for regular builds; the throughput and latency figures are reported either way.
+#ifndef COUCHBASE_CXX_CLIENT_BUILD_SANITIZED
+namespace
+{
+// Only allocations made on the client threads are counted: the mock server shares the process,
+// and its allocations are not the cost of the client.
+thread_local bool t_count_allocations{ false };
+std::atomic<std::uint64_t> g_allocations{ 0 };
+std::atomic<std::uint64_t> g_allocated_bytes{ 0 };
+} // namespace
+
+void*
+operator new(std::size_t n)
+{
+  if (t_count_allocations) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(n, std::memory_order_relaxed);
+  }
+  void* p = std::malloc(n != 0 ? n : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t /* n */) noexcept
+{
+  std::free(p);
+}
+#endif
+
+namespace
+{
+void
+count_allocations_on_this_thread()
+{
+#ifndef COUCHBASE_CXX_CLIENT_BUILD_SANITIZED
+  t_count_allocations = true;
+#endif
+}
+
+struct allocation_counters {
+  std::uint64_t allocations{ 0 };
+  std::uint64_t bytes{ 0 };
+};
+
+auto
+allocation_snapshot() -> allocation_counters
+{
+#ifndef COUCHBASE_CXX_CLIENT_BUILD_SANITIZED
+  return { g_allocations.load(), g_allocated_bytes.load() };
+#else
+  return {};
+#endif
+}
+
+constexpr std::size_t number_of_keys = 1024;
+constexpr std::size_t operations_per_run = 20'000;
+constexpr std::array<std::size_t, 3> concurrency_levels{ 1, 16, 128 };
+
+enum class kv_operation { get, upsert };
+
+// The classic path goes through core::cluster and the bucket, the agent path through
+// core::agent and its crud_component.
+enum class kv_path { bucket, agent };
+
+// Keeps `concurrency` operations in flight on the cluster, or on the agent when one is given,
+// until `operations_per_run` have completed, and records the latency of each of them.
+class closed_loop : public std::enable_shared_from_this<closed_loop>
+{
+public:
+  closed_loop(const couchbase::core::cluster& cluster,
+              kv_operation operation,
+              const std::vector<couchbase::core::document_id>& ids,
+              const std::vector<std::byte>& value,
+              couchbase::core::agent* agent = nullptr)
+    : cluster_{ cluster }
+    , agent_{ agent }
+    , operation_{ operation }
+    , ids_{ ids }
+    , value_{ value }
+  {
+    latencies_.resize(operations_per_run);
+  }
+
+  void run(std::size_t concurrency)
+  {
+    for (std::size_t i = 0; i < concurrency; ++i) {
+      issue();
+    }
+    done_.get_future().wait();
+  }
+
+  [[nodiscard]] auto latencies() -> std::vector<std::chrono::nanoseconds>&
+  {
+    return latencies_;
+  }
+
+  [[nodiscard]] auto errors() const -> std::size_t
+  {
+    return errors_;
+  }
+
+private:
+  void issue()
+  {
+    const auto index = issued_.fetch_add(1);
+    if (index >= operations_per_run) {
+      return;
+    }
+    const auto& id = ids_[index % ids_.size()];
+    const auto start = std::chrono::steady_clock::now();
+    if (agent_ != nullptr) {
+      return issue_on_agent(id, index, start);
+    }
+    if (operation_ == kv_operation::get) {
+      cluster_.execute(couchbase::core::operations::get_request{ id },
+                       [self = shared_from_this(), index, start](auto&& resp) {
+                         self->complete(index, start, resp.ctx.ec());
+                       });
+    } else {
+      cluster_.execute(couchbase::core::operations::upsert_request{ id, value_ },
+                       [self = shared_from_this(), index, start](auto&& resp) {
+                         self->complete(index, start, resp.ctx.ec());
+                       });
+    }
+  }
+
+  void issue_on_agent(const couchbase::core::document_id& id,
+                      std::size_t index,
+                      std::chrono::steady_clock::time_point start)
+  {
+    auto handler = [self = shared_from_this(), index, start](auto /* result */,
+                                                             std::error_code ec) {
+      self->complete(index, start, ec);
+    };
+    if (operation_ == kv_operation::get) {
+      couchbase::core::get_options options{};
+      options.key = couchbase::core::utils::to_binary(id.key());
+      options.timeout = couchbase::core::timeout_defaults::key_value_timeout;
+      if (auto op = agent_->get(options, std::move(handler)); !op) {
+        complete(index, start, op.error());
+      }
+    } else {
+      couchbase::core::upsert_options options{};
+      options.key = couchbase::core::utils::to_binary(id.key());
+      options.value = value_;
+      options.timeout = couchbase::core::timeout_defaults::key_value_timeout;
+      if (auto op = agent_->upsert(options, std::move(handler)); !op) {
+        complete(index, start, op.error());
+      }
+    }
+  }
+
+  void complete(std::size_t index,
+                std::chrono::steady_clock::time_point start,
+                std::error_code ec)
+  {
+    latencies_[index] = std::chrono::steady_clock::now() - start;
+    if (ec) {
+      ++errors_;
+    }
+    if (completed_.fetch_add(1) + 1 == operations_per_run) {
+      return done_.set_value();
+    }
+    issue();
+  }
+
+  const couchbase::core::cluster& cluster_;
+  couchbase::core::agent* agent_;
+  kv_operation operation_;
+  const std::vector<couchbase::core::document_id>& ids_;
+  const std::vector<std::byte>& value_;
+  std::vector<std::chrono::nanoseconds> latencies_{};
+  std::atomic<std::size_t> issued_{ 0 };
+  std::atomic<std::size_t> completed_{ 0 };
+  std::atomic<std::size_t> errors_{ 0 };
+  std::promise<void> done_{};
+};
+
+auto
+percentile(const std::vector<std::chrono::nanoseconds>& sorted, double p) -> double
+{
+  const auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+  return std::chrono::duration<double, std::micro>(sorted[index]).count();
+}
+
+void
+run_and_report(const couchbase::core::cluster& cluster,
+               couchbase::core::agent* agent,
+               const test::utils::mock_kv_server& server,
+               kv_operation operation,
+               std::size_t concurrency,
+               const std::vector<couchbase::core::document_id>& ids,
+               const std::vector<std::byte>& value)
+{
+  auto loop = std::make_shared<closed_loop>(cluster, operation, ids, value, agent);
+
+  const auto wire_before = server.stats();
+  const auto allocations_before = allocation_snapshot();
+  const auto start = std::chrono::steady_clock::now();
+  loop->run(concurrency);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const auto allocations_after = allocation_snapshot();
+  const auto wire_after = server.stats();
+
+  REQUIRE(loop->errors() == 0);
+
+  auto& latencies = loop->latencies();
+  std::sort(latencies.begin(), latencies.end());
+  const auto ops = static_cast<double>(operations_per_run);
+  fmt::print(
+    "{:<7} {:<7} {:>5} {:>12.0f} {:>9.1f} {:>9.1f} {:>9.1f} {:>10.1f} {:>12.1f} {:>10.1f}\n",
+    agent == nullptr ? "bucket" : "agent",
+    operation == kv_operation::get ? "get" : "upsert",
+    concurrency,
+    ops / std::chrono::duration<double>(elapsed).count(),
+    percentile(latencies, 0.50),
+    percentile(latencies, 0.99),
+    percentile(latencies, 0.999),
+    static_cast<double>(allocations_after.allocations - allocations_before.allocations) / ops,
+    static_cast<double>(allocations_after.bytes - allocations_before.bytes) / ops,
+    static_cast<double>((wire_after.bytes_received - wire_before.bytes_received) +
+                        (wire_after.bytes_sent - wire_before.bytes_sent)) /
+      ops);
+}
+} // namespace
+
+TEST_CASE("benchmark: pipelined get and upsert against the mock KV server", "[benchmark]")
+{
+  test::utils::mock_kv_server_options options{};
+  options.value_size = 1024;
+  test::utils::mock_kv_server server{ options };
+
+  asio::io_context io{};
+  couchbase::core::cluster cluster(io);
+  auto io_thread = std::thread([&io]() {
+    count_allocations_on_this_thread();
+    io.run();
+  });
+  count_allocations_on_this_thread();
+
+  couchbase::core::cluster_credentials auth{};
+  auth.username = options.username;
+  auth.password = options.password;
+  auth.allowed_sasl_mechanisms = { { "PLAIN" } };
+  auto connstr = couchbase::core::utils::parse_connection_string(server.connection_string());
+  test::utils::open_cluster(cluster, couchbase::core::origin(auth, connstr));
+  test::utils::open_bucket(cluster, options.bucket_name);
+
+  std::vector<couchbase::core::document_id> ids{};
+  ids.reserve(number_of_keys);
+  for (std::size_t i = 0; i < number_of_keys; ++i) {
+    ids.emplace_back(options.bucket_name, "_default", "_default", fmt::format("key_{}", i));
+  }
+  const std::vector<std::byte> value(options.value_size, std::byte{ 'x' });
+
+  couchbase::core::agent_group group(io, { { cluster } });
+  REQUIRE_SUCCESS(group.open_bucket(options.bucket_name));
+  auto agent = group.get_agent(options.bucket_name);
+  REQUIRE(agent.has_value());
+
+  // warm up the connection, the buffer pools and the allocator
+  std::make_shared<closed_loop>(cluster, kv_operation::upsert, ids, value)->run(16);
+  std::make_shared<closed_loop>(cluster, kv_operation::upsert, ids, value, &agent.value())
+    ->run(16);
+
+  // Neither byte column counts copies: a copy into a buffer that is reused, or a buffer that is
+  // allocated but only partly written, does not show up as such.
+  fmt::print("heap B/op: bytes allocated on the client threads per operation\n"
+             "wire B/op: bytes sent and received per operation\n");
+  fmt::print("{:<7} {:<7} {:>5} {:>12} {:>9} {:>9} {:>9} {:>10} {:>12} {:>10}\n",
+             "path",
+             "op",
+             "conc",
+             "ops/s",
+             "p50 us",
+             "p99 us",
+             "p99.9 us",
+             "allocs/op",
+             "heap B/op",
+             "wire B/op");
+  // both paths side by side, on the same connections
+  for (const auto operation : { kv_operation::get, kv_operation::upsert }) {
+    for (const auto concurrency : concurrency_levels) {
+      for (const auto path : { kv_path::bucket, kv_path::agent }) {
+        run_and_report(cluster,
+                       path == kv_path::agent ? &agent.value() : nullptr,
+                       server,
+                       operation,
+                       concurrency,
+                       ids,
+                       value);
+      }
+    }
+  }
+
+  group.close();
+  test::utils::close_cluster(cluster);
+  io_thread.join();
+}
@@ -0,0 +1,135 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/mcbp_message.hxx"
+#include "core/io/mcbp_parser.hxx"
+#include "core/protocol/client_opcode.hxx"
+#include "core/protocol/magic.hxx"
+#include "core/utils/byteswap.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+using couchbase::core::io::mcbp_frame_view;
+using couchbase::core::io::mcbp_message;
+using couchbase::core::io::mcbp_parser;
+
+// Same size as the read buffer of mcbp_session.
+constexpr std::size_t read_size = 16384;
+
+// Fills one socket read with successful GET responses: 4 bytes of flags and a small JSON value.
+auto
+pipelined_get_responses(std::size_t value_size) -> std::vector<std::byte>
+{
+  std::vector<std::byte> wire;
+  wire.reserve(read_size);
+  std::uint32_t opaque = 0;
+  const std::size_t frame_size = couchbase::core::protocol::header_size + 4 + value_size;
+  while (wire.size() + frame_size <= read_size) {
+    couchbase::core::io::binary_header header{};
+    header.magic = static_cast<std::uint8_t>(couchbase::core::protocol::magic::client_response);
+    header.opcode = static_cast<std::uint8_t>(couchbase::core::protocol::client_opcode::get);
+    header.extlen = 4;
+    header.datatype = 0x01; // JSON
+    header.bodylen = couchbase::core::utils::byte_swap(static_cast<std::uint32_t>(4 + value_size));
+    header.opaque = ++opaque;
+    header.cas = 0x1122334455667788ULL;
+    const auto* raw = reinterpret_cast<const std::byte*>(&header);
+    wire.insert(wire.end(), raw, raw + couchbase::core::protocol::header_size);
+    wire.insert(wire.end(), 4, std::byte{ 0 });
+    wire.insert(wire.end(), value_size, std::byte{ '7' });
+  }
+  return wire;
+}
+
+// The parser as it was before the read cursor: every frame is copied out and then erased from
+// the front of the buffer, moving the rest of the read each time.
+auto
+parse_with_erase(std::vector<std::byte>& buf, mcbp_message& msg) -> bool
+{
+  if (buf.size() < couchbase::core::protocol::header_size) {
+    return false;
+  }
+  std::memcpy(&msg.header, buf.data(), couchbase::core::protocol::header_size);
+  const auto body_size = couchbase::core::utils::byte_swap(msg.header.bodylen);
+  const auto frame_end =
+    buf.begin() + static_cast<std::ptrdiff_t>(couchbase::core::protocol::header_size + body_size);
+  msg.body.assign(buf.begin() + couchbase::core::protocol::header_size, frame_end);
+  buf.erase(buf.begin(), frame_end);
+  return true;
+}
+} // namespace
+
+TEST_CASE("benchmark: parse pipelined GET responses", "[benchmark]")
+{
+  constexpr std::array<std::size_t, 3> value_sizes{ 16, 128, 1024 };
+  for (const auto value_size : value_sizes) {
+    const auto wire = pipelined_get_responses(value_size);
+    std::size_t frames = 0;
+    {
+      mcbp_parser parser;
+      parser.feed(wire.begin(), wire.end());
+      mcbp_frame_view frame{};
+      while (parser.next(frame) == mcbp_parser::result::ok) {
+        ++frames;
+      }
+    }
+    REQUIRE(frames > 0);
+
+    BENCHMARK(fmt::format("erase per frame, {} frames of {} bytes", frames, value_size))
+    {
+      std::vector<std::byte> buf(wire.begin(), wire.end());
+      mcbp_message msg;
+      std::size_t parsed = 0;
+      while (parse_with_erase(buf, msg)) {
+        ++parsed;
+      }
+      return parsed;
+    };
+
+    BENCHMARK(fmt::format("cursor, copy to message, {} frames of {} bytes", frames, value_size))
+    {
+      mcbp_parser parser;
+      parser.feed(wire.begin(), wire.end());
+      mcbp_message msg;
+      std::size_t parsed = 0;
+      while (parser.next(msg) == mcbp_parser::result::ok) {
+        ++parsed;
+      }
+      return parsed;
+    };
+
+    BENCHMARK(fmt::format("cursor, frame views, {} frames of {} bytes", frames, value_size))
+    {
+      mcbp_parser parser;
+      parser.feed(wire.begin(), wire.end());
+      mcbp_frame_view frame{};
+      std::size_t parsed = 0;
+      while (parser.next(frame) == mcbp_parser::result::ok) {
+        ++parsed;
+      }
+      return parsed;
+    };
+  }
+}
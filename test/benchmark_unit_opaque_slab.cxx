@@ -0,0 +1,139 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/opaque_ring_table.hxx"
+#include "core/io/opaque_slab.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+// Stand-ins for the queue_request and response_handler of an agent-path operation.
+struct request {
+  std::uint32_t opaque{};
+};
+struct handler {
+};
+using pending_operation = std::pair<std::shared_ptr<request>, std::shared_ptr<handler>>;
+
+// The command handler of a classic-path operation holds its command alive.
+using command_handler = couchbase::core::utils::movable_function<void()>;
+
+constexpr std::size_t operations = 10'000;
+
+// Registers an operation per opaque and completes the oldest one once `in_flight` are
+// outstanding, like responses arriving in order on a pipelined connection.
+template<typename Insert, typename Take>
+auto
+pipeline(std::size_t in_flight, Insert&& insert, Take&& take) -> std::size_t
+{
+  std::size_t completed{ 0 };
+  std::uint32_t opaque{ 0 };
+  for (std::size_t i = 0; i < operations; ++i) {
+    insert(++opaque);
+    if (i >= in_flight) {
+      completed += take(opaque - static_cast<std::uint32_t>(in_flight));
+    }
+  }
+  for (std::size_t i = 0; i < in_flight && i < operations; ++i) {
+    completed += take(opaque - static_cast<std::uint32_t>(i));
+  }
+  return completed;
+}
+} // namespace
+
+TEST_CASE("benchmark: in-flight operation registry of a KV session", "[benchmark]")
+{
+  auto req = std::make_shared<request>();
+  auto hdl = std::make_shared<handler>();
+
+  constexpr std::array<std::size_t, 3> in_flight{ 1, 100, 2'000 };
+  for (const auto window : in_flight) {
+    BENCHMARK(fmt::format("agent path, std::map + std::recursive_mutex, {} in flight", window))
+    {
+      std::recursive_mutex mutex;
+      std::map<std::uint32_t, pending_operation> operations{};
+      return pipeline(
+        window,
+        [&](std::uint32_t opaque) {
+          const std::scoped_lock lock(mutex);
+          operations.try_emplace(opaque, req, hdl);
+        },
+        [&](std::uint32_t opaque) -> std::size_t {
+          const std::scoped_lock lock(mutex);
+          if (auto it = operations.find(opaque); it != operations.end()) {
+            operations.erase(it);
+            return 1;
+          }
+          return 0;
+        });
+    };
+
+    BENCHMARK(fmt::format("agent path, opaque_slab + std::mutex, {} in flight", window))
+    {
+      std::mutex mutex;
+      couchbase::core::io::opaque_slab<pending_operation> operations{};
+      return pipeline(
+        window,
+        [&](std::uint32_t opaque) {
+          const std::scoped_lock lock(mutex);
+          operations.insert(opaque, { req, hdl });
+        },
+        [&](std::uint32_t opaque) -> std::size_t {
+          const std::scoped_lock lock(mutex);
+          return operations.take(opaque).first ? 1 : 0;
+        });
+    };
+
+    BENCHMARK(fmt::format("classic path, opaque_ring_table + std::mutex, {} in flight", window))
+    {
+      std::mutex mutex;
+      couchbase::core::io::opaque_ring_table<command_handler> handlers{};
+      return pipeline(
+        window,
+        [&](std::uint32_t opaque) {
+          const std::scoped_lock lock(mutex);
+          handlers.insert(opaque, [req]() {
+            ++req->opaque;
+          });
+        },
+        [&](std::uint32_t opaque) -> std::size_t {
+          command_handler fun{};
+          {
+            const std::scoped_lock lock(mutex);
+            fun = handlers.take(opaque);
+          }
+          if (fun) {
+            fun();
+            return 1;
+          }
+          return 0;
+        });
+    };
+  }
+}
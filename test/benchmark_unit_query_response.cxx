@@ -0,0 +1,179 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/utils/json.hxx"
+#include "core/utils/json_streaming_lexer.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <tao/json/value.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// Sanitizer builds provide their own operator new/delete, so the heap high-water mark is only
+// tracked for regular builds; the timings are reported either way.
+#ifndef COUCHBASE_CXX_CLIENT_BUILD_SANITIZED
+namespace
+{
+// Every block carries its size in front of it, so that the bytes in use can be followed through
+// operator delete as well, and their peak recorded.
+constexpr std::size_t block_header_size{ alignof(std::max_align_t) };
+std::atomic<std::size_t> g_live_bytes{ 0 };
+std::atomic<std::size_t> g_peak_bytes{ 0 };
+} // namespace
+
+void*
+operator new(std::size_t n)
+{
+  auto* block = static_cast<unsigned char*>(std::malloc(block_header_size + n));
+  if (block == nullptr) {
+    throw std::bad_alloc{};
+  }
+  *reinterpret_cast<std::size_t*>(block) = n;
+  const auto live = g_live_bytes.fetch_add(n, std::memory_order_relaxed) + n;
+  auto peak = g_peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !g_peak_bytes.compare_exchange_weak(peak, live)) {
+  }
+  return block + block_header_size;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+  auto* block = static_cast<unsigned char*>(p) - block_header_size;
+  g_live_bytes.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+  std::free(block);
+}
+
+void
+operator delete(void* p, std::size_t /* n */) noexcept
+{
+  operator delete(p);
+}
+#endif
+
+namespace
+{
+// A buffered query response with `number_of_rows` documents of roughly 400 bytes each.
+auto
+query_response_body(std::size_t number_of_rows) -> std::string
+{
+  std::string body = R"({"requestID":"6cf4c6ac-5b4e-4cbd-bd4c-4d4e1d4b1c2a",)"
+                     R"("signature":{"*":"*"},"results":[)";
+  for (std::size_t i = 0; i < number_of_rows; ++i) {
+    if (i > 0) {
+      body += ',';
+    }
+    body += fmt::format(R"({{"airline":{{"id":{},"type":"airline","name":"Airline {}",)"
+                        R"("iata":"A{}","icao":"AIR{}","callsign":"CALL{}","country":"France",)"
+                        R"("routes":[{{"from":"CDG","to":"LHR","stops":0,"distance":344.5}},)"
+                        R"({{"from":"CDG","to":"JFK","stops":0,"distance":5837.2}}],)"
+                        R"("active":true,"rating":4.5,"description":"{}"}}}})",
+                        i,
+                        i,
+                        i % 100,
+                        i % 1000,
+                        i,
+                        std::string(120, 'd'));
+  }
+  body += R"(],"status":"success","metrics":{"elapsedTime":"1.5s","executionTime":"1.5s",)";
+  body += fmt::format(R"("resultCount":{},"resultSize":{}}}}})", number_of_rows, body.size());
+  return body;
+}
+
+// The rows as make_response used to extract them: the whole body is parsed into one DOM, and
+// every row is generated back out of it.
+auto
+rows_from_dom(const std::string& body) -> std::vector<std::string>
+{
+  auto payload = couchbase::core::utils::json::parse(body);
+  std::vector<std::string> rows{};
+  if (const auto* r = payload.find("results"); r != nullptr) {
+    rows.reserve(r->get_array().size());
+    for (const auto& row : r->get_array()) {
+      rows.emplace_back(couchbase::core::utils::json::generate(row));
+    }
+  }
+  return rows;
+}
+
+// The rows as make_response extracts them now: sliced out of the body by the streaming lexer, with
+// only the metadata parsed into a DOM.
+auto
+rows_from_lexer(const std::string& body) -> std::vector<std::string>
+{
+  auto result = couchbase::core::utils::json::split_rows(body, "/results/^", 4);
+  [[maybe_unused]] const auto meta = couchbase::core::utils::json::parse(result.meta);
+  return std::move(result.rows);
+}
+
+// The high-water mark of the heap while extracting the rows, over what was in use before.
+template<typename Extract>
+auto
+peak_bytes(const std::string& body, Extract extract) -> std::size_t
+{
+#ifndef COUCHBASE_CXX_CLIENT_BUILD_SANITIZED
+  const auto baseline = g_live_bytes.load();
+  g_peak_bytes.store(baseline);
+  {
+    auto rows = extract(body);
+  }
+  return g_peak_bytes.load() - baseline;
+#else
+  (void)body;
+  (void)extract;
+  return 0;
+#endif
+}
+} // namespace
+
+TEST_CASE("benchmark: extract rows from a buffered query response", "[benchmark]")
+{
+  constexpr std::size_t number_of_rows = 50'000;
+  const auto body = query_response_body(number_of_rows);
+  REQUIRE(rows_from_dom(body).size() == number_of_rows);
+  REQUIRE(rows_from_lexer(body).size() == number_of_rows);
+
+  constexpr double mib = 1024.0 * 1024.0;
+  fmt::print(
+    "body of {} rows: {:.1f} MiB\n", number_of_rows, static_cast<double>(body.size()) / mib);
+  fmt::print("peak heap on top of the body, DOM:   {:.1f} MiB\n",
+             static_cast<double>(peak_bytes(body, rows_from_dom)) / mib);
+  fmt::print("peak heap on top of the body, lexer: {:.1f} MiB\n",
+             static_cast<double>(peak_bytes(body, rows_from_lexer)) / mib);
+
+  BENCHMARK(fmt::format("DOM, {} rows", number_of_rows))
+  {
+    return rows_from_dom(body).size();
+  };
+
+  BENCHMARK(fmt::format("streaming lexer, {} rows", number_of_rows))
+  {
+    return rows_from_lexer(body).size();
+  };
+}
@@ -0,0 +1,107 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/transactions/internal/utils.hxx"
+#include "core/transactions/staged_mutation.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+using couchbase::core::document_id;
+using couchbase::core::transactions::staged_mutation;
+using couchbase::core::transactions::staged_mutation_queue;
+using couchbase::core::transactions::staged_mutation_type;
+
+namespace
+{
+auto
+make_ids(std::size_t count) -> std::vector<document_id>
+{
+  std::vector<document_id> ids{};
+  ids.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    ids.emplace_back("travel-sample", "inventory", "airline", fmt::format("airline_{}", i));
+  }
+  return ids;
+}
+
+auto
+make_mutation(const document_id& id) -> staged_mutation
+{
+  return staged_mutation{
+    staged_mutation_type::REPLACE, id, couchbase::cas{}, std::nullopt, 0U, 0U, std::nullopt, "op",
+  };
+}
+} // namespace
+
+// Stages every document of a transaction, looking each one up first like a transactional replace
+// does to read its own writes.
+TEST_CASE("benchmark: staging mutations of a large transaction", "[benchmark]")
+{
+  constexpr std::array<std::size_t, 3> sizes{ 1'000, 10'000, 100'000 };
+  for (const auto size : sizes) {
+    const auto ids = make_ids(size);
+
+    BENCHMARK(fmt::format("staged_mutation_queue, {} mutations", size))
+    {
+      staged_mutation_queue queue{};
+      std::size_t found{ 0 };
+      for (const auto& id : ids) {
+        found += queue.find_any(id) != nullptr ? 1 : 0;
+        queue.add(make_mutation(id));
+      }
+      for (const auto& id : ids) {
+        found += queue.find_replace(id) != nullptr ? 1 : 0;
+      }
+      return found;
+    };
+
+    if (size > 10'000) {
+      // the linear scan needs minutes per sample here
+      continue;
+    }
+
+    BENCHMARK(fmt::format("linear scan over std::vector, {} mutations", size))
+    {
+      std::vector<staged_mutation> queue{};
+      auto find = [&queue](const document_id& id) -> staged_mutation* {
+        for (auto& item : queue) {
+          if (couchbase::core::transactions::document_ids_equal(item.id(), id)) {
+            return &item;
+          }
+        }
+        return nullptr;
+      };
+      std::size_t found{ 0 };
+      for (const auto& id : ids) {
+        found += find(id) != nullptr ? 1 : 0;
+        queue.emplace_back(make_mutation(id));
+      }
+      for (const auto& id : ids) {
+        found += find(id) != nullptr ? 1 : 0;
+      }
+      return found;
+    };
+  }
+}
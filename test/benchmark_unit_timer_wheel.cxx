@@ -0,0 +1,92 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/timer_wheel.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+// Stands in for a command: the handler holds a reference to it, like the deadline of
+// mcbp_command does.
+struct operation {
+  std::size_t completed{ 0 };
+};
+
+// The life of a KV deadline: armed when the operation starts, cancelled when the response
+// arrives, long before it would fire.
+template<typename Timer>
+auto
+arm_and_cancel(asio::io_context& ctx,
+               std::vector<std::unique_ptr<Timer>>& timers,
+               const std::shared_ptr<operation>& op) -> std::size_t
+{
+  for (auto& timer : timers) {
+    timer->expires_after(std::chrono::milliseconds{ 2500 });
+    timer->async_wait([op](std::error_code ec) {
+      if (ec) {
+        ++op->completed;
+      }
+    });
+  }
+  for (auto& timer : timers) {
+    timer->cancel();
+  }
+  // asio::steady_timer completes cancelled waits with operation_aborted through the io_context
+  ctx.restart();
+  ctx.poll();
+  return op->completed;
+}
+} // namespace
+
+TEST_CASE("benchmark: operation deadline armed and cancelled", "[benchmark]")
+{
+  constexpr std::array<std::size_t, 3> in_flight{ 1, 100, 10'000 };
+  for (const auto operations : in_flight) {
+    asio::io_context ctx;
+    auto op = std::make_shared<operation>();
+
+    std::vector<std::unique_ptr<asio::steady_timer>> steady_timers{};
+    std::vector<std::unique_ptr<couchbase::core::io::wheel_timer>> wheel_timers{};
+    for (std::size_t i = 0; i < operations; ++i) {
+      steady_timers.emplace_back(std::make_unique<asio::steady_timer>(ctx));
+      wheel_timers.emplace_back(std::make_unique<couchbase::core::io::wheel_timer>(ctx));
+    }
+
+    BENCHMARK(fmt::format("asio::steady_timer, {} operations in flight", operations))
+    {
+      return arm_and_cancel(ctx, steady_timers, op);
+    };
+
+    BENCHMARK(fmt::format("timer_wheel, {} operations in flight", operations))
+    {
+      return arm_and_cancel(ctx, wheel_timers, op);
+    };
+  }
+}
@@ -88,7 +88,8 @@ TEST_CASE("integration: analytics query", "[integration]")
       return resp.rows.size() == 1;
     }));
     REQUIRE_SUCCESS(resp.ctx.ec);
-    REQUIRE(resp.rows[0] == value);
+    REQUIRE(couchbase::core::utils::json::parse(resp.rows[0]) ==
+            couchbase::core::utils::json::parse(value));
     REQUIRE_FALSE(resp.meta.request_id.empty());
     REQUIRE_FALSE(resp.meta.client_context_id.empty());
     REQUIRE(resp.meta.status ==
@@ -107,7 +108,8 @@ TEST_CASE("integration: analytics query", "[integration]")
       return resp.rows.size() == 1;
     }));
     REQUIRE_SUCCESS(resp.ctx.ec);
-    REQUIRE(resp.rows[0] == value);
+    REQUIRE(couchbase::core::utils::json::parse(resp.rows[0]) ==
+            couchbase::core::utils::json::parse(value));
   }
 
   SECTION("named params")
@@ -123,7 +125,8 @@ TEST_CASE("integration: analytics query", "[integration]")
       return resp.rows.size() == 1;
     }));
     REQUIRE_SUCCESS(resp.ctx.ec);
-    REQUIRE(resp.rows[0] == value);
+    REQUIRE(couchbase::core::utils::json::parse(resp.rows[0]) ==
+            couchbase::core::utils::json::parse(value));
   }
 
   SECTION("named params preformatted")
@@ -139,7 +142,8 @@ TEST_CASE("integration: analytics query", "[integration]")
       return resp.rows.size() == 1;
     }));
     REQUIRE_SUCCESS(resp.ctx.ec);
-    REQUIRE(resp.rows[0] == value);
+    REQUIRE(couchbase::core::utils::json::parse(resp.rows[0]) ==
+            couchbase::core::utils::json::parse(value));
   }
 
   SECTION("raw")
@@ -155,7 +159,8 @@ TEST_CASE("integration: analytics query", "[integration]")
       return resp.rows.size() == 1;
     }));
     REQUIRE_SUCCESS(resp.ctx.ec);
-    REQUIRE(resp.rows[0] == value);
+    REQUIRE(couchbase::core::utils::json::parse(resp.rows[0]) ==
+            couchbase::core::utils::json::parse(value));
   }
 
   SECTION("consistency")
@@ -189,7 +194,8 @@ TEST_CASE("integration: analytics query", "[integration]")
 
     REQUIRE_SUCCESS(resp.ctx.ec);
     REQUIRE(resp.rows.size() == 1);
-    REQUIRE(resp.rows[0] == value);
+    REQUIRE(couchbase::core::utils::json::parse(resp.rows[0]) ==
+            couchbase::core::utils::json::parse(value));
   }
 
   SECTION("readonly")
@@ -326,7 +332,8 @@ TEST_CASE("integration: analytics scope query", "[integration]")
     return resp.rows.size() == 1;
   }));
   REQUIRE_SUCCESS(resp.ctx.ec);
-  REQUIRE(resp.rows[0] == value);
+  REQUIRE(couchbase::core::utils::json::parse(resp.rows[0]) ==
+          couchbase::core::utils::json::parse(value));
 
   {
     couchbase::core::operations::management::scope_drop_request req{ integration.ctx.bucket,
@@ -153,3 +153,15 @@ TEST_CASE("transactions: atr_entry::has_expired: large ttl plus margin does not
   const auto entry = make_atr_entry(cas_ns, start_ms, ttl_ms);
   REQUIRE_FALSE(entry.has_expired(/*safety_margin=*/100));
 }
+
+TEST_CASE("transactions: atr_entry::expires_at_ms: start plus timeout", "[unit]")
+{
+  REQUIRE(make_atr_entry(0, 1000ULL, 500U).expires_at_ms() == 1500ULL);
+  REQUIRE_FALSE(make_atr_entry(0, std::nullopt, 500U).expires_at_ms().has_value());
+  REQUIRE_FALSE(make_atr_entry(0, 1000ULL, std::nullopt).expires_at_ms().has_value());
+
+  // no overflow for the largest timeout
+  const std::uint64_t start_ms = std::numeric_limits<std::uint32_t>::max();
+  REQUIRE(make_atr_entry(0, start_ms, std::numeric_limits<std::uint32_t>::max()).expires_at_ms() ==
+          2 * start_ms);
+}
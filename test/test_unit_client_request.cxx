@@ -0,0 +1,169 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/document_id.hxx"
+#include "core/protocol/client_request.hxx"
+#include "core/protocol/cmd_get.hxx"
+#include "core/protocol/cmd_upsert.hxx"
+#include "core/protocol/compression_policy.hxx"
+#include "core/protocol/datatype.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using couchbase::core::protocol::client_request;
+using couchbase::core::protocol::compression_policy;
+using couchbase::core::protocol::compression_sampler;
+using couchbase::core::protocol::upsert_request_body;
+
+auto
+make_upsert(std::size_t value_size) -> client_request<upsert_request_body>
+{
+  client_request<upsert_request_body> req;
+  req.opaque(42);
+  req.partition(115);
+  req.body().id({ "default", "_default", "_default", "foo" });
+  req.body().flags(0x02000006);
+  req.body().content(std::vector<std::byte>(value_size, std::byte{ '7' }));
+  return req;
+}
+
+auto
+make_incompressible_upsert(std::size_t value_size) -> client_request<upsert_request_body>
+{
+  std::vector<std::byte> value(value_size);
+  std::uint32_t state = 0x12345678;
+  for (auto& b : value) {
+    state = state * 1664525U + 1013904223U;
+    b = static_cast<std::byte>(state >> 24U);
+  }
+  auto req = make_upsert(0);
+  req.body().content(std::move(value));
+  return req;
+}
+
+auto
+is_compressed(const std::vector<std::byte>& frame) -> bool
+{
+  return (frame[5] & couchbase::core::protocol::datatype::snappy) != std::byte{ 0 };
+}
+} // namespace
+
+TEST_CASE("unit: gathered upsert keeps a small value in the frame", "[unit]")
+{
+  auto req = make_upsert(100);
+  auto expected = make_upsert(100).data();
+
+  auto payload = req.gathered_data();
+  REQUIRE(payload.value.empty());
+  REQUIRE(payload.frame == expected);
+}
+
+TEST_CASE("unit: gathered upsert detaches a large value from the frame", "[unit]")
+{
+  const std::size_t value_size = client_request<upsert_request_body>::min_size_to_gather;
+  auto req = make_upsert(value_size);
+  auto expected = make_upsert(value_size).data();
+
+  auto payload = req.gathered_data();
+  REQUIRE(payload.value.size() == value_size);
+  REQUIRE(payload.frame.size() + payload.value.size() == expected.size());
+
+  // frame and value written back to back are the same bytes as the single buffer
+  auto wire = payload.frame;
+  wire.insert(wire.end(), payload.value.begin(), payload.value.end());
+  REQUIRE(wire == expected);
+}
+
+TEST_CASE("unit: gathered request without a value is encoded as a single buffer", "[unit]")
+{
+  client_request<couchbase::core::protocol::get_request_body> req;
+  req.opaque(42);
+  req.body().id({ "default", "_default", "_default", "foo" });
+
+  auto payload = req.gathered_data();
+  REQUIRE(payload.value.empty());
+  REQUIRE(payload.frame.size() == couchbase::core::protocol::header_size + 3);
+}
+
+TEST_CASE("unit: upsert is compressed only from the configured minimum size", "[unit]")
+{
+  const compression_policy policy{ 64, 0.83 };
+
+  auto small = make_upsert(63).gathered_data(&policy);
+  REQUIRE_FALSE(is_compressed(small.frame));
+
+  auto large = make_upsert(64).gathered_data(&policy);
+  REQUIRE(is_compressed(large.frame));
+  REQUIRE(large.frame.size() < make_upsert(64).data().size());
+
+  // without a policy (snappy not negotiated) nothing is compressed
+  REQUIRE_FALSE(is_compressed(make_upsert(64).gathered_data().frame));
+}
+
+TEST_CASE("unit: upsert is sent uncompressed when it does not reach the minimum ratio", "[unit]")
+{
+  const compression_policy lenient{ 32, 0.83 };
+  REQUIRE_FALSE(is_compressed(make_incompressible_upsert(4096).gathered_data(&lenient).frame));
+
+  const compression_policy strict{ 32, 0.001 };
+  REQUIRE_FALSE(is_compressed(make_upsert(4096).gathered_data(&strict).frame));
+}
+
+TEST_CASE("unit: compressed large upsert is kept in the frame", "[unit]")
+{
+  const std::size_t value_size = client_request<upsert_request_body>::min_size_to_gather;
+  const compression_policy policy{};
+
+  auto payload = make_upsert(value_size).gathered_data(&policy);
+  REQUIRE(payload.value.empty());
+  REQUIRE(is_compressed(payload.frame));
+}
+
+TEST_CASE("unit: adaptive compression backs off from incompressible values", "[unit]")
+{
+  compression_sampler sampler{};
+  const compression_policy policy{ 32, 0.83, &sampler };
+
+  // an unknown collection is always tried
+  REQUIRE(sampler.should_try(policy.min_ratio));
+
+  for (int i = 0; i < 64; ++i) {
+    static_cast<void>(make_incompressible_upsert(1024).gathered_data(&policy));
+  }
+  REQUIRE(sampler.average_ratio() > policy.min_ratio);
+
+  std::size_t attempts = 0;
+  for (std::uint32_t i = 0; i < 10 * compression_sampler::probe_interval; ++i) {
+    if (sampler.should_try(policy.min_ratio)) {
+      ++attempts;
+    }
+  }
+  REQUIRE(attempts == 10);
+
+  // once the values compress again, the probes pull the average back down
+  for (int i = 0; i < 64; ++i) {
+    sampler.record(0.1);
+  }
+  REQUIRE(sampler.average_ratio() < policy.min_ratio);
+  REQUIRE(sampler.should_try(policy.min_ratio));
+}
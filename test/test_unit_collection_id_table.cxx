@@ -0,0 +1,105 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/collection_id_table.hxx"
+
+#include <memory>
+
+using couchbase::core::collection_handle;
+using couchbase::core::collection_id_table;
+using couchbase::core::document_id;
+
+TEST_CASE("unit: document_id created through a collection handle", "[unit]")
+{
+  auto handle = std::make_shared<collection_handle>("travel", "inventory", "airline");
+  const document_id id{ handle, "airline_10" };
+
+  REQUIRE(id.handle() == handle);
+  REQUIRE(id.bucket() == "travel");
+  REQUIRE(id.scope() == "inventory");
+  REQUIRE(id.collection() == "airline");
+  REQUIRE(id.collection_path() == "inventory.airline");
+  REQUIRE(id.key() == "airline_10");
+  REQUIRE(id.use_collections());
+  REQUIRE_FALSE(id.has_default_collection());
+  REQUIRE_FALSE(id.is_collection_resolved());
+}
+
+TEST_CASE("unit: collection_id_table resolves ids by collection path", "[unit]")
+{
+  collection_id_table table{};
+
+  REQUIRE(table.find(document_id{ "travel", "_default", "_default", "key" }) == 0U);
+
+  const document_id id{ "travel", "inventory", "airline", "airline_10" };
+  REQUIRE_FALSE(table.find(id).has_value());
+  table.update(id, 8);
+  REQUIRE(table.find(id) == 8U);
+  REQUIRE(table.find(document_id{ "travel", "inventory", "airline", "other" }) == 8U);
+  REQUIRE_FALSE(table.find(document_id{ "travel", "inventory", "hotel", "hotel_1" }).has_value());
+}
+
+TEST_CASE("unit: collection_id_table caches ids on collection handles", "[unit]")
+{
+  collection_id_table table{};
+  auto handle = std::make_shared<collection_handle>("travel", "inventory", "airline");
+
+  // an id resolved through a plain document_id is picked up by the handle on its first lookup
+  table.update(document_id{ "travel", "inventory", "airline", "airline_10" }, 8);
+  REQUIRE_FALSE(handle->uid(table.generation()).has_value());
+  REQUIRE(table.find(document_id{ handle, "airline_20" }) == 8U);
+  REQUIRE(handle->uid(table.generation()) == 8U);
+
+  // and an id resolved through the handle is stored with it directly
+  auto hotel = std::make_shared<collection_handle>("travel", "inventory", "hotel");
+  table.update(document_id{ hotel, "hotel_1" }, 9);
+  REQUIRE(hotel->uid(table.generation()) == 9U);
+  REQUIRE(table.find(document_id{ "travel", "inventory", "hotel", "hotel_2" }) == 9U);
+}
+
+TEST_CASE("unit: collection_id_table invalidates every cached id at once", "[unit]")
+{
+  collection_id_table table{};
+  auto handle = std::make_shared<collection_handle>("travel", "inventory", "airline");
+  table.update(document_id{ handle, "airline_10" }, 8);
+  const auto generation = table.generation();
+
+  table.invalidate();
+
+  REQUIRE(table.generation() != generation);
+  REQUIRE_FALSE(handle->uid(table.generation()).has_value());
+  REQUIRE_FALSE(table.find(document_id{ handle, "airline_10" }).has_value());
+  REQUIRE_FALSE(table.find(document_id{ "travel", "inventory", "airline", "airline_10" }).has_value());
+  REQUIRE(table.find(document_id{ "travel", "_default", "_default", "key" }) == 0U);
+
+  table.update(document_id{ handle, "airline_10" }, 12);
+  REQUIRE(table.find(document_id{ handle, "airline_10" }) == 12U);
+}
+
+TEST_CASE("unit: collection handles do not carry ids between tables", "[unit]")
+{
+  auto handle = std::make_shared<collection_handle>("travel", "inventory", "airline");
+
+  collection_id_table first{};
+  first.update(document_id{ handle, "airline_10" }, 8);
+
+  // e.g. the bucket was closed and opened again
+  const collection_id_table second{};
+  REQUIRE_FALSE(second.find(document_id{ handle, "airline_10" }).has_value());
+}
@@ -590,6 +590,40 @@ TEST_CASE("unit: connection string", "[unit]")
   }
 }
 
+TEST_CASE("unit: connection string kv_connections_per_node", "[unit]")
+{
+  CHECK(couchbase::core::utils::parse_connection_string("couchbase://127.0.0.1")
+          .options.kv_connections_per_node == 1);
+  CHECK(couchbase::core::utils::parse_connection_string(
+          "couchbase://127.0.0.1?kv_connections_per_node=4")
+          .options.kv_connections_per_node == 4);
+  CHECK(couchbase::core::utils::parse_connection_string(
+          "couchbase://127.0.0.1?kv_connections_per_node=0")
+          .options.kv_connections_per_node == 1);
+}
+
+TEST_CASE("unit: connection string node selection", "[unit]")
+{
+  using couchbase::core::service_type;
+  using couchbase::core::io::http_node_selection;
+
+  CHECK(couchbase::core::utils::parse_connection_string("couchbase://127.0.0.1")
+          .options.http_node_selection.empty());
+
+  auto connstr = couchbase::core::utils::parse_connection_string(
+    "couchbase://127.0.0.1?query_node_selection=least_latency&search_node_selection=round_robin");
+  CHECK(connstr.warnings.empty());
+  CHECK(connstr.options.http_node_selection.at(service_type::query) ==
+        http_node_selection::least_latency);
+  CHECK(connstr.options.http_node_selection.at(service_type::search) ==
+        http_node_selection::round_robin);
+  CHECK(connstr.options.http_node_selection.count(service_type::analytics) == 0);
+
+  connstr = couchbase::core::utils::parse_connection_string(
+    "couchbase://127.0.0.1?analytics_node_selection=fastest");
+  CHECK(connstr.warnings.size() == 1);
+}
+
 TEST_CASE("unit: bootstrap nodes randomization", "[unit]")
 {
   std::vector<std::string> source_hostnames{
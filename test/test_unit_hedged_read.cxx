@@ -0,0 +1,133 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/impl/hedged_read.hxx"
+
+#include <asio/io_context.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using couchbase::core::impl::hedged_read;
+using couchbase::core::impl::read_latency_tracker;
+using namespace std::chrono_literals;
+
+namespace
+{
+void
+fill_window(read_latency_tracker& tracker,
+            const std::string& endpoint,
+            std::chrono::steady_clock::duration fast,
+            std::chrono::steady_clock::duration slow,
+            std::size_t slow_count)
+{
+  for (std::size_t i = 0; i < read_latency_tracker::window_size; ++i) {
+    tracker.record(endpoint, i < read_latency_tracker::window_size - slow_count ? fast : slow);
+  }
+}
+} // namespace
+
+TEST_CASE("unit: read_latency_tracker derives the hedge delay from the 95th percentile", "[unit]")
+{
+  read_latency_tracker tracker{};
+  REQUIRE(tracker.hedge_delay("node1:11210") == read_latency_tracker::default_delay);
+
+  for (std::size_t i = 0; i < read_latency_tracker::min_samples - 1; ++i) {
+    tracker.record("node1:11210", 2ms);
+  }
+  REQUIRE(tracker.hedge_delay("node1:11210") == read_latency_tracker::default_delay);
+
+  // 6 of 128 reads are slow: they sit above the 95th percentile and do not move the delay
+  fill_window(tracker, "node1:11210", 2ms, 100ms, 6);
+  REQUIRE(tracker.hedge_delay("node1:11210") == 2ms);
+
+  // 10 of 128 reads are slow: now they do
+  fill_window(tracker, "node1:11210", 2ms, 100ms, 10);
+  REQUIRE(tracker.hedge_delay("node1:11210") == 100ms);
+
+  fill_window(tracker, "node2:11210", 100us, 100us, 0);
+  REQUIRE(tracker.hedge_delay("node2:11210") == read_latency_tracker::min_delay);
+
+  fill_window(tracker, "node3:11210", 10s, 10s, 0);
+  REQUIRE(tracker.hedge_delay("node3:11210") == read_latency_tracker::max_delay);
+
+  REQUIRE(tracker.hedge_delay("node1:11210") == 100ms);
+}
+
+TEST_CASE("unit: hedged_read asks the next node only after the hedge delay", "[unit]")
+{
+  asio::io_context io{};
+  auto tracker = std::make_shared<read_latency_tracker>();
+  fill_window(*tracker, "active:11210", 20ms, 20ms, 0);
+
+  std::vector<std::size_t> dispatched{};
+  auto hedge = std::make_shared<hedged_read>(
+    io,
+    tracker,
+    std::vector<std::string>{ "active:11210", "replica1:11210", "replica2:11210" },
+    [&dispatched](std::size_t index) {
+      dispatched.push_back(index);
+    });
+
+  hedge->start();
+  REQUIRE(dispatched == std::vector<std::size_t>{ 0 });
+
+  io.run_for(5ms);
+  REQUIRE(dispatched == std::vector<std::size_t>{ 0 });
+
+  io.run_for(50ms);
+  REQUIRE(dispatched.size() >= 2);
+  REQUIRE(dispatched[1] == 1);
+
+  hedge->stop();
+  auto sent = dispatched.size();
+  io.restart();
+  io.run_for(50ms);
+  REQUIRE(dispatched.size() == sent);
+  REQUIRE(hedge->sent() == sent);
+}
+
+TEST_CASE("unit: hedged_read asks the next node right away when a node fails", "[unit]")
+{
+  asio::io_context io{};
+  auto tracker = std::make_shared<read_latency_tracker>();
+  fill_window(*tracker, "active:11210", 10s, 10s, 0);
+
+  std::vector<std::size_t> dispatched{};
+  auto hedge = std::make_shared<hedged_read>(
+    io,
+    tracker,
+    std::vector<std::string>{ "active:11210", "replica1:11210" },
+    [&dispatched](std::size_t index) {
+      dispatched.push_back(index);
+    });
+
+  hedge->start();
+  hedge->hedge_now();
+  REQUIRE(dispatched == std::vector<std::size_t>{ 0, 1 });
+
+  // nobody is left to ask
+  hedge->hedge_now();
+  io.run_for(5ms);
+  REQUIRE(dispatched == std::vector<std::size_t>{ 0, 1 });
+  REQUIRE(hedge->sent() == 2);
+}
@@ -0,0 +1,170 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/http_node_selector.hxx"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+using couchbase::core::service_type;
+using couchbase::core::io::http_endpoint_load;
+using couchbase::core::io::http_node_selector;
+using couchbase::core::io::pick_least_loaded_node;
+using namespace std::chrono_literals;
+
+TEST_CASE("unit: http_node_selector picks two distinct indexes", "[unit]")
+{
+  REQUIRE(http_node_selector::pick_two(1) == std::make_pair(std::size_t{ 0 }, std::size_t{ 0 }));
+
+  std::set<std::size_t> seen{};
+  for (int i = 0; i < 1'000; ++i) {
+    auto [first, second] = http_node_selector::pick_two(3);
+    REQUIRE(first < 3);
+    REQUIRE(second < 3);
+    REQUIRE(first != second);
+    seen.insert(first);
+    seen.insert(second);
+  }
+  REQUIRE(seen.size() == 3);
+}
+
+TEST_CASE("unit: http_endpoint_load averages latencies and fades while idle", "[unit]")
+{
+  const auto now = std::chrono::steady_clock::now();
+  http_endpoint_load load{};
+  REQUIRE(load.average_latency(now) == 0ns);
+
+  load.start();
+  REQUIRE(load.outstanding() == 1);
+  load.finish(10ms, now);
+  REQUIRE(load.outstanding() == 0);
+  REQUIRE(load.average_latency(now) == 10ms);
+
+  load.start();
+  load.finish(20ms, now);
+  REQUIRE(load.average_latency(now) == 12ms);
+
+  REQUIRE(load.average_latency(now + http_endpoint_load::decay_half_life) == 6ms);
+}
+
+TEST_CASE("unit: http_endpoint_load scores requests in flight", "[unit]")
+{
+  const auto now = std::chrono::steady_clock::now();
+  http_endpoint_load load{};
+  load.start();
+  load.finish(1ms, now);
+  const auto idle = load.score(now);
+
+  load.start();
+  load.start();
+  REQUIRE(load.score(now) == 3 * idle);
+}
+
+TEST_CASE("unit: least loaded node selection skips nodes without the service", "[unit]")
+{
+  http_node_selector selector{};
+  std::vector<couchbase::core::topology::configuration::node> nodes(2);
+  nodes[0].hostname = "kv_only";
+  nodes[0].services_plain.key_value = 11210;
+  REQUIRE(pick_least_loaded_node(nodes, service_type::query, "default", false, selector) ==
+          nullptr);
+
+  nodes[1].hostname = "query";
+  nodes[1].services_plain.query = 8093;
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(pick_least_loaded_node(nodes, service_type::query, "default", false, selector) ==
+            &nodes[1]);
+  }
+}
+
+TEST_CASE("unit: http_node_selector keeps loads per service and endpoint", "[unit]")
+{
+  http_node_selector selector{};
+  const std::string hostname{ "node1" };
+  REQUIRE(selector.score(service_type::query, hostname, 8093) == 0);
+
+  auto query = selector.load_for(service_type::query, hostname, 8093);
+  REQUIRE(selector.load_for(service_type::query, hostname, 8093) == query);
+  REQUIRE(selector.load_for(service_type::search, hostname, 8093) != query);
+  REQUIRE(selector.load_for(service_type::query, hostname, 18093) != query);
+
+  const auto now = std::chrono::steady_clock::now();
+  query->start();
+  query->finish(5ms, now);
+  REQUIRE(selector.score(service_type::query, hostname, 8093, now) == query->score(now));
+  REQUIRE(selector.score(service_type::search, hostname, 8093, now) < query->score(now));
+}
+
+namespace
+{
+// Sends requests one after another to three nodes, one of which is twenty times slower, and
+// returns the 99th percentile latency.
+template<typename Choose>
+auto
+p99_with_one_slow_node(Choose&& choose) -> std::chrono::nanoseconds
+{
+  constexpr std::array<std::chrono::nanoseconds, 3> service_times{ 1ms, 1ms, 20ms };
+  std::vector<std::chrono::nanoseconds> latencies{};
+  auto now = std::chrono::steady_clock::time_point{} + 1h;
+  for (std::size_t i = 0; i < 10'000; ++i) {
+    const auto node = choose(i, now);
+    now += service_times[node];
+    latencies.push_back(service_times[node]);
+  }
+  std::sort(latencies.begin(), latencies.end());
+  return latencies[latencies.size() * 99 / 100];
+}
+} // namespace
+
+TEST_CASE("unit: least latency selection keeps a slow node out of the tail", "[unit]")
+{
+  const auto round_robin = p99_with_one_slow_node([](std::size_t i, auto /* now */) {
+    return i % 3;
+  });
+  REQUIRE(round_robin == 20ms);
+
+  http_node_selector selector{};
+  std::vector<couchbase::core::topology::configuration::node> nodes(3);
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    nodes[i].index = i;
+    nodes[i].hostname = "node" + std::to_string(i + 1);
+    nodes[i].services_plain.query = 8093;
+  }
+  // does not offer the query service, so it is never picked
+  nodes.emplace_back().hostname = "node4";
+
+  const auto least_latency = p99_with_one_slow_node([&](std::size_t /* i */, auto now) {
+    const auto* picked =
+      pick_least_loaded_node(nodes, service_type::query, "default", false, selector, now);
+    REQUIRE(picked != nullptr);
+    REQUIRE(picked->hostname != "node4");
+    const auto node = picked->index;
+    auto load = selector.load_for(service_type::query, picked->hostname, 8093);
+    load->start();
+    load->finish(node == 2 ? 20ms : 1ms, now + (node == 2 ? 20ms : 1ms));
+    return node;
+  });
+  REQUIRE(least_latency == 1ms);
+}
@@ -0,0 +1,101 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/io_context_pool.hxx"
+
+#include <asio/io_context.hpp>
+
+#include <set>
+
+using couchbase::core::io::io_context_pool;
+
+TEST_CASE("unit: io_context_pool without extra contexts hands out the primary", "[unit]")
+{
+  asio::io_context primary;
+  io_context_pool pool{ primary };
+
+  REQUIRE(pool.size() == 1);
+  REQUIRE(&pool.primary() == &primary);
+  REQUIRE(&pool.context_for("node1", 11210) == &primary);
+  REQUIRE(&pool.context_for("node2", 11210) == &primary);
+}
+
+TEST_CASE("unit: io_context_pool ignores the primary in the list of extra contexts", "[unit]")
+{
+  asio::io_context primary;
+  asio::io_context other;
+  io_context_pool pool{ primary, { primary, other } };
+
+  REQUIRE(pool.size() == 2);
+  REQUIRE(&pool.primary() == &primary);
+}
+
+TEST_CASE("unit: io_context_pool spreads endpoints and keeps them pinned", "[unit]")
+{
+  asio::io_context primary;
+  asio::io_context second;
+  asio::io_context third;
+  io_context_pool pool{ primary, { second, third } };
+  REQUIRE(pool.size() == 3);
+
+  std::set<asio::io_context*> used{};
+  used.insert(&pool.context_for("node1", 11210));
+  used.insert(&pool.context_for("node2", 11210));
+  used.insert(&pool.context_for("node3", 11210));
+  REQUIRE(used.size() == 3);
+
+  // the same endpoint always lands on the same context
+  auto* node1 = &pool.context_for("node1", 11210);
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(&pool.context_for("node1", 11210) == node1);
+  }
+}
+
+TEST_CASE("unit: io_context_pool spreads the connections to one endpoint", "[unit]")
+{
+  asio::io_context primary;
+  asio::io_context second;
+  asio::io_context third;
+  io_context_pool pool{ primary, { second, third } };
+
+  auto* first = &pool.context_for("node1", 11210);
+  REQUIRE(&pool.context_for("node1", 11210, 0) == first);
+
+  std::set<asio::io_context*> used{ first };
+  used.insert(&pool.context_for("node1", 11210, 1));
+  used.insert(&pool.context_for("node1", 11210, 2));
+  REQUIRE(used.size() == 3);
+
+  // more connections than contexts wrap around, and ask for the same contexts every time
+  REQUIRE(&pool.context_for("node1", 11210, 3) == first);
+  REQUIRE(&pool.context_for("node1", 11210, 1) != first);
+}
+
+TEST_CASE("unit: io_context_pool treats each port of a node as its own endpoint", "[unit]")
+{
+  asio::io_context primary;
+  asio::io_context other;
+  io_context_pool pool{ primary, { other } };
+
+  auto* kv = &pool.context_for("node1", 11210);
+  auto* query = &pool.context_for("node1", 8093);
+  REQUIRE(kv != query);
+  REQUIRE(&pool.context_for("node1", 11210) == kv);
+  REQUIRE(&pool.context_for("node1", 8093) == query);
+}
@@ -22,6 +22,8 @@
 
 #include "core/utils/json_streaming_lexer.hxx"
 
+#include <spdlog/fmt/bundled/core.h>
+
 struct query_result {
   std::error_code ec{};
   std::size_t number_of_rows{};
@@ -234,3 +236,49 @@ TEST_CASE("unit: json_streaming_lexer parse payload with missing results", "[uni
   REQUIRE(result.rows.empty());
   REQUIRE(result.meta == chunk);
 }
+
+TEST_CASE("unit: json_streaming_lexer split_rows slices a large body across feeds", "[unit]")
+{
+  test::utils::init_logger();
+
+  // Large enough to be fed to the lexer in several slices, with rows straddling the boundaries.
+  std::string body = R"({"requestID":"r","results":[)";
+  constexpr std::size_t number_of_rows = 5000;
+  for (std::size_t i = 0; i < number_of_rows; ++i) {
+    if (i > 0) {
+      body += ",";
+    }
+    body += fmt::format(R"({{"id":{},"pad":"{}"}})", i, std::string(i % 50, 'x'));
+  }
+  body += R"(],"status":"success"})";
+  REQUIRE(body.size() > 128 * 1024);
+
+  auto result = couchbase::core::utils::json::split_rows(body, "/results/^", 4);
+  REQUIRE_SUCCESS(result.ec);
+  REQUIRE(result.rows.size() == number_of_rows);
+  REQUIRE(result.rows[0] == R"({"id":0,"pad":""})");
+  REQUIRE(result.rows[4999] == fmt::format(R"({{"id":4999,"pad":"{}"}})", std::string(49, 'x')));
+  REQUIRE(result.meta == R"({"requestID":"r","results":[],"status":"success"})");
+}
+
+TEST_CASE("unit: json_streaming_lexer split_rows keeps a body without rows as metadata", "[unit]")
+{
+  test::utils::init_logger();
+
+  const std::string body = R"({"status":"fatal","errors":[{"code":5000,"msg":"boom"}]})";
+  auto result = couchbase::core::utils::json::split_rows(body, "/results/^", 4);
+  REQUIRE_SUCCESS(result.ec);
+  REQUIRE(result.rows.empty());
+  REQUIRE(result.meta == body);
+}
+
+TEST_CASE("unit: json_streaming_lexer split_rows fails an incomplete body", "[unit]")
+{
+  test::utils::init_logger();
+
+  for (const std::string body : { "", "   ", R"({"results":[{"a":1},)", "[1,2]" }) {
+    INFO("body=" << body);
+    auto result = couchbase::core::utils::json::split_rows(body, "/results/^", 4);
+    REQUIRE(result.ec);
+  }
+}
@@ -25,10 +25,13 @@
 #include <couchbase/codec/tao_json_serializer.hxx>
 
 #include <tao/json.hpp>
+#include <tao/json/binding.hpp>
+#include <tao/json/contrib/traits.hpp>
 
 #include <cstdint>
 #include <string_view>
 #include <system_error>
+#include <tuple>
 #include <vector>
 
 using Catch::Approx;
@@ -247,6 +250,105 @@ TEST_CASE("unit: default_json_transcoder decodes user data", "[unit]")
   REQUIRE(value.at("birth_year").get_unsigned() == 1879);
 }
 
+struct ticket {
+  std::string id{};
+  std::uint32_t seats{};
+  bool confirmed{};
+};
+
+template<>
+struct tao::json::traits<ticket>
+  : tao::json::binding::object<TAO_JSON_BIND_REQUIRED("id", &ticket::id),
+                               TAO_JSON_BIND_REQUIRED("seats", &ticket::seats),
+                               TAO_JSON_BIND_REQUIRED("confirmed", &ticket::confirmed)> {
+};
+
+TEST_CASE("unit: default_json_transcoder encodes and decodes bound user data", "[unit]")
+{
+  const ticket original{ "ticket::1", 2, true };
+
+  // bindings are written in declaration order, without going through tao::json::value
+  auto encoded = couchbase::codec::default_json_transcoder::encode(original);
+  REQUIRE(encoded.data == to_bytes(R"({"id":"ticket::1","seats":2,"confirmed":true})"));
+  REQUIRE(encoded.flags == couchbase::codec::codec_flags::json_common_flags);
+
+  auto decoded = couchbase::codec::default_json_transcoder::decode<ticket>(encoded);
+  REQUIRE(decoded.id == original.id);
+  REQUIRE(decoded.seats == original.seats);
+  REQUIRE(decoded.confirmed == original.confirmed);
+
+  decoded = couchbase::codec::default_json_transcoder::decode<ticket>({
+    to_bytes(R"({ "confirmed": false, "seats": 3, "id": "ticket::2" })"),
+    couchbase::codec::codec_flags::json_common_flags,
+  });
+  REQUIRE(decoded.id == "ticket::2");
+  REQUIRE(decoded.seats == 3);
+  REQUIRE_FALSE(decoded.confirmed);
+
+  REQUIRE_THROWS_AS(couchbase::codec::default_json_transcoder::decode<ticket>({
+                      to_bytes(R"({"id":"ticket::3",)"),
+                      couchbase::codec::codec_flags::json_common_flags,
+                    }),
+                    std::system_error);
+}
+
+TEST_CASE("unit: default_json_transcoder rejects bound user data with missing keys", "[unit]")
+{
+  try {
+    std::ignore = couchbase::codec::default_json_transcoder::decode<ticket>({
+      to_bytes(R"({"id":"x"})"),
+      couchbase::codec::codec_flags::json_common_flags,
+    });
+    FAIL("expected decoding to fail");
+  } catch (const std::system_error& e) {
+    REQUIRE(e.code() == couchbase::errc::common::decoding_failure);
+  }
+}
+
+TEST_CASE("unit: default_json_transcoder keeps the last of duplicated keys in bound user data",
+          "[unit]")
+{
+  // same as parsing into tao::json::value, which the documents that are not bound go through
+  auto decoded = couchbase::codec::default_json_transcoder::decode<ticket>({
+    to_bytes(R"({"id":"ticket::1","seats":2,"confirmed":true,"seats":4})"),
+    couchbase::codec::codec_flags::json_common_flags,
+  });
+  REQUIRE(decoded.id == "ticket::1");
+  REQUIRE(decoded.seats == 4);
+  REQUIRE(decoded.confirmed);
+}
+
+TEST_CASE("unit: default_json_transcoder encodes and decodes containers of user data", "[unit]")
+{
+  // profile only provides assign/as, so the container goes through tao::json::value
+  const std::vector<profile> people{
+    { "this_guy_again", "Albert Einstein", 1879 },
+    { "radium", "Marie Curie", 1867 },
+  };
+  auto encoded = couchbase::codec::default_json_transcoder::encode(people);
+  REQUIRE(encoded.data ==
+          to_bytes(R"([{"birth_year":1879,"full_name":"Albert Einstein",)"
+                   R"("username":"this_guy_again"},)"
+                   R"({"birth_year":1867,"full_name":"Marie Curie","username":"radium"}])"));
+
+  auto decoded = couchbase::codec::default_json_transcoder::decode<std::vector<profile>>(encoded);
+  REQUIRE(decoded.size() == 2);
+  REQUIRE(decoded[1].username == "radium");
+  REQUIRE(decoded[1].birth_year == 1867);
+
+  // ticket is bound, so the container is written straight into the output
+  const std::vector<ticket> tickets{ { "ticket::1", 2, true }, { "ticket::2", 1, false } };
+  encoded = couchbase::codec::default_json_transcoder::encode(tickets);
+  REQUIRE(encoded.data == to_bytes(R"([{"id":"ticket::1","seats":2,"confirmed":true},)"
+                                   R"({"id":"ticket::2","seats":1,"confirmed":false}])"));
+
+  auto decoded_tickets =
+    couchbase::codec::default_json_transcoder::decode<std::vector<ticket>>(encoded);
+  REQUIRE(decoded_tickets.size() == 2);
+  REQUIRE(decoded_tickets[1].id == "ticket::2");
+  REQUIRE_FALSE(decoded_tickets[1].confirmed);
+}
+
 TEST_CASE("unit: default_lenient_json_transcoder is recognized as a transcoder", "[unit]")
 {
   STATIC_REQUIRE(
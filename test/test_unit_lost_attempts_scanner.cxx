@@ -0,0 +1,213 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/topology/configuration.hxx"
+#include "core/transactions/internal/lost_attempts_scanner.hxx"
+
+#include <couchbase/error_codes.hxx>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace couchbase::core::transactions;
+using namespace std::chrono_literals;
+
+namespace
+{
+auto
+make_atr_ids(std::size_t count) -> std::vector<std::string>
+{
+  std::vector<std::string> ids{};
+  ids.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    ids.push_back("_txn:atr-" + std::to_string(i));
+  }
+  return ids;
+}
+
+auto
+one_of(std::uint32_t num_active_clients, std::uint32_t index_of_this_client)
+  -> client_record_details
+{
+  client_record_details details{};
+  details.num_active_clients = num_active_clients;
+  details.index_of_this_client = index_of_this_client;
+  return details;
+}
+
+auto
+make_atr_entry(std::uint64_t start_ms, std::optional<std::uint32_t> expires_after_ms) -> atr_entry
+{
+  return atr_entry{
+    /*atr_bucket=*/"b",
+    /*atr_id=*/"id",
+    /*attempt_id=*/"attempt",
+    /*state=*/attempt_state::PENDING,
+    /*timestamp_start_ms=*/start_ms,
+    /*timestamp_commit_ms=*/std::nullopt,
+    /*timestamp_complete_ms=*/std::nullopt,
+    /*timestamp_rollback_ms=*/std::nullopt,
+    /*timestamp_rolled_back_ms=*/std::nullopt,
+    /*expires_after_ms=*/expires_after_ms,
+    /*inserted_ids=*/std::nullopt,
+    /*replaced_ids=*/std::nullopt,
+    /*removed_ids=*/std::nullopt,
+    /*forward_compat=*/std::nullopt,
+    /*cas=*/start_ms * 1'000'000,
+    /*durability_level=*/std::nullopt,
+  };
+}
+} // namespace
+
+TEST_CASE("transactions: lost_attempts_pass takes every n-th ATR for this client", "[unit]")
+{
+  const auto atr_ids = make_atr_ids(100);
+  const auto start = std::chrono::steady_clock::now();
+
+  lost_attempts_pass alone{ atr_ids, one_of(1, 0), nullptr, 60s, start };
+  REQUIRE(alone.total() == 100);
+  REQUIRE(alone.number_of_lanes() == 1);
+
+  lost_attempts_pass second_of_three{ atr_ids, one_of(3, 1), nullptr, 60s, start };
+  REQUIRE(second_of_three.total() == 33);
+  const auto batch = second_of_three.launch(start + 60s);
+  REQUIRE(batch.size() == 16);
+  REQUIRE(batch[0].second == "_txn:atr-1");
+  REQUIRE(batch[1].second == "_txn:atr-4");
+}
+
+TEST_CASE("transactions: lost_attempts_pass keeps at most 16 checks in flight per node", "[unit]")
+{
+  const auto atr_ids = make_atr_ids(100);
+  const auto start = std::chrono::steady_clock::now();
+
+  SECTION("without a configuration all ATRs share one node")
+  {
+    lost_attempts_pass pass{ atr_ids, one_of(1, 0), nullptr, 60s, start };
+    REQUIRE(pass.launch(start + 60s).size() == lost_attempts_pass::window_per_node);
+    REQUIRE(pass.launch(start + 60s).empty());
+    REQUIRE(pass.in_flight(0) == 16);
+
+    REQUIRE_FALSE(pass.finish(0));
+    const auto next = pass.launch(start + 60s);
+    REQUIRE(next.size() == 1);
+    REQUIRE(next[0].second == "_txn:atr-16");
+  }
+
+  SECTION("each node has its own window")
+  {
+    auto config = std::make_shared<couchbase::core::topology::configuration>();
+    config->nodes.resize(2);
+    config->vbmap = couchbase::core::topology::configuration::vbucket_map{ { 0 }, { 1 } };
+
+    lost_attempts_pass pass{ atr_ids, one_of(1, 0), config, 60s, start };
+    REQUIRE(pass.number_of_lanes() == 2);
+    REQUIRE(pass.launch(start + 60s).size() == 2 * lost_attempts_pass::window_per_node);
+    REQUIRE(pass.in_flight(0) == 16);
+    REQUIRE(pass.in_flight(1) == 16);
+
+    REQUIRE_FALSE(pass.finish(1));
+    const auto next = pass.launch(start + 60s);
+    REQUIRE(next.size() == 1);
+    REQUIRE(next[0].first == 1);
+  }
+}
+
+TEST_CASE("transactions: lost_attempts_pass spreads its checks across the cleanup window", "[unit]")
+{
+  const auto atr_ids = make_atr_ids(100);
+  const auto start = std::chrono::steady_clock::now();
+  lost_attempts_pass pass{ atr_ids, one_of(1, 0), nullptr, 80s, start };
+
+  // one check is due right away, then one per 1% of the window
+  REQUIRE(pass.launch(start).size() == 1);
+  REQUIRE(pass.launch(start).empty());
+  REQUIRE(pass.launch(start + 10s).size() == 12);
+  REQUIRE(pass.tick_interval() == 800ms);
+  REQUIRE_FALSE(pass.all_launched());
+
+  lost_attempts_pass short_window{ atr_ids, one_of(1, 0), nullptr, 100ms, start };
+  REQUIRE(short_window.tick_interval() == lost_attempts_pass::min_tick);
+}
+
+TEST_CASE("transactions: lost_attempts_pass schedules the next pass at the end of the window",
+          "[unit]")
+{
+  const auto atr_ids = make_atr_ids(20);
+  const auto start = std::chrono::steady_clock::now();
+  lost_attempts_pass pass{ atr_ids, one_of(1, 0), nullptr, 60s, start };
+
+  std::size_t launched{ 0 };
+  bool done{ false };
+  while (!done) {
+    const auto batch = pass.launch(start + 60s);
+    launched += batch.size();
+    for (const auto& [lane_index, atr_id] : batch) {
+      done = pass.finish(lane_index);
+    }
+  }
+  REQUIRE(launched == 20);
+  REQUIRE(pass.all_launched());
+  REQUIRE(pass.next_pass_delay(start + 20s) == 40s);
+  REQUIRE(pass.next_pass_delay(start + 70s) == std::chrono::steady_clock::duration::zero());
+}
+
+TEST_CASE("transactions: lost_attempts_scanner skips ATRs whose CAS has not changed", "[unit]")
+{
+  const known_atr known{ 42, std::nullopt };
+
+  REQUIRE(classify_light_read(known, {}, 42, std::nullopt) == light_read_outcome::unchanged);
+  REQUIRE(classify_light_read(known, {}, 43, std::nullopt) == light_read_outcome::changed);
+  REQUIRE(classify_light_read(known, couchbase::errc::key_value::document_not_found, 0, {}) ==
+          light_read_outcome::missing);
+  REQUIRE(classify_light_read(known, couchbase::errc::common::unambiguous_timeout, 42, {}) ==
+          light_read_outcome::changed);
+}
+
+TEST_CASE("transactions: lost_attempts_scanner cleans ATRs once an attempt has expired", "[unit]")
+{
+  const known_atr known{ 42, 1'500U };
+
+  REQUIRE(classify_light_read(known, {}, 42, 1'500U) == light_read_outcome::unchanged);
+  REQUIRE(classify_light_read(known, {}, 42, 1'501U) == light_read_outcome::expired);
+  // a changed ATR is read again, whatever the clock says
+  REQUIRE(classify_light_read(known, {}, 43, 1'501U) == light_read_outcome::changed);
+  // without the clock there is no telling whether the attempt expired
+  REQUIRE(classify_light_read(known, {}, 42, std::nullopt) == light_read_outcome::changed);
+}
+
+TEST_CASE("transactions: lost_attempts_scanner remembers the earliest expiry of an ATR", "[unit]")
+{
+  const auto known = remember_atr(7,
+                                  {
+                                    make_atr_entry(2'000, 100),
+                                    make_atr_entry(1'000, 500),
+                                    make_atr_entry(500, std::nullopt),
+                                  });
+  REQUIRE(known.cas == 7);
+  REQUIRE(known.expires_at_ms == 1'500U);
+
+  REQUIRE_FALSE(remember_atr(7, {}).expires_at_ms.has_value());
+  REQUIRE_FALSE(remember_atr(7, { make_atr_entry(500, std::nullopt) }).expires_at_ms.has_value());
+}
@@ -19,7 +19,10 @@
 
 #include "core/io/mcbp_output_queue.hxx"
 
+#include <atomic>
 #include <cstddef>
+#include <cstring>
+#include <thread>
 #include <vector>
 
 namespace
@@ -136,3 +139,88 @@ TEST_CASE("unit: reset clears both buffers and returns the queue to idle", "[uni
   // After a reset the queue is idle, so a new enqueue re-arms the dispatch.
   REQUIRE(queue.enqueue(byte_buffer(std::byte{ 0x03 })));
 }
+
+TEST_CASE("unit: a frame and its detached value are written back to back", "[unit]")
+{
+  couchbase::core::io::mcbp_output_queue queue;
+  REQUIRE(queue.enqueue(byte_buffer(std::byte{ 0x01 }, 24), byte_buffer(std::byte{ 0x02 }, 100)));
+  REQUIRE_FALSE(queue.enqueue(byte_buffer(std::byte{ 0x03 }, 24), {}));
+
+  REQUIRE(queue.begin_writing());
+  REQUIRE(queue.writing().size() == 3);
+  REQUIRE(queue.writing()[0][0] == std::byte{ 0x01 });
+  REQUIRE(queue.writing()[1].size() == 100);
+  REQUIRE(queue.writing()[2][0] == std::byte{ 0x03 });
+}
+
+TEST_CASE("unit: queued_bytes counts what has not been moved into a writing batch", "[unit]")
+{
+  couchbase::core::io::mcbp_output_queue queue;
+  REQUIRE(queue.queued_bytes() == 0);
+
+  static_cast<void>(
+    queue.enqueue(byte_buffer(std::byte{ 0x01 }, 24), byte_buffer(std::byte{ 0x02 }, 100)));
+  queue.stage(byte_buffer(std::byte{ 0x03 }, 24));
+  REQUIRE(queue.queued_bytes() == 148);
+
+  REQUIRE(queue.begin_writing());
+  REQUIRE(queue.queued_bytes() == 0);
+
+  static_cast<void>(queue.enqueue(byte_buffer(std::byte{ 0x04 }, 10)));
+  REQUIRE(queue.queued_bytes() == 10);
+  queue.reset();
+  REQUIRE(queue.queued_bytes() == 0);
+}
+
+TEST_CASE("unit: concurrent producers lose nothing and keep their own order", "[unit]")
+{
+  constexpr std::size_t producers = 4;
+  constexpr std::size_t buffers_per_producer = 10'000;
+  couchbase::core::io::mcbp_output_queue queue;
+  std::atomic_size_t dispatches{ 0 };
+
+  std::vector<std::thread> threads{};
+  for (std::size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue, &dispatches, p]() {
+      for (std::size_t i = 0; i < buffers_per_producer; ++i) {
+        // first byte identifies the producer, the rest carries the sequence number
+        std::vector<std::byte> buf(1 + sizeof(i));
+        buf[0] = static_cast<std::byte>(p);
+        std::memcpy(buf.data() + 1, &i, sizeof(i));
+        if (queue.enqueue(std::move(buf))) {
+          dispatches.fetch_add(1);
+        }
+      }
+    });
+  }
+
+  // the writer: only drains when a dispatch was requested, like do_write does
+  std::vector<std::size_t> next(producers, 0);
+  std::size_t received = 0;
+  std::size_t drained_dispatches = 0;
+  while (received < producers * buffers_per_producer) {
+    if (drained_dispatches == dispatches.load()) {
+      std::this_thread::yield();
+      continue;
+    }
+    ++drained_dispatches;
+    while (queue.begin_writing()) {
+      for (const auto& buf : queue.writing()) {
+        const auto p = static_cast<std::size_t>(buf[0]);
+        std::size_t sequence{};
+        std::memcpy(&sequence, buf.data() + 1, sizeof(sequence));
+        REQUIRE(sequence == next[p]);
+        ++next[p];
+        ++received;
+      }
+      queue.finish_writing();
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(received == producers * buffers_per_producer);
+  REQUIRE_FALSE(queue.begin_writing());
+  REQUIRE(drained_dispatches == dispatches.load());
+}
@@ -18,9 +18,14 @@
 #include "test_helper.hxx"
 
 #include "core/io/mcbp_parser.hxx"
+#include "core/protocol/datatype.hxx"
 #include "core/protocol/magic.hxx"
+#include "core/utils/byteswap.hxx"
+
+#include <snappy.h>
 
 #include <array>
+#include <string>
 #include <vector>
 
 namespace
@@ -55,6 +60,10 @@ struct frame_builder {
   {
     return set(4, v);
   }
+  auto datatype(std::uint8_t v) -> frame_builder& // byte 5
+  {
+    return set(5, v);
+  }
   auto bodylen(std::uint32_t v) -> frame_builder& // bytes 8-11
   {
     return set(8, static_cast<std::uint8_t>(v >> 24U))
@@ -136,3 +145,105 @@ TEST_CASE("unit: mcbp_parser accepts a well-formed frame (positive control)", "[
   CHECK(parser.next(msg) == mcbp_parser::result::ok);
   CHECK(msg.body.size() == 7);
 }
+
+TEST_CASE("unit: mcbp_parser walks pipelined frames split across reads", "[unit]")
+{
+  std::vector<std::byte> wire;
+  for (std::uint8_t i = 0; i < 3; ++i) {
+    auto header = frame_builder{}
+                    .magic_byte(magic::client_response)
+                    .opcode(0x00)
+                    .extlen(0x04)
+                    .bodylen(6)
+                    .bytes;
+    wire.insert(wire.end(), header.begin(), header.end());
+    wire.insert(wire.end(), 4, std::byte{ 0x00 }); // extras
+    wire.insert(wire.end(), 2, std::byte{ i });    // value
+  }
+
+  mcbp_parser parser;
+  // the first read ends in the middle of the second frame
+  auto split = wire.begin() + 40;
+  parser.feed(wire.begin(), split);
+
+  couchbase::core::io::mcbp_frame_view frame{};
+  REQUIRE(parser.next(frame) == mcbp_parser::result::ok);
+  CHECK(frame.prefix.size() == 4);
+  REQUIRE(frame.value.size() == 2);
+  CHECK(frame.value[0] == std::byte{ 0 });
+  CHECK(parser.next(frame) == mcbp_parser::result::need_data);
+
+  parser.feed(split, wire.end());
+  CHECK(parser.offset == 0);
+
+  mcbp_message msg;
+  REQUIRE(parser.next(msg) == mcbp_parser::result::ok);
+  REQUIRE(msg.body.size() == 6);
+  CHECK(msg.body[4] == std::byte{ 1 });
+  REQUIRE(parser.next(msg) == mcbp_parser::result::ok);
+  CHECK(msg.body[4] == std::byte{ 2 });
+  CHECK(parser.next(msg) == mcbp_parser::result::need_data);
+  CHECK(parser.bytes_to_parse() == 0);
+}
+
+TEST_CASE("unit: mcbp_parser inflates a snappy value into the caller's buffer", "[unit]")
+{
+  const std::string value(4096, 'z');
+  std::string compressed;
+  snappy::Compress(value.data(), value.size(), &compressed);
+  REQUIRE(compressed.size() < value.size());
+
+  auto header = frame_builder{}
+                  .magic_byte(magic::client_response)
+                  .opcode(0x00)
+                  .extlen(0x04)
+                  .datatype(static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy))
+                  .bodylen(static_cast<std::uint32_t>(4 + compressed.size()))
+                  .bytes;
+  std::vector<std::byte> wire(header.begin(), header.end());
+  wire.insert(wire.end(), 4, std::byte{ 0x07 }); // extras
+  for (auto c : compressed) {
+    wire.push_back(static_cast<std::byte>(c));
+  }
+
+  mcbp_parser parser;
+  parser.feed(wire.begin(), wire.end());
+
+  // a recycled buffer with enough capacity is reused as is
+  mcbp_message msg;
+  msg.body.reserve(8192);
+  const auto* storage = msg.body.data();
+  REQUIRE(parser.next(msg) == mcbp_parser::result::ok);
+  CHECK(msg.body.data() == storage);
+  REQUIRE(msg.body.size() == 4 + value.size());
+  CHECK(couchbase::core::utils::byte_swap(msg.header.bodylen) == 4 + value.size());
+  CHECK(msg.body[0] == std::byte{ 0x07 });
+  CHECK(msg.body[4] == std::byte{ 'z' });
+  CHECK(msg.body.back() == std::byte{ 'z' });
+  CHECK(parser.compressed_bytes == compressed.size());
+  CHECK(parser.decompressed_bytes == value.size());
+}
+
+TEST_CASE("unit: mcbp_parser keeps the raw value when snappy data is corrupt", "[unit]")
+{
+  auto header = frame_builder{}
+                  .magic_byte(magic::client_response)
+                  .opcode(0x00)
+                  .extlen(0x04)
+                  .datatype(static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy))
+                  .bodylen(7)
+                  .bytes;
+  std::vector<std::byte> wire(header.begin(), header.end());
+  wire.insert(wire.end(), 4, std::byte{ 0x00 }); // extras
+  wire.insert(wire.end(), 3, std::byte{ 0xff }); // not a snappy stream
+
+  mcbp_parser parser;
+  parser.feed(wire.begin(), wire.end());
+
+  mcbp_message msg;
+  REQUIRE(parser.next(msg) == mcbp_parser::result::ok);
+  REQUIRE(msg.body.size() == 7);
+  CHECK(couchbase::core::utils::byte_swap(msg.header.bodylen) == 7);
+  CHECK(msg.body[4] == std::byte{ 0xff });
+  CHECK(parser.compressed_bytes == 0);
+}
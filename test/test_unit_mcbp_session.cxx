@@ -225,3 +225,27 @@ TEST_CASE("unit: mcbp_session is not stopped after construction", "[unit]")
   CHECK_FALSE(session.is_bootstrapped());
   stop_and_drain(session, io);
 }
+
+TEST_CASE("unit: only the outermost mcbp_write_batch of a thread is current", "[unit]")
+{
+  using couchbase::core::io::mcbp_write_batch;
+
+  REQUIRE(mcbp_write_batch::current() == nullptr);
+  {
+    const mcbp_write_batch outer{};
+    REQUIRE(mcbp_write_batch::current() == &outer);
+    {
+      const mcbp_write_batch inner{};
+      REQUIRE(mcbp_write_batch::current() == &outer);
+    }
+    REQUIRE(mcbp_write_batch::current() == &outer);
+
+    // other threads are not affected by the batch
+    const mcbp_write_batch* seen_by_other_thread = &outer;
+    std::thread([&seen_by_other_thread] {
+      seen_by_other_thread = mcbp_write_batch::current();
+    }).join();
+    REQUIRE(seen_by_other_thread == nullptr);
+  }
+  REQUIRE(mcbp_write_batch::current() == nullptr);
+}
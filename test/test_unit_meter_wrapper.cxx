@@ -19,15 +19,19 @@
 
 #include "core/cluster_label_listener.hxx"
 #include "core/metrics/meter_wrapper.hxx"
+#include "core/metrics/metric_label.hxx"
 
 #include <couchbase/error_codes.hxx>
 #include <couchbase/metrics/meter.hxx>
 
+#include <atomic>
 #include <chrono>
 #include <map>
 #include <memory>
 #include <string>
 #include <system_error>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 namespace
@@ -173,6 +177,32 @@ TEST_CASE("unit: meter_wrapper record_value routes every value through one cache
   REQUIRE(meter->recorders.begin()->second->values.size() == 4);
 }
 
+TEST_CASE("unit: metric_label interns equal values to the same label", "[unit]")
+{
+  using couchbase::core::metrics::metric_label;
+
+  const std::string bucket{ "travel-sample" };
+  const metric_label from_string{ bucket };
+  const metric_label from_literal{ "travel-sample" };
+  REQUIRE(from_string == from_literal);
+  REQUIRE(from_string.hash() == from_literal.hash());
+  REQUIRE(&from_string.str() == &from_literal.str());
+  REQUIRE(from_string.str() == "travel-sample");
+  REQUIRE(from_string != metric_label{ "beer-sample" });
+  REQUIRE(metric_label{}.empty());
+  REQUIRE(metric_label{} == metric_label{ std::string{} });
+
+  // other threads get the same labels, whatever they interned first
+  metric_label other_thread_label{};
+  std::thread([&other_thread_label]() {
+    for (int i = 0; i < 1'000; ++i) {
+      std::ignore = metric_label{ "op-" + std::to_string(i) };
+    }
+    other_thread_label = metric_label{ "travel-sample" };
+  }).join();
+  REQUIRE(other_thread_label == from_literal);
+}
+
 TEST_CASE("unit: standardized_error_type classifies by category, not raw value", "[unit]")
 {
   using couchbase::core::metrics::standardized_error_type;
@@ -200,3 +230,67 @@ TEST_CASE("unit: meter_wrapper record_value tolerates a null cluster-label liste
   REQUIRE(meter->recorders.size() == 1);
   REQUIRE(meter->recorders.begin()->second->values.size() == 1);
 }
+
+TEST_CASE("unit: standardized_error_type names a Couchbase error the same way on every use",
+          "[unit]")
+{
+  using couchbase::core::metrics::standardized_error_type;
+
+  for (int i = 0; i < 3; ++i) {
+    REQUIRE(standardized_error_type(couchbase::errc::key_value::document_not_found) ==
+            "DocumentNotFound");
+    REQUIRE(standardized_error_type(couchbase::errc::common::unambiguous_timeout) ==
+            "UnambiguousTimeout");
+    REQUIRE(standardized_error_type(couchbase::errc::field_level_encryption::
+                                      generic_cryptography_failure) == "CryptoError");
+  }
+}
+
+TEST_CASE("unit: meter_wrapper instances do not share recorders through the thread cache",
+          "[unit]")
+{
+  // Both wrappers are used from this one thread with equal attributes, so they land on the same
+  // slot of the per-thread cache; each must still be served the recorder of its own meter.
+  auto first_meter = std::make_shared<counting_meter>();
+  auto second_meter = std::make_shared<counting_meter>();
+  couchbase::core::metrics::meter_wrapper first{ first_meter, nullptr };
+  couchbase::core::metrics::meter_wrapper second{ second_meter, nullptr };
+
+  const auto attrs = kv_attributes("get");
+  for (int i = 0; i < 3; ++i) {
+    first.value_recorder_for(attrs)->record_value(i);
+    second.value_recorder_for(attrs)->record_value(i);
+  }
+
+  REQUIRE(first_meter->get_value_recorder_calls == 1);
+  REQUIRE(second_meter->get_value_recorder_calls == 1);
+  REQUIRE(first_meter->recorders.begin()->second->values.size() == 3);
+  REQUIRE(second_meter->recorders.begin()->second->values.size() == 3);
+}
+
+TEST_CASE("unit: meter_wrapper resolves one recorder for values recorded from many threads",
+          "[unit]")
+{
+  auto meter = std::make_shared<counting_meter>();
+  couchbase::core::metrics::meter_wrapper wrapper{ meter, nullptr };
+  const auto attrs = kv_attributes("get");
+  auto recorder = wrapper.value_recorder_for(attrs);
+
+  std::vector<std::thread> threads{};
+  std::atomic_int mismatches{ 0 };
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 1000; ++i) {
+        if (wrapper.value_recorder_for(attrs) != recorder) {
+          ++mismatches;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(mismatches == 0);
+  REQUIRE(meter->get_value_recorder_calls == 1);
+}
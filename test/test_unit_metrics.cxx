@@ -17,16 +17,28 @@
 
 #include "test_helper.hxx"
 
+#include "core/diagnostics.hxx"
+#include "core/metrics/connection_stats_openmetrics.hxx"
 #include "core/metrics/constants.hxx"
 #include "core/metrics/logging_meter.hxx"
 #include "core/metrics/logging_meter_options.hxx"
 #include "core/metrics/meter_wrapper.hxx"
+#include "core/metrics/openmetrics_writer.hxx"
 #include "core/tracing/constants.hxx"
+#include "core/utils/json.hxx"
 
+#include <catch2/catch_approx.hpp>
 #include <couchbase/error_codes.hxx>
 #include <spdlog/fmt/bundled/printf.h>
 
 #include <asio/io_context.hpp>
+#include <tao/json/value.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
 
 TEST_CASE("unit: metric attributes encoding", "[unit]")
 {
@@ -136,12 +148,12 @@ TEST_CASE("unit: logging_meter get_value_recorder", "[unit]")
     { couchbase::core::tracing::attributes::op::operation_name, "n1ql_query" },
   };
 
-  SECTION("returns noop recorder for unknown meter name")
+  SECTION("returns a counter for a meter other than the operation durations")
   {
     auto recorder = meter->get_value_recorder("unknown.meter", kv_get_tags);
     REQUIRE(recorder != nullptr);
-    // noop recorder is returned — recording should not throw
     recorder->record_value(42);
+    REQUIRE(meter->get_value_recorder("unknown.meter", kv_get_tags) == recorder);
   }
 
   SECTION("returns noop recorder when service tag is missing")
@@ -207,3 +219,255 @@ TEST_CASE("unit: logging_meter get_value_recorder", "[unit]")
     REQUIRE(kv_recorder != query_recorder);
   }
 }
+
+TEST_CASE("unit: logging_meter report merges the values recorded by every thread", "[unit]")
+{
+  asio::io_context ctx{};
+  couchbase::core::metrics::logging_meter_options options{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(ctx, options);
+
+  const std::map<std::string, std::string> kv_get_tags{
+    { couchbase::core::tracing::attributes::op::service,
+      couchbase::core::tracing::service::key_value },
+    { couchbase::core::tracing::attributes::op::operation_name, "get" },
+  };
+  auto recorder =
+    meter->get_value_recorder(couchbase::core::metrics::operation_meter_name, kv_get_tags);
+
+  // more threads than shards, each of them recording 1ms to 100ms
+  constexpr std::size_t number_of_threads{ 12 };
+  std::vector<std::thread> threads{};
+  threads.reserve(number_of_threads);
+  for (std::size_t i = 0; i < number_of_threads; ++i) {
+    threads.emplace_back([&recorder]() {
+      for (std::int64_t ms = 1; ms <= 100; ++ms) {
+        recorder->record_value(ms * 1'000);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto report = meter->build_report();
+  INFO(couchbase::core::utils::json::generate(report));
+  const auto& get = report.at("operations").at("kv").at("get");
+  REQUIRE(get.at("total_count").as<std::uint64_t>() == number_of_threads * 100);
+  const auto& percentiles = get.at("percentiles_us");
+  REQUIRE(percentiles.at("50.0").as<std::int64_t>() == Catch::Approx(50'000).epsilon(0.01));
+  REQUIRE(percentiles.at("90.0").as<std::int64_t>() == Catch::Approx(90'000).epsilon(0.01));
+  REQUIRE(percentiles.at("100.0").as<std::int64_t>() == Catch::Approx(100'000).epsilon(0.01));
+
+  // the next report only covers what was recorded since
+  recorder->record_value(5'000);
+  report = meter->build_report();
+  REQUIRE(report.at("operations").at("kv").at("get").at("total_count").as<std::uint64_t>() == 1);
+}
+
+TEST_CASE("unit: logging_meter reports do not lose values recorded while they run", "[unit]")
+{
+  asio::io_context ctx{};
+  couchbase::core::metrics::logging_meter_options options{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(ctx, options);
+
+  const std::map<std::string, std::string> kv_get_tags{
+    { couchbase::core::tracing::attributes::op::service,
+      couchbase::core::tracing::service::key_value },
+    { couchbase::core::tracing::attributes::op::operation_name, "get" },
+  };
+  auto recorder =
+    meter->get_value_recorder(couchbase::core::metrics::operation_meter_name, kv_get_tags);
+
+  const auto reported_count = [&meter]() -> std::uint64_t {
+    auto report = meter->build_report();
+    const auto* operations = report.find("operations");
+    if (operations == nullptr) {
+      return 0;
+    }
+    return operations->at("kv").at("get").at("total_count").as<std::uint64_t>();
+  };
+
+  constexpr std::size_t number_of_threads{ 12 };
+  constexpr std::size_t values_per_thread{ 20'000 };
+  std::atomic_bool recording{ true };
+  std::uint64_t total{ 0 };
+  std::thread reporter([&recording, &total, &reported_count]() {
+    while (recording.load()) {
+      total += reported_count();
+    }
+  });
+
+  std::vector<std::thread> threads{};
+  threads.reserve(number_of_threads);
+  for (std::size_t i = 0; i < number_of_threads; ++i) {
+    threads.emplace_back([&recorder]() {
+      for (std::size_t n = 0; n < values_per_thread; ++n) {
+        recorder->record_value(static_cast<std::int64_t>(n % 1'000 + 1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  recording = false;
+  reporter.join();
+
+  total += reported_count();
+  REQUIRE(total == number_of_threads * values_per_thread);
+}
+
+TEST_CASE("unit: openmetrics_writer escapes label values and sanitizes names", "[unit]")
+{
+  couchbase::core::metrics::openmetrics_writer writer{};
+  writer.gauge_family("db.couchbase.connections", "Open \"connections\"");
+  writer.gauge({ { "couchbase.node", "a\\b\n" } }, 3);
+  auto exposition = std::move(writer).finish();
+
+  REQUIRE(exposition == "# TYPE db_couchbase_connections gauge\n"
+                        "# HELP db_couchbase_connections Open \\\"connections\\\"\n"
+                        "db_couchbase_connections{couchbase_node=\"a\\\\b\\n\"} 3.0\n"
+                        "# EOF\n");
+  REQUIRE(couchbase::core::metrics::openmetrics_writer::sanitize_name("9lives-total") ==
+          "_lives_total");
+}
+
+TEST_CASE("unit: openmetrics_writer spells infinities and NaN the OpenMetrics way", "[unit]")
+{
+  couchbase::core::metrics::openmetrics_writer writer{};
+  writer.histogram_family("latency", "Latency");
+  writer.histogram({}, { { 0.5, 1 }, { std::numeric_limits<double>::infinity(), 2 } }, 1.5, 2);
+  writer.gauge_family("extremes", "Extremes");
+  writer.gauge({ { "kind", "low" } }, -std::numeric_limits<double>::infinity());
+  writer.gauge({ { "kind", "none" } }, std::numeric_limits<double>::quiet_NaN());
+  auto exposition = std::move(writer).finish();
+
+  REQUIRE(exposition == "# TYPE latency histogram\n"
+                        "# HELP latency Latency\n"
+                        "latency_bucket{le=\"0.5\"} 1\n"
+                        "latency_bucket{le=\"+Inf\"} 2\n"
+                        "latency_sum 1.5\n"
+                        "latency_count 2\n"
+                        "# TYPE extremes gauge\n"
+                        "# HELP extremes Extremes\n"
+                        "extremes{kind=\"low\"} -Inf\n"
+                        "extremes{kind=\"none\"} NaN\n"
+                        "# EOF\n");
+}
+
+TEST_CASE("unit: logging_meter renders the OpenMetrics exposition", "[unit]")
+{
+  asio::io_context ctx{};
+  couchbase::core::metrics::logging_meter_options options{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(ctx, options);
+
+  const std::map<std::string, std::string> kv_get_tags{
+    { couchbase::core::tracing::attributes::op::service,
+      couchbase::core::tracing::service::key_value },
+    { couchbase::core::tracing::attributes::op::operation_name, "get" },
+  };
+  auto get_recorder =
+    meter->get_value_recorder(couchbase::core::metrics::operation_meter_name, kv_get_tags);
+  get_recorder->record_value(200);    // 0.2ms
+  get_recorder->record_value(3'000);  // 3ms
+  get_recorder->record_value(20'000); // 20ms
+
+  const std::map<std::string, std::string> retry_tags{
+    { couchbase::core::tracing::attributes::op::service,
+      couchbase::core::tracing::service::key_value },
+    { couchbase::core::tracing::attributes::op::retry_reason, "kv_locked" },
+  };
+  auto retry_recorder =
+    meter->get_value_recorder(couchbase::core::metrics::retry_meter_name, retry_tags);
+  retry_recorder->record_value(1);
+  retry_recorder->record_value(1);
+
+  auto render = [&meter]() {
+    couchbase::core::metrics::openmetrics_writer writer{};
+    meter->write_openmetrics(writer);
+    return std::move(writer).finish();
+  };
+  auto contains = [](const std::string& exposition, const std::string& line) {
+    return exposition.find(line + "\n") != std::string::npos;
+  };
+
+  auto exposition = render();
+  INFO(exposition);
+  REQUIRE(contains(exposition, "# TYPE db_client_operation_duration_seconds histogram"));
+  REQUIRE(contains(exposition,
+                   R"(db_client_operation_duration_seconds_bucket{couchbase_service="kv",)"
+                   R"(db_operation_name="get",le="0.00025"} 1)"));
+  REQUIRE(contains(exposition,
+                   R"(db_client_operation_duration_seconds_bucket{couchbase_service="kv",)"
+                   R"(db_operation_name="get",le="0.005"} 2)"));
+  REQUIRE(contains(exposition,
+                   R"(db_client_operation_duration_seconds_bucket{couchbase_service="kv",)"
+                   R"(db_operation_name="get",le="+Inf"} 3)"));
+  REQUIRE(contains(exposition,
+                   R"(db_client_operation_duration_seconds_count{couchbase_service="kv",)"
+                   R"(db_operation_name="get"} 3)"));
+  REQUIRE(contains(exposition, "# TYPE db_couchbase_operation_retries counter"));
+  REQUIRE(contains(exposition,
+                   R"(db_couchbase_operation_retries_total{couchbase_retry_reason="kv_locked",)"
+                   R"(couchbase_service="kv"} 2)"));
+  REQUIRE(exposition.size() >= 6);
+  REQUIRE(exposition.compare(exposition.size() - 6, 6, "# EOF\n") == 0);
+
+  // a scrape does not reset the values, later ones include everything recorded so far
+  get_recorder->record_value(20'000);
+  auto next_exposition = render();
+  REQUIRE(contains(next_exposition,
+                   R"(db_client_operation_duration_seconds_count{couchbase_service="kv",)"
+                   R"(db_operation_name="get"} 4)"));
+}
+
+TEST_CASE("unit: connection statistics are rendered as OpenMetrics families", "[unit]")
+{
+  couchbase::core::diag::connection_stats_result stats{};
+  {
+    couchbase::core::diag::endpoint_connection_stats kv{};
+    kv.type = couchbase::core::service_type::key_value;
+    kv.id = "0xcafe";
+    kv.remote = "192.168.1.2:11210";
+    kv.bucket = "travel-sample";
+    kv.bytes_sent = 4096;
+    kv.in_flight = 12;
+    kv.opaque_overflow_spills = 3;
+    stats.services[kv.type].push_back(kv);
+  }
+  {
+    couchbase::core::diag::endpoint_connection_stats query{};
+    query.type = couchbase::core::service_type::query;
+    query.id = "0xbeef";
+    query.remote = "192.168.1.2:8093";
+    query.in_flight = 1;
+    stats.services[query.type].push_back(query);
+  }
+
+  couchbase::core::metrics::openmetrics_writer writer{};
+  couchbase::core::metrics::write_connection_stats(writer, stats);
+  auto exposition = std::move(writer).finish();
+  INFO(exposition);
+
+  auto contains = [&exposition](const std::string& line) {
+    return exposition.find(line + "\n") != std::string::npos;
+  };
+  REQUIRE(contains("# TYPE db_couchbase_connection_sent_bytes counter"));
+  REQUIRE(contains(R"(db_couchbase_connection_sent_bytes_total{couchbase_local_id="0xcafe",)"
+                   R"(couchbase_service="kv",db_namespace="travel-sample",)"
+                   R"(network_peer_address="192.168.1.2:11210"} 4096)"));
+  REQUIRE(contains(R"(db_couchbase_connection_opaque_overflow_spills_total{)"
+                   R"(couchbase_local_id="0xcafe",couchbase_service="kv",)"
+                   R"(db_namespace="travel-sample",network_peer_address="192.168.1.2:11210"} 3)"));
+  REQUIRE(contains("# TYPE db_couchbase_connection_in_flight gauge"));
+  REQUIRE(contains(R"(db_couchbase_connection_in_flight{couchbase_local_id="0xbeef",)"
+                   R"(couchbase_service="query",network_peer_address="192.168.1.2:8093"} 1.0)"));
+
+  // each family is written once, with the samples of every connection under it
+  std::size_t families{ 0 };
+  for (auto pos = exposition.find("# TYPE db_couchbase_connection_in_flight ");
+       pos != std::string::npos;
+       pos = exposition.find("# TYPE db_couchbase_connection_in_flight ", pos + 1)) {
+    ++families;
+  }
+  REQUIRE(families == 1);
+}
@@ -112,6 +112,35 @@ TEST_CASE("unit: opaque_ring_table routes ring-colliding opaques independently",
   REQUIRE(b == 2);
 }
 
+TEST_CASE("unit: opaque_ring_table counts registered handlers and overflow spills", "[unit]")
+{
+  table t;
+  REQUIRE(t.size() == 0);
+  REQUIRE(t.overflow_spills() == 0);
+
+  t.insert(5, [](int) {
+  });
+  t.insert(6, [](int) {
+  });
+  REQUIRE(t.size() == 2);
+  REQUIRE(t.overflow_spills() == 0);
+
+  t.insert(5 + ring_size, [](int) {
+  });
+  REQUIRE(t.size() == 3);
+  REQUIRE(t.overflow_spills() == 1);
+
+  REQUIRE(static_cast<bool>(t.take(5 + ring_size)));
+  REQUIRE(static_cast<bool>(t.take(5)));
+  REQUIRE_FALSE(static_cast<bool>(t.take(5)));
+  REQUIRE(t.size() == 1);
+
+  // the spills are a running total, they are not undone when the entries are taken
+  REQUIRE(t.overflow_spills() == 1);
+  REQUIRE(t.drain().size() == 1);
+  REQUIRE(t.size() == 0);
+}
+
 TEST_CASE("unit: opaque_ring_table same-slot guard keeps the first handler for a duplicate opaque",
           "[unit]")
 {
@@ -0,0 +1,149 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/opaque_slab.hxx"
+
+#include <cstdint>
+#include <memory>
+#include <set>
+
+namespace
+{
+using entry = std::shared_ptr<int>;
+using slab = couchbase::core::io::opaque_slab<entry>;
+} // namespace
+
+TEST_CASE("unit: opaque_slab stores, finds and takes an entry once", "[unit]")
+{
+  slab s{ 16 };
+  s.insert(42, std::make_shared<int>(7));
+  REQUIRE(s.size() == 1);
+
+  auto* found = s.find(42);
+  REQUIRE(found != nullptr);
+  REQUIRE(**found == 7);
+  // finding does not remove, which is what persistent requests rely on
+  REQUIRE(s.find(42) != nullptr);
+
+  auto taken = s.take(42);
+  REQUIRE(taken);
+  REQUIRE(*taken == 7);
+  REQUIRE(s.size() == 0);
+  REQUIRE(s.find(42) == nullptr);
+  REQUIRE_FALSE(s.take(42));
+}
+
+TEST_CASE("unit: opaque_slab does not hand out an entry for a stale opaque", "[unit]")
+{
+  slab s{ 16 };
+  s.insert(3, std::make_shared<int>(3));
+  // same slot, different generation
+  REQUIRE(s.find(3 + 16) == nullptr);
+  REQUIRE_FALSE(s.take(3 + 16));
+  REQUIRE(s.size() == 1);
+}
+
+TEST_CASE("unit: opaque_slab reuses slots as opaques advance", "[unit]")
+{
+  slab s{ 16 };
+  for (std::uint32_t opaque = 1; opaque < 1000; ++opaque) {
+    s.insert(opaque, std::make_shared<int>(static_cast<int>(opaque)));
+    if (opaque > 8) {
+      REQUIRE(*s.take(opaque - 8) == static_cast<int>(opaque - 8));
+    }
+  }
+  // eight operations in flight at any time never need more than the initial slots
+  REQUIRE(s.capacity() == 16);
+  REQUIRE(s.size() == 8);
+}
+
+TEST_CASE("unit: opaque_slab spills colliding opaques to the overflow map", "[unit]")
+{
+  slab s{ 16 };
+  // every one of these lands on slot 0
+  for (std::uint32_t i = 1; i <= 5; ++i) {
+    s.insert(i << 20U, std::make_shared<int>(static_cast<int>(i)));
+  }
+  REQUIRE(s.capacity() == 16);
+  REQUIRE(s.size() == 5);
+  REQUIRE(s.overflow_spills() == 4);
+
+  for (std::uint32_t i = 1; i <= 5; ++i) {
+    auto* found = s.find(i << 20U);
+    REQUIRE(found != nullptr);
+    REQUIRE(**found == static_cast<int>(i));
+  }
+  // taking the one in the slot leaves the spilled ones reachable
+  REQUIRE(*s.take(1U << 20U) == 1);
+  for (std::uint32_t i = 2; i <= 5; ++i) {
+    REQUIRE(*s.take(i << 20U) == static_cast<int>(i));
+  }
+  REQUIRE(s.size() == 0);
+  REQUIRE(s.find(3U << 20U) == nullptr);
+}
+
+TEST_CASE("unit: opaque_slab stays bounded while a persistent entry holds its slot", "[unit]")
+{
+  slab s{ 16 };
+  s.insert(1, std::make_shared<int>(1));
+
+  constexpr std::uint32_t laps = 10'000;
+  constexpr std::uint32_t in_flight = 8;
+  for (std::uint32_t opaque = 2; opaque < laps * 16; ++opaque) {
+    s.insert(opaque, std::make_shared<int>(static_cast<int>(opaque)));
+    if (opaque >= 2 + in_flight) {
+      const auto oldest = opaque - in_flight;
+      REQUIRE(*s.take(oldest) == static_cast<int>(oldest));
+    }
+    // the persistent entry is never taken, only found
+    REQUIRE(s.find(1) != nullptr);
+  }
+
+  REQUIRE(s.capacity() == 16);
+  REQUIRE(s.size() == 1 + in_flight);
+  REQUIRE(**s.find(1) == 1);
+  // once per lap the counter lands on the held slot
+  REQUIRE(s.overflow_spills() >= laps - 1);
+  REQUIRE(s.overflow_spills() <= laps);
+}
+
+TEST_CASE("unit: opaque_slab caps its capacity", "[unit]")
+{
+  const slab s{ slab::max_capacity * 4 };
+  REQUIRE(s.capacity() == slab::max_capacity);
+}
+
+TEST_CASE("unit: opaque_slab drains every entry", "[unit]")
+{
+  slab s{ 16 };
+  s.insert(5, std::make_shared<int>(5));
+  s.insert(21, std::make_shared<int>(21));
+  s.insert(6, std::make_shared<int>(6));
+
+  auto drained = s.drain();
+  REQUIRE(drained.size() == 3);
+  std::set<std::uint32_t> opaques{};
+  for (const auto& [opaque, value] : drained) {
+    REQUIRE(*value == static_cast<int>(opaque));
+    opaques.insert(opaque);
+  }
+  REQUIRE(opaques == std::set<std::uint32_t>{ 5, 6, 21 });
+  REQUIRE(s.size() == 0);
+  REQUIRE(s.find(5) == nullptr);
+}
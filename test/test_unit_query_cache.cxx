@@ -0,0 +1,188 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/query_cache.hxx"
+#include "core/metrics/constants.hxx"
+#include "core/metrics/meter_wrapper.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using couchbase::core::query_cache;
+
+namespace
+{
+class collecting_value_recorder : public couchbase::metrics::value_recorder
+{
+public:
+  void record_value(std::int64_t value) override
+  {
+    const std::scoped_lock lock(mutex_);
+    values_.push_back(value);
+  }
+
+  auto values() -> std::vector<std::int64_t>
+  {
+    const std::scoped_lock lock(mutex_);
+    return values_;
+  }
+
+private:
+  std::mutex mutex_{};
+  std::vector<std::int64_t> values_{};
+};
+
+class collecting_meter : public couchbase::metrics::meter
+{
+public:
+  std::map<std::string, std::shared_ptr<collecting_value_recorder>> recorders{};
+
+  auto get_value_recorder(const std::string& name,
+                          const std::map<std::string, std::string>& /* tags */)
+    -> std::shared_ptr<couchbase::metrics::value_recorder> override
+  {
+    auto& recorder = recorders[name];
+    if (!recorder) {
+      recorder = std::make_shared<collecting_value_recorder>();
+    }
+    return recorder;
+  }
+};
+
+auto
+sum(const std::vector<std::int64_t>& values) -> std::int64_t
+{
+  return std::accumulate(values.begin(), values.end(), std::int64_t{ 0 });
+}
+} // namespace
+
+TEST_CASE("unit: query_cache returns what was put", "[unit]")
+{
+  query_cache cache;
+  cache.put("SELECT 1", "p1");
+  cache.put("SELECT 2", "p2", "plan2");
+
+  auto first = cache.get("SELECT 1");
+  REQUIRE(first.has_value());
+  REQUIRE(first->name == "p1");
+  REQUIRE_FALSE(first->plan.has_value());
+
+  auto second = cache.get("SELECT 2");
+  REQUIRE(second.has_value());
+  REQUIRE(second->name == "p2");
+  REQUIRE(second->plan == "plan2");
+
+  // the first entry for a statement wins
+  cache.put("SELECT 1", "other");
+  REQUIRE(cache.get("SELECT 1")->name == "p1");
+
+  cache.erase("SELECT 1");
+  REQUIRE_FALSE(cache.get("SELECT 1").has_value());
+
+  auto stats = cache.stats();
+  REQUIRE(stats.hits == 3);
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.evictions == 0);
+}
+
+TEST_CASE("unit: query_cache does not grow past its capacity", "[unit]")
+{
+  query_cache cache{ 64 };
+  for (int i = 0; i < 1000; ++i) {
+    cache.put("SELECT " + std::to_string(i), "p" + std::to_string(i));
+  }
+  REQUIRE(cache.size() <= 64);
+  REQUIRE(cache.stats().evictions == 1000 - cache.size());
+
+  cache.set_capacity(16);
+  REQUIRE(cache.capacity() == 16);
+  REQUIRE(cache.size() <= 16);
+  REQUIRE(cache.stats().evictions == 1000 - cache.size());
+}
+
+TEST_CASE("unit: query_cache smaller than its shard count keeps to its capacity", "[unit]")
+{
+  query_cache cache{ 1 };
+  for (int i = 0; i < 100; ++i) {
+    cache.put("SELECT " + std::to_string(i), "p" + std::to_string(i));
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.get("SELECT " + std::to_string(i)).has_value());
+  }
+
+  cache.set_capacity(5);
+  for (int i = 0; i < 100; ++i) {
+    cache.put("SELECT " + std::to_string(i), "p" + std::to_string(i));
+    REQUIRE(cache.size() <= 5);
+  }
+
+  // statements move to their new shards, so they are still found after a resize
+  cache.set_capacity(64);
+  for (int i = 0; i < 100; ++i) {
+    const auto statement = "SELECT " + std::to_string(i);
+    if (cache.get(statement).has_value()) {
+      cache.erase(statement);
+      REQUIRE_FALSE(cache.get(statement).has_value());
+    }
+  }
+  REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("unit: query_cache evicts the least recently used statement", "[unit]")
+{
+  query_cache cache{ 32 };
+  cache.put("SELECT 'keep'", "keep");
+  for (int i = 0; i < 1000; ++i) {
+    cache.put("SELECT " + std::to_string(i), "p" + std::to_string(i));
+    REQUIRE(cache.get("SELECT 'keep'").has_value());
+  }
+}
+
+TEST_CASE("unit: query_cache reports evictions to the meter once per batch", "[unit]")
+{
+  auto meter = std::make_shared<collecting_meter>();
+  query_cache cache{ 64 };
+  cache.set_meter(couchbase::core::metrics::meter_wrapper::create(meter, nullptr));
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.put("SELECT " + std::to_string(i), "p" + std::to_string(i));
+  }
+  REQUIRE(cache.get("SELECT 999").has_value());
+  REQUIRE_FALSE(cache.get("SELECT 'missing'").has_value());
+
+  auto& evictions = meter->recorders[couchbase::core::metrics::query_cache_eviction_meter_name];
+  REQUIRE(sum(evictions->values()) == static_cast<std::int64_t>(cache.stats().evictions));
+  REQUIRE(meter->recorders[couchbase::core::metrics::query_cache_hit_meter_name]->values() ==
+          std::vector<std::int64_t>{ 1 });
+  REQUIRE(meter->recorders[couchbase::core::metrics::query_cache_miss_meter_name]->values() ==
+          std::vector<std::int64_t>{ 1 });
+
+  // shrinking evicts statements of every shard, and records them as one value
+  const auto recorded_before_resize = evictions->values().size();
+  cache.set_capacity(16);
+  const auto values = evictions->values();
+  REQUIRE(values.size() - recorded_before_resize == 1);
+  REQUIRE(sum(values) == static_cast<std::int64_t>(cache.stats().evictions));
+}
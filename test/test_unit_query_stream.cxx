@@ -416,3 +416,74 @@ TEST_CASE("unit: a mid-stream query terminal error is reported with the request
   REQUIRE(reported.at("first_error_code").as<std::uint64_t>() == 5000);
   REQUIRE(reported.at("first_error_message").as<std::string>() == "boom");
 }
+
+TEST_CASE("unit: query_stream next_rows drains the stream in batches", "[unit]")
+{
+  asio::io_context io;
+  std::string doc = R"({"requestID":"r","results":[{"a":1},{"a":2},{"a":3}],)"
+                    R"("status":"fatal","errors":[{"code":5000,"msg":"boom"}]})";
+  auto body = test::utils::make_cached_response_body(io, doc);
+  couchbase::core::query_stream stream{ io, std::move(body) };
+
+  std::vector<std::string> rows;
+  std::error_code end_ec{};
+  int terminals = 0;
+  std::function<void()> pump = [&]() {
+    stream.next_rows(2, 1024, [&](couchbase::core::row_batch batch, std::error_code ec) {
+      if (batch.empty()) {
+        end_ec = ec;
+        // The terminal is sticky for batched pulls too.
+        if (++terminals < 3) {
+          pump();
+        }
+        return;
+      }
+      REQUIRE(batch.size() <= 2);
+      for (std::size_t i = 0; i < batch.size(); ++i) {
+        rows.emplace_back(batch[i]);
+      }
+      pump();
+    });
+  };
+  stream.start([&](std::error_code) {
+    pump();
+  });
+  io.run();
+
+  REQUIRE(rows.size() == 3);
+  REQUIRE(rows[2] == R"({"a":3})");
+  REQUIRE(end_ec); // trailing error delivered after the last batch
+  REQUIRE(terminals == 3);
+}
+
+TEST_CASE("unit: query_stream buffered replay next_rows honours the batch limits", "[unit]")
+{
+  asio::io_context io;
+  couchbase::core::operations::query_response::query_meta_data meta{};
+  meta.status = "success";
+  const std::vector<std::string> rows{ R"({"a":1})", R"({"a":2})", R"({"a":3})" };
+  couchbase::core::query_stream stream{ io, rows, meta };
+
+  std::vector<std::size_t> batch_sizes;
+  std::vector<std::string> drained;
+  std::error_code end_ec{ make_error_code(std::errc::operation_in_progress) };
+  std::function<void()> pump = [&]() {
+    stream.next_rows(2, 1024, [&](couchbase::core::row_batch batch, std::error_code ec) {
+      if (batch.empty()) {
+        end_ec = ec;
+        return;
+      }
+      batch_sizes.push_back(batch.size());
+      for (std::size_t i = 0; i < batch.size(); ++i) {
+        drained.emplace_back(batch[i]);
+      }
+      pump();
+    });
+  };
+  pump();
+  io.run();
+
+  REQUIRE(batch_sizes == std::vector<std::size_t>{ 2, 1 });
+  REQUIRE(drained == rows);
+  REQUIRE(!end_ec);
+}
@@ -32,6 +32,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <tao/json/value.hpp>
 
+#include <string>
+#include <vector>
+
 namespace ops = couchbase::core::operations;
 
 TEST_CASE("unit: parse_query_meta extracts fields from a query response", "[unit]")
@@ -203,3 +206,47 @@ TEST_CASE("unit: encode_analytics_options quotes the query context", "[unit][sec
     REQUIRE(body.at("query_context").get_string() == "default:`bkt`.`scp`");
   }
 }
+
+TEST_CASE("unit: query make_response keeps rows verbatim and parses the metadata", "[unit]")
+{
+  ops::query_request req{ "SELECT 1" };
+  couchbase::core::io::http_response encoded{};
+  encoded.status_code = 200;
+
+  SECTION("rows are sliced out of the body as they were sent")
+  {
+    encoded.body.append(R"({"requestID":"r","results":[{"b":2,"a":[1, 2]},"x",null],)"
+                        R"("status":"success","metrics":{"resultCount":3,"resultSize":30,)"
+                        R"("elapsedTime":"1ms","executionTime":"1ms"}})");
+    auto resp = req.make_response({}, encoded);
+
+    REQUIRE_FALSE(resp.ctx.ec);
+    REQUIRE(resp.rows == std::vector<std::string>{ R"({"b":2,"a":[1, 2]})", R"("x")", "null" });
+    REQUIRE(resp.meta.request_id == "r");
+    REQUIRE(resp.meta.metrics.has_value());
+    REQUIRE(resp.meta.metrics->result_count == 3);
+  }
+
+  SECTION("a truncated body is a parsing failure")
+  {
+    encoded.body.append(R"({"requestID":"r","results":[{"a":1},)");
+    auto resp = req.make_response({}, encoded);
+
+    REQUIRE(resp.ctx.ec == couchbase::errc::common::parsing_failure);
+  }
+}
+
+TEST_CASE("unit: analytics make_response keeps rows verbatim and parses the metadata", "[unit]")
+{
+  ops::analytics_request req{};
+  req.statement = "SELECT 1";
+  couchbase::core::io::http_response encoded{};
+  encoded.status_code = 200;
+  encoded.body.append(R"({"requestID":"r","results":[ { "a": 1 } ],"status":"success"})");
+
+  auto resp = req.make_response({}, encoded);
+
+  REQUIRE_FALSE(resp.ctx.ec);
+  REQUIRE(resp.rows == std::vector<std::string>{ R"({ "a": 1 })" });
+  REQUIRE(resp.meta.status == ops::analytics_response::analytics_status::success);
+}
@@ -22,6 +22,7 @@
 
 #include <asio/io_context.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 #include <chrono>
 #include <functional>
@@ -419,3 +420,52 @@ TEST_CASE("unit: row_streamer cancel wins over an armed idle timer", "[unit]")
   REQUIRE(ended);
   REQUIRE(end_ec == couchbase::errc::common::request_canceled);
 }
+
+TEST_CASE("unit: row_streamer next_rows batches rows within the row and byte limits", "[unit]")
+{
+  asio::io_context io;
+  std::string doc = R"({"results":[)";
+  for (int i = 0; i < 10; ++i) {
+    doc += (i == 0 ? "" : ",") + std::string{ R"({"a":)" } + std::to_string(i) + "}";
+  }
+  doc += R"(],"status":"success"})";
+  const std::size_t max_rows = GENERATE(std::size_t{ 4 }, std::size_t{ 100 });
+  const std::size_t max_bytes = GENERATE(std::size_t{ 1 }, std::size_t{ 1024 });
+  auto body = test::utils::make_cached_response_body(io, doc);
+  couchbase::core::row_streamer streamer{ io, std::move(body), "/results/^" };
+
+  std::vector<std::string> rows;
+  std::vector<std::size_t> batch_sizes;
+  std::error_code end_ec{ make_error_code(std::errc::operation_in_progress) };
+  std::function<void()> pump = [&]() {
+    streamer.next_rows(max_rows,
+                       max_bytes,
+                       [&](couchbase::core::row_batch batch, std::error_code ec) {
+                         if (ec || batch.empty()) {
+                           end_ec = ec;
+                           return;
+                         }
+                         batch_sizes.push_back(batch.size());
+                         for (std::size_t i = 0; i < batch.size(); ++i) {
+                           rows.emplace_back(batch[i]);
+                         }
+                         pump();
+                       });
+  };
+  streamer.start([&](std::string, std::error_code) {
+    pump();
+  });
+  io.run();
+
+  REQUIRE(rows.size() == 10);
+  REQUIRE(rows.front() == R"({"a":0})");
+  REQUIRE(rows.back() == R"({"a":9})");
+  for (auto size : batch_sizes) {
+    REQUIRE(size >= 1);
+    REQUIRE(size <= max_rows);
+    if (max_bytes == 1) {
+      REQUIRE(size == 1); // the first row always goes out, but closes the batch on its own
+    }
+  }
+  REQUIRE(!end_ec); // the end arrives after the last batch, clean
+}
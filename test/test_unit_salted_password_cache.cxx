@@ -0,0 +1,142 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/sasl/scram-sha/salted_password_cache.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using couchbase::core::sasl::Mechanism;
+using couchbase::core::sasl::mechanism::scram::locked_secret;
+using couchbase::core::sasl::mechanism::scram::salted_password_cache;
+
+TEST_CASE("unit: salted_password_cache derives once per credential", "[unit]")
+{
+  salted_password_cache cache{};
+  int calls{ 0 };
+  auto derive = [&calls]() {
+    ++calls;
+    return std::string{ "salted" };
+  };
+
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA512, "alice", "secret", "salt", 4096, derive) == "salted");
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA512, "alice", "secret", "salt", 4096, derive) == "salted");
+  REQUIRE(calls == 1);
+  REQUIRE(cache.size() == 1);
+
+  // any part of the key, and the password itself, selects a different value
+  cache.get(Mechanism::SCRAM_SHA256, "alice", "secret", "salt", 4096, derive);
+  cache.get(Mechanism::SCRAM_SHA512, "bob", "secret", "salt", 4096, derive);
+  cache.get(Mechanism::SCRAM_SHA512, "alice", "secret", "pepper", 4096, derive);
+  cache.get(Mechanism::SCRAM_SHA512, "alice", "secret", "salt", 8192, derive);
+  REQUIRE(calls == 5);
+  cache.get(Mechanism::SCRAM_SHA512, "alice", "changed", "salt", 4096, derive);
+  REQUIRE(calls == 6);
+  REQUIRE(cache.size() == 5);
+
+  cache.clear();
+  REQUIRE(cache.size() == 0);
+  cache.get(Mechanism::SCRAM_SHA512, "alice", "changed", "salt", 4096, derive);
+  REQUIRE(calls == 7);
+}
+
+TEST_CASE("unit: salted_password_cache evicts the least recently used entry", "[unit]")
+{
+  salted_password_cache cache{ 2 };
+  int calls{ 0 };
+  auto derive = [&calls]() {
+    ++calls;
+    return std::to_string(calls);
+  };
+
+  cache.get(Mechanism::SCRAM_SHA512, "a", "pw", "salt", 4096, derive);
+  cache.get(Mechanism::SCRAM_SHA512, "b", "pw", "salt", 4096, derive);
+  cache.get(Mechanism::SCRAM_SHA512, "a", "pw", "salt", 4096, derive);
+  cache.get(Mechanism::SCRAM_SHA512, "c", "pw", "salt", 4096, derive);
+  REQUIRE(cache.size() == 2);
+  REQUIRE(calls == 3);
+
+  // "b" was evicted, "a" survived
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA512, "a", "pw", "salt", 4096, derive) == "1");
+  REQUIRE(calls == 3);
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA512, "b", "pw", "salt", 4096, derive) == "4");
+}
+
+TEST_CASE("unit: salted_password_cache does not keep failed derivations", "[unit]")
+{
+  salted_password_cache cache{};
+  REQUIRE_THROWS_AS(cache.get(Mechanism::SCRAM_SHA1,
+                              "alice",
+                              "secret",
+                              "salt",
+                              4096,
+                              []() -> std::string {
+                                throw std::runtime_error("boom");
+                              }),
+                    std::runtime_error);
+  REQUIRE(cache.size() == 0);
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA1, "alice", "secret", "salt", 4096, []() {
+    return std::string{ "salted" };
+  }) == "salted");
+}
+
+TEST_CASE("unit: salted_password_cache shares one derivation between concurrent misses", "[unit]")
+{
+  salted_password_cache cache{};
+  std::atomic_int calls{ 0 };
+  std::vector<std::thread> threads{};
+  std::vector<std::string> results(8);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&cache, &calls, &results, i]() {
+      results[i] = cache.get(Mechanism::SCRAM_SHA256, "alice", "secret", "salt", 4096, [&calls]() {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return std::string{ "salted" };
+      });
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(calls == 1);
+  for (const auto& result : results) {
+    REQUIRE(result == "salted");
+  }
+}
+
+TEST_CASE("unit: locked_secret keeps and compares its bytes", "[unit]")
+{
+  // larger than a page, and containing zero bytes
+  std::string value(10000, 'x');
+  value[42] = '\0';
+  const locked_secret secret{ value };
+  REQUIRE(secret.view() == value);
+  REQUIRE(secret.equals(value));
+  value[9999] = 'y';
+  REQUIRE_FALSE(secret.equals(value));
+  REQUIRE_FALSE(secret.equals(secret.view().substr(1)));
+
+  const locked_secret empty{ std::string_view{} };
+  REQUIRE(empty.view().empty());
+  REQUIRE(empty.equals(std::string_view{}));
+}
@@ -17,12 +17,23 @@
 
 #include "test_helper.hxx"
 
+#include "core/topology/configuration.hxx"
 #include "core/transactions/staged_mutation.hxx"
 
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 using namespace couchbase::core::transactions;
 
@@ -80,3 +91,284 @@ TEST_CASE("transactions: staged_mutation::type_as_string returns correct labels"
     REQUIRE(sm.type_as_string() == "REMOVE");
   }
 }
+
+namespace
+{
+auto
+make_mutation(staged_mutation_type type, couchbase::core::document_id id, std::string operation_id)
+  -> staged_mutation
+{
+  return staged_mutation{ type,
+                          std::move(id),
+                          couchbase::cas{},
+                          std::optional<couchbase::codec::binary>{},
+                          0U,
+                          0U,
+                          std::nullopt,
+                          std::move(operation_id) };
+}
+} // namespace
+
+TEST_CASE("transactions: staged_mutation_queue finds mutations by document id", "[unit]")
+{
+  using couchbase::core::document_id;
+  staged_mutation_queue queue{};
+  REQUIRE(queue.empty());
+
+  queue.add(make_mutation(staged_mutation_type::INSERT, { "b", "s", "c", "k1" }, "op1"));
+  queue.add(make_mutation(staged_mutation_type::REPLACE, { "b", "s", "c", "k2" }, "op2"));
+  queue.add(make_mutation(staged_mutation_type::REMOVE, { "b", "s", "c", "k3" }, "op3"));
+  // same key in another collection is another document
+  queue.add(make_mutation(staged_mutation_type::REPLACE, { "b", "s", "c2", "k1" }, "op4"));
+
+  REQUIRE(queue.find_any({ "b", "s", "c", "k1" })->operation_id() == "op1");
+  REQUIRE(queue.find_insert({ "b", "s", "c", "k1" })->operation_id() == "op1");
+  REQUIRE(queue.find_replace({ "b", "s", "c", "k1" }) == nullptr);
+  REQUIRE(queue.find_replace({ "b", "s", "c", "k2" })->operation_id() == "op2");
+  REQUIRE(queue.find_remove({ "b", "s", "c", "k3" })->operation_id() == "op3");
+  REQUIRE(queue.find_replace({ "b", "s", "c2", "k1" })->operation_id() == "op4");
+  REQUIRE(queue.find_any({ "b", "s", "c", "missing" }) == nullptr);
+  REQUIRE(queue.find_any({ "b2", "s", "c", "k1" }) == nullptr);
+
+  SECTION("restaging a document replaces its mutation")
+  {
+    queue.add(make_mutation(staged_mutation_type::REMOVE, { "b", "s", "c", "k2" }, "op5"));
+    REQUIRE(queue.find_replace({ "b", "s", "c", "k2" }) == nullptr);
+    REQUIRE(queue.find_remove({ "b", "s", "c", "k2" })->operation_id() == "op5");
+
+    std::size_t count{ 0 };
+    queue.iterate([&count](staged_mutation&) {
+      ++count;
+    });
+    REQUIRE(count == 4);
+  }
+
+  SECTION("removed documents are not found, the others still are")
+  {
+    queue.remove_any({ "b", "s", "c", "k1" });
+    queue.remove_any({ "b", "s", "c", "missing" });
+    REQUIRE(queue.find_any({ "b", "s", "c", "k1" }) == nullptr);
+    REQUIRE(queue.find_replace({ "b", "s", "c", "k2" })->operation_id() == "op2");
+    REQUIRE(queue.find_remove({ "b", "s", "c", "k3" })->operation_id() == "op3");
+    REQUIRE(queue.find_replace({ "b", "s", "c2", "k1" })->operation_id() == "op4");
+
+    queue.remove_any({ "b", "s", "c2", "k1" });
+    queue.remove_any({ "b", "s", "c", "k2" });
+    queue.remove_any({ "b", "s", "c", "k3" });
+    REQUIRE(queue.empty());
+  }
+}
+
+namespace
+{
+auto
+make_mutations(std::size_t count) -> std::vector<staged_mutation>
+{
+  std::vector<staged_mutation> mutations{};
+  mutations.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    mutations.push_back(make_mutation(staged_mutation_type::REPLACE,
+                                      { "b", "s", "c", "key-" + std::to_string(i) },
+                                      "op" + std::to_string(i)));
+  }
+  return mutations;
+}
+
+auto
+pointers_to(std::vector<staged_mutation>& mutations) -> std::vector<staged_mutation*>
+{
+  std::vector<staged_mutation*> items{};
+  items.reserve(mutations.size());
+  for (auto& mutation : mutations) {
+    items.push_back(&mutation);
+  }
+  return items;
+}
+
+auto
+without_configuration() -> unstaging_pipeline::configuration_lookup
+{
+  return [](const std::string& /* bucket_name */,
+            unstaging_pipeline::configuration_handler handler) {
+    handler(std::make_error_code(std::errc::operation_canceled), nullptr);
+  };
+}
+
+auto
+message_of(const std::exception_ptr& exc) -> std::string
+{
+  try {
+    std::rethrow_exception(exc);
+  } catch (const std::exception& e) {
+    return e.what();
+  }
+}
+} // namespace
+
+TEST_CASE("transactions: unstaging_pipeline keeps at most window operations in flight per node",
+          "[unit]")
+{
+  auto config = std::make_shared<couchbase::core::topology::configuration>();
+  config->nodes.resize(2);
+  config->vbmap = couchbase::core::topology::configuration::vbucket_map{ { 0 }, { 1 } };
+
+  auto mutations = make_mutations(40);
+  auto node_of = [config](const staged_mutation& item) {
+    return config->map_key(item.id().key(), 0).second.value();
+  };
+  std::map<std::size_t, std::size_t> per_node{};
+  for (const auto& mutation : mutations) {
+    ++per_node[node_of(mutation)];
+  }
+  REQUIRE(per_node.size() == 2);
+  REQUIRE(per_node[0] > 2);
+  REQUIRE(per_node[1] > 2);
+
+  std::deque<std::pair<std::size_t, unstaging_pipeline::completion_handler>> pending{};
+  std::map<std::size_t, std::size_t> in_flight{};
+  std::map<std::size_t, std::size_t> max_in_flight{};
+  std::map<std::size_t, std::size_t> unstaged{};
+  bool done{ false };
+  std::exception_ptr result{};
+
+  auto pipeline = std::make_shared<unstaging_pipeline>(
+    pointers_to(mutations),
+    2,
+    [config](const std::string& /* bucket_name */,
+             unstaging_pipeline::configuration_handler handler) {
+      handler({}, config);
+    },
+    [&](staged_mutation& item, unstaging_pipeline::completion_handler handler) {
+      const auto node = node_of(item);
+      max_in_flight[node] = std::max(max_in_flight[node], ++in_flight[node]);
+      ++unstaged[node];
+      pending.emplace_back(node, std::move(handler));
+    },
+    nullptr,
+    [&](std::exception_ptr exc) {
+      done = true;
+      result = std::move(exc);
+    });
+  pipeline->start();
+  REQUIRE(pending.size() == 4);
+
+  while (!pending.empty()) {
+    auto [node, handler] = std::move(pending.front());
+    pending.pop_front();
+    --in_flight[node];
+    handler({});
+  }
+  REQUIRE(done);
+  REQUIRE_FALSE(result);
+  REQUIRE(max_in_flight[0] == 2);
+  REQUIRE(max_in_flight[1] == 2);
+  REQUIRE(unstaged == per_node);
+}
+
+TEST_CASE("transactions: unstaging_pipeline does not recurse on synchronous completions", "[unit]")
+{
+  auto mutations = make_mutations(10'000);
+  std::size_t depth{ 0 };
+  std::size_t max_depth{ 0 };
+  std::size_t unstaged{ 0 };
+  bool done{ false };
+
+  auto pipeline = std::make_shared<unstaging_pipeline>(
+    pointers_to(mutations),
+    1,
+    without_configuration(),
+    [&](staged_mutation& /* item */, unstaging_pipeline::completion_handler handler) {
+      max_depth = std::max(max_depth, ++depth);
+      ++unstaged;
+      handler({});
+      --depth;
+    },
+    nullptr,
+    [&](std::exception_ptr exc) {
+      REQUIRE_FALSE(exc);
+      done = true;
+    });
+  pipeline->start();
+
+  REQUIRE(done);
+  REQUIRE(unstaged == mutations.size());
+  REQUIRE(max_depth == 1);
+}
+
+TEST_CASE("transactions: unstaging_pipeline stops after the first error and drains in-flight "
+          "operations",
+          "[unit]")
+{
+  auto mutations = make_mutations(10);
+  std::deque<unstaging_pipeline::completion_handler> pending{};
+  std::size_t unstaged{ 0 };
+  bool done{ false };
+  std::exception_ptr result{};
+
+  auto pipeline = std::make_shared<unstaging_pipeline>(
+    pointers_to(mutations),
+    4,
+    without_configuration(),
+    [&](staged_mutation& /* item */, unstaging_pipeline::completion_handler handler) {
+      ++unstaged;
+      pending.emplace_back(std::move(handler));
+    },
+    std::make_exception_ptr(std::runtime_error("aborted")),
+    [&](std::exception_ptr exc) {
+      done = true;
+      result = std::move(exc);
+    });
+  pipeline->start();
+  REQUIRE(pending.size() == 4);
+
+  auto complete_next = [&pending](std::exception_ptr exc) {
+    auto handler = std::move(pending.front());
+    pending.pop_front();
+    handler(std::move(exc));
+  };
+
+  complete_next({});
+  REQUIRE(unstaged == 5);
+  REQUIRE(pending.size() == 4);
+
+  complete_next(std::make_exception_ptr(std::runtime_error("first")));
+  REQUIRE(unstaged == 5);
+  REQUIRE(pending.size() == 3);
+  REQUIRE_FALSE(done);
+
+  complete_next(std::make_exception_ptr(std::runtime_error("second")));
+  complete_next({});
+  REQUIRE(unstaged == 5);
+  REQUIRE_FALSE(done);
+
+  complete_next({});
+  REQUIRE(pending.empty());
+  REQUIRE(done);
+  REQUIRE(result);
+  REQUIRE(message_of(result) == "first");
+}
+
+TEST_CASE("transactions: unstaging_pipeline reports the abort error when unstaging cannot start",
+          "[unit]")
+{
+  auto mutations = make_mutations(3);
+  bool done{ false };
+  std::exception_ptr result{};
+
+  auto pipeline = std::make_shared<unstaging_pipeline>(
+    pointers_to(mutations),
+    4,
+    without_configuration(),
+    [](staged_mutation& /* item */, unstaging_pipeline::completion_handler /* handler */) {
+      throw std::runtime_error("cannot send");
+    },
+    std::make_exception_ptr(std::runtime_error("aborted")),
+    [&](std::exception_ptr exc) {
+      done = true;
+      result = std::move(exc);
+    });
+  pipeline->start();
+
+  REQUIRE(done);
+  REQUIRE(message_of(result) == "aborted");
+}
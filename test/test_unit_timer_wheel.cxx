@@ -0,0 +1,169 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/timer_wheel.hxx"
+
+#include <asio/io_context.hpp>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+using couchbase::core::io::timer_wheel;
+using couchbase::core::io::wheel_timer;
+using namespace std::chrono_literals;
+
+TEST_CASE("unit: timer_wheel fires a timer once it is due, never earlier", "[unit]")
+{
+  asio::io_context ctx;
+  auto& wheel = asio::use_service<timer_wheel>(ctx);
+
+  const auto now = timer_wheel::clock::now();
+  int fired{ 0 };
+  wheel.schedule(now + 10ms, [&fired](std::error_code ec) {
+    REQUIRE_FALSE(ec);
+    ++fired;
+  });
+  REQUIRE(wheel.size() == 1);
+
+  REQUIRE(wheel.expire(now + 9ms) == 0);
+  REQUIRE(fired == 0);
+  REQUIRE(wheel.expire(now + 11ms) == 1);
+  REQUIRE(fired == 1);
+  REQUIRE(wheel.size() == 0);
+  REQUIRE(wheel.expire(now + 20ms) == 0);
+}
+
+TEST_CASE("unit: timer_wheel cascades long timers down to their tick", "[unit]")
+{
+  asio::io_context ctx;
+  auto& wheel = asio::use_service<timer_wheel>(ctx);
+
+  const auto now = timer_wheel::clock::now();
+  std::vector<std::chrono::milliseconds> fired{};
+  // one timer on each level, and one beyond the range of the last level
+  const std::array<std::chrono::milliseconds, 5> delays{ 75s, 100ms, 2500ms, 5h, 60 * 24h };
+  for (auto delay : delays) {
+    wheel.schedule(now + delay, [&fired, delay](std::error_code) {
+      fired.emplace_back(delay);
+    });
+  }
+
+  REQUIRE(wheel.expire(now + 99ms) == 0);
+  REQUIRE(wheel.expire(now + 101ms) == 1);
+  REQUIRE(wheel.expire(now + 2499ms) == 0);
+  REQUIRE(wheel.expire(now + 2501ms) == 1);
+  REQUIRE(wheel.expire(now + 74999ms) == 0);
+  REQUIRE(wheel.expire(now + 75001ms) == 1);
+  REQUIRE(wheel.expire(now + 5h - 1ms) == 0);
+  REQUIRE(wheel.expire(now + 5h + 1ms) == 1);
+  REQUIRE(wheel.expire(now + 60 * 24h - 1ms) == 0);
+  REQUIRE(wheel.expire(now + 60 * 24h + 1ms) == 1);
+  REQUIRE(fired == std::vector<std::chrono::milliseconds>{ 100ms, 2500ms, 75s, 5h, 60 * 24h });
+}
+
+TEST_CASE("unit: timer_wheel drops cancelled timers without invoking them", "[unit]")
+{
+  asio::io_context ctx;
+  auto& wheel = asio::use_service<timer_wheel>(ctx);
+
+  const auto now = timer_wheel::clock::now();
+  auto owner = std::make_shared<int>(42);
+  bool fired{ false };
+  auto handle = wheel.schedule(now + 5ms, [owner, &fired](std::error_code) {
+    fired = true;
+  });
+  REQUIRE(owner.use_count() == 2);
+
+  REQUIRE(wheel.cancel(handle));
+  REQUIRE(owner.use_count() == 1);
+  REQUIRE_FALSE(wheel.cancel(handle));
+
+  REQUIRE(wheel.expire(now + 10ms) == 0);
+  REQUIRE_FALSE(fired);
+}
+
+TEST_CASE("unit: timer_wheel handle of a fired timer does not cancel its successor", "[unit]")
+{
+  asio::io_context ctx;
+  auto& wheel = asio::use_service<timer_wheel>(ctx);
+
+  const auto now = timer_wheel::clock::now();
+  auto first = wheel.schedule(now + 1ms, [](std::error_code) {
+  });
+  REQUIRE(wheel.expire(now + 2ms) == 1);
+
+  // the slot of the first timer is reused
+  bool fired{ false };
+  wheel.schedule(now + 3ms, [&fired](std::error_code) {
+    fired = true;
+  });
+  REQUIRE_FALSE(wheel.cancel(first));
+  REQUIRE(wheel.expire(now + 4ms) == 1);
+  REQUIRE(fired);
+}
+
+TEST_CASE("unit: wheel_timer is driven by the io_context", "[unit]")
+{
+  asio::io_context ctx;
+  wheel_timer deadline{ ctx };
+  wheel_timer backoff{ ctx };
+
+  std::vector<int> fired{};
+  deadline.expires_after(20ms);
+  deadline.async_wait([&fired](std::error_code) {
+    fired.emplace_back(1);
+  });
+  backoff.expires_after(5ms);
+  backoff.async_wait([&fired](std::error_code) {
+    fired.emplace_back(2);
+  });
+  REQUIRE(deadline.expiry() > backoff.expiry());
+
+  ctx.run_for(200ms);
+  REQUIRE(fired == std::vector<int>{ 2, 1 });
+}
+
+TEST_CASE("unit: re-arming a wheel_timer replaces the pending wait", "[unit]")
+{
+  asio::io_context ctx;
+  wheel_timer timer{ ctx };
+
+  std::vector<int> fired{};
+  timer.expires_after(5ms);
+  timer.async_wait([&fired](std::error_code) {
+    fired.emplace_back(1);
+  });
+  timer.expires_after(10ms);
+  timer.async_wait([&fired](std::error_code) {
+    fired.emplace_back(2);
+  });
+  REQUIRE(timer.cancel() == 1);
+  REQUIRE(timer.cancel() == 0);
+
+  timer.expires_after(1ms);
+  timer.async_wait([&fired](std::error_code) {
+    fired.emplace_back(3);
+  });
+
+  ctx.run_for(100ms);
+  REQUIRE(fired == std::vector<int>{ 3 });
+}
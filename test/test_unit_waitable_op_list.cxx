@@ -238,12 +238,37 @@ TEST_CASE("transactions: query_mode_entered stays false until in-flight ops drai
 
 TEST_CASE("transactions: operations after commit/rollback are rejected with a conflict", "[unit]")
 {
-  // Once commit/rollback has blocked operations (wait_and_block_ops), a racing operation must be
+  // Once commit/rollback has blocked operations (block_ops_when_done), a racing operation must be
   // rejected: increment_ops() throws async_operation_conflict. Mapping that conflict to the
   // CONCURRENT_OPERATIONS_DETECTED_ON_SAME_DOCUMENT cause happens in attempt_context_impl and is
   // covered by the FIT ThreadSafety suite, not here.
   couchbase::core::transactions::waitable_op_list op_list;
-  op_list.wait_and_block_ops(); // no ops in flight, so this returns immediately and blocks new ops
+  bool blocked{ false };
+  // no ops in flight, so the handler runs immediately and new ops are blocked
+  op_list.block_ops_when_done([&blocked]() {
+    blocked = true;
+  });
+  REQUIRE(blocked);
+
+  REQUIRE_THROWS_AS(op_list.increment_ops(),
+                    couchbase::core::transactions::async_operation_conflict);
+}
+
+TEST_CASE("transactions: block_ops_when_done runs the handler once the last op finishes", "[unit]")
+{
+  couchbase::core::transactions::waitable_op_list op_list;
+  op_list.increment_ops();
+  op_list.increment_ops();
+  int calls{ 0 };
+  op_list.block_ops_when_done([&calls]() {
+    ++calls;
+  });
+  // the caller is not blocked, the handler waits for the ops instead
+  REQUIRE(calls == 0);
+  op_list.decrement_ops();
+  REQUIRE(calls == 0);
+  op_list.decrement_ops();
+  REQUIRE(calls == 1);
 
   REQUIRE_THROWS_AS(op_list.increment_ops(),
                     couchbase::core::transactions::async_operation_conflict);
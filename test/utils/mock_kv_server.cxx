@@ -0,0 +1,496 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "mock_kv_server.hxx"
+
+#include "core/error_context/key_value_status_code.hxx"
+#include "core/protocol/client_opcode.hxx"
+#include "core/protocol/hello_feature.hxx"
+#include "core/protocol/magic.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/ip/tcp.hpp>
+#include <asio/post.hpp>
+#include <asio/steady_timer.hpp>
+#include <asio/write.hpp>
+#include <spdlog/fmt/bundled/core.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace test::utils
+{
+namespace
+{
+using couchbase::core::key_value_status_code;
+using couchbase::core::protocol::client_opcode;
+using couchbase::core::protocol::hello_feature;
+using couchbase::core::protocol::magic;
+
+constexpr std::size_t header_size = 24;
+
+auto
+read_uint16(const std::byte* data) -> std::uint16_t
+{
+  return static_cast<std::uint16_t>((std::to_integer<std::uint16_t>(data[0]) << 8U) |
+                                    std::to_integer<std::uint16_t>(data[1]));
+}
+
+auto
+read_uint32(const std::byte* data) -> std::uint32_t
+{
+  return (static_cast<std::uint32_t>(read_uint16(data)) << 16U) | read_uint16(data + 2);
+}
+
+void
+write_uint(std::byte* data, std::uint64_t value, std::size_t size)
+{
+  for (std::size_t i = 0; i < size; ++i) {
+    data[size - 1 - i] = static_cast<std::byte>(value & 0xffU);
+    value >>= 8U;
+  }
+}
+
+auto
+to_bytes(std::string_view text) -> std::vector<std::byte>
+{
+  std::vector<std::byte> bytes(text.size());
+  std::transform(text.begin(), text.end(), bytes.begin(), [](char c) {
+    return static_cast<std::byte>(c);
+  });
+  return bytes;
+}
+
+struct request {
+  client_opcode opcode{};
+  std::array<std::byte, 4> opaque{};
+  std::uint8_t datatype{};
+  std::vector<std::byte> extras{};
+  std::string key{};
+  std::vector<std::byte> value{};
+};
+
+struct response {
+  client_opcode opcode{};
+  key_value_status_code status{ key_value_status_code::success };
+  std::array<std::byte, 4> opaque{};
+  std::uint64_t cas{ 0 };
+  std::uint8_t datatype{ 0 };
+  std::vector<std::byte> extras{};
+  std::vector<std::byte> value{};
+};
+
+// Appends the frame of @p resp to @p output.
+void
+encode(const response& resp, std::vector<std::byte>& output)
+{
+  const auto offset = output.size();
+  output.resize(offset + header_size + resp.extras.size() + resp.value.size());
+  auto* header = output.data() + offset;
+  header[0] = static_cast<std::byte>(magic::client_response);
+  header[1] = static_cast<std::byte>(resp.opcode);
+  header[4] = static_cast<std::byte>(resp.extras.size());
+  header[5] = static_cast<std::byte>(resp.datatype);
+  write_uint(header + 6, static_cast<std::uint16_t>(resp.status), 2);
+  write_uint(header + 8, resp.extras.size() + resp.value.size(), 4);
+  std::copy(resp.opaque.begin(), resp.opaque.end(), header + 12);
+  write_uint(header + 16, resp.cas, 8);
+  auto* body = header + header_size;
+  body = std::copy(resp.extras.begin(), resp.extras.end(), body);
+  std::copy(resp.value.begin(), resp.value.end(), body);
+}
+
+struct document {
+  std::vector<std::byte> value{};
+  std::array<std::byte, 4> flags{};
+  std::uint8_t datatype{ 0 };
+  std::uint64_t cas{ 0 };
+};
+} // namespace
+
+class mock_kv_server::impl
+{
+  class connection : public std::enable_shared_from_this<connection>
+  {
+  public:
+    connection(impl* server, asio::ip::tcp::socket socket)
+      : server_{ server }
+      , socket_{ std::move(socket) }
+    {
+      std::error_code ignored;
+      socket_.set_option(asio::ip::tcp::no_delay{ true }, ignored);
+    }
+
+    void start()
+    {
+      do_read();
+    }
+
+    void send(const response& resp)
+    {
+      encode(resp, output_);
+      if (!writing_) {
+        do_write();
+      }
+    }
+
+    void send_later(response&& resp, std::chrono::microseconds delay)
+    {
+      auto timer = std::make_shared<asio::steady_timer>(socket_.get_executor(), delay);
+      timer->async_wait(
+        [self = shared_from_this(), timer, resp = std::move(resp)](std::error_code ec) {
+          if (!ec) {
+            self->send(resp);
+          }
+        });
+    }
+
+    [[nodiscard]] auto bucket_selected() const -> bool
+    {
+      return bucket_selected_;
+    }
+
+    void select_bucket()
+    {
+      bucket_selected_ = true;
+    }
+
+  private:
+    void do_read()
+    {
+      socket_.async_read_some(
+        asio::buffer(read_buffer_),
+        [self = shared_from_this()](std::error_code ec, std::size_t bytes_transferred) {
+          if (ec) {
+            return;
+          }
+          self->server_->bytes_received_ += bytes_transferred;
+          self->input_.insert(self->input_.end(),
+                              self->read_buffer_.begin(),
+                              self->read_buffer_.begin() +
+                                static_cast<std::ptrdiff_t>(bytes_transferred));
+          if (!self->dispatch_frames()) {
+            std::error_code ignored;
+            self->socket_.close(ignored);
+            return;
+          }
+          self->do_read();
+        });
+    }
+
+    // Decodes and handles every complete frame in the input. False on a malformed frame.
+    auto dispatch_frames() -> bool
+    {
+      std::size_t offset = 0;
+      while (input_.size() - offset >= header_size) {
+        const auto* header = input_.data() + offset;
+        const auto body_size = read_uint32(header + 8);
+        if (input_.size() - offset - header_size < body_size) {
+          break;
+        }
+        std::size_t framing_extras_size = 0;
+        std::size_t key_size = read_uint16(header + 2);
+        const auto frame_magic = std::to_integer<std::uint8_t>(header[0]);
+        if (frame_magic == static_cast<std::uint8_t>(magic::alt_client_request)) {
+          framing_extras_size = std::to_integer<std::size_t>(header[2]);
+          key_size = std::to_integer<std::size_t>(header[3]);
+        } else if (frame_magic != static_cast<std::uint8_t>(magic::client_request)) {
+          return false;
+        }
+        const auto extras_size = std::to_integer<std::size_t>(header[4]);
+        if (framing_extras_size + extras_size + key_size > body_size) {
+          return false;
+        }
+
+        request req{};
+        req.opcode = static_cast<client_opcode>(header[1]);
+        req.datatype = std::to_integer<std::uint8_t>(header[5]);
+        std::copy(header + 12, header + 16, req.opaque.begin());
+        const auto* body = header + header_size + framing_extras_size;
+        req.extras.assign(body, body + extras_size);
+        body += extras_size;
+        req.key.assign(reinterpret_cast<const char*>(body), key_size);
+        body += key_size;
+        req.value.assign(body, header + header_size + body_size);
+
+        offset += header_size + body_size;
+        server_->handle(shared_from_this(), std::move(req));
+      }
+      input_.erase(input_.begin(), input_.begin() + static_cast<std::ptrdiff_t>(offset));
+      return true;
+    }
+
+    void do_write()
+    {
+      if (output_.empty()) {
+        writing_ = false;
+        return;
+      }
+      writing_ = true;
+      std::swap(output_, writing_buffer_);
+      asio::async_write(
+        socket_,
+        asio::buffer(writing_buffer_),
+        [self = shared_from_this()](std::error_code ec, std::size_t bytes_transferred) {
+          self->server_->bytes_sent_ += bytes_transferred;
+          self->writing_buffer_.clear();
+          if (ec) {
+            self->writing_ = false;
+            return;
+          }
+          self->do_write();
+        });
+    }
+
+    impl* server_;
+    asio::ip::tcp::socket socket_;
+    std::array<std::byte, 16384> read_buffer_{};
+    std::vector<std::byte> input_{};
+    std::vector<std::byte> output_{};
+    std::vector<std::byte> writing_buffer_{};
+    bool writing_{ false };
+    bool bucket_selected_{ false };
+  };
+
+public:
+  explicit impl(mock_kv_server_options options)
+    : options_{ std::move(options) }
+    , acceptor_{ ctx_, asio::ip::tcp::endpoint{ asio::ip::make_address("127.0.0.1"), 0 } }
+  {
+  }
+
+  void start()
+  {
+    do_accept();
+    thread_ = std::thread([this]() {
+      ctx_.run();
+    });
+  }
+
+  void stop()
+  {
+    asio::post(ctx_, [this]() {
+      std::error_code ignored;
+      acceptor_.close(ignored);
+      ctx_.stop();
+    });
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  [[nodiscard]] auto port() const -> std::uint16_t
+  {
+    return acceptor_.local_endpoint().port();
+  }
+
+  [[nodiscard]] auto options() const -> const mock_kv_server_options&
+  {
+    return options_;
+  }
+
+  [[nodiscard]] auto stats() const -> mock_kv_server_stats
+  {
+    return { connections_.load(), requests_.load(), bytes_received_.load(), bytes_sent_.load() };
+  }
+
+private:
+  void do_accept()
+  {
+    acceptor_.async_accept([this](std::error_code ec, asio::ip::tcp::socket socket) {
+      if (ec) {
+        return;
+      }
+      ++connections_;
+      std::make_shared<connection>(this, std::move(socket))->start();
+      do_accept();
+    });
+  }
+
+  void handle(const std::shared_ptr<connection>& conn, request&& req)
+  {
+    ++requests_;
+    response resp{};
+    resp.opcode = req.opcode;
+    resp.opaque = req.opaque;
+    switch (req.opcode) {
+      case client_opcode::hello:
+        for (std::size_t i = 0; i + 1 < req.value.size(); i += 2) {
+          switch (static_cast<hello_feature>(read_uint16(req.value.data() + i))) {
+            case hello_feature::tcp_nodelay:
+            case hello_feature::select_bucket:
+            case hello_feature::json:
+            case hello_feature::unordered_execution:
+            case hello_feature::alt_request_support:
+              resp.value.push_back(req.value[i]);
+              resp.value.push_back(req.value[i + 1]);
+              break;
+            default:
+              break;
+          }
+        }
+        break;
+
+      case client_opcode::sasl_list_mechs:
+        resp.value = to_bytes("PLAIN");
+        break;
+
+      case client_opcode::sasl_auth:
+        if (req.key != "PLAIN" ||
+            req.value != to_bytes(fmt::format("{}{}{}{}",
+                                              '\0',
+                                              options_.username,
+                                              '\0',
+                                              options_.password))) {
+          resp.status = key_value_status_code::auth_error;
+        }
+        break;
+
+      case client_opcode::select_bucket:
+        if (req.key == options_.bucket_name) {
+          conn->select_bucket();
+        } else {
+          resp.status = key_value_status_code::no_access;
+        }
+        break;
+
+      case client_opcode::get_cluster_config:
+        resp.datatype = 0x01; // JSON
+        resp.value = to_bytes(configuration(conn->bucket_selected()));
+        break;
+
+      case client_opcode::noop:
+        break;
+
+      case client_opcode::get:
+        if (auto it = documents_.find(req.key); it != documents_.end()) {
+          resp.cas = it->second.cas;
+          resp.datatype = it->second.datatype;
+          resp.extras.assign(it->second.flags.begin(), it->second.flags.end());
+          resp.value = it->second.value;
+        } else {
+          resp.cas = 1;
+          resp.extras.resize(4);
+          resp.value.resize(options_.value_size, std::byte{ 'x' });
+        }
+        return reply(conn, std::move(resp));
+
+      case client_opcode::upsert: {
+        auto& doc = documents_[req.key];
+        doc.value = std::move(req.value);
+        doc.datatype = req.datatype;
+        if (req.extras.size() >= doc.flags.size()) {
+          std::copy_n(req.extras.begin(), doc.flags.size(), doc.flags.begin());
+        }
+        doc.cas = ++cas_;
+        resp.cas = doc.cas;
+        return reply(conn, std::move(resp));
+      }
+
+      default:
+        resp.status = key_value_status_code::unknown_command;
+        break;
+    }
+    conn->send(resp);
+  }
+
+  // KV operations are answered after the configured latency.
+  void reply(const std::shared_ptr<connection>& conn, response&& resp) const
+  {
+    if (options_.latency.count() > 0) {
+      return conn->send_later(std::move(resp), options_.latency);
+    }
+    conn->send(resp);
+  }
+
+  [[nodiscard]] auto configuration(bool with_bucket) const -> std::string
+  {
+    const auto port = acceptor_.local_endpoint().port();
+    auto nodes_ext =
+      fmt::format(R"([{{"services":{{"kv":{}}},"hostname":"$HOST","thisNode":true}}])", port);
+    if (!with_bucket) {
+      return fmt::format(R"({{"rev":1,"revEpoch":1,"nodesExt":{}}})", nodes_ext);
+    }
+    std::string vbucket_map{};
+    for (std::uint16_t i = 0; i < options_.number_of_vbuckets; ++i) {
+      vbucket_map += (i == 0) ? "[0]" : ",[0]";
+    }
+    return fmt::format(
+      R"({{"rev":1,"revEpoch":1,"name":"{}","uuid":"mock","nodeLocator":"vbucket","nodesExt":{},)"
+      R"("bucketCapabilities":["cccp","nodesExt","touch","xattr"],)"
+      R"("vBucketServerMap":{{"hashAlgorithm":"CRC","numReplicas":0,"serverList":["$HOST:{}"],)"
+      R"("vBucketMap":[{}]}}}})",
+      options_.bucket_name,
+      nodes_ext,
+      port,
+      vbucket_map);
+  }
+
+  mock_kv_server_options options_;
+  asio::io_context ctx_{};
+  asio::ip::tcp::acceptor acceptor_;
+  std::thread thread_{};
+  // only touched from the server thread
+  std::unordered_map<std::string, document> documents_{};
+  std::uint64_t cas_{ 0 };
+  std::atomic<std::uint64_t> connections_{ 0 };
+  std::atomic<std::uint64_t> requests_{ 0 };
+  std::atomic<std::uint64_t> bytes_received_{ 0 };
+  std::atomic<std::uint64_t> bytes_sent_{ 0 };
+};
+
+mock_kv_server::mock_kv_server(mock_kv_server_options options)
+  : impl_{ std::make_shared<impl>(std::move(options)) }
+{
+  impl_->start();
+}
+
+mock_kv_server::~mock_kv_server()
+{
+  impl_->stop();
+}
+
+auto
+mock_kv_server::port() const -> std::uint16_t
+{
+  return impl_->port();
+}
+
+auto
+mock_kv_server::connection_string() const -> std::string
+{
+  return fmt::format("couchbase://127.0.0.1:{}=mcd", impl_->port());
+}
+
+auto
+mock_kv_server::options() const -> const mock_kv_server_options&
+{
+  return impl_->options();
+}
+
+auto
+mock_kv_server::stats() const -> mock_kv_server_stats
+{
+  return impl_->stats();
+}
+} // namespace test::utils
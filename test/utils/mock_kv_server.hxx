@@ -0,0 +1,75 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace test::utils
+{
+struct mock_kv_server_options {
+  std::string bucket_name{ "default" };
+  std::string username{ "Administrator" };
+  std::string password{ "password" };
+  std::uint16_t number_of_vbuckets{ 64 };
+  // size of the value GET returns for a key that was never stored
+  std::size_t value_size{ 256 };
+  // time the server holds every KV response before writing it
+  std::chrono::microseconds latency{ 0 };
+};
+
+struct mock_kv_server_stats {
+  std::uint64_t connections{ 0 };
+  std::uint64_t requests{ 0 };
+  std::uint64_t bytes_received{ 0 };
+  std::uint64_t bytes_sent{ 0 };
+};
+
+/**
+ * A single-node KV service that speaks just enough of the memcached binary protocol for the SDK to
+ * bootstrap and run GET and SET against it: HELLO, SASL (PLAIN only), SELECT_BUCKET,
+ * GET_CLUSTER_CONFIG and NOOP. Any other command is answered with "unknown command". Documents are
+ * kept in memory.
+ *
+ * The server listens on an ephemeral loopback port and runs on its own thread, so that benchmarks
+ * and tests can drive the full client stack without a cluster.
+ */
+class mock_kv_server
+{
+public:
+  explicit mock_kv_server(mock_kv_server_options options = {});
+  mock_kv_server(const mock_kv_server&) = delete;
+  mock_kv_server(mock_kv_server&&) = delete;
+  auto operator=(const mock_kv_server&) -> mock_kv_server& = delete;
+  auto operator=(mock_kv_server&&) -> mock_kv_server& = delete;
+  ~mock_kv_server();
+
+  [[nodiscard]] auto port() const -> std::uint16_t;
+  // connection string that bootstraps over KV from this server
+  [[nodiscard]] auto connection_string() const -> std::string;
+  [[nodiscard]] auto options() const -> const mock_kv_server_options&;
+  [[nodiscard]] auto stats() const -> mock_kv_server_stats;
+
+private:
+  class impl;
+  std::shared_ptr<impl> impl_;
+};
+} // namespace test::utils
@@ -323,7 +323,9 @@ public:
              incompressible_body_,
              "Use random characters to fill generated document value (by default uses 'x' to fill "
              "the body).");
-    add_option("--number-of-io-threads", number_of_io_threads_, "Number of the IO threads.")
+    add_option("--number-of-io-threads",
+               number_of_io_threads_,
+               "Number of the IO threads of the cluster (each endpoint is pinned to one of them).")
       ->default_val(default_number_of_io_threads);
     add_option("--number-of-keys-to-populate",
                number_of_keys_to_populate_,
@@ -371,18 +373,15 @@ public:
     }
     apply_logger_options(common_options_.logger);
 
-    const auto cluster_options = build_cluster_options(common_options_);
+    auto cluster_options = build_cluster_options(common_options_);
+    cluster_options.network().io_threads(number_of_io_threads_);
 
+    // Only drives the stats timer, the cluster runs its own IO threads.
     asio::io_context io;
     auto guard = asio::make_work_guard(io);
-
-    std::vector<std::thread> io_pool{};
-    io_pool.reserve(number_of_io_threads_);
-    for (std::size_t i = 0; i < number_of_io_threads_; ++i) {
-      io_pool.emplace_back([&io]() {
-        io.run();
-      });
-    }
+    std::thread io_thread([&io]() {
+      io.run();
+    });
 
     hdr_init(/* minimum - 1 us*/ 1'000,
              /* maximum - 30 s*/ 30'000'000'000LL,
@@ -399,19 +398,19 @@ public:
                "| Version: {}\n"
                "| Connection String: {}\n"
                "| Ratio: {} (Get:Replace:Delete:Insert:Query)\n"
-               "| Batch size: {}\n",
+               "| Batch size: {}\n"
+               "| IO threads: {}\n",
                couchbase::core::meta::sdk_semver(),
                connection_string,
                operation_generator::parse(operation_ratio_string_).to_string(),
-               operation_batch_size_);
+               operation_batch_size_,
+               number_of_io_threads_);
 
     auto [connect_err, cluster] =
       couchbase::cluster::connect(connection_string, cluster_options).get();
     if (connect_err) {
       guard.reset();
-      for (auto& thread : io_pool) {
-        thread.join();
-      }
+      io_thread.join();
       fail(fmt::format(
         "Failed to connect to the cluster at \"{}\": {}", connection_string, connect_err));
     }
@@ -470,9 +469,7 @@ public:
       }
     }
 
-    for (auto& thread : io_pool) {
-      thread.join();
-    }
+    io_thread.join();
 
     if (total > 0) {
       fmt::print("Latency distribution (in ms)\n");
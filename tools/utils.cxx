@@ -322,6 +322,9 @@ add_options(CLI::App* app, compression_options& options)
                  options.minimum_ratio,
                  "The minimum compression ratio to allow compressed form to be used.")
     ->default_val(defaults.compression.min_ratio);
+  group->add_flag("--compression-adaptive",
+                  options.adaptive,
+                  "Stop compressing documents of collections that do not compress well.");
 }
 
 void
@@ -734,6 +737,7 @@ apply_options(couchbase::cluster_options& options, const compression_options& co
   options.compression().enabled(!compression.disable);
   options.compression().min_size(compression.minimum_size);
   options.compression().min_ratio(compression.minimum_ratio);
+  options.compression().adaptive(compression.adaptive);
 }
 
 void
@@ -123,6 +123,7 @@ struct compression_options {
   bool disable{ false };
   std::size_t minimum_size{};
   double minimum_ratio{};
+  bool adaptive{ false };
 };
 
 struct dns_srv_options {